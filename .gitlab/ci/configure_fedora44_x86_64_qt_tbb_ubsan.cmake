@@ -4,4 +4,9 @@ set(VTK_SANITIZER "undefined" CACHE STRING "")
 # Enable VTK_USE_FUTURE_CONST so that at something on CI tests it.
 set(VTK_USE_FUTURE_CONST ON CACHE BOOL "")
 
+# Build HDF5 thread safe so that vtkHDFWriter is tested writing in the background
+# with HDF5 readers upstream. HDF5 does not support its HL library with thread safety.
+set(VTK_HDF5_ENABLE_THREADSAFE ON CACHE BOOL "")
+set(HDF5_ALLOW_UNSUPPORTED ON CACHE BOOL "")
+
 include("${CMAKE_CURRENT_LIST_DIR}/configure_fedora44.cmake")
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkAbstractPointLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkDataSetLocatorCache.h"
+#include "vtkGenericCell.h"
+#include "vtkJumpAndWalkCellLocator.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> CreateData(int nbOfPoints)
+{
+  auto mesh = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  for (int i = 0; i < nbOfPoints; i++)
+  {
+    points->InsertNextPoint(i, i % 7, i % 3);
+    verts->InsertNextCell({ static_cast<vtkIdType>(i) });
+  }
+  mesh->SetPoints(points);
+  mesh->SetVerts(verts);
+  return mesh;
+}
+
+//------------------------------------------------------------------------------
+bool TestReuse()
+{
+  vtkLogScopeFunction(INFO);
+  vtkNew<vtkDataSetLocatorCache> cache;
+  auto mesh = ::CreateData(100);
+
+  auto cellLocator = cache->GetCellLocator(mesh);
+  if (!vtkStaticCellLocator::SafeDownCast(cellLocator) ||
+    cellLocator->FindCell(mesh->GetPoint(42)) != 42)
+  {
+    vtkLog(ERROR, "Default cell locator should be a vtkStaticCellLocator built on mesh.");
+    return false;
+  }
+  if (cache->GetCellLocator(mesh) != cellLocator || cache->GetNumberOfHits() != 1 ||
+    cache->GetNumberOfBuilds() != 1)
+  {
+    vtkLog(ERROR, "Second request should reuse the cached cell locator.");
+    return false;
+  }
+
+  // a different locator type is a different entry
+  vtkNew<vtkCellLocator> prototype;
+  auto otherLocator = cache->GetCellLocator(mesh, prototype);
+  if (!vtkCellLocator::SafeDownCast(otherLocator) || otherLocator == prototype.Get() ||
+    cache->GetNumberOfBuilds() != 2 || cache->GetNumberOfEntries() != 2)
+  {
+    vtkLog(ERROR, "Requesting another type should build a new entry.");
+    return false;
+  }
+
+  // point locators are supported too
+  auto pointLocator = cache->GetPointLocator(mesh);
+  if (!vtkStaticPointLocator::SafeDownCast(pointLocator) ||
+    pointLocator->FindClosestPoint(mesh->GetPoint(42)) != 42)
+  {
+    vtkLog(ERROR, "Default point locator should be a built vtkStaticPointLocator.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestParameters()
+{
+  vtkLogScopeFunction(INFO);
+  vtkNew<vtkDataSetLocatorCache> cache;
+  auto mesh = ::CreateData(100);
+  vtkNew<vtkStaticCellLocator> coarse;
+  coarse->SetNumberOfCellsPerNode(50);
+  vtkNew<vtkStaticCellLocator> fine;
+  fine->SetNumberOfCellsPerNode(2);
+
+  // each configuration has its own entry, alternating does not rebuild
+  for (int i = 0; i < 3; i++)
+  {
+    cache->GetCellLocator(mesh, coarse);
+    cache->GetCellLocator(mesh, fine);
+  }
+  if (cache->GetNumberOfEntries() != 2 || cache->GetNumberOfBuilds() != 2 ||
+    cache->GetNumberOfHits() != 4)
+  {
+    vtkLog(ERROR, "Prototypes with different parameters should have their own entry.");
+    return false;
+  }
+
+  if (cache->GetCellLocator(mesh, coarse)->GetNumberOfCellsPerNode() != 50 ||
+    cache->GetCellLocator(mesh, fine)->GetNumberOfCellsPerNode() != 2)
+  {
+    vtkLog(ERROR, "Cached locators should have the parameters of their prototype.");
+    return false;
+  }
+
+  // modifying a prototype selects the entry of its new configuration
+  fine->SetNumberOfCellsPerNode(50);
+  cache->GetCellLocator(mesh, fine);
+  if (cache->GetNumberOfEntries() != 2 || cache->GetNumberOfBuilds() != 2)
+  {
+    vtkLog(ERROR, "Equally configured prototypes should share their entry.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestMeshModification()
+{
+  vtkLogScopeFunction(INFO);
+  vtkNew<vtkDataSetLocatorCache> cache;
+  auto mesh = ::CreateData(100);
+  vtkNew<vtkPointLocator> prototype;
+
+  cache->GetPointLocator(mesh, prototype);
+  mesh->GetPoints()->SetPoint(0, 50, 50, 50);
+  mesh->GetPoints()->Modified();
+
+  auto locator = cache->GetPointLocator(mesh, prototype);
+  if (cache->GetNumberOfBuilds() != 2 || cache->GetNumberOfHits() != 0)
+  {
+    vtkLog(ERROR, "Modified mesh should trigger a rebuild.");
+    return false;
+  }
+  if (locator->FindClosestPoint(50, 50, 50) != 0)
+  {
+    vtkLog(ERROR, "Rebuilt locator should see the new point position.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestEviction()
+{
+  vtkLogScopeFunction(INFO);
+  vtkNew<vtkDataSetLocatorCache> cache;
+  auto first = ::CreateData(10000);
+  auto second = ::CreateData(10000);
+
+  cache->GetCellLocator(first);
+  const vtkIdType entrySize = cache->GetMemorySize();
+  cache->SetMemoryLimit(entrySize + entrySize / 2);
+
+  cache->GetCellLocator(second);
+  if (cache->GetNumberOfEntries() != 1 || cache->GetNumberOfEvictions() != 1)
+  {
+    vtkLog(ERROR, "Least recently used entry should be evicted.");
+    return false;
+  }
+
+  cache->GetCellLocator(second);
+  if (cache->GetNumberOfHits() != 1)
+  {
+    vtkLog(ERROR, "Most recent entry should be kept.");
+    return false;
+  }
+
+  cache->ResetStatistics();
+  if (cache->GetNumberOfHits() != 0 || cache->GetNumberOfBuilds() != 0 ||
+    cache->GetNumberOfEvictions() != 0)
+  {
+    vtkLog(ERROR, "Statistics should be reset.");
+    return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestRelease()
+{
+  vtkLogScopeFunction(INFO);
+  vtkNew<vtkDataSetLocatorCache> cache;
+  auto mesh = ::CreateData(10);
+  cache->GetCellLocator(mesh);
+  cache->GetPointLocator(mesh);
+
+  // the cache should not keep an otherwise unused dataset alive
+  mesh = nullptr;
+  if (cache->GetNumberOfEntries() != 0)
+  {
+    vtkLog(ERROR, "Entries of deleted datasets should be removed.");
+    return false;
+  }
+
+  // same with a vtkJumpAndWalkCellLocator, that also sets the dataset on its point locator
+  mesh = ::CreateData(10);
+  vtkNew<vtkJumpAndWalkCellLocator> prototype;
+  auto locator = cache->GetCellLocator(mesh, prototype);
+  double x[3];
+  mesh->GetPoint(7, x);
+  mesh = nullptr;
+  if (cache->GetNumberOfEntries() != 0)
+  {
+    vtkLog(ERROR, "Entries of deleted datasets should be removed with vtkJumpAndWalkCellLocator.");
+    return false;
+  }
+
+  // a locator kept by the caller remains usable
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3];
+  double weights[8];
+  int subId;
+  if (locator->FindCell(x, 0, cell, subId, pcoords, weights) != 7)
+  {
+    vtkLog(ERROR, "Locator should remain usable after its dataset is deleted.");
+    return false;
+  }
+  locator = nullptr;
+
+  auto other = ::CreateData(10);
+  cache->GetCellLocator(other);
+  cache->ReleaseDataSet(other);
+  if (cache->GetNumberOfEntries() != 0 || cache->GetMemorySize() != 0)
+  {
+    vtkLog(ERROR, "ReleaseDataSet should remove entries.");
+    return false;
+  }
+
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataSetLocatorCache(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return (::TestReuse() && ::TestParameters() && ::TestMeshModification() && ::TestEviction() &&
+           ::TestRelease())
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
@@ -0,0 +1,381 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataSetLocatorCache.h"
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkAbstractPointLocator.h"
+#include "vtkCommand.h"
+#include "vtkDataSet.h"
+#include "vtkJumpAndWalkCellLocator.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkDataSetLocatorCache);
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Estimate the memory used by a built locator, in kibibytes.
+// Cell locators store the cell bounds and a (cell id, bin id) map,
+// point locators store a (point id, bin id) map.
+vtkIdType EstimateLocatorSize(vtkLocator* locator)
+{
+  vtkDataSet* dataset = locator->GetDataSet();
+  if (!dataset)
+  {
+    return 0;
+  }
+
+  std::size_t bytes = 0;
+  if (vtkAbstractCellLocator::SafeDownCast(locator))
+  {
+    bytes = static_cast<std::size_t>(dataset->GetNumberOfCells()) *
+      (6 * sizeof(double) + 2 * sizeof(vtkIdType));
+  }
+  else
+  {
+    bytes = static_cast<std::size_t>(dataset->GetNumberOfPoints()) * 2 * sizeof(vtkIdType);
+  }
+
+  return static_cast<vtkIdType>(bytes / 1024 + 1);
+}
+
+//------------------------------------------------------------------------------
+// Return a key describing the locator class and the search parameters copied
+// by CopyLocatorParameters, so that each configuration has its own entry.
+std::string GetLocatorKey(vtkLocator* locator)
+{
+  std::ostringstream key;
+  key << locator->GetClassName() << ";" << locator->GetAutomatic() << ";"
+      << locator->GetMaxLevel();
+
+  if (auto cellLocator = vtkAbstractCellLocator::SafeDownCast(locator))
+  {
+    key << ";" << cellLocator->GetNumberOfCellsPerNode() << ";"
+        << cellLocator->GetCacheCellBounds();
+  }
+
+  if (auto staticCellLocator = vtkStaticCellLocator::SafeDownCast(locator))
+  {
+    const int* divisions = staticCellLocator->GetDivisions();
+    key << ";" << divisions[0] << "," << divisions[1] << "," << divisions[2] << ";"
+        << staticCellLocator->GetMaxNumberOfBuckets();
+  }
+
+  if (auto jumpAndWalkLocator = vtkJumpAndWalkCellLocator::SafeDownCast(locator))
+  {
+    auto pointLocator = jumpAndWalkLocator->GetPointLocator();
+    key << ";" << jumpAndWalkLocator->GetNumberOfClosestPoints() << ";"
+        << (pointLocator ? pointLocator->GetClassName() : "");
+  }
+
+  if (auto pointLocator = vtkAbstractPointLocator::SafeDownCast(locator))
+  {
+    key << ";" << pointLocator->GetTolerance();
+  }
+
+  if (auto staticPointLocator = vtkStaticPointLocator::SafeDownCast(locator))
+  {
+    const int* divisions = staticPointLocator->GetDivisions();
+    key << ";" << staticPointLocator->GetNumberOfPointsPerBucket() << ";" << divisions[0] << ","
+        << divisions[1] << "," << divisions[2] << ";"
+        << staticPointLocator->GetMaxNumberOfBuckets();
+  }
+
+  return key.str();
+}
+
+//------------------------------------------------------------------------------
+// Copy the search parameters from prototype to locator.
+void CopyLocatorParameters(vtkLocator* prototype, vtkLocator* locator)
+{
+  locator->SetAutomatic(prototype->GetAutomatic());
+  locator->SetMaxLevel(prototype->GetMaxLevel());
+
+  auto protoCell = vtkAbstractCellLocator::SafeDownCast(prototype);
+  auto cellLocator = vtkAbstractCellLocator::SafeDownCast(locator);
+  if (protoCell && cellLocator)
+  {
+    cellLocator->SetNumberOfCellsPerNode(protoCell->GetNumberOfCellsPerNode());
+    cellLocator->SetCacheCellBounds(protoCell->GetCacheCellBounds());
+  }
+
+  auto protoStaticCell = vtkStaticCellLocator::SafeDownCast(prototype);
+  auto staticCellLocator = vtkStaticCellLocator::SafeDownCast(locator);
+  if (protoStaticCell && staticCellLocator)
+  {
+    staticCellLocator->SetDivisions(protoStaticCell->GetDivisions());
+    staticCellLocator->SetMaxNumberOfBuckets(protoStaticCell->GetMaxNumberOfBuckets());
+  }
+
+  auto protoJumpAndWalk = vtkJumpAndWalkCellLocator::SafeDownCast(prototype);
+  auto jumpAndWalkLocator = vtkJumpAndWalkCellLocator::SafeDownCast(locator);
+  if (protoJumpAndWalk && jumpAndWalkLocator)
+  {
+    jumpAndWalkLocator->SetNumberOfClosestPoints(protoJumpAndWalk->GetNumberOfClosestPoints());
+    // the point locator of the prototype is a prototype too
+    if (auto protoPointLocator = protoJumpAndWalk->GetPointLocator())
+    {
+      jumpAndWalkLocator->SetPointLocator(
+        vtk::TakeSmartPointer(protoPointLocator->NewInstance()));
+    }
+  }
+
+  auto protoPoint = vtkAbstractPointLocator::SafeDownCast(prototype);
+  auto pointLocator = vtkAbstractPointLocator::SafeDownCast(locator);
+  if (protoPoint && pointLocator)
+  {
+    pointLocator->SetTolerance(protoPoint->GetTolerance());
+  }
+
+  auto protoStaticPoint = vtkStaticPointLocator::SafeDownCast(prototype);
+  auto staticPointLocator = vtkStaticPointLocator::SafeDownCast(locator);
+  if (protoStaticPoint && staticPointLocator)
+  {
+    staticPointLocator->SetNumberOfPointsPerBucket(protoStaticPoint->GetNumberOfPointsPerBucket());
+    staticPointLocator->SetDivisions(protoStaticPoint->GetDivisions());
+    staticPointLocator->SetMaxNumberOfBuckets(protoStaticPoint->GetMaxNumberOfBuckets());
+  }
+}
+
+//------------------------------------------------------------------------------
+// Return a copy of the dataset structure: points and cells are shared,
+// attributes, field data and locators are not.
+vtkSmartPointer<vtkDataSet> CopyStructure(vtkDataSet* dataset, vtkLocator* locator)
+{
+  auto structure = vtk::TakeSmartPointer(dataset->NewInstance());
+  structure->CopyStructure(dataset);
+
+  // vtkJumpAndWalkCellLocator walks through cell neighbors, build the links
+  // now rather than lazily from concurrent queries.
+  if (vtkJumpAndWalkCellLocator::SafeDownCast(locator))
+  {
+    if (auto polyData = vtkPolyData::SafeDownCast(structure))
+    {
+      polyData->BuildLinks();
+    }
+    else if (auto unstructuredGrid = vtkUnstructuredGrid::SafeDownCast(structure))
+    {
+      unstructuredGrid->BuildLinks();
+    }
+  }
+
+  return structure;
+}
+}
+
+struct vtkDataSetLocatorCache::vtkInternals
+{
+  struct Entry
+  {
+    vtkSmartPointer<vtkLocator> Locator;
+    vtkMTimeType MeshMTime = 0;
+    vtkIdType MemorySize = 0;
+    vtkIdType LastAccess = 0;
+  };
+
+  using Key = std::pair<vtkDataSet*, std::string>;
+  std::map<Key, Entry> Entries;
+  // DeleteEvent observer tag of each dataset with entries
+  std::map<vtkDataSet*, unsigned long> DeleteObservers;
+  vtkIdType AccessCounter = 0;
+};
+
+//------------------------------------------------------------------------------
+vtkDataSetLocatorCache::vtkDataSetLocatorCache()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkDataSetLocatorCache::~vtkDataSetLocatorCache()
+{
+  for (const auto& observer : this->Internals->DeleteObservers)
+  {
+    observer.first->RemoveObserver(observer.second);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractCellLocator> vtkDataSetLocatorCache::GetCellLocator(
+  vtkDataSet* dataset, vtkAbstractCellLocator* prototype)
+{
+  vtkNew<vtkStaticCellLocator> defaultLocator;
+  return vtkAbstractCellLocator::SafeDownCast(this->GetLocator(dataset, prototype, defaultLocator));
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractPointLocator> vtkDataSetLocatorCache::GetPointLocator(
+  vtkDataSet* dataset, vtkAbstractPointLocator* prototype)
+{
+  vtkNew<vtkStaticPointLocator> defaultLocator;
+  return vtkAbstractPointLocator::SafeDownCast(
+    this->GetLocator(dataset, prototype, defaultLocator));
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkLocator> vtkDataSetLocatorCache::GetLocator(
+  vtkDataSet* dataset, vtkLocator* prototype, vtkLocator* defaultLocator)
+{
+  if (!dataset)
+  {
+    return nullptr;
+  }
+
+  vtkLocator* model = prototype ? prototype : defaultLocator;
+  auto& entry = this->Internals->Entries[{ dataset, ::GetLocatorKey(model) }];
+  entry.LastAccess = ++this->Internals->AccessCounter;
+
+  const vtkMTimeType meshMTime = dataset->GetMeshMTime();
+  if (entry.Locator && entry.MeshMTime == meshMTime)
+  {
+    this->NumberOfHits++;
+    vtkDebugMacro("Reuse " << model->GetClassName() << " for " << dataset);
+    return entry.Locator;
+  }
+
+  if (!entry.Locator)
+  {
+    entry.Locator = vtk::TakeSmartPointer(model->NewInstance());
+    if (prototype)
+    {
+      ::CopyLocatorParameters(prototype, entry.Locator);
+    }
+  }
+
+  // The locator is built over a copy of the dataset structure so that the cache
+  // does not keep the dataset alive. Entries are removed on its DeleteEvent.
+  entry.Locator->SetDataSet(::CopyStructure(dataset, entry.Locator));
+  entry.Locator->BuildLocator();
+  entry.MeshMTime = meshMTime;
+  entry.MemorySize = ::EstimateLocatorSize(entry.Locator);
+  this->NumberOfBuilds++;
+  vtkDebugMacro("Build " << model->GetClassName() << " for " << dataset);
+
+  auto& observers = this->Internals->DeleteObservers;
+  if (observers.find(dataset) == observers.end())
+  {
+    observers[dataset] = dataset->AddObserver(
+      vtkCommand::DeleteEvent, this, &vtkDataSetLocatorCache::OnDataSetDeleted);
+  }
+
+  // Keep a reference so the requested locator survives eviction.
+  vtkSmartPointer<vtkLocator> locator = entry.Locator;
+  this->Evict();
+  this->Modified();
+
+  return locator;
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::OnDataSetDeleted(vtkObject* caller, unsigned long, void*)
+{
+  vtkDataSet* dataset = static_cast<vtkDataSet*>(caller);
+  this->Internals->DeleteObservers.erase(dataset);
+  auto& entries = this->Internals->Entries;
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    it = it->first.first == dataset ? entries.erase(it) : std::next(it);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::Evict()
+{
+  if (this->MemoryLimit <= 0)
+  {
+    return;
+  }
+
+  auto& entries = this->Internals->Entries;
+  while (entries.size() > 1 && this->GetMemorySize() > this->MemoryLimit)
+  {
+    auto lru = std::min_element(entries.begin(), entries.end(),
+      [](const auto& lhs, const auto& rhs)
+      { return lhs.second.LastAccess < rhs.second.LastAccess; });
+    entries.erase(lru);
+    this->NumberOfEvictions++;
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkDataSetLocatorCache::GetMemorySize() const
+{
+  vtkIdType size = 0;
+  for (const auto& item : this->Internals->Entries)
+  {
+    size += item.second.MemorySize;
+  }
+  return size;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkDataSetLocatorCache::GetNumberOfEntries() const
+{
+  return static_cast<vtkIdType>(this->Internals->Entries.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfBuilds = 0;
+  this->NumberOfEvictions = 0;
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::ReleaseDataSet(vtkDataSet* dataset)
+{
+  auto& entries = this->Internals->Entries;
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    it = it->first.first == dataset ? entries.erase(it) : std::next(it);
+  }
+
+  auto& observers = this->Internals->DeleteObservers;
+  auto observer = observers.find(dataset);
+  if (observer != observers.end())
+  {
+    dataset->RemoveObserver(observer->second);
+    observers.erase(observer);
+  }
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::Clear()
+{
+  this->Internals->Entries.clear();
+  for (const auto& observer : this->Internals->DeleteObservers)
+  {
+    observer.first->RemoveObserver(observer.second);
+  }
+  this->Internals->DeleteObservers.clear();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkDataSetLocatorCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MemoryLimit: " << this->MemoryLimit << "\n";
+  os << indent << "MemorySize: " << this->GetMemorySize() << "\n";
+  os << indent << "NumberOfEntries: " << this->GetNumberOfEntries() << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfBuilds: " << this->NumberOfBuilds << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
+}
+VTK_ABI_NAMESPACE_END
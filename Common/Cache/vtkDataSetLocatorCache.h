@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef vtkDataSetLocatorCache_h
+#define vtkDataSetLocatorCache_h
+
+#include "vtkCommonCacheModule.h" // Export macro
+
+#include "vtkObject.h"
+#include "vtkSmartPointer.h" // for smart pointer
+
+#include <memory> // for unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+
+class vtkAbstractCellLocator;
+class vtkAbstractPointLocator;
+class vtkDataSet;
+class vtkLocator;
+
+/**
+ * vtkDataSetLocatorCache is a shareable store of built spatial locators.
+ *
+ * Several filters in a pipeline usually search the same source dataset:
+ * vtkProbeFilter, vtkPointInterpolator, vtkStreamTracer... Each of them
+ * builds its own locator over that dataset. When those filters are given the
+ * same vtkDataSetLocatorCache, the first one builds the locator and the
+ * following ones reuse it.
+ *
+ * ## Details
+ * Entries are keyed on the dataset instance, the locator class name and its
+ * search parameters, so that differently configured locators of the same class
+ * have their own entry. An entry is valid as long as the dataset MeshMTime did
+ * not change since the locator was built; a stale entry is rebuilt on next
+ * request. Both vtkAbstractCellLocator and vtkAbstractPointLocator subclasses
+ * are supported. The requested locator type is given as a prototype instance,
+ * whose configuration is copied to the built locator through NewInstance()
+ * and the search parameters of the locator class. When no prototype is given,
+ * vtkStaticCellLocator or vtkStaticPointLocator are used.
+ *
+ * ## Memory
+ * The memory used by each locator is estimated after build. When the total
+ * exceeds MemoryLimit, least recently used entries are evicted.
+ * Locators are built over a copy of the dataset structure, sharing its points
+ * and cells, rather than over the dataset itself: point and cell ids are the
+ * same, but the locator DataSet is not the requested dataset. This way the
+ * cache does not extend the lifetime of datasets, and the entries of a dataset
+ * are removed when it is deleted.
+ *
+ * ## Statistics
+ * The numbers of hits, builds and evictions are recorded and can be used to
+ * tune the memory limit.
+ *
+ * @sa vtkDataObjectMeshCache vtkStaticCellLocator vtkStaticPointLocator
+ */
+class VTKCOMMONCACHE_EXPORT vtkDataSetLocatorCache : public vtkObject
+{
+public:
+  static vtkDataSetLocatorCache* New();
+  vtkTypeMacro(vtkDataSetLocatorCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Return a built cell locator over dataset, of the same type as prototype.
+   * If prototype is nullptr, a vtkStaticCellLocator is used.
+   * The locator is built only if no entry exists that is up-to-date with
+   * both the dataset and the prototype parameters.
+   * Return nullptr if dataset is nullptr.
+   */
+  vtkSmartPointer<vtkAbstractCellLocator> GetCellLocator(
+    vtkDataSet* dataset, vtkAbstractCellLocator* prototype = nullptr);
+
+  /**
+   * Return a built point locator over dataset, of the same type as prototype.
+   * If prototype is nullptr, a vtkStaticPointLocator is used.
+   * The locator is built only if no entry exists that is up-to-date with
+   * both the dataset and the prototype parameters.
+   * Return nullptr if dataset is nullptr.
+   */
+  vtkSmartPointer<vtkAbstractPointLocator> GetPointLocator(
+    vtkDataSet* dataset, vtkAbstractPointLocator* prototype = nullptr);
+
+  ///@{
+  /**
+   * Set/Get the maximum amount of memory used by cached locators, in kibibytes.
+   * Least recently used entries are evicted when the limit is exceeded.
+   * The most recently requested locator is always kept, even if it is larger
+   * than the limit. A value of 0 means no limit. Default is 0.
+   */
+  vtkSetMacro(MemoryLimit, vtkIdType);
+  vtkGetMacro(MemoryLimit, vtkIdType);
+  ///@}
+
+  /**
+   * Return the estimated memory used by cached locators, in kibibytes.
+   */
+  vtkIdType GetMemorySize() const;
+
+  /**
+   * Return the number of cached locators.
+   */
+  vtkIdType GetNumberOfEntries() const;
+
+  ///@{
+  /**
+   * Statistics: number of requests served by an up-to-date entry,
+   * number of locators built, and number of entries evicted to satisfy
+   * the memory limit.
+   */
+  vtkGetMacro(NumberOfHits, vtkIdType);
+  vtkGetMacro(NumberOfBuilds, vtkIdType);
+  vtkGetMacro(NumberOfEvictions, vtkIdType);
+  ///@}
+
+  /**
+   * Reset hits, builds and evictions counters.
+   */
+  void ResetStatistics();
+
+  /**
+   * Remove every entry associated to the given dataset.
+   */
+  void ReleaseDataSet(vtkDataSet* dataset);
+
+  /**
+   * Remove all entries.
+   */
+  void Clear();
+
+protected:
+  vtkDataSetLocatorCache();
+  ~vtkDataSetLocatorCache() override;
+
+private:
+  vtkDataSetLocatorCache(const vtkDataSetLocatorCache&) = delete;
+  void operator=(const vtkDataSetLocatorCache&) = delete;
+
+  /**
+   * Common implementation of GetCellLocator and GetPointLocator.
+   * defaultLocator is used when prototype is nullptr.
+   */
+  vtkSmartPointer<vtkLocator> GetLocator(
+    vtkDataSet* dataset, vtkLocator* prototype, vtkLocator* defaultLocator);
+
+  /**
+   * Remove the entries of a dataset being deleted.
+   */
+  void OnDataSetDeleted(vtkObject* caller, unsigned long event, void* callData);
+
+  /**
+   * Evict least recently used entries until MemoryLimit is satisfied.
+   */
+  void Evict();
+
+  vtkIdType MemoryLimit = 0;
+  vtkIdType NumberOfHits = 0;
+  vtkIdType NumberOfBuilds = 0;
+  vtkIdType NumberOfEvictions = 0;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the multithreaded vtkKdTree build gives the same regions as the
+// serial one, including with many repeated cell center coordinates.
+
+#include "vtkCellArray.h"
+#include "vtkKdTree.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+using RegionBounds = std::vector<std::array<double, 12>>;
+
+//------------------------------------------------------------------------------
+RegionBounds BuildRegions(vtkPolyData* data, int numberOfRegions)
+{
+  vtkNew<vtkKdTree> tree;
+  tree->SetDataSet(data);
+  tree->SetNumberOfRegionsOrMore(numberOfRegions);
+  tree->SetMinCells(1);
+  tree->BuildLocator();
+
+  RegionBounds regions(tree->GetNumberOfRegions());
+  for (int i = 0; i < tree->GetNumberOfRegions(); ++i)
+  {
+    tree->GetRegionBounds(i, regions[i].data());
+    tree->GetRegionDataBounds(i, regions[i].data() + 6);
+  }
+  return regions;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestKdTreeParallelBuild(int, char*[])
+{
+  // Vertices on a coarse lattice, so that cell centers share coordinates.
+  constexpr int numberOfCells = 300000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < numberOfCells; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = std::floor(random->GetNextRangeValue(0, 200)) / 10.0;
+    }
+    points->InsertNextPoint(x);
+    verts->InsertNextCell(1, &i);
+  }
+  vtkNew<vtkPolyData> data;
+  data->SetPoints(points);
+  data->SetVerts(verts);
+
+  const std::string backend = vtkSMPTools::GetBackend();
+
+  vtkSMPTools::SetBackend("Sequential");
+  RegionBounds serial = ::BuildRegions(data, 64);
+
+  vtkSMPTools::SetBackend(backend.c_str());
+  vtkSMPTools::Initialize(4);
+  RegionBounds parallel = ::BuildRegions(data, 64);
+
+  if (serial.size() != 64 || serial != parallel)
+  {
+    vtkLog(ERROR,
+      "Parallel build with " << backend << " differs from serial build: " << parallel.size()
+                             << " regions instead of " << serial.size());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -12,26 +12,34 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <array>
+#include <deque>
 #include <list>
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -172,6 +180,205 @@ private:
 };
 }
 
+// helpers for the shared memory parallel build of the k-d tree
+namespace
+{
+// Below these numbers of points, the serial algorithms are used.
+constexpr int PARALLEL_SELECT_THRESHOLD = 1 << 16;
+constexpr int PARALLEL_SUBTREE_THRESHOLD = 1 << 12;
+
+//------------------------------------------------------------------------------
+// Compute the parametric center of each cell of a data set.
+struct ComputeCellCentersWorker
+{
+  vtkDataSet* DataSet;
+  float* Centers;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  ComputeCellCentersWorker(vtkDataSet* set, float* centers, int maxCellSize)
+    : DataSet(set)
+    , Centers(centers)
+    , MaxCellSize(maxCellSize)
+  {
+  }
+
+  void Initialize() { this->Weights.Local().resize(std::max(this->MaxCellSize, 1)); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->Weights.Local().data();
+    double pcoords[3], center[3];
+    float* cptr = this->Centers + 3 * begin;
+
+    for (vtkIdType cellId = begin; cellId < end; ++cellId, cptr += 3)
+    {
+      this->DataSet->GetCell(cellId, cell);
+      int subId = cell->GetParametricCenter(pcoords);
+      cell->EvaluateLocation(subId, pcoords, center, weights);
+      cptr[0] = static_cast<float>(center[0]);
+      cptr[1] = static_cast<float>(center[1]);
+      cptr[2] = static_cast<float>(center[2]);
+    }
+  }
+
+  void Reduce() {}
+
+  static void Execute(vtkDataSet* set, float* centers, int maxCellSize)
+  {
+    vtkIdType nCells = set->GetNumberOfCells();
+    if (nCells == 0)
+    {
+      return;
+    }
+
+    // GetCell() is thread safe once it has been called from a single thread.
+    vtkNew<vtkGenericCell> cell;
+    set->GetCell(0, cell);
+
+    ComputeCellCentersWorker worker(set, centers, maxCellSize);
+    vtkSMPTools::For(0, nCells, worker);
+  }
+};
+
+//------------------------------------------------------------------------------
+// Stable three-way partition of the points [L, R) of X around the value T of
+// their dim component: lower values first, then values equal to T, then
+// greater values. Return the number of lower and equal values.
+void ParallelPartition(
+  int dim, float* X, int L, int R, float T, std::vector<float>& buffer, int& nLower, int& nEqual)
+{
+  const vtkIdType n = R - L;
+  const vtkIdType chunkSize =
+    std::max<vtkIdType>(n / (8 * vtkSMPTools::GetEstimatedNumberOfThreads()), 1024);
+  const vtkIdType nChunks = (n + chunkSize - 1) / chunkSize;
+
+  // count the lower, equal and greater values of each chunk
+  std::vector<std::array<vtkIdType, 3>> offsets(nChunks + 1, { 0, 0, 0 });
+  vtkSMPTools::For(0, nChunks,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType chunk = first; chunk < last; ++chunk)
+      {
+        const float* component = X + 3 * (L + chunk * chunkSize) + dim;
+        const vtkIdType size = std::min(chunkSize, n - chunk * chunkSize);
+        auto& counts = offsets[chunk + 1];
+        for (vtkIdType i = 0; i < size; ++i)
+        {
+          const float value = component[3 * i];
+          counts[value < T ? 0 : (value == T ? 1 : 2)]++;
+        }
+      }
+    });
+
+  // turn counts into the destination of each chunk part
+  for (vtkIdType chunk = 1; chunk <= nChunks; ++chunk)
+  {
+    for (int part = 0; part < 3; ++part)
+    {
+      offsets[chunk][part] += offsets[chunk - 1][part];
+    }
+  }
+  const vtkIdType totalLower = offsets[nChunks][0];
+  const vtkIdType totalEqual = offsets[nChunks][1];
+
+  buffer.resize(3 * n);
+  vtkSMPTools::For(0, nChunks,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType chunk = first; chunk < last; ++chunk)
+      {
+        vtkIdType dest[3] = { offsets[chunk][0], totalLower + offsets[chunk][1],
+          totalLower + totalEqual + offsets[chunk][2] };
+        const float* point = X + 3 * (L + chunk * chunkSize);
+        const vtkIdType size = std::min(chunkSize, n - chunk * chunkSize);
+        for (vtkIdType i = 0; i < size; ++i, point += 3)
+        {
+          const float value = point[dim];
+          const int part = value < T ? 0 : (value == T ? 1 : 2);
+          std::copy(point, point + 3, buffer.data() + 3 * dest[part]++);
+        }
+      }
+    });
+
+  vtkSMPTools::For(0, n,
+    [&](vtkIdType first, vtkIdType last)
+    { std::copy(buffer.data() + 3 * first, buffer.data() + 3 * last, X + 3 * (L + first)); });
+
+  nLower = static_cast<int>(totalLower);
+  nEqual = static_cast<int>(totalEqual);
+}
+
+//------------------------------------------------------------------------------
+// Narrow the interval [L, R) of X containing the K-th smallest dim component
+// with parallel partitions. Points on the left of the final interval are
+// strictly lower than the ones inside, and points on the right strictly
+// greater, so selecting K in the final interval gives the same result as
+// selecting it in the whole array. Return true if the K-th value was found,
+// i.e. X[K] is inside a sequence of values equal to it, preceded by lower
+// values and followed by greater values.
+bool ParallelNarrowSelect(int dim, float* X, int K, int& L, int& R)
+{
+  constexpr int sampleSize = 1023;
+  std::vector<float> sample(sampleSize);
+  std::vector<float> buffer;
+
+  while (R - L > PARALLEL_SELECT_THRESHOLD)
+  {
+    // pivot on a sample, at the relative rank of K in the interval
+    const double stride = static_cast<double>(R - L) / sampleSize;
+    for (int i = 0; i < sampleSize; ++i)
+    {
+      sample[i] = X[3 * (L + static_cast<int>(i * stride)) + dim];
+    }
+    const int rank = static_cast<int>(static_cast<double>(K - L) / (R - L) * (sampleSize - 1));
+    std::nth_element(sample.begin(), sample.begin() + rank, sample.end());
+    const float T = sample[rank];
+
+    int nLower, nEqual;
+    ::ParallelPartition(dim, X, L, R, T, buffer, nLower, nEqual);
+
+    if (K < L + nLower)
+    {
+      R = L + nLower;
+    }
+    else if (K < L + nLower + nEqual)
+    {
+      return true;
+    }
+    else
+    {
+      L += nLower + nEqual;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+float ParallelFindMaxLeftHalf(int dim, float* c1, int K)
+{
+  vtkSMPThreadLocal<float> localMax(c1[dim]);
+  vtkSMPTools::For(0, K,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      float& max = localMax.Local();
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        max = std::max(c1[3 * i + dim], max);
+      }
+    });
+
+  float max = c1[dim];
+  for (float value : localMax)
+  {
+    max = std::max(value, max);
+  }
+  return max;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkKdTree);
 
@@ -637,52 +844,24 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
-
-  float* cptr = center;
-  double dcenter[3];
-
   if (set)
   {
-    for (int j = 0; j < totalCells; j++)
-    {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
-    }
+    ::ComputeCellCentersWorker::Execute(set, center, maxCellSize);
   }
   else
   {
+    float* cptr = center;
     vtkCollectionSimpleIterator cookie;
     this->DataSets->InitTraversal(cookie);
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
-      int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
-      {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
-      }
+      ::ComputeCellCentersWorker::Execute(iset, cptr, maxCellSize);
+      cptr += 3 * iset->GetNumberOfCells();
+      this->UpdateSubOperationProgress(static_cast<double>(cptr - center) / (3.0 * totalCells));
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -1240,12 +1419,91 @@ int vtkKdTree::DivideTest(int size, int level)
 
 //------------------------------------------------------------------------------
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (kd->GetNumberOfPoints() > ::PARALLEL_SUBTREE_THRESHOLD &&
+    vtkSMPTools::GetEstimatedNumberOfThreads() > 1 && !vtkSMPTools::IsParallelScope())
+  {
+    this->DivideRegionInParallel(kd, c1, ids, level);
+    return 0;
+  }
+
+  if (!this->SplitRegion(kd, c1, ids, level))
+  {
+    return 0;
+  }
+
+  int nleft = kd->GetLeft()->GetNumberOfPoints();
+
+  int* leftIds = ids;
+  int* rightIds = ids ? ids + nleft : nullptr;
+
+  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+
+  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Split the top of the tree breadth first, until there are enough independent
+// subtrees to keep all threads busy, then divide these subtrees concurrently.
+// Each subtree works on its own range of the point array.
+void vtkKdTree::DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  struct Subtree
+  {
+    vtkKdNode* Node;
+    float* Points;
+    int* Ids;
+    int Level;
+  };
+
+  const std::size_t numberOfTasks = 8 * vtkSMPTools::GetEstimatedNumberOfThreads();
+  std::deque<Subtree> toSplit{ { kd, c1, ids, level } };
+  std::vector<Subtree> subtrees;
+
+  while (!toSplit.empty())
+  {
+    Subtree subtree = toSplit.front();
+    toSplit.pop_front();
+
+    if (subtree.Node->GetNumberOfPoints() <= ::PARALLEL_SUBTREE_THRESHOLD ||
+      toSplit.size() + subtrees.size() >= numberOfTasks)
+    {
+      subtrees.push_back(subtree);
+      continue;
+    }
+
+    if (!this->SplitRegion(subtree.Node, subtree.Points, subtree.Ids, subtree.Level))
+    {
+      continue;
+    }
+
+    int nleft = subtree.Node->GetLeft()->GetNumberOfPoints();
+    toSplit.push_back({ subtree.Node->GetLeft(), subtree.Points, subtree.Ids, subtree.Level + 1 });
+    toSplit.push_back({ subtree.Node->GetRight(), subtree.Points + 3 * nleft,
+      subtree.Ids ? subtree.Ids + nleft : nullptr, subtree.Level + 1 });
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        const Subtree& subtree = subtrees[i];
+        this->DivideRegion(subtree.Node, subtree.Points, subtree.Ids, subtree.Level);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+bool vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
   if (!ok)
   {
-    return 0;
+    return false;
   }
 
   int maxdim = this->SelectCutDirection(kd);
@@ -1294,21 +1552,8 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
   this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
 
-  if (kd->GetLeft() == nullptr)
-  {
-    return 0; // unable to divide region further
-  }
-
-  int nleft = kd->GetLeft()->GetNumberOfPoints();
-
-  int* leftIds = ids;
-  int* rightIds = ids ? ids + nleft : nullptr;
-
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
-
-  return 0;
+  // false if unable to divide region further
+  return kd->GetLeft() != nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1415,7 +1660,17 @@ int vtkKdTree::Select(int dim, float* c1, int* ids, int nvals, double& coord)
   int mid = nvals / 2;
   int right = nvals - 1;
 
-  vtkKdTree::Select_(dim, c1, ids, left, right, mid);
+  // The parallel selection reorders the points differently, so it is only
+  // used when there are no point ids to keep in sync with the points.
+  const bool parallel =
+    !ids && nvals > ::PARALLEL_SELECT_THRESHOLD && !vtkSMPTools::IsParallelScope();
+
+  int L = left;
+  int R = right + 1;
+  if (!parallel || !::ParallelNarrowSelect(dim, c1, mid, L, R))
+  {
+    vtkKdTree::Select_(dim, c1, ids, L, R - 1, mid);
+  }
 
   // We need to be careful in the case where the "mid"
   // value is repeated several times in the array.  We
@@ -1453,7 +1708,8 @@ int vtkKdTree::Select(int dim, float* c1, int* ids, int nvals, double& coord)
     return mid; // failed to divide region
   }
 
-  float leftMax = vtkKdTree::FindMaxLeftHalf(dim, c1, mid);
+  float leftMax = parallel ? ::ParallelFindMaxLeftHalf(dim, c1, mid)
+                          : vtkKdTree::FindMaxLeftHalf(dim, c1, mid);
 
   coord = (static_cast<double>(c1[midValIndex]) + static_cast<double>(leftMax)) / 2.0;
 
@@ -768,6 +768,14 @@ protected:
 
   int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
 
+  // Divide the top levels of the tree, then the resulting subtrees
+  // concurrently. The regions are the same as the serial division.
+  void DivideRegionInParallel(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  // Split a single region in two child nodes.
+  // Return false if the region should not or could not be divided.
+  bool SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
   void SelfRegister(vtkKdNode* kd);
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkProbeFilter, vtkResampleWithDataSet and vtkStreamTracer share
+// the locator built over their source through a vtkDataSetLocatorCache, that
+// it is rebuilt when the source mesh changes, and that another locator is
+// built when the parameters of the locator prototype change.
+
+#include "vtkDataArray.h"
+#include "vtkDataSetLocatorCache.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkResampleWithDataSet.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStreamTracer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CheckStatistics(vtkDataSetLocatorCache* cache, vtkIdType builds, vtkIdType hits,
+  const char* step)
+{
+  if (cache->GetNumberOfBuilds() != builds || cache->GetNumberOfHits() != hits)
+  {
+    std::cerr << step << ": got " << cache->GetNumberOfBuilds() << " builds and "
+              << cache->GetNumberOfHits() << " hits instead of " << builds << " and " << hits
+              << "\n";
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); i++)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestProbeFilterLocatorCache(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-5, 5, -5, 5, -5, 5);
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputConnection(wavelet->GetOutputPort());
+  tetrahedralize->Update();
+  vtkNew<vtkUnstructuredGrid> source;
+  source->DeepCopy(tetrahedralize->GetOutput());
+
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(source->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < source->GetNumberOfPoints(); i++)
+  {
+    velocity->SetTuple3(i, 1.0, 0.1, 0.0);
+  }
+  source->GetPointData()->SetVectors(velocity);
+
+  // Image inputs are probed cell by cell of the source, without locator.
+  vtkNew<vtkPolyData> input;
+  vtkNew<vtkPoints> inputPoints;
+  for (int k = 0; k < 7; k++)
+  {
+    for (int j = 0; j < 7; j++)
+    {
+      for (int i = 0; i < 7; i++)
+      {
+        inputPoints->InsertNextPoint(-4.5 + 1.5 * i, -4.5 + 1.5 * j, -4.5 + 1.5 * k);
+      }
+    }
+  }
+  input->SetPoints(inputPoints);
+
+  vtkNew<vtkDataSetLocatorCache> cache;
+  vtkNew<vtkStaticCellLocator> prototype;
+
+  // The first filter builds the locator.
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(input);
+  probe->SetSourceData(source);
+  probe->SetCellLocator(prototype);
+  probe->SetLocatorCache(cache);
+  probe->Update();
+  if (!::CheckStatistics(cache, 1, 0, "First probe"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The result is the one of a probe filter that builds its own locator.
+  vtkNew<vtkProbeFilter> reference;
+  reference->SetInputData(input);
+  reference->SetSourceData(source);
+  reference->SetCellLocator(prototype);
+  reference->Update();
+  if (!::SameArrays(probe->GetOutput()->GetPointData()->GetArray("RTData"),
+        reference->GetOutput()->GetPointData()->GetArray("RTData")))
+  {
+    std::cerr << "Probing with the cached locator gives different values.\n";
+    return EXIT_FAILURE;
+  }
+
+  // The following filters reuse it.
+  vtkNew<vtkResampleWithDataSet> resample;
+  resample->SetInputData(input);
+  resample->SetSourceData(source);
+  resample->SetCellLocator(prototype);
+  resample->SetLocatorCache(cache);
+  resample->Update();
+  if (!::CheckStatistics(cache, 1, 1, "Resample"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyData> seeds;
+  vtkNew<vtkPoints> seedPoints;
+  seedPoints->InsertNextPoint(-4.0, 0.2, 0.3);
+  seeds->SetPoints(seedPoints);
+  vtkNew<vtkStreamTracer> tracer;
+  tracer->SetInputData(source);
+  tracer->SetSourceData(seeds);
+  tracer->SetIntegrationDirectionToForward();
+  tracer->SetMaximumPropagation(20.0);
+  tracer->SetCellLocator(prototype);
+  tracer->SetLocatorCache(cache);
+  tracer->Update();
+  if (!::CheckStatistics(cache, 1, 2, "Stream tracer"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (tracer->GetOutput()->GetNumberOfPoints() < 2)
+  {
+    std::cerr << "Stream tracer with the cached locator gives no streamline.\n";
+    return EXIT_FAILURE;
+  }
+
+  // Moving a point of the source rebuilds the locator.
+  double point[3];
+  source->GetPoint(0, point);
+  point[0] -= 0.25;
+  source->GetPoints()->SetPoint(0, point);
+  source->GetPoints()->Modified();
+  probe->Update();
+  resample->Update();
+  if (!::CheckStatistics(cache, 2, 3, "Modified source"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Changing the parameters of the prototype builds a locator for the new
+  // configuration, the previous one stays cached.
+  prototype->SetNumberOfCellsPerNode(prototype->GetNumberOfCellsPerNode() + 1);
+  probe->Modified();
+  probe->Update();
+  if (!::CheckStatistics(cache, 3, 3, "Modified prototype"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (cache->GetNumberOfEntries() != 2)
+  {
+    std::cerr << "Filters should share one cached locator per configuration.\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
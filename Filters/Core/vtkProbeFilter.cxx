@@ -8,6 +8,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkDataSetLocatorCache.h"
 #include "vtkFindCellStrategy.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
@@ -34,6 +35,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkProbeFilter);
 vtkCxxSetObjectMacro(vtkProbeFilter, CellLocator, vtkAbstractCellLocator);
+vtkCxxSetObjectMacro(vtkProbeFilter, LocatorCache, vtkDataSetLocatorCache);
 void vtkProbeFilter::SetFindCellStrategy(vtkFindCellStrategy* findCellStrategy)
 {
   if (findCellStrategy)
@@ -74,6 +76,7 @@ vtkProbeFilter::vtkProbeFilter()
   this->SetValidPointMaskArrayName("vtkValidPointMask");
 
   this->CellLocator = nullptr;
+  this->LocatorCache = nullptr;
 
   this->PointList = nullptr;
   this->CellList = nullptr;
@@ -98,6 +101,7 @@ vtkProbeFilter::~vtkProbeFilter()
 
   this->SetValidPointMaskArrayName(nullptr);
   this->SetCellLocator(nullptr);
+  this->SetLocatorCache(nullptr);
 
   delete this->PointList;
   delete this->CellList;
@@ -646,7 +650,20 @@ void vtkProbeFilter::ProbeEmptyPoints(
   if (auto ps = vtkPointSet::SafeDownCast(source))
   {
     auto existingCellLocator = ps->GetCellLocator();
-    if (this->CellLocator != nullptr)
+    if (this->LocatorCache != nullptr)
+    {
+      // share the locator with the other filters using this cache
+      if (this->CellLocator != nullptr)
+      {
+        cellLocator = this->LocatorCache->GetCellLocator(ps, this->CellLocator);
+      }
+      else
+      {
+        vtkNew<vtkJumpAndWalkCellLocator> prototype;
+        cellLocator = this->LocatorCache->GetCellLocator(ps, prototype);
+      }
+    }
+    else if (this->CellLocator != nullptr)
     {
       // if the existing locator is the same type as the one provided
       if (existingCellLocator && existingCellLocator->IsA(this->CellLocator->GetClassName()))
@@ -1221,5 +1238,6 @@ void vtkProbeFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent
      << "CellLocator: " << (this->CellLocator ? this->CellLocator->GetClassName() : "NULL") << "\n";
+  os << indent << "LocatorCache: " << this->LocatorCache << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -60,6 +60,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractCellLocator;
+class vtkDataSetLocatorCache;
 class vtkCharArray;
 class vtkGenericCell;
 class vtkIdTypeArray;
@@ -270,6 +271,21 @@ public:
   virtual vtkAbstractCellLocator* GetCellLocatorPrototype() { return this->GetCellLocator(); }
   ///@}
 
+  ///@{
+  /**
+   * Set / get a locator cache shared with other filters. When specified, the
+   * cell locator for a vtkPointSet source is requested from the cache instead
+   * of being attached to the source, so that filters probing the same source
+   * reuse a single built locator of the requested type. CellLocator, if set,
+   * is used as the locator prototype, vtkJumpAndWalkCellLocator otherwise.
+   * Default is nullptr.
+   */
+  VTK_MARSHALEXCLUDE(VTK_MARSHAL_EXCLUDE_REASON_NOT_SUPPORTED)
+  virtual void SetLocatorCache(vtkDataSetLocatorCache*);
+  VTK_MARSHALEXCLUDE(VTK_MARSHAL_EXCLUDE_REASON_NOT_SUPPORTED)
+  vtkGetObjectMacro(LocatorCache, vtkDataSetLocatorCache);
+  ///@}
+
 protected:
   vtkProbeFilter();
   ~vtkProbeFilter() override;
@@ -327,6 +343,7 @@ protected:
 
   // support the FindCell() operation for vtkPointSet
   vtkAbstractCellLocator* CellLocator;
+  vtkDataSetLocatorCache* LocatorCache;
 
   vtkDataSetAttributes::FieldList* CellList;
   vtkDataSetAttributes::FieldList* PointList;
@@ -127,6 +127,18 @@ vtkAbstractCellLocator* vtkResampleWithDataSet::GetCellLocator() const
   return this->Prober->GetCellLocator();
 }
 
+//------------------------------------------------------------------------------
+void vtkResampleWithDataSet::SetLocatorCache(vtkDataSetLocatorCache* cache)
+{
+  this->Prober->SetLocatorCache(cache);
+}
+
+//------------------------------------------------------------------------------
+vtkDataSetLocatorCache* vtkResampleWithDataSet::GetLocatorCache() const
+{
+  return this->Prober->GetLocatorCache();
+}
+
 //------------------------------------------------------------------------------
 void vtkResampleWithDataSet::SetTolerance(double arg)
 {
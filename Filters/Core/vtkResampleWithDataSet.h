@@ -28,6 +28,7 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractCellLocator;
 class vtkCompositeDataProbeFilter;
 class vtkDataSet;
+class vtkDataSetLocatorCache;
 
 class VTKFILTERSCORE_EXPORT VTK_MARSHALAUTO vtkResampleWithDataSet
   : public vtkPassInputTypeAlgorithm
@@ -209,6 +210,18 @@ public:
   virtual vtkAbstractCellLocator* GetCellLocatorPrototype() const { return this->GetCellLocator(); }
   ///@}
 
+  ///@{
+  /**
+   * Set/Get a locator cache shared with other filters.
+   * The value is forwarded to the underlying probe filter.
+   * @sa vtkProbeFilter::SetLocatorCache
+   */
+  VTK_MARSHALEXCLUDE(VTK_MARSHAL_EXCLUDE_REASON_NOT_SUPPORTED)
+  virtual void SetLocatorCache(vtkDataSetLocatorCache*);
+  VTK_MARSHALEXCLUDE(VTK_MARSHAL_EXCLUDE_REASON_NOT_SUPPORTED)
+  virtual vtkDataSetLocatorCache* GetLocatorCache() const;
+  ///@}
+
   vtkMTimeType GetMTime() override;
 
 protected:
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the frustum cell selection on structured and unstructured inputs,
+// where cells are either fully inside, fully outside or crossing the frustum.
+
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractSelection.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkIdType CountSelectedCells(vtkDataSet* input, double lo, double hi)
+{
+  // near lower left, far lower left, near upper left, far upper left,
+  // near lower right, far lower right, near upper right, far upper right
+  const double corners[32] = { lo, lo, hi, 1.0, lo, lo, lo, 1.0, lo, hi, hi, 1.0, lo, hi, lo, 1.0,
+    hi, lo, hi, 1.0, hi, lo, lo, 1.0, hi, hi, hi, 1.0, hi, hi, lo, 1.0 };
+  vtkNew<vtkDoubleArray> frustum;
+  for (double corner : corners)
+  {
+    frustum->InsertNextValue(corner);
+  }
+
+  vtkNew<vtkSelectionNode> node;
+  node->SetContentType(vtkSelectionNode::FRUSTUM);
+  node->SetFieldType(vtkSelectionNode::CELL);
+  node->SetSelectionList(frustum);
+  vtkNew<vtkSelection> selection;
+  selection->AddNode(node);
+
+  vtkNew<vtkExtractSelection> extract;
+  extract->SetInputData(0, input);
+  extract->SetInputData(1, selection);
+  extract->Update();
+  return vtkDataSet::SafeDownCast(extract->GetOutput())->GetNumberOfCells();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestFrustumSelectorPointCodes(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    points->SetPoint(ptId, image->GetPoint(ptId));
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(image->GetNumberOfCells());
+  vtkNew<vtkIdList> cellPointIds;
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); ++cellId)
+  {
+    image->GetCellPoints(cellId, cellPointIds);
+    grid->InsertNextCell(VTK_VOXEL, cellPointIds);
+  }
+
+  // cells overlapping [2.5, 7.5]^3: 6 cells per axis
+  for (vtkDataSet* input : { static_cast<vtkDataSet*>(image), static_cast<vtkDataSet*>(grid) })
+  {
+    const vtkIdType inside = ::CountSelectedCells(input, 2.5, 7.5);
+    if (inside != 216)
+    {
+      vtkLog(ERROR, "Expected 216 cells in " << input->GetClassName() << ", got " << inside);
+      return EXIT_FAILURE;
+    }
+    const vtkIdType outside = ::CountSelectedCells(input, 20.5, 30.5);
+    if (outside != 0)
+    {
+      vtkLog(ERROR, "Expected no cell in " << input->GetClassName() << ", got " << outside);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -3,16 +3,19 @@
 // Funded by CEA, DAM, DIF, F-91297 Arpajon, France
 #include "vtkFrustumSelector.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkNew.h"
 #include "vtkPlane.h"
 #include "vtkPlanes.h"
+#include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
@@ -21,6 +24,7 @@
 #include "vtkSignedCharArray.h"
 #include "vtkVector.h"
 
+#include <array>
 #include <bitset>
 #include <vector>
 
@@ -88,6 +92,105 @@ struct FrustumPlanesType : public std::array<vtkSmartPointer<vtkPlane>, MAX_PLAN
   }
 };
 
+//------------------------------------------------------------------------------
+// Position of a point relative to the frustum planes: bit i of Outside is set
+// if the point is strictly outside plane i, bit i of NotInside is set if the
+// point is outside or on plane i.
+struct PointPlaneCodes
+{
+  unsigned char Outside;
+  unsigned char NotInside;
+};
+
+//------------------------------------------------------------------------------
+// Normals and origins of the frustum planes, stored contiguously so that
+// classifying a point does not go through vtkPlane virtual calls.
+struct FrustumPlaneCoefficients
+{
+  std::array<double, 3 * MAX_PLANES> Normals;
+  std::array<double, 3 * MAX_PLANES> Origins;
+
+  FrustumPlaneCoefficients(vtkPlanes* frustum)
+  {
+    for (int i = 0; i < MAX_PLANES; ++i)
+    {
+      frustum->GetNormals()->GetTuple(i, this->Normals.data() + 3 * i);
+      frustum->GetPoints()->GetPoint(i, this->Origins.data() + 3 * i);
+    }
+  }
+
+  PointPlaneCodes Classify(double x, double y, double z) const
+  {
+    PointPlaneCodes codes{ 0, 0 };
+    for (int i = 0; i < MAX_PLANES; ++i)
+    {
+      const double* n = this->Normals.data() + 3 * i;
+      const double* o = this->Origins.data() + 3 * i;
+      // same expression as vtkPlane::Evaluate
+      const double dist = n[0] * (x - o[0]) + n[1] * (y - o[1]) + n[2] * (z - o[2]);
+      codes.Outside |= static_cast<unsigned char>(dist > 0.0) << i;
+      codes.NotInside |= static_cast<unsigned char>(dist >= 0.0) << i;
+    }
+    return codes;
+  }
+};
+
+//------------------------------------------------------------------------------
+struct ClassifyPointsWorker
+{
+  template <typename PointsArray>
+  void operator()(
+    PointsArray* points, const FrustumPlaneCoefficients& planes, std::vector<PointPlaneCodes>& codes)
+  {
+    vtkSMPTools::For(0, points->GetNumberOfTuples(),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        PointPlaneCodes* code = codes.data() + begin;
+        for (const auto x : vtk::DataArrayTupleRange<3>(points, begin, end))
+        {
+          *code++ = planes.Classify(x[0], x[1], x[2]);
+        }
+      });
+  }
+};
+
+//------------------------------------------------------------------------------
+// Classify all the points of the input against the frustum planes.
+void ClassifyPoints(
+  vtkPlanes* frustum, vtkDataSet* input, std::vector<PointPlaneCodes>& codes)
+{
+  const FrustumPlaneCoefficients planes(frustum);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  codes.resize(numPts);
+
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet && pointSet->GetPoints())
+  {
+    ClassifyPointsWorker worker;
+    vtkDataArray* pointsArray = pointSet->GetPoints()->GetData();
+    using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+    if (!Dispatcher::Execute(pointsArray, worker, planes, codes))
+    {
+      worker(pointsArray, planes, codes);
+    }
+    return;
+  }
+
+  // Hacky PrepareForMultithreadedAccess()
+  double xx[3];
+  input->GetPoint(0, xx);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      double x[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        input->GetPoint(ptId, x);
+        codes[ptId] = planes.Classify(x[0], x[1], x[2]);
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 class ComputeCellsInFrustumFunctor
 {
@@ -96,8 +199,10 @@ private:
   vtkDataSet* Input;
   vtkSignedCharArray* Array;
   std::array<int, MAX_PLANES * 2> NPVertexIds;
+  const PointPlaneCodes* PointCodes = nullptr;
 
   vtkSMPThreadLocalObject<vtkGenericCell> TLCell;
+  vtkSMPThreadLocalObject<vtkIdList> TLCellPointIds;
   vtkSMPThreadLocal<FrustumPlanesType> TLFrustumPlanes;
   vtkSMPThreadLocal<std::vector<double>> TLVertexBuffer;
 
@@ -116,6 +221,16 @@ public:
     this->NPVertexIds = ComputeNPVertexIds(this->Frustum);
   }
 
+  //--------------------------------------------------------------------------
+  // Use the per point plane codes to accept or reject cells without computing
+  // their bounds. Cells which straddle a plane still go through the exact test.
+  void SetPointCodes(const PointPlaneCodes* codes)
+  {
+    this->PointCodes = codes;
+    vtkNew<vtkIdList> ids;
+    this->Input->GetCellPoints(0, ids);
+  }
+
   //--------------------------------------------------------------------------
   void Initialize() { this->TLFrustumPlanes.Local().Initialize(this->Frustum); }
 
@@ -124,11 +239,37 @@ public:
   {
     double bounds[6];
     auto*& cell = this->TLCell.Local();
+    auto*& cellPointIds = this->TLCellPointIds.Local();
     auto& frustumPlanes = this->TLFrustumPlanes.Local();
     auto& vertexBuffer = this->TLVertexBuffer.Local();
 
     for (vtkIdType cellId = begin; cellId < end; ++cellId)
     {
+      if (this->PointCodes)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        this->Input->GetCellPoints(cellId, npts, pts, cellPointIds);
+        if (npts > 0)
+        {
+          // A cell lies within the convex hull of its points: it is outside
+          // if all its points are outside of the same plane, and inside if
+          // all its points are strictly inside all planes.
+          unsigned char outside = 0xff;
+          unsigned char notInside = 0;
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            outside &= this->PointCodes[pts[i]].Outside;
+            notInside |= this->PointCodes[pts[i]].NotInside;
+          }
+          if (outside || !notInside)
+          {
+            this->Array->SetValue(cellId, static_cast<signed char>(!outside));
+            continue;
+          }
+        }
+      }
+
       this->Input->GetCellBounds(cellId, bounds);
       int isect = this->ABoxFrustumIsect(cellId, bounds, cell, frustumPlanes, vertexBuffer, false);
       this->Array->SetValue(cellId, static_cast<signed char>(isect == 1));
@@ -956,6 +1097,17 @@ void vtkFrustumSelector::ComputeSelectedCells(vtkDataSet* input, vtkSignedCharAr
   }
 
   ComputeCellsInFrustumFunctor functor(this->Frustum, input, cellSelected);
+
+  // Classify each point once, so that most cells are decided from the codes
+  // of their points and only the cells crossing the frustum boundary are
+  // clipped.
+  std::vector<PointPlaneCodes> pointCodes;
+  if (input->GetNumberOfPoints() > 0)
+  {
+    ::ClassifyPoints(this->Frustum, input, pointCodes);
+    functor.SetPointCodes(pointCodes.data());
+  }
+
   vtkSMPTools::For(0, numCells, functor);
 }
 
@@ -7,6 +7,10 @@
  * on whether they are inside or intersect a frustum of interest.  This handles
  * the vtkSelectionNode::FRUSTUM selection type.
  *
+ * For cell selection on vtkDataSet inputs, the points are first classified
+ * against the frustum planes in parallel. Cells whose points are all inside,
+ * or all outside of a same plane, are decided from these codes; only the cells
+ * crossing the frustum boundary are clipped against the planes.
  */
 
 #ifndef vtkFrustumSelector_h
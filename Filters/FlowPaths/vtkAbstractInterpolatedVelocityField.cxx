@@ -8,6 +8,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetLocatorCache.h"
 #include "vtkFindCellStrategy.h"
 #include "vtkGenericCell.h"
 #include "vtkJumpAndWalkCellLocator.h"
@@ -21,6 +22,7 @@
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkAbstractInterpolatedVelocityField, CellLocator, vtkAbstractCellLocator);
+vtkCxxSetObjectMacro(vtkAbstractInterpolatedVelocityField, LocatorCache, vtkDataSetLocatorCache);
 void vtkAbstractInterpolatedVelocityField::SetFindCellStrategy(
   vtkFindCellStrategy* findCellStrategy)
 {
@@ -63,6 +65,7 @@ vtkAbstractInterpolatedVelocityField::vtkAbstractInterpolatedVelocityField()
 
   this->InitializationState = NOT_INITIALIZED;
   this->CellLocator = nullptr;
+  this->LocatorCache = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -87,6 +90,7 @@ vtkAbstractInterpolatedVelocityField::~vtkAbstractInterpolatedVelocityField()
   this->DataSetsInfo.clear();
 
   this->SetCellLocator(nullptr);
+  this->SetLocatorCache(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -157,8 +161,14 @@ void vtkAbstractInterpolatedVelocityField::Initialize(
           jumpAndWalkCellLocatorPrototype->GetNumberOfClosestPoints());
       }
       auto existingCellLocator = pointSet->GetCellLocator();
+      if (this->LocatorCache)
+      {
+        // share the built locator with the other filters using this cache
+        cellLocator->ShallowCopy(
+          this->LocatorCache->GetCellLocator(pointSet, cellLocatorPrototype));
+      }
       // if the existing locator is the same type as the one provided
-      if (existingCellLocator && existingCellLocator->IsA(cellLocator->GetClassName()))
+      else if (existingCellLocator && existingCellLocator->IsA(cellLocator->GetClassName()))
       {
         // use the existing one because it will be most probably already built
         existingCellLocator->BuildLocator();
@@ -492,6 +502,7 @@ void vtkAbstractInterpolatedVelocityField::CopyParameters(
 {
   this->Caching = from->Caching;
   this->SetCellLocator(from->GetCellLocator());
+  this->SetLocatorCache(from->GetLocatorCache());
   this->NormalizeVector = from->NormalizeVector;
   this->ForceSurfaceTangentVector = from->ForceSurfaceTangentVector;
   this->SurfaceDataset = from->SurfaceDataset;
@@ -586,5 +597,6 @@ void vtkAbstractInterpolatedVelocityField::PrintSelf(ostream& os, vtkIndent inde
   os << endl;
   os << indent << "Cell Locator: " << endl;
   this->CellLocator->PrintSelf(os, indent);
+  os << indent << "Locator Cache: " << this->LocatorCache << endl;
 }
 VTK_ABI_NAMESPACE_END
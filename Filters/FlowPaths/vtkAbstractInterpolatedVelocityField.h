@@ -77,6 +77,7 @@ class vtkCompositeDataSet;
 class vtkDataObject;
 class vtkDataSet;
 class vtkDataArray;
+class vtkDataSetLocatorCache;
 class vtkIdList;
 class vtkPointData;
 class vtkGenericCell;
@@ -267,6 +268,17 @@ public:
   vtkGetObjectMacro(CellLocator, vtkAbstractCellLocator);
   ///@}
 
+  ///@{
+  /**
+   * Set / get a locator cache shared with other filters. When specified, the
+   * cell locators of vtkPointSet datasets are requested from the cache, with
+   * CellLocator as prototype, instead of being attached to the datasets.
+   * Default is nullptr.
+   */
+  virtual void SetLocatorCache(vtkDataSetLocatorCache*);
+  vtkGetObjectMacro(LocatorCache, vtkDataSetLocatorCache);
+  ///@}
+
 protected:
   vtkAbstractInterpolatedVelocityField();
   ~vtkAbstractInterpolatedVelocityField() override;
@@ -318,6 +330,7 @@ protected:
    * cached information) associated with each dataset.
    */
   vtkAbstractCellLocator* CellLocator;
+  vtkDataSetLocatorCache* LocatorCache;
   std::vector<vtkDataSetInformation> DataSetsInfo;
   std::vector<vtkDataSetInformation>::iterator GetDataSetInfo(vtkDataSet* dataset);
   ///@}
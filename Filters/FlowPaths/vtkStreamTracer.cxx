@@ -13,6 +13,7 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkCompositeInterpolatedVelocityField.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDataSetLocatorCache.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
 #include "vtkGenericCell.h"
@@ -44,6 +45,7 @@ VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkStreamTracer);
 vtkCxxSetObjectMacro(vtkStreamTracer, Integrator, vtkInitialValueProblemSolver);
 vtkCxxSetObjectMacro(vtkStreamTracer, CellLocator, vtkAbstractCellLocator);
+vtkCxxSetObjectMacro(vtkStreamTracer, LocatorCache, vtkDataSetLocatorCache);
 void vtkStreamTracer::SetInterpolatorPrototype(
   vtkAbstractInterpolatedVelocityField* interpolatorPrototype)
 {
@@ -91,6 +93,7 @@ vtkStreamTracer::vtkStreamTracer()
   this->GenerateNormalsInIntegrate = true;
 
   this->CellLocator = nullptr;
+  this->LocatorCache = nullptr;
 
   this->SetNumberOfInputPorts(2);
 
@@ -115,6 +118,7 @@ vtkStreamTracer::~vtkStreamTracer()
 {
   this->SetIntegrator(nullptr);
   this->SetCellLocator(nullptr);
+  this->SetLocatorCache(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -602,6 +606,7 @@ int vtkStreamTracer::CheckInputs(vtkAbstractInterpolatedVelocityField*& func, in
   {
     func = vtkCompositeInterpolatedVelocityField::New();
     func->SetCellLocator(this->CellLocator);
+    func->SetLocatorCache(this->LocatorCache);
   }
 
   // Tweak special cases.
@@ -1847,6 +1852,7 @@ void vtkStreamTracer::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Integrator: " << this->Integrator << endl;
   os << indent << "Cell Locator: " << this->CellLocator << endl;
+  os << indent << "Locator Cache: " << this->LocatorCache << endl;
   os << indent << "Maximum error: " << this->MaximumError << endl;
   os << indent << "Maximum number of steps: " << this->MaximumNumberOfSteps << endl;
   os << indent << "Vorticity computation: " << (this->ComputeVorticity ? " On" : " Off") << endl;
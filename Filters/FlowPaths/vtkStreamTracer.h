@@ -92,6 +92,7 @@ class vtkAbstractInterpolatedVelocityField;
 class vtkCompositeDataSet;
 class vtkDataArray;
 class vtkDataSetAttributes;
+class vtkDataSetLocatorCache;
 class vtkDoubleArray;
 class vtkExecutive;
 class vtkGenericCell;
@@ -426,6 +427,17 @@ public:
   vtkGetObjectMacro(CellLocator, vtkAbstractCellLocator);
   ///@}
 
+  ///@{
+  /**
+   * Set / get a locator cache shared with other filters. When specified, the
+   * cell locators of vtkPointSet inputs are requested from the cache, with
+   * CellLocator as prototype, so that filters searching the same input reuse
+   * a single built locator. It has no effect on AMR inputs. Default is nullptr.
+   */
+  virtual void SetLocatorCache(vtkDataSetLocatorCache*);
+  vtkGetObjectMacro(LocatorCache, vtkDataSetLocatorCache);
+  ///@}
+
   ///@{
   /**
    * Force the filter to run stream tracer advection in serial. This affects
@@ -547,6 +559,7 @@ protected:
   bool SurfaceStreamlines;
 
   vtkAbstractCellLocator* CellLocator;
+  vtkDataSetLocatorCache* LocatorCache;
 
   // These are used to manage complex input types such as
   // multiblock / composite datasets. Basically the filter input is
@@ -25,6 +25,8 @@
 #include "vtkTestUtilities.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <cmath>
+
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
 #include "vtkMPIController.h"
 #else
@@ -63,6 +65,61 @@ bool TestDuplicatePoints(vtkMultiProcessController* controller)
   return waveletDS->GetNumberOfPoints() == redistributedDS->GetNumberOfPoints();
 }
 
+bool TestPipelinedExchange(vtkMultiProcessController* controller)
+{
+  int myrank = controller->GetLocalProcessId();
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-10, 10, -10, 10, -10 + 10 * myrank, 10 * myrank);
+  wavelet->Update();
+
+  for (int mode : { vtkRedistributeDataSetFilter::ASSIGN_TO_ONE_REGION,
+         vtkRedistributeDataSetFilter::ASSIGN_TO_ALL_INTERSECTING_REGIONS })
+  {
+    // A limit of one byte makes the ranks wait for each part to be received.
+    vtkNew<vtkRedistributeDataSetFilter> redistribute[2];
+    for (int i = 0; i < 2; ++i)
+    {
+      redistribute[i]->SetInputConnection(wavelet->GetOutputPort());
+      redistribute[i]->SetController(controller);
+      redistribute[i]->SetBoundaryMode(mode);
+      redistribute[i]->SetNumberOfPartitions(8);
+      redistribute[i]->SetUsePipelinedExchange(i == 1);
+      redistribute[i]->SetMaximumInFlightBytes(1);
+      redistribute[i]->Update();
+    }
+
+    vtkDataSet* expected = vtkDataSet::SafeDownCast(redistribute[0]->GetOutputDataObject(0));
+    vtkDataSet* actual = vtkDataSet::SafeDownCast(redistribute[1]->GetOutputDataObject(0));
+    if (expected->GetNumberOfCells() != actual->GetNumberOfCells() ||
+      expected->GetNumberOfPoints() != actual->GetNumberOfPoints())
+    {
+      vtkLog(ERROR,
+        "Pipelined exchange gives " << actual->GetNumberOfCells() << " cells and "
+                                    << actual->GetNumberOfPoints() << " points instead of "
+                                    << expected->GetNumberOfCells() << " and "
+                                    << expected->GetNumberOfPoints());
+      return false;
+    }
+    double sums[2] = { 0.0, 0.0 };
+    vtkDataSet* outputs[2] = { expected, actual };
+    for (int i = 0; i < 2; ++i)
+    {
+      vtkDataArray* values = outputs[i]->GetPointData()->GetArray("RTData");
+      for (vtkIdType id = 0; values && id < values->GetNumberOfTuples(); ++id)
+      {
+        sums[i] += values->GetComponent(id, 0);
+      }
+    }
+    if (std::abs(sums[0] - sums[1]) > 1e-6 * std::abs(sums[0]))
+    {
+      vtkLog(ERROR, "Pipelined exchange gives different point data");
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TestMultiBlockEmptyOnAllRanksButZero(vtkMultiProcessController* controller)
 {
   // See !8745
@@ -167,6 +224,11 @@ int TestRedistributeDataSetFilter(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  if (!TestPipelinedExchange(controller))
+  {
+    return EXIT_FAILURE;
+  }
+
   const int rank = controller->GetLocalProcessId();
   vtkLogger::SetThreadName("rank:" + vtk::to_string(rank));
 
@@ -22,11 +22,16 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <array>
+#include <climits>
 #include <iterator>
+#include <list>
 #include <map>
 #include <memory>
+#include <thread>
 #include <tuple>
+#include <utility>
 
 // clang-format off
 #include "vtk_diy2.h"
@@ -77,6 +82,86 @@ struct BlockT
   }
 };
 
+using VectorOfUG = std::vector<vtkSmartPointer<vtkUnstructuredGrid>>;
+using VectorOfVectorOfUG = std::vector<VectorOfUG>;
+
+// Tags of the messages sent by vtkDIYKdTreeUtilities::PipelinedExchange: a
+// header with the partition id and the size of a part, followed by the
+// serialized part in pieces that fit in a MPI message.
+constexpr int PIPELINED_HEADER_TAG = 1210;
+constexpr int PIPELINED_DATA_TAG = 1211;
+constexpr size_t PIPELINED_MAX_MESSAGE_SIZE = INT_MAX;
+
+//------------------------------------------------------------------------------
+std::shared_ptr<diy::Assigner> GetExchangeAssigner(
+  diy::mpi::communicator& comm, int nblocks, std::shared_ptr<diy::Assigner> block_assigner)
+{
+  if (!block_assigner && vtkMath::IsPowerOfTwo(nblocks))
+  {
+    block_assigner = std::make_shared<vtkDIYExplicitAssigner>(
+      vtkDIYKdTreeUtilities::CreateAssigner(comm, nblocks));
+  }
+  else if (!block_assigner)
+  {
+    block_assigner = std::make_shared<diy::ContiguousAssigner>(comm.size(), nblocks);
+  }
+  return block_assigner;
+}
+
+//------------------------------------------------------------------------------
+// Set each partition of the result to the parts received for it, appending
+// them when there are several.
+void MergeParts(const VectorOfVectorOfUG& parts, vtkPartitionedDataSet* result)
+{
+  assert(static_cast<unsigned int>(parts.size()) == result->GetNumberOfPartitions());
+  for (unsigned int cc = 0; cc < result->GetNumberOfPartitions(); ++cc)
+  {
+    if (parts[cc].size() == 1)
+    {
+      result->SetPartition(cc, parts[cc][0]);
+    }
+    else if (parts[cc].size() > 1)
+    {
+      vtkNew<vtkAppendFilter> appender;
+      appender->MergePointsOn();
+      for (auto& ug : parts[cc])
+      {
+        appender->AddInputDataObject(ug);
+      }
+      appender->Update();
+      result->SetPartition(cc, appender->GetOutputDataObject(0));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// A serialized part sent by vtkDIYKdTreeUtilities::PipelinedExchange, kept
+// until all its messages are received.
+struct PipelinedMessage
+{
+  std::vector<long long> Header;
+  diy::MemoryBuffer Buffer;
+  std::vector<diy::mpi::request> Requests;
+
+  bool Test()
+  {
+    while (!this->Requests.empty() && this->Requests.back().test())
+    {
+      this->Requests.pop_back();
+    }
+    return this->Requests.empty();
+  }
+
+  void Wait()
+  {
+    while (!this->Requests.empty())
+    {
+      this->Requests.back().wait();
+      this->Requests.pop_back();
+    }
+  }
+};
+
 }
 
 //------------------------------------------------------------------------------
@@ -307,18 +392,7 @@ vtkSmartPointer<vtkPartitionedDataSet> vtkDIYKdTreeUtilities::Exchange(
     assert(sumblocks == nblocks * comm.size());
   }
 #endif
-  if (!block_assigner && vtkMath::IsPowerOfTwo(nblocks))
-  {
-    block_assigner = std::make_shared<vtkDIYExplicitAssigner>(
-      vtkDIYKdTreeUtilities::CreateAssigner(comm, nblocks));
-  }
-  else if (!block_assigner)
-  {
-    block_assigner = std::make_shared<diy::ContiguousAssigner>(comm.size(), nblocks);
-  }
-
-  using VectorOfUG = std::vector<vtkSmartPointer<vtkUnstructuredGrid>>;
-  using VectorOfVectorOfUG = std::vector<VectorOfUG>;
+  block_assigner = ::GetExchangeAssigner(comm, nblocks, block_assigner);
 
   diy::Master master(
     comm, 1, -1, []() { return static_cast<void*>(new VectorOfVectorOfUG()); },
@@ -379,28 +453,195 @@ vtkSmartPointer<vtkPartitionedDataSet> vtkDIYKdTreeUtilities::Exchange(
 
   vtkNew<vtkPartitionedDataSet> result;
   result->SetNumberOfPartitions(localParts->GetNumberOfPartitions());
-  auto block0 = *master.block<VectorOfVectorOfUG>(0);
-  assert(static_cast<unsigned int>(block0.size()) == result->GetNumberOfPartitions());
+  ::MergeParts(*master.block<VectorOfVectorOfUG>(0), result);
+  return result;
+}
 
-  for (unsigned int cc = 0; cc < result->GetNumberOfPartitions(); ++cc)
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPartitionedDataSet> vtkDIYKdTreeUtilities::PipelinedExchange(
+  unsigned int number_of_partitions, const std::vector<unsigned int>& part_ids,
+  const std::function<vtkSmartPointer<vtkDataSet>(unsigned int)>& get_part,
+  vtkMultiProcessController* controller, std::shared_ptr<diy::Assigner> block_assigner,
+  vtkIdType max_in_flight_bytes)
+{
+  diy::mpi::communicator comm = vtkDIYUtilities::GetCommunicator(controller);
+  block_assigner =
+    ::GetExchangeAssigner(comm, static_cast<int>(number_of_partitions), block_assigner);
+  const int myrank = comm.rank();
+  const int nranks = comm.size();
+
+  // Tell each rank how many parts to expect from this one.
+  std::vector<int> send_counts(nranks, 0);
+  for (const auto& partId : part_ids)
+  {
+    ++send_counts[block_assigner->rank(static_cast<int>(partId))];
+  }
+  send_counts[myrank] = 0;
+  std::vector<int> recv_counts(nranks, 0);
+  diy::mpi::all_to_all(comm, send_counts, recv_counts);
+  int num_expected = 0;
+  for (const auto& count : recv_counts)
   {
-    if (block0[cc].size() == 1)
+    num_expected += count;
+  }
+
+  // Build the parts for the ranks that follow this one first, so that the
+  // ranks do not all send to the same rank at the same time.
+  std::vector<unsigned int> order(part_ids);
+  std::stable_sort(order.begin(), order.end(),
+    [&](unsigned int a, unsigned int b)
     {
-      result->SetPartition(cc, block0[cc][0]);
+      const int ra = (block_assigner->rank(static_cast<int>(a)) - myrank - 1 + nranks) % nranks;
+      const int rb = (block_assigner->rank(static_cast<int>(b)) - myrank - 1 + nranks) % nranks;
+      return ra < rb;
+    });
+
+  // The parts of each partition, with the rank that sent them.
+  std::vector<std::vector<std::pair<int, vtkSmartPointer<vtkUnstructuredGrid>>>> received(
+    number_of_partitions);
+  std::list<PipelinedMessage> in_flight;
+  size_t in_flight_bytes = 0;
+
+  // Receive the parts that arrived, and release the parts that were received.
+  // Returns true if a part was received or released.
+  auto progress = [&]()
+  {
+    bool progressed = false;
+    while (num_expected > 0)
+    {
+      auto status = comm.iprobe(diy::mpi::any_source, PIPELINED_HEADER_TAG);
+      if (!status)
+      {
+        break;
+      }
+      const int source = status->source();
+      std::vector<long long> header;
+      comm.recv(source, PIPELINED_HEADER_TAG, header);
+      // The sender posted all the pieces with the header.
+      diy::MemoryBuffer buffer;
+      buffer.buffer.resize(static_cast<size_t>(header[1]));
+      for (size_t offset = 0; offset < buffer.buffer.size(); offset += PIPELINED_MAX_MESSAGE_SIZE)
+      {
+        const size_t count = std::min(PIPELINED_MAX_MESSAGE_SIZE, buffer.buffer.size() - offset);
+        diy::mpi::detail::recv(comm.handle(), source, PIPELINED_DATA_TAG, &buffer.buffer[offset],
+          static_cast<int>(count), diy::mpi::detail::get_mpi_datatype<char>());
+      }
+      vtkDataSet* ptr = nullptr;
+      vtkDIYUtilities::Load(buffer, ptr);
+      vtkSmartPointer<vtkUnstructuredGrid> sptr;
+      sptr.TakeReference(vtkUnstructuredGrid::SafeDownCast(ptr));
+      received[static_cast<size_t>(header[0])].emplace_back(source, sptr);
+      --num_expected;
+      progressed = true;
     }
-    else if (block0[cc].size() > 1)
+    for (auto iter = in_flight.begin(); iter != in_flight.end();)
     {
-      vtkNew<vtkAppendFilter> appender;
-      appender->MergePointsOn();
-      for (auto& ug : block0[cc])
+      if (iter->Test())
       {
-        appender->AddInputDataObject(ug);
+        in_flight_bytes -= iter->Buffer.buffer.size();
+        iter = in_flight.erase(iter);
+        progressed = true;
+      }
+      else
+      {
+        ++iter;
       }
-      appender->Update();
-      result->SetPartition(cc, appender->GetOutputDataObject(0));
     }
+    return progressed;
+  };
+
+  // Make progress, blocking until there is some when there is a single kind
+  // of message to wait for.  Blocking on a send while a part is expected, or
+  // the other way round, could deadlock with a rank doing the same, so the
+  // thread yields instead when there are both.
+  auto wait_for_progress = [&]()
+  {
+    if (progress())
+    {
+      return;
+    }
+    if (num_expected == 0 && !in_flight.empty())
+    {
+      in_flight.front().Wait();
+    }
+    else if (num_expected > 0 && in_flight.empty())
+    {
+      comm.probe(diy::mpi::any_source, PIPELINED_HEADER_TAG);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  };
+
+  for (const auto& partId : order)
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> part = vtkUnstructuredGrid::SafeDownCast(get_part(partId));
+    const int target_rank = block_assigner->rank(static_cast<int>(partId));
+    if (target_rank == myrank)
+    {
+      // short-circuit messages to self.
+      if (part)
+      {
+        received[partId].emplace_back(myrank, part);
+      }
+      continue;
+    }
+
+    // part_ids only lists the non-empty parts, and the target rank waits for
+    // as many parts as the all_to_all above counted, so a part is sent even
+    // if get_part returns nullptr for it.
+    in_flight.emplace_back();
+    auto& message = in_flight.back();
+    vtkDIYUtilities::Save(message.Buffer, part);
+    part = nullptr;
+    const size_t size = message.Buffer.buffer.size();
+    message.Header = { static_cast<long long>(partId), static_cast<long long>(size) };
+    message.Requests.push_back(comm.isend(target_rank, PIPELINED_HEADER_TAG, message.Header));
+    for (size_t offset = 0; offset < size; offset += PIPELINED_MAX_MESSAGE_SIZE)
+    {
+      const size_t count = std::min(PIPELINED_MAX_MESSAGE_SIZE, size - offset);
+      message.Requests.push_back(diy::mpi::detail::isend(comm.handle(), target_rank,
+        PIPELINED_DATA_TAG, &message.Buffer.buffer[offset], static_cast<int>(count),
+        diy::mpi::detail::get_mpi_datatype<char>()));
+    }
+    // The requests are tested from the back, test the last piece first.
+    std::reverse(message.Requests.begin(), message.Requests.end());
+    in_flight_bytes += size;
+
+    progress();
+    while (max_in_flight_bytes > 0 && in_flight_bytes > static_cast<size_t>(max_in_flight_bytes))
+    {
+      wait_for_progress();
+    }
+  }
+  while (num_expected > 0 || !in_flight.empty())
+  {
+    wait_for_progress();
+  }
+
+  // Append the parts in the order of the ranks that sent them, so that the
+  // result does not depend on the order in which they arrived.
+  VectorOfVectorOfUG parts(number_of_partitions);
+  for (unsigned int cc = 0; cc < number_of_partitions; ++cc)
+  {
+    std::stable_sort(received[cc].begin(), received[cc].end(),
+      [](const std::pair<int, vtkSmartPointer<vtkUnstructuredGrid>>& a,
+        const std::pair<int, vtkSmartPointer<vtkUnstructuredGrid>>& b)
+      { return a.first < b.first; });
+    for (auto& item : received[cc])
+    {
+      if (item.second)
+      {
+        parts[cc].push_back(item.second);
+      }
+    }
+    received[cc].clear();
   }
 
+  vtkNew<vtkPartitionedDataSet> result;
+  result->SetNumberOfPartitions(number_of_partitions);
+  ::MergeParts(parts, result);
   return result;
 }
 
@@ -18,8 +18,9 @@
 #include "vtkObject.h"
 #include "vtkSmartPointer.h" // for vtkSmartPointer
 
-#include <memory> // for std::shared_ptr
-#include <vector> // for std::vector
+#include <functional> // for std::function
+#include <memory>     // for std::shared_ptr
+#include <vector>     // for std::vector
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDataObject;
@@ -100,6 +101,32 @@ public:
   static vtkSmartPointer<vtkPartitionedDataSet> Exchange(vtkPartitionedDataSet* parts,
     vtkMultiProcessController* controller, std::shared_ptr<diy::Assigner> block_assigner = nullptr);
 
+  /**
+   * Same as `Exchange` except that the parts are not all built up front. Only
+   * the partitions listed in `part_ids` are non-empty on this rank, and
+   * `get_part` is called to build each of them, one after the other. A part
+   * is serialized and sent to its target rank as soon as it is built, while
+   * the parts received from the other ranks are deserialized as they arrive.
+   * This overlaps building the parts with the communication, and keeps only
+   * a few parts in memory at a time instead of all of them.
+   *
+   * The parts that were sent and not yet received are kept in memory until
+   * the receiving rank gets them. When their size exceeds
+   * `max_in_flight_bytes`, this rank waits for them to be received, while
+   * still receiving parts itself, before building the next part. A value of 0
+   * or less does not limit their size. A single part larger than the limit is
+   * still sent.
+   *
+   * `get_part` must return a vtkUnstructuredGrid, or nullptr. The returned
+   * vtkPartitionedDataSet has `number_of_partitions` partitions, with the
+   * same cells as the one `Exchange` returns for the same parts.
+   */
+  static vtkSmartPointer<vtkPartitionedDataSet> PipelinedExchange(
+    unsigned int number_of_partitions, const std::vector<unsigned int>& part_ids,
+    const std::function<vtkSmartPointer<vtkDataSet>(unsigned int)>& get_part,
+    vtkMultiProcessController* controller, std::shared_ptr<diy::Assigner> block_assigner,
+    vtkIdType max_in_flight_bytes);
+
   /**
    * Generates and adds global cell ids to datasets in `parts`. One this to note
    * that this method does not assign valid global ids to ghost cells. This may
@@ -158,6 +158,8 @@ vtkRedistributeDataSetFilter::vtkRedistributeDataSetFilter()
   , PreservePartitionsInOutput(false)
   , GenerateGlobalCellIds(true)
   , EnableDebugging(false)
+  , UsePipelinedExchange(false)
+  , MaximumInFlightBytes(0)
   , ValidDim{ true, true, true }
   , Strategy(vtkSmartPointer<vtkNativePartitioningStrategy>::New())
 {
@@ -867,6 +869,42 @@ bool vtkRedistributeDataSetFilter::RedistributeDataSet(vtkDataSet* inputDS,
   vtkPartitionedDataSet* outputPDS, const vtkPartitioningStrategy::PartitionInformation& info)
 {
   // note: inputDS can be null.
+  if (this->UsePipelinedExchange)
+  {
+    // extract each part only when it is about to be sent.
+    std::vector<std::vector<vtkIdType>> region_cell_ids;
+    auto clone = this->PrepareSplit(inputDS, info, region_cell_ids);
+    std::vector<unsigned int> part_ids;
+    for (size_t region_idx = 0; region_idx < region_cell_ids.size(); ++region_idx)
+    {
+      if (!region_cell_ids[region_idx].empty())
+      {
+        part_ids.push_back(static_cast<unsigned int>(region_idx));
+      }
+    }
+
+    vtkNew<vtkExtractCells> extractor;
+    extractor->SetInputDataObject(clone);
+    extractor->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+    auto get_part = [&](unsigned int region_idx) -> vtkSmartPointer<vtkDataSet>
+    {
+      auto& cell_ids = region_cell_ids[region_idx];
+      extractor->SetCellIds(cell_ids.data(), static_cast<vtkIdType>(cell_ids.size()));
+      extractor->Update();
+      std::vector<vtkIdType>().swap(cell_ids);
+
+      vtkNew<vtkUnstructuredGrid> ug;
+      ug->ShallowCopy(extractor->GetOutputDataObject(0));
+      return ug;
+    };
+
+    auto pieces = vtkDIYKdTreeUtilities::PipelinedExchange(
+      static_cast<unsigned int>(info.NumberOfPartitions), part_ids, get_part,
+      this->GetController(), this->Assigner, this->MaximumInFlightBytes);
+    outputPDS->CompositeShallowCopy(pieces);
+    return true;
+  }
+
   auto parts = this->SplitDataSet(inputDS, info);
   if (parts->GetNumberOfPartitions() != static_cast<unsigned int>(info.NumberOfPartitions))
   {
@@ -926,14 +964,14 @@ vtkSmartPointer<vtkDataSet> vtkRedistributeDataSetFilter::ClipDataSet(
 }
 
 //------------------------------------------------------------------------------
-vtkSmartPointer<vtkPartitionedDataSet> vtkRedistributeDataSetFilter::SplitDataSet(
-  vtkDataSet* dataset, const vtkPartitioningStrategy::PartitionInformation& info)
+vtkSmartPointer<vtkDataSet> vtkRedistributeDataSetFilter::PrepareSplit(vtkDataSet* dataset,
+  const vtkPartitioningStrategy::PartitionInformation& info,
+  std::vector<std::vector<vtkIdType>>& region_cell_ids)
 {
+  region_cell_ids.clear();
   if (!dataset || info.NumberOfPartitions == 0 || dataset->GetNumberOfCells() == 0)
   {
-    vtkNew<vtkPartitionedDataSet> result;
-    result->SetNumberOfPartitions(static_cast<unsigned int>(info.NumberOfPartitions));
-    return result;
+    return nullptr;
   }
 
   const auto numCells = dataset->GetNumberOfCells();
@@ -954,7 +992,7 @@ vtkSmartPointer<vtkPartitionedDataSet> vtkRedistributeDataSetFilter::SplitDataSe
 
   // convert cell_regions to a collection of cell-ids for each region so that we
   // can use `vtkExtractCells` to extract cells for each region.
-  std::vector<std::vector<vtkIdType>> region_cell_ids(info.NumberOfPartitions);
+  region_cell_ids.resize(info.NumberOfPartitions);
   for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
   {
     auto part = info.TargetPartitions->GetValue(cellId);
@@ -974,9 +1012,6 @@ vtkSmartPointer<vtkPartitionedDataSet> vtkRedistributeDataSetFilter::SplitDataSe
     }
   }
 
-  vtkNew<vtkPartitionedDataSet> result;
-  result->SetNumberOfPartitions(static_cast<unsigned int>(info.NumberOfPartitions));
-
   // we create a clone of the input and add the
   // cell_ownership cell arrays to it so that they are propagated to each of the
   // extracted subsets and exchanged. It will be used later on to mark
@@ -984,6 +1019,22 @@ vtkSmartPointer<vtkPartitionedDataSet> vtkRedistributeDataSetFilter::SplitDataSe
   auto clone = vtkSmartPointer<vtkDataSet>::Take(dataset->NewInstance());
   clone->ShallowCopy(dataset);
   clone->GetCellData()->AddArray(cell_ownership);
+  return clone;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPartitionedDataSet> vtkRedistributeDataSetFilter::SplitDataSet(
+  vtkDataSet* dataset, const vtkPartitioningStrategy::PartitionInformation& info)
+{
+  vtkNew<vtkPartitionedDataSet> result;
+  result->SetNumberOfPartitions(static_cast<unsigned int>(info.NumberOfPartitions));
+
+  std::vector<std::vector<vtkIdType>> region_cell_ids;
+  auto clone = this->PrepareSplit(dataset, info, region_cell_ids);
+  if (!clone)
+  {
+    return result;
+  }
 
   vtkNew<vtkExtractCells> extractor;
   extractor->SetInputDataObject(clone);
@@ -1177,6 +1228,8 @@ void vtkRedistributeDataSetFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PreservePartitionsInOutput: " << this->PreservePartitionsInOutput << endl;
   os << indent << "GenerateGlobalCellIds: " << this->GenerateGlobalCellIds << endl;
   os << indent << "EnableDebugging: " << this->EnableDebugging << endl;
+  os << indent << "UsePipelinedExchange: " << this->UsePipelinedExchange << endl;
+  os << indent << "MaximumInFlightBytes: " << this->MaximumInFlightBytes << endl;
   os << indent << "Strategy:" << std::endl;
   if (this->Strategy)
   {
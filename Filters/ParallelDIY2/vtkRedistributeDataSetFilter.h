@@ -255,6 +255,38 @@ public:
   vtkBooleanMacro(LoadBalanceAcrossAllBlocks, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, the parts of each dataset are exchanged one at a time
+   * instead of in a single step: each part is extracted, serialized and sent
+   * to its target rank as soon as it is ready, while the parts sent by the
+   * other ranks are received as they arrive. This overlaps the extraction of
+   * the parts with the communication, and avoids holding all the extracted
+   * and serialized parts in memory at once, at the cost of a few more
+   * messages.
+   *
+   * Default is false.
+   *
+   * @sa MaximumInFlightBytes
+   */
+  vtkSetMacro(UsePipelinedExchange, bool);
+  vtkGetMacro(UsePipelinedExchange, bool);
+  vtkBooleanMacro(UsePipelinedExchange, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When UsePipelinedExchange is true, the maximum size in bytes of the
+   * serialized parts that were sent by this rank and not yet received. Once
+   * it is reached, the rank waits for the parts to be received before it
+   * extracts the next one. Set to 0 to not limit it.
+   *
+   * Default is 0.
+   */
+  vtkSetClampMacro(MaximumInFlightBytes, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(MaximumInFlightBytes, vtkIdType);
+  ///@}
+
   ///@{
   /**
    * Setter/Getter for Strategy
@@ -308,6 +340,16 @@ private:
 
   bool RedistributeDataSet(vtkDataSet* inputDS, vtkPartitionedDataSet* outputPDS,
     const vtkPartitioningStrategy::PartitionInformation& info);
+
+  /**
+   * Fills `region_cell_ids` with the ids of the cells to extract for each
+   * partition, and returns a shallow copy of the dataset, with the cell
+   * ownership array added, to extract them from. Returns nullptr if there
+   * is nothing to split.
+   */
+  vtkSmartPointer<vtkDataSet> PrepareSplit(vtkDataSet* dataset,
+    const vtkPartitioningStrategy::PartitionInformation& info,
+    std::vector<std::vector<vtkIdType>>& region_cell_ids);
   vtkSmartPointer<vtkDataSet> ClipDataSet(vtkDataSet* dataset, const vtkBoundingBox& bbox);
 
   void MarkGhostCells(vtkPartitionedDataSet* pieces);
@@ -326,6 +368,8 @@ private:
   bool PreservePartitionsInOutput;
   bool GenerateGlobalCellIds;
   bool EnableDebugging;
+  bool UsePipelinedExchange;
+  vtkIdType MaximumInFlightBytes;
   bool ValidDim[3];
 
   vtkSmartPointer<vtkPartitioningStrategy> Strategy;
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkMemoryLimitImageDataStreamer splits the requests so that the
+// pieces computed upstream, halos included, fit in the memory limit, that it
+// prefers blocks to slabs for large kernels, and that the streamed output is
+// the same as the output computed at once, also when the requests come in
+// pieces from downstream.
+
+#include "vtkCallbackCommand.h"
+#include "vtkExtentTranslator.h"
+#include "vtkImageData.h"
+#include "vtkImageDataStreamer.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkMemoryLimitImageDataStreamer.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Keep the largest number of points produced by the source for one piece.
+void RecordPieceSize(vtkObject* caller, unsigned long, void* clientData, void*)
+{
+  vtkImageData* output = vtkRTAnalyticSource::SafeDownCast(caller)->GetOutput();
+  vtkIdType* largestPiece = static_cast<vtkIdType*>(clientData);
+  *largestPiece = std::max(*largestPiece, output->GetNumberOfPoints());
+}
+
+//------------------------------------------------------------------------------
+bool SameScalars(vtkImageData* expected, vtkImageData* actual)
+{
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  vtkDataArray* actualScalars = actual->GetPointData()->GetScalars();
+  if (!actualScalars || actualScalars->GetNumberOfTuples() != expectedScalars->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType id = 0; id < expectedScalars->GetNumberOfTuples(); ++id)
+  {
+    if (std::abs(expectedScalars->GetComponent(id, 0) - actualScalars->GetComponent(id, 0)) >
+      1e-6 * std::abs(expectedScalars->GetComponent(id, 0)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestMemoryLimitImageDataStreamer(int, char*[])
+{
+  // The expected output, computed at once.
+  vtkNew<vtkRTAnalyticSource> wholeSource;
+  wholeSource->SetWholeExtent(0, 63, 0, 63, 0, 63);
+  vtkNew<vtkImageGaussianSmooth> wholeSmooth;
+  wholeSmooth->SetInputConnection(wholeSource->GetOutputPort());
+  wholeSmooth->SetStandardDeviation(2.0);
+  wholeSmooth->SetRadiusFactor(3.0);
+  wholeSmooth->Update();
+  vtkImageData* expected = wholeSmooth->GetOutput();
+
+  // The source produces floats, 1 MiB for the whole extent.
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 63, 0, 63, 0, 63);
+  vtkIdType largestPiece = 0;
+  vtkNew<vtkCallbackCommand> recordPieceSize;
+  recordPieceSize->SetCallback(::RecordPieceSize);
+  recordPieceSize->SetClientData(&largestPiece);
+  source->AddObserver(vtkCommand::EndEvent, recordPieceSize);
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  smooth->SetInputConnection(source->GetOutputPort());
+  smooth->SetStandardDeviation(2.0);
+  smooth->SetRadiusFactor(3.0);
+
+  // A kernel radius of 6 makes thin slabs wasteful, so blocks are used.
+  vtkNew<vtkMemoryLimitImageDataStreamer> streamer;
+  streamer->SetInputConnection(smooth->GetOutputPort());
+  streamer->SetMemoryLimit(300);
+  largestPiece = 0;
+  streamer->Update();
+  if (streamer->GetNumberOfStreamDivisions() < 4 ||
+    streamer->GetExtentTranslator()->GetSplitMode() != vtkExtentTranslator::BLOCK_MODE)
+  {
+    std::cerr << "Unexpected " << streamer->GetNumberOfStreamDivisions()
+              << " pieces with split mode " << streamer->GetExtentTranslator()->GetSplitMode()
+              << "\n";
+    return EXIT_FAILURE;
+  }
+  if (largestPiece * sizeof(float) > 300 * 1024)
+  {
+    std::cerr << "A piece of " << largestPiece << " points does not fit in the memory limit\n";
+    return EXIT_FAILURE;
+  }
+  if (!::SameScalars(expected, streamer->GetOutput()))
+  {
+    std::cerr << "Streamed output differs\n";
+    return EXIT_FAILURE;
+  }
+
+  // Without optimization, the split mode of the translator is kept.
+  vtkNew<vtkMemoryLimitImageDataStreamer> slabStreamer;
+  slabStreamer->SetInputConnection(smooth->GetOutputPort());
+  slabStreamer->SetMemoryLimit(300);
+  slabStreamer->OptimizeTileShapeOff();
+  slabStreamer->GetExtentTranslator()->SetSplitModeToZSlab();
+  slabStreamer->Update();
+  if (slabStreamer->GetExtentTranslator()->GetSplitMode() != vtkExtentTranslator::Z_SLAB_MODE ||
+    slabStreamer->GetNumberOfStreamDivisions() < streamer->GetNumberOfStreamDivisions() ||
+    !::SameScalars(expected, slabStreamer->GetOutput()))
+  {
+    std::cerr << "Streaming with z slabs failed\n";
+    return EXIT_FAILURE;
+  }
+
+  // Pieces requested from downstream, as a streaming writer does, are split
+  // again, and only the pieces are allocated.
+  vtkNew<vtkMemoryLimitImageDataStreamer> pieceStreamer;
+  pieceStreamer->SetInputConnection(smooth->GetOutputPort());
+  pieceStreamer->SetMemoryLimit(300);
+  vtkNew<vtkImageDataStreamer> pieces;
+  pieces->SetInputConnection(pieceStreamer->GetOutputPort());
+  pieces->SetNumberOfStreamDivisions(3);
+  pieces->Update();
+  if (!::SameScalars(expected, pieces->GetOutput()) ||
+    pieceStreamer->GetOutput()->GetNumberOfPoints() >= expected->GetNumberOfPoints())
+  {
+    std::cerr << "Streaming pieces requested from downstream failed\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -13,6 +13,8 @@
 #include "vtkPipelineSize.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMemoryLimitImageDataStreamer);
 
@@ -21,6 +23,7 @@ vtkMemoryLimitImageDataStreamer::vtkMemoryLimitImageDataStreamer()
 {
   // Set a default memory limit of 50 mebibytes
   this->MemoryLimit = 50 * 1024;
+  this->OptimizeTileShape = 1;
 }
 
 //------------------------------------------------------------------------------
@@ -29,6 +32,98 @@ void vtkMemoryLimitImageDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "MemoryLimit (in kibibytes): " << this->MemoryLimit << endl;
+  os << indent << "OptimizeTileShape: " << (this->OptimizeTileShape ? "On" : "Off") << endl;
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkMemoryLimitImageDataStreamer::EstimatePipelineSize(
+  vtkInformation* inInfo, const int extent[6])
+{
+  // set the update extent
+  inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+  // set a hint not to combine with previous requests
+  inInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_REPLACE);
+
+  // then propagate it, so that the upstream filters add their halos
+  vtkExecutive* exec = vtkExecutive::PRODUCER()->GetExecutive(inInfo);
+  int index = vtkExecutive::PRODUCER()->GetPort(inInfo);
+  vtkStreamingDemandDrivenPipeline* sddp = vtkStreamingDemandDrivenPipeline::SafeDownCast(exec);
+  sddp->PropagateUpdateExtent(index);
+
+  // then reset the INITIALIZED flag to the default value COMBINE
+  inInfo->Set(
+    vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_COMBINE);
+
+  vtkPipelineSize* sizer = vtkPipelineSize::New();
+  unsigned long size = sizer->GetEstimatedSize(this, 0, 0);
+  sizer->Delete();
+  return size;
+}
+
+//------------------------------------------------------------------------------
+int vtkMemoryLimitImageDataStreamer::ComputeNumberOfPieces(
+  vtkInformation* inInfo, const int extent[6], int splitMode, unsigned long& size)
+{
+  vtkExtentTranslator* translator = this->GetExtentTranslator();
+  int wholeExtent[6];
+  std::copy(extent, extent + 6, wholeExtent);
+  int numberOfPieces = 1;
+  unsigned long oldSize;
+  float ratio;
+  size = 0;
+
+  // watch for the limiting case where the size is the maximum size
+  // represented by an unsigned long. In that case we do not want to do
+  // the ratio test. We actual test for size < 0.5 of the max unsigned
+  // long which would indicate that oldSize is about at max unsigned
+  // long.
+  unsigned long maxSize;
+  maxSize = (((unsigned long)0x1) << (8 * sizeof(unsigned long) - 1));
+
+  // we also have to watch how many pieces we are creating. Since
+  // NumberOfStreamDivisions is an int, it cannot be more that say 2^31
+  // (which is a bit much anyhow) so we also stop if the number of pieces
+  // is too large.
+  int count = 0;
+
+  // double the number of pieces until the size fits in memory
+  // or the reduction in size falls to 20%
+  do
+  {
+    oldSize = size;
+
+    // The first piece lies in a corner of the extent, where the halos are
+    // clipped, so also measure a piece from the middle of the extent.
+    size = 0;
+    for (int piece : { 0, numberOfPieces / 2 })
+    {
+      int inExt[6];
+      translator->PieceToExtentThreadSafe(
+        piece, numberOfPieces, 0, wholeExtent, inExt, splitMode, 1);
+      size = std::max(size, this->EstimatePipelineSize(inInfo, inExt));
+      if (numberOfPieces == 1)
+      {
+        break;
+      }
+    }
+
+    // watch for the first time through
+    if (!oldSize)
+    {
+      ratio = 0.5;
+    }
+    // otherwise the normal ratio calculation
+    else
+    {
+      ratio = size / (float)oldSize;
+    }
+    numberOfPieces = numberOfPieces * 2;
+    count++;
+  } while (size > this->MemoryLimit && (size < maxSize && ratio < 0.8) && count < 29);
+
+  // undo the last *2
+  return numberOfPieces / 2;
 }
 
 //------------------------------------------------------------------------------
@@ -51,71 +146,77 @@ vtkTypeBool vtkMemoryLimitImageDataStreamer ::ProcessRequest(
       vtkExtentTranslator* translator = this->GetExtentTranslator();
       translator->SetWholeExtent(outExt);
 
-      vtkPipelineSize* sizer = vtkPipelineSize::New();
-      this->NumberOfStreamDivisions = 1;
-      unsigned long oldSize, size = 0;
-      float ratio;
-      translator->SetPiece(0);
-
-      // watch for the limiting case where the size is the maximum size
-      // represented by an unsigned long. In that case we do not want to do
-      // the ratio test. We actual test for size < 0.5 of the max unsigned
-      // long which would indicate that oldSize is about at max unsigned
-      // long.
-      unsigned long maxSize;
-      maxSize = (((unsigned long)0x1) << (8 * sizeof(unsigned long) - 1));
-
-      // we also have to watch how many pieces we are creating. Since
-      // NumberOfStreamDivisions is an int, it cannot be more that say 2^31
-      // (which is a bit much anyhow) so we also stop if the number of pieces
-      // is too large.
-      int count = 0;
-
-      // double the number of pieces until the size fits in memory
-      // or the reduction in size falls to 20%
-      do
+      if (!this->OptimizeTileShape)
+      {
+        unsigned long size;
+        this->NumberOfStreamDivisions =
+          this->ComputeNumberOfPieces(inInfo, outExt, translator->GetSplitMode(), size);
+      }
+      else
       {
-        oldSize = size;
-        translator->SetNumberOfPieces(this->NumberOfStreamDivisions);
-        translator->PieceToExtentByPoints();
-
-        int inExt[6];
-        translator->GetExtent(inExt);
-        // set the update extent
-        inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
-        // set a hint not to combine with previous requests
-        inInfo->Set(
-          vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_REPLACE);
-
-        // then propagate it
-        vtkExecutive* exec = vtkExecutive::PRODUCER()->GetExecutive(inInfo);
-        int index = vtkExecutive::PRODUCER()->GetPort(inInfo);
-        vtkStreamingDemandDrivenPipeline* sddp =
-          vtkStreamingDemandDrivenPipeline::SafeDownCast(exec);
-        sddp->PropagateUpdateExtent(index);
-
-        // then reset the INITIALIZED flag to the default value COMBINE
-        inInfo->Set(
-          vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_COMBINE);
-
-        size = sizer->GetEstimatedSize(this, 0, 0);
-        // watch for the first time through
-        if (!oldSize)
+        // Slabs are tried first since they are contiguous in memory, blocks
+        // are chosen when their smaller halos make them worth it.
+        const int splitModes[4] = { vtkExtentTranslator::Z_SLAB_MODE,
+          vtkExtentTranslator::Y_SLAB_MODE, vtkExtentTranslator::X_SLAB_MODE,
+          vtkExtentTranslator::BLOCK_MODE };
+        int bestSplitMode = splitModes[0];
+        int bestNumberOfPieces = 0;
+        unsigned long bestSize = 0;
+        double bestTotalSize = 0.0;
+        for (int splitMode : splitModes)
         {
-          ratio = 0.5;
+          unsigned long size;
+          int numberOfPieces = this->ComputeNumberOfPieces(inInfo, outExt, splitMode, size);
+          // Among the split modes that fit in memory, prefer the one that
+          // requests the least memory for all pieces, which accounts for the
+          // halos computed more than once.  If none fits, prefer the one with
+          // the smallest pieces.
+          double totalSize = static_cast<double>(size) * numberOfPieces;
+          bool better;
+          if (!bestNumberOfPieces)
+          {
+            better = true;
+          }
+          else if ((size <= this->MemoryLimit) != (bestSize <= this->MemoryLimit))
+          {
+            better = size <= this->MemoryLimit;
+          }
+          else if (size <= this->MemoryLimit)
+          {
+            better = totalSize < bestTotalSize;
+          }
+          else
+          {
+            better = size < bestSize;
+          }
+          if (better)
+          {
+            bestSplitMode = splitMode;
+            bestNumberOfPieces = numberOfPieces;
+            bestSize = size;
+            bestTotalSize = totalSize;
+          }
         }
-        // otherwise the normal ratio calculation
-        else
+        switch (bestSplitMode)
         {
-          ratio = size / (float)oldSize;
+          case vtkExtentTranslator::X_SLAB_MODE:
+            translator->SetSplitModeToXSlab();
+            break;
+          case vtkExtentTranslator::Y_SLAB_MODE:
+            translator->SetSplitModeToYSlab();
+            break;
+          case vtkExtentTranslator::Z_SLAB_MODE:
+            translator->SetSplitModeToZSlab();
+            break;
+          default:
+            translator->SetSplitModeToBlock();
+            break;
         }
-        this->NumberOfStreamDivisions = this->NumberOfStreamDivisions * 2;
-        count++;
-      } while (size > this->MemoryLimit && (size < maxSize && ratio < 0.8) && count < 29);
+        this->NumberOfStreamDivisions = bestNumberOfPieces;
+      }
 
-      // undo the last *2
-      this->NumberOfStreamDivisions = this->NumberOfStreamDivisions / 2;
-      sizer->Delete();
+      vtkDebugMacro("Streaming " << this->NumberOfStreamDivisions << " pieces with split mode "
+                                 << translator->GetSplitMode());
     }
     return this->Superclass::ProcessRequest(request, inputVector, outputVector);
   }
@@ -7,6 +7,20 @@
  * To satisfy a request, this filter calls update on its input
  * many times with smaller update extents.  All processing up stream
  * streams smaller pieces.
+ *
+ * The number of pieces is chosen so that the memory needed by the upstream
+ * pipeline for one piece stays below MemoryLimit.  The estimate is made by
+ * propagating the update extent of candidate pieces through the pipeline, so
+ * it includes the halos that the upstream filters add to their requests
+ * (for example the kernel of a convolution).  When OptimizeTileShape is on,
+ * the split mode of the extent translator is also chosen among slabs along
+ * each axis and blocks, to minimize the total memory requested by all
+ * pieces: blocks need smaller halos than slabs when the upstream filters
+ * have large kernels.
+ *
+ * When a writer that streams pieces, such as vtkXMLImageDataWriter with
+ * several pieces, is connected to the output, each piece requested by the
+ * writer is split again, so the whole volume never has to be in memory.
  */
 
 #ifndef vtkMemoryLimitImageDataStreamer_h
@@ -31,6 +45,17 @@ public:
   vtkGetMacro(MemoryLimit, unsigned long);
   ///@}
 
+  ///@{
+  /**
+   * Choose the split mode of the extent translator that minimizes the
+   * memory requested for all the pieces, instead of using its current
+   * split mode.  Default is on.
+   */
+  vtkSetMacro(OptimizeTileShape, vtkTypeBool);
+  vtkGetMacro(OptimizeTileShape, vtkTypeBool);
+  vtkBooleanMacro(OptimizeTileShape, vtkTypeBool);
+  ///@}
+
   // See the vtkAlgorithm for a description of what these do
   vtkTypeBool ProcessRequest(
     vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -39,7 +64,22 @@ protected:
   vtkMemoryLimitImageDataStreamer();
   ~vtkMemoryLimitImageDataStreamer() override = default;
 
+  /**
+   * Compute the number of pieces of the given extent needed to fit in the
+   * memory limit with the given split mode, and the estimated size in
+   * kibibytes of the pipeline for one piece.
+   */
+  int ComputeNumberOfPieces(
+    vtkInformation* inInfo, const int extent[6], int splitMode, unsigned long& size);
+
+  /**
+   * Propagate the given update extent upstream and return the estimated
+   * size of the pipeline in kibibytes.
+   */
+  unsigned long EstimatePipelineSize(vtkInformation* inInfo, const int extent[6]);
+
   unsigned long MemoryLimit;
+  vtkTypeBool OptimizeTileShape;
 
 private:
   vtkMemoryLimitImageDataStreamer(const vtkMemoryLimitImageDataStreamer&) = delete;
@@ -8,6 +8,7 @@
 #include "vtkCharArray.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetLocatorCache.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -21,6 +22,7 @@
 #include "vtkPoints.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
@@ -30,6 +32,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPointInterpolator);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Locator, vtkAbstractPointLocator);
+vtkCxxSetObjectMacro(vtkPointInterpolator, LocatorCache, vtkDataSetLocatorCache);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Kernel, vtkInterpolationKernel);
 
 //------------------------------------------------------------------------------
@@ -55,17 +58,17 @@ struct ProbePoints
   vtkSMPThreadLocalObject<vtkIdList> PIds;
   vtkSMPThreadLocalObject<vtkDoubleArray> Weights;
 
-  ProbePoints(vtkPointInterpolator* ptInt, vtkDataSet* input, vtkPointData* inPD,
-    vtkPointData* outPD, char* valid)
+  ProbePoints(vtkPointInterpolator* ptInt, vtkAbstractPointLocator* locator, vtkDataSet* input,
+    vtkPointData* inPD, vtkPointData* outPD, char* valid)
     : PointInterpolator(ptInt)
     , Input(input)
+    , Locator(locator)
     , InPD(inPD)
     , OutPD(outPD)
     , Valid(valid)
   {
     // Gather information from the interpolator
     this->Kernel = ptInt->GetKernel();
-    this->Locator = ptInt->GetLocator();
     this->Strategy = ptInt->GetNullPointsStrategy();
     double nullV = ptInt->GetNullValue();
     this->Promote = ptInt->GetPromoteOutputArrays();
@@ -151,9 +154,10 @@ struct ImageProbePoints : public ProbePoints
   double Origin[3];
   double Spacing[3];
 
-  ImageProbePoints(vtkPointInterpolator* ptInt, vtkImageData* image, int dims[3], double origin[3],
-    double spacing[3], vtkPointData* inPD, vtkPointData* outPD, char* valid)
-    : ProbePoints(ptInt, image, inPD, outPD, valid)
+  ImageProbePoints(vtkPointInterpolator* ptInt, vtkAbstractPointLocator* locator,
+    vtkImageData* image, int dims[3], double origin[3], double spacing[3], vtkPointData* inPD,
+    vtkPointData* outPD, char* valid)
+    : ProbePoints(ptInt, locator, image, inPD, outPD, valid)
   {
     for (int i = 0; i < 3; ++i)
     {
@@ -215,6 +219,7 @@ vtkPointInterpolator::vtkPointInterpolator()
   this->SetNumberOfInputPorts(2);
 
   this->Locator = vtkStaticPointLocator::New();
+  this->LocatorCache = nullptr;
 
   this->Kernel = vtkLinearKernel::New();
 
@@ -235,6 +240,7 @@ vtkPointInterpolator::vtkPointInterpolator()
 vtkPointInterpolator::~vtkPointInterpolator()
 {
   this->SetLocator(nullptr);
+  this->SetLocatorCache(nullptr);
   this->SetKernel(nullptr);
 }
 
@@ -287,8 +293,17 @@ void vtkPointInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataS
     vtkErrorMacro(<< "Point locator required\n");
     return;
   }
-  this->Locator->SetDataSet(source);
-  this->Locator->BuildLocator();
+  vtkSmartPointer<vtkAbstractPointLocator> locator = this->Locator;
+  if (this->LocatorCache)
+  {
+    // share the locator with the other filters using this cache
+    locator = this->LocatorCache->GetPointLocator(source, this->Locator);
+  }
+  else
+  {
+    this->Locator->SetDataSet(source);
+    this->Locator->BuildLocator();
+  }
 
   // Set up the interpolation process
   vtkIdType numPts = input->GetNumberOfPoints();
@@ -314,7 +329,7 @@ void vtkPointInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataS
   // Now loop over input points, finding closest points and invoking kernel.
   if (this->Kernel->GetRequiresInitialization())
   {
-    this->Kernel->Initialize(this->Locator, source, inPD);
+    this->Kernel->Initialize(locator, source, inPD);
   }
 
   // If the input is image data then there is a faster path
@@ -324,12 +339,13 @@ void vtkPointInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataS
     int dims[3];
     double origin[3], spacing[3];
     this->ExtractImageDescription(imgInput, dims, origin, spacing);
-    ImageProbePoints imageProbe(this, imgInput, dims, origin, spacing, inPD, outPD, mask);
+    ImageProbePoints imageProbe(
+      this, locator, imgInput, dims, origin, spacing, inPD, outPD, mask);
     vtkSMPTools::For(0, dims[2], imageProbe); // over slices
   }
   else
   {
-    ProbePoints probe(this, input, inPD, outPD, mask);
+    ProbePoints probe(this, locator, input, inPD, outPD, mask);
     vtkSMPTools::For(0, numPts, probe);
   }
 
@@ -488,6 +504,7 @@ void vtkPointInterpolator::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Source: " << source << "\n";
   os << indent << "Locator: " << this->Locator << "\n";
+  os << indent << "LocatorCache: " << this->LocatorCache << "\n";
   os << indent << "Kernel: " << this->Kernel << "\n";
 
   os << indent << "Null Points Strategy: " << this->NullPointsStrategy << endl;
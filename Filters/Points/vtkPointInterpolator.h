@@ -60,6 +60,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractPointLocator;
+class vtkDataSetLocatorCache;
 class vtkIdList;
 class vtkDoubleArray;
 class vtkInterpolationKernel;
@@ -108,6 +109,17 @@ public:
   vtkGetObjectMacro(Locator, vtkAbstractPointLocator);
   ///@}
 
+  ///@{
+  /**
+   * Specify a locator cache shared with other filters. When set, the
+   * source point locator is requested from the cache, using Locator as
+   * prototype, so that filters interpolating from the same source reuse a
+   * single built locator. By default no cache is used.
+   */
+  void SetLocatorCache(vtkDataSetLocatorCache* cache);
+  vtkGetObjectMacro(LocatorCache, vtkDataSetLocatorCache);
+  ///@}
+
   ///@{
   /**
    * Specify an interpolation kernel. By default a vtkLinearKernel is used
@@ -259,6 +271,7 @@ protected:
   ~vtkPointInterpolator() override;
 
   vtkAbstractPointLocator* Locator;
+  vtkDataSetLocatorCache* LocatorCache;
   vtkInterpolationKernel* Kernel;
 
   int NullPointsStrategy;
@@ -5,6 +5,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkBMPWriter.h"
 #include "vtkCommand.h"
+#include "vtkFeatures.h" // for VTK_USE_ZSTD
 #include "vtkImageData.h"
 #include "vtkJPEGWriter.h"
 #include "vtkLogger.h"
@@ -19,6 +20,9 @@
 #include "vtkXMLImageDataWriter.h"
 #include "vtkZLibDataCompressor.h"
 #include "vtksys/FStream.hxx"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include <cassert>
 #include <cmath>
@@ -33,17 +37,17 @@ namespace
 struct vtkThreadedImageWriterFunctor
 {
   template <class TArray>
-  void operator()(TArray* array, const std::string& fileName, bool zLibCompression)
+  void operator()(TArray* array, const std::string& fileName, vtkDataCompressor* compressor)
   {
     auto* buffer = array->GetPointer(0);
     const size_t bufferSize = array->GetNumberOfValues() * array->GetDataTypeSize();
     vtksys::ofstream fileHandler(fileName.c_str(), ios::out | ios::binary);
-    if (zLibCompression)
+    if (compressor)
     {
-      vtkNew<vtkZLibDataCompressor> zLib;
-      unsigned char* cBuffer = new unsigned char[bufferSize];
-      size_t compressSize =
-        zLib->Compress(reinterpret_cast<unsigned char*>(buffer), bufferSize, cBuffer, bufferSize);
+      const size_t compressionSpace = compressor->GetMaximumCompressionSpace(bufferSize);
+      unsigned char* cBuffer = new unsigned char[compressionSpace];
+      size_t compressSize = compressor->Compress(
+        reinterpret_cast<unsigned char*>(buffer), bufferSize, cBuffer, compressionSpace);
       fileHandler.write(reinterpret_cast<const char*>(cBuffer), compressSize);
       delete[] cBuffer;
     }
@@ -64,9 +68,10 @@ void EncodeAndWrite(const vtkSmartPointer<vtkImageData>& image, const std::strin
 
   if (extension == "Z")
   {
+    vtkNew<vtkZLibDataCompressor> zLib;
     auto scalars = image->GetPointData()->GetScalars()->ToAOSDataArray();
     if (!vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AOSArrays>::Execute(
-          scalars, vtkThreadedImageWriterFunctor{}, fileName, true))
+          scalars, vtkThreadedImageWriterFunctor{}, fileName, zLib))
     {
       vtkErrorWithObjectMacro(nullptr,
         "EncodeAndWrite: Array " << image->GetPointData()->GetScalars()->GetClassName()
@@ -74,6 +79,21 @@ void EncodeAndWrite(const vtkSmartPointer<vtkImageData>& image, const std::strin
     }
   }
 
+#ifdef VTK_USE_ZSTD
+  else if (extension == "zst")
+  {
+    vtkNew<vtkZstdDataCompressor> zstd;
+    auto scalars = image->GetPointData()->GetScalars()->ToAOSDataArray();
+    if (!vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AOSArrays>::Execute(
+          scalars, vtkThreadedImageWriterFunctor{}, fileName, zstd))
+    {
+      vtkErrorWithObjectMacro(nullptr,
+        "EncodeAndWrite: Array " << image->GetPointData()->GetScalars()->GetClassName()
+                                 << " not supported.");
+    }
+  }
+#endif
+
   else if (extension == "png")
   {
     vtkNew<vtkPNGWriter> writer;
@@ -126,7 +146,7 @@ void EncodeAndWrite(const vtkSmartPointer<vtkImageData>& image, const std::strin
   {
     if (!vtkArrayDispatch::DispatchByArray<vtkArrayDispatch::AOSArrays>::Execute(
           image->GetPointData()->GetScalars()->ToAOSDataArray(), vtkThreadedImageWriterFunctor{},
-          fileName, false))
+          fileName, nullptr))
     {
       vtkErrorWithObjectMacro(nullptr,
         "EncodeAndWrite: Array " << image->GetPointData()->GetScalars()->GetClassName()
@@ -6,7 +6,8 @@
  *           locking while encoding data.
  *
  * @details  This writer allow to encode an image data based on its file
- *           extension: tif, tiff, bpm, png, jpg, jpeg, vti, Z, ppm, raw
+ *           extension: tif, tiff, bpm, png, jpg, jpeg, vti, Z, ppm, raw,
+ *           and zst when VTK is built with VTK_USE_ZSTD.
  *
  * @author   Patricia Kroll Fasel @ LANL
  */
@@ -46,6 +46,19 @@ int TestCompressLZ4(int argc, char* argv[])
   }
   delete[] cbuffer;
 
+  // CopyParameters keeps acceleration levels that the compression level
+  // does not describe.
+  compressor->SetAccelerationLevel(40);
+  vtkLZ4DataCompressor* copy = vtkLZ4DataCompressor::New();
+  copy->CopyParameters(compressor);
+  if (copy->GetAccelerationLevel() != 40)
+  {
+    std::cerr << "CopyParameters gives acceleration level " << copy->GetAccelerationLevel()
+              << std::endl;
+    res = 1;
+  }
+  copy->Delete();
+
   compressor->Delete();
   return res;
 }
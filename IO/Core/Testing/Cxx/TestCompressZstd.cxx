@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// .NAME Test of vtkZstdDataCompressor
+// .SECTION Description
+//
+
+#include "vtkNew.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+int TestCompressZstd(int, char*[])
+{
+  constexpr size_t start_size = 1 << 22;
+  std::vector<unsigned char> buffer(start_size);
+  for (size_t cc = 0; cc < start_size; cc++)
+  {
+    buffer[cc] = static_cast<unsigned char>(64 * std::sin(cc * 0.001) + (cc % 7));
+  }
+
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int threads : { 0, 4 })
+  {
+    compressor->SetNumberOfThreads(threads);
+    for (int level = 1; level <= 9; level += 4)
+    {
+      compressor->SetCompressionLevel(level);
+      if (compressor->GetCompressionLevel() != level)
+      {
+        std::cerr << "Level " << level << " read back as " << compressor->GetCompressionLevel()
+                  << std::endl;
+        return 1;
+      }
+
+      std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(start_size));
+      size_t rlen = compressor->Compress(buffer.data(), start_size, cbuffer.data(), cbuffer.size());
+      if (rlen == 0 || rlen >= start_size)
+      {
+        std::cerr << "Compression failed at level " << level << std::endl;
+        return 1;
+      }
+
+      std::vector<unsigned char> ucbuffer(start_size);
+      if (compressor->Uncompress(cbuffer.data(), rlen, ucbuffer.data(), start_size) !=
+          start_size ||
+        ucbuffer != buffer)
+      {
+        std::cerr << "Round trip failed at level " << level << std::endl;
+        return 1;
+      }
+      std::cout << "Level " << level << ", " << threads << " threads: " << start_size << " -> "
+                << rlen << std::endl;
+    }
+  }
+
+  // The XML writers set up one compressor per thread with CopyParameters,
+  // which must keep the levels that the compression level does not describe.
+  compressor->SetZstdLevel(22);
+  compressor->SetNumberOfThreads(2);
+  vtkNew<vtkZstdDataCompressor> copy;
+  copy->CopyParameters(compressor);
+  if (copy->GetZstdLevel() != 22 || copy->GetNumberOfThreads() != 2)
+  {
+    std::cerr << "CopyParameters gives level " << copy->GetZstdLevel() << " and "
+              << copy->GetNumberOfThreads() << " threads" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
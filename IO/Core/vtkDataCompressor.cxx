@@ -16,6 +16,15 @@ void vtkDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//------------------------------------------------------------------------------
+void vtkDataCompressor::CopyParameters(vtkDataCompressor* other)
+{
+  if (other && other != this)
+  {
+    this->SetCompressionLevel(other->GetCompressionLevel());
+  }
+}
+
 //------------------------------------------------------------------------------
 size_t vtkDataCompressor::Compress(unsigned char const* uncompressedData, size_t uncompressedSize,
   unsigned char* compressedData, size_t compressionSpace)
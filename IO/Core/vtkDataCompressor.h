@@ -88,6 +88,14 @@ public:
   virtual void SetCompressionLevel(int compressionLevel) = 0;
   virtual int GetCompressionLevel() = 0;
 
+  /**
+   * Copy the settings of another compressor of the same type, such as its
+   * compression level, but none of its compression state. This is used to
+   * set up one compressor per thread. Subclasses with settings that
+   * GetCompressionLevel() does not fully describe must override it.
+   */
+  virtual void CopyParameters(vtkDataCompressor* other);
+
 protected:
   vtkDataCompressor();
   ~vtkDataCompressor() override;
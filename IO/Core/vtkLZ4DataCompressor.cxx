@@ -96,4 +96,17 @@ size_t vtkLZ4DataCompressor::GetMaximumCompressionSpace(size_t size)
 {
   return LZ4_COMPRESSBOUND(size);
 }
+
+//------------------------------------------------------------------------------
+void vtkLZ4DataCompressor::CopyParameters(vtkDataCompressor* other)
+{
+  if (auto lz4 = vtkLZ4DataCompressor::SafeDownCast(other))
+  {
+    this->SetAccelerationLevel(lz4->AccelerationLevel);
+  }
+  else
+  {
+    this->Superclass::CopyParameters(other);
+  }
+}
 VTK_ABI_NAMESPACE_END
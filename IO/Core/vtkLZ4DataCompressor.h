@@ -43,6 +43,12 @@ public:
   vtkSetClampMacro(AccelerationLevel, int, 1, VTK_INT_MAX);
   vtkGetMacro(AccelerationLevel, int);
 
+  /**
+   * Copy the acceleration level of another vtkLZ4DataCompressor, which may
+   * be outside of the range that the compression level maps to.
+   */
+  void CopyParameters(vtkDataCompressor* other) override;
+
 protected:
   vtkLZ4DataCompressor();
   ~vtkLZ4DataCompressor() override;
@@ -138,4 +138,17 @@ size_t vtkLZMADataCompressor::GetMaximumCompressionSpace(size_t size)
 {
   return static_cast<size_t>(size + (size >> 2) + 128);
 }
+
+//------------------------------------------------------------------------------
+void vtkLZMADataCompressor::CopyParameters(vtkDataCompressor* other)
+{
+  if (auto lzma = vtkLZMADataCompressor::SafeDownCast(other))
+  {
+    this->SetCompressionLevel(lzma->CompressionLevel);
+  }
+  else
+  {
+    this->Superclass::CopyParameters(other);
+  }
+}
 VTK_ABI_NAMESPACE_END
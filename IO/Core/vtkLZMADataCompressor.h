@@ -45,6 +45,11 @@ public:
   // Compression level getter required by vtkDataCompressor.
   int GetCompressionLevel() override;
 
+  /**
+   * Copy the compression level of another vtkLZMADataCompressor.
+   */
+  void CopyParameters(vtkDataCompressor* other) override;
+
 protected:
   vtkLZMADataCompressor();
   ~vtkLZMADataCompressor() override;
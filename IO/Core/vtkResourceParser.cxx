@@ -18,7 +18,9 @@ class vtkResourceParser::vtkInternals
 {
 public:
   static constexpr std::size_t BufferTail = 256;
-  static constexpr std::size_t BufferSize = 512;
+  // Large enough so that refilling the range, which moves the tail and calls
+  // the stream, is rare compared to the number of parsed values.
+  static constexpr std::size_t BufferSize = 65536;
   static_assert(BufferSize >= BufferTail, "BufferSize must be at least BufferTail");
 
   void SetStream(vtkResourceStream* stream)
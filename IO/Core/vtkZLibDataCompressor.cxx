@@ -100,4 +100,17 @@ size_t vtkZLibDataCompressor::GetMaximumCompressionSpace(size_t size)
   // ZLib specifies that destination buffer must be 0.1% larger + 12 bytes.
   return size + (size + 999) / 1000 + 12;
 }
+
+//------------------------------------------------------------------------------
+void vtkZLibDataCompressor::CopyParameters(vtkDataCompressor* other)
+{
+  if (auto zlib = vtkZLibDataCompressor::SafeDownCast(other))
+  {
+    this->SetCompressionLevel(zlib->CompressionLevel);
+  }
+  else
+  {
+    this->Superclass::CopyParameters(other);
+  }
+}
 VTK_ABI_NAMESPACE_END
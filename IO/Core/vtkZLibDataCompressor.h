@@ -41,6 +41,11 @@ public:
   void SetCompressionLevel(int compressionLevel) override;
   ///@}
 
+  /**
+   * Copy the compression level of another vtkZLibDataCompressor.
+   */
+  void CopyParameters(vtkDataCompressor* other) override;
+
 protected:
   vtkZLibDataCompressor();
   ~vtkZLibDataCompressor() override;
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <array>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+namespace
+{
+// Zstandard levels matching the vtkDataCompressor levels 1..9.
+constexpr std::array<int, 9> ZstdLevels = { 1, 2, 3, 4, 6, 9, 12, 16, 19 };
+}
+
+struct vtkZstdDataCompressor::vtkInternals
+{
+  ZSTD_CCtx* CompressionContext = nullptr;
+  ZSTD_DCtx* DecompressionContext = nullptr;
+
+  ~vtkInternals()
+  {
+    ZSTD_freeCCtx(this->CompressionContext);
+    ZSTD_freeDCtx(this->DecompressionContext);
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ZstdLevel: " << this->ZstdLevel << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  if (!this->Internals->CompressionContext)
+  {
+    this->Internals->CompressionContext = ZSTD_createCCtx();
+    if (!this->Internals->CompressionContext)
+    {
+      vtkErrorMacro("Cannot create Zstandard compression context.");
+      return 0;
+    }
+  }
+  ZSTD_CCtx* context = this->Internals->CompressionContext;
+  ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, this->ZstdLevel);
+  // Fails if the library is built without multithreading support, in which
+  // case compression is done on the calling thread.
+  ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, this->NumberOfThreads);
+
+  size_t cs = ZSTD_compress2(
+    context, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstandard error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  if (!this->Internals->DecompressionContext)
+  {
+    this->Internals->DecompressionContext = ZSTD_createDCtx();
+    if (!this->Internals->DecompressionContext)
+    {
+      vtkErrorMacro("Cannot create Zstandard decompression context.");
+      return 0;
+    }
+  }
+
+  size_t us = ZSTD_decompressDCtx(this->Internals->DecompressionContext, uncompressedData,
+    uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstandard error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  // Return the smallest level giving at least the current Zstandard level.
+  auto it = std::lower_bound(::ZstdLevels.begin(), ::ZstdLevels.end(), this->ZstdLevel);
+  int level = static_cast<int>(std::min<std::ptrdiff_t>(it - ::ZstdLevels.begin(), 8)) + 1;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << level);
+  return level;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  // In order to make an intuitive interface for vtkDataCompressor objects
+  // we accept compressionLevel values 1..9. 1 is fastest, 9 is slowest
+  // 1 is worst compression, 9 is best compression.
+  compressionLevel = std::min(std::max(compressionLevel, 1), 9);
+  this->SetZstdLevel(::ZstdLevels[compressionLevel - 1]);
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::CopyParameters(vtkDataCompressor* other)
+{
+  if (auto zstd = vtkZstdDataCompressor::SafeDownCast(other))
+  {
+    this->SetZstdLevel(zstd->ZstdLevel);
+    this->SetNumberOfThreads(zstd->NumberOfThreads);
+  }
+  else
+  {
+    this->Superclass::CopyParameters(other);
+  }
+}
+VTK_ABI_NAMESPACE_END
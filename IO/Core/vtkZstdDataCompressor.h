@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard for compressing and uncompressing data. Zstandard
+ * compresses about as well as ZLib while being several times faster,
+ * both for compression and decompression.
+ *
+ * The compressed buffers are standard Zstandard frames.
+ *
+ * This class is available only if VTK is built with VTK_USE_ZSTD.
+ *
+ * @warning
+ * Compression and decompression contexts are kept between calls, so an
+ * instance must not be used by several threads at once. Use one instance
+ * per thread instead.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  ///@{
+  /**
+   * Get/Set the compression level, between 1 (fastest) and 9 (best
+   * compression). Levels are mapped to Zstandard levels 1 to 19.
+   * Default is 5, which maps to Zstandard level 6.
+   */
+  int GetCompressionLevel() override;
+  void SetCompressionLevel(int compressionLevel) override;
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the Zstandard compression level directly, between 1 and 22.
+   * Levels above 19 use much more memory.
+   */
+  vtkSetClampMacro(ZstdLevel, int, 1, 22);
+  vtkGetMacro(ZstdLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of threads used by Zstandard to compress a buffer.
+   * With more than one thread, large buffers are split into jobs compressed
+   * concurrently; the result is still a single frame. This requires a
+   * Zstandard library built with multithreading support, otherwise
+   * compression is done on the calling thread.
+   * Default is 0, compression on the calling thread.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, 256);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  /**
+   * Copy the Zstandard level and the number of threads of another vtkZstdDataCompressor.
+   */
+  void CopyParameters(vtkDataCompressor* other) override;
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int ZstdLevel = 6;
+  int NumberOfThreads = 0;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the points read by vtkEnSightGoldBinaryReader for unstructured and
+// structured parts, and that a geometry file with truncated coordinates is
+// reported as an error.
+
+#include "vtkCommand.h"
+#include "vtkEnSightGoldBinaryReader.h"
+#include "vtkExecutive.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int Dimensions[3] = { 4, 3, 2 };
+constexpr int NumberOfStructuredPoints = Dimensions[0] * Dimensions[1] * Dimensions[2];
+constexpr int NumberOfUnstructuredPoints = 5;
+
+//------------------------------------------------------------------------------
+std::array<float, 3> UnstructuredPoint(int i)
+{
+  return { 0.25f * i, 1.0f / (i + 1), -3.5f + 0.125f * i * i };
+}
+
+//------------------------------------------------------------------------------
+std::array<float, 3> StructuredPoint(int i)
+{
+  const int x = i % Dimensions[0];
+  const int y = (i / Dimensions[0]) % Dimensions[1];
+  const int z = i / (Dimensions[0] * Dimensions[1]);
+  return { x + 0.01f * y, y - 0.001f * z, 2.0f * z + 0.1f * x };
+}
+
+//------------------------------------------------------------------------------
+class GeometryFile
+{
+public:
+  explicit GeometryFile(const std::string& fileName)
+    : Stream(fileName, std::ios::binary)
+  {
+  }
+
+  void Line(const char* line)
+  {
+    char buffer[80] = {};
+    std::strncpy(buffer, line, sizeof(buffer) - 1);
+    this->Stream.write(buffer, sizeof(buffer));
+  }
+
+  void Int(int value) { this->Stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+  void Floats(const std::vector<float>& values)
+  {
+    this->Stream.write(
+      reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  }
+
+private:
+  std::ofstream Stream;
+};
+
+//------------------------------------------------------------------------------
+// Write coordinates component by component, the last one only partially when truncated.
+void WriteCoordinates(GeometryFile& geometry, int numberOfPoints,
+  std::array<float, 3> (*point)(int), bool truncated)
+{
+  for (int component = 0; component < 3; ++component)
+  {
+    std::vector<float> values;
+    const int count = truncated && component == 2 ? numberOfPoints / 2 : numberOfPoints;
+    for (int i = 0; i < count; ++i)
+    {
+      values.push_back(point(i)[component]);
+    }
+    geometry.Floats(values);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Write a case file and a binary geometry file with an unstructured part of
+// triangles and a structured block part.
+std::string WriteDataSet(const std::string& directory, const std::string& name,
+  bool truncateUnstructured, bool truncateStructured)
+{
+  const std::string caseFileName = directory + "/" + name + ".case";
+  std::ofstream caseFile(caseFileName);
+  caseFile << "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: " << name << ".geo\n";
+  caseFile.close();
+
+  GeometryFile geometry(directory + "/" + name + ".geo");
+  geometry.Line("C Binary");
+  geometry.Line("Coordinates test");
+  geometry.Line("Written by TestEnSightGoldBinaryCoordinates");
+  geometry.Line("node id off");
+  geometry.Line("element id off");
+
+  geometry.Line("part");
+  geometry.Int(1);
+  geometry.Line("unstructured");
+  geometry.Line("coordinates");
+  geometry.Int(NumberOfUnstructuredPoints);
+  ::WriteCoordinates(
+    geometry, NumberOfUnstructuredPoints, ::UnstructuredPoint, truncateUnstructured);
+  if (truncateUnstructured)
+  {
+    return caseFileName;
+  }
+  geometry.Line("tria3");
+  geometry.Int(3);
+  for (int triangle = 0; triangle < 3; ++triangle)
+  {
+    geometry.Int(triangle + 1);
+    geometry.Int(triangle + 2);
+    geometry.Int(triangle + 3);
+  }
+
+  geometry.Line("part");
+  geometry.Int(2);
+  geometry.Line("structured");
+  geometry.Line("block");
+  geometry.Int(Dimensions[0]);
+  geometry.Int(Dimensions[1]);
+  geometry.Int(Dimensions[2]);
+  ::WriteCoordinates(geometry, NumberOfStructuredPoints, ::StructuredPoint, truncateStructured);
+  return caseFileName;
+}
+
+//------------------------------------------------------------------------------
+bool CheckPoints(vtkPointSet* part, int numberOfPoints, std::array<float, 3> (*point)(int))
+{
+  if (!part || part->GetNumberOfPoints() != numberOfPoints)
+  {
+    vtkLog(ERROR, "Wrong number of points.");
+    return false;
+  }
+  for (int i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    part->GetPoint(i, x);
+    const std::array<float, 3> expected = point(i);
+    if (x[0] != expected[0] || x[1] != expected[1] || x[2] != expected[2])
+    {
+      vtkLog(ERROR,
+        "Wrong point " << i << ": (" << x[0] << ", " << x[1] << ", " << x[2] << ") instead of ("
+                       << expected[0] << ", " << expected[1] << ", " << expected[2] << ")");
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestTruncated(const std::string& caseFileName)
+{
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  vtkNew<vtkTest::ErrorObserver> executiveErrorObserver;
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetCaseFileName(caseFileName.c_str());
+  reader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  reader->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, executiveErrorObserver);
+  reader->Update();
+  if (errorObserver->CheckErrorMessage("Could not read the coordinates") != 0)
+  {
+    vtkLog(ERROR, "Truncated coordinates of " << caseFileName << " were not reported.");
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestEnSightGoldBinaryCoordinates(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetCaseFileName(
+    ::WriteDataSet(tempDir, "TestEnSightGoldBinaryCoordinates", false, false).c_str());
+  reader->Update();
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  if (!output || output->GetNumberOfBlocks() != 2)
+  {
+    vtkLog(ERROR, "Expected two parts.");
+    return EXIT_FAILURE;
+  }
+  auto unstructured = vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0));
+  auto structured = vtkStructuredGrid::SafeDownCast(output->GetBlock(1));
+  if (!::CheckPoints(unstructured, NumberOfUnstructuredPoints, ::UnstructuredPoint) ||
+    !::CheckPoints(structured, NumberOfStructuredPoints, ::StructuredPoint))
+  {
+    return EXIT_FAILURE;
+  }
+  if (unstructured->GetNumberOfCells() != 3)
+  {
+    vtkLog(ERROR, "Expected 3 triangles.");
+    return EXIT_FAILURE;
+  }
+
+  if (!::TestTruncated(
+        ::WriteDataSet(tempDir, "TestEnSightGoldBinaryCoordinates_ug", true, false)) ||
+    !::TestTruncated(::WriteDataSet(tempDir, "TestEnSightGoldBinaryCoordinates_sg", false, true)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -12,7 +12,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkPoints.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
@@ -1227,7 +1229,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   char line[80];
   vtkIdType i;
   int* pointIds;
-  float *xCoords, *yCoords, *zCoords;
   vtkPoints* points = vtkPoints::New();
   vtkPolyData* pd = vtkPolyData::New();
 
@@ -1322,10 +1323,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   this->ReadInt(&this->NumberOfMeasuredPoints);
 
   pointIds = new int[this->NumberOfMeasuredPoints];
-  xCoords = new float[this->NumberOfMeasuredPoints];
-  yCoords = new float[this->NumberOfMeasuredPoints];
-  zCoords = new float[this->NumberOfMeasuredPoints];
-  points->Reserve(this->NumberOfMeasuredPoints);
   pd->AllocateEstimate(this->NumberOfMeasuredPoints, 1);
 
   // Extract the array of point indices. Note EnSight Manual v8.2 (pp. 559,
@@ -1338,27 +1335,23 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   this->ReadIntArray(pointIds, this->NumberOfMeasuredPoints);
 
   // Read point coordinates tuple by tuple while each tuple contains three
-  // components: (x-cord, y-cord, z-cord)
-  int floatSize = sizeof(float);
-  for (i = 0; i < this->NumberOfMeasuredPoints; i++)
-  {
-    this->GoldIFile->read((char*)(xCoords + i), floatSize);
-    this->GoldIFile->read((char*)(yCoords + i), floatSize);
-    this->GoldIFile->read((char*)(zCoords + i), floatSize);
-  }
+  // components: (x-cord, y-cord, z-cord). They are already interleaved as
+  // vtkPoints expects them, so read them at once in the points array.
+  vtkNew<vtkFloatArray> coords;
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(this->NumberOfMeasuredPoints);
+  this->GoldIFile->read(reinterpret_cast<char*>(coords->GetPointer(0)),
+    sizeof(float) * 3 * this->NumberOfMeasuredPoints);
 
   if (this->ByteOrder == FILE_LITTLE_ENDIAN)
   {
-    vtkByteSwap::Swap4LERange(xCoords, this->NumberOfMeasuredPoints);
-    vtkByteSwap::Swap4LERange(yCoords, this->NumberOfMeasuredPoints);
-    vtkByteSwap::Swap4LERange(zCoords, this->NumberOfMeasuredPoints);
+    vtkByteSwap::Swap4LERange(coords->GetPointer(0), 3 * this->NumberOfMeasuredPoints);
   }
   else
   {
-    vtkByteSwap::Swap4BERange(xCoords, this->NumberOfMeasuredPoints);
-    vtkByteSwap::Swap4BERange(yCoords, this->NumberOfMeasuredPoints);
-    vtkByteSwap::Swap4BERange(zCoords, this->NumberOfMeasuredPoints);
+    vtkByteSwap::Swap4BERange(coords->GetPointer(0), 3 * this->NumberOfMeasuredPoints);
   }
+  points->SetData(coords);
 
   // NOTE: EnSight always employs a 1-based indexing scheme and therefore
   // 'if (this->ParticleCoordinatesByIndex)' was removed here. Otherwise
@@ -1366,7 +1359,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   // This bug was noticed while fixing bug #7453.
   for (i = 0; i < this->NumberOfMeasuredPoints; i++)
   {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
     pd->InsertNextCell(VTK_VERTEX, 1, &i);
   }
 
@@ -1376,9 +1368,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   points->Delete();
   pd->Delete();
   delete[] pointIds;
-  delete[] xCoords;
-  delete[] yCoords;
-  delete[] zCoords;
 
   delete this->GoldIFile;
   this->GoldIFile = nullptr;
@@ -1883,7 +1872,6 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
   vtkIdType i, j;
   vtkIdType numElements, cellId;
   int idx, cellType;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -1926,33 +1914,20 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
         return -1;
       }
 
-      vtkPoints* points = vtkPoints::New();
+      vtkNew<vtkPoints> points;
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Reserve(numPts);
-
       if (this->NodeIdsListed)
       {
         this->GoldIFile->seekg(sizeof(int) * numPts + this->FortranSkipBytes, ios::cur);
       }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
+      if (!this->ReadCoordinates(points, numPts))
       {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+        vtkErrorMacro("Could not read the coordinates of the unstructured points.");
+        return -1;
       }
-
       output->SetPoints(points);
-      points->Delete();
-      delete[] xCoords;
-      delete[] yCoords;
-      delete[] zCoords;
     }
     else if (strncmp(line, "point", 5) == 0)
     {
@@ -2918,9 +2893,8 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   int iblanked = 0;
   int dimensions[3];
   int i;
-  vtkPoints* points = vtkPoints::New();
+  vtkNew<vtkPoints> points;
   int numPts;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -2959,22 +2933,13 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     static_cast<unsigned int>(numPts * this->SizeOfInt) > this->FileSize)
   {
     vtkErrorMacro("Invalid dimensions read; check that ByteOrder is set correctly.");
-    points->Delete();
     return -1;
   }
   output->SetDimensions(dimensions);
-  points->Reserve(numPts);
-
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
+  if (!this->ReadCoordinates(points, numPts))
   {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+    vtkErrorMacro("Could not read the coordinates of the structured points.");
+    return -1;
   }
   output->SetPoints(points);
   if (iblanked)
@@ -2991,11 +2956,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     }
   }
 
-  points->Delete();
-  delete[] xCoords;
-  delete[] yCoords;
-  delete[] zCoords;
-
   this->GoldIFile->peek();
   if (this->GoldIFile->eof())
   {
@@ -3032,11 +2992,9 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
   int lineRead;
   int iblanked = 0;
   int dimensions[3];
-  int i;
   vtkFloatArray* xCoords = vtkFloatArray::New();
   vtkFloatArray* yCoords = vtkFloatArray::New();
   vtkFloatArray* zCoords = vtkFloatArray::New();
-  float* tempCoords;
   int numPts;
 
   this->NumberOfNewOutputs++;
@@ -3085,31 +3043,12 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
   }
 
   output->SetDimensions(dimensions);
-  xCoords->ReserveValues(dimensions[0]);
-  yCoords->ReserveValues(dimensions[1]);
-  zCoords->ReserveValues(dimensions[2]);
-
-  tempCoords = new float[dimensions[0]];
-  this->ReadFloatArray(tempCoords, dimensions[0]);
-  for (i = 0; i < dimensions[0]; i++)
-  {
-    xCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete[] tempCoords;
-  tempCoords = new float[dimensions[1]];
-  this->ReadFloatArray(tempCoords, dimensions[1]);
-  for (i = 0; i < dimensions[1]; i++)
-  {
-    yCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete[] tempCoords;
-  tempCoords = new float[dimensions[2]];
-  this->ReadFloatArray(tempCoords, dimensions[2]);
-  for (i = 0; i < dimensions[2]; i++)
-  {
-    zCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete[] tempCoords;
+  xCoords->SetNumberOfValues(dimensions[0]);
+  yCoords->SetNumberOfValues(dimensions[1]);
+  zCoords->SetNumberOfValues(dimensions[2]);
+  this->ReadFloatArray(xCoords->GetPointer(0), dimensions[0]);
+  this->ReadFloatArray(yCoords->GetPointer(0), dimensions[1]);
+  this->ReadFloatArray(zCoords->GetPointer(0), dimensions[2]);
   if (iblanked)
   {
     vtkWarningMacro("VTK does not handle blanking for rectilinear grids.");
@@ -3502,6 +3441,39 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float* result, vtkIdType numFloat
   return 1;
 }
 
+// Internal function to read the coordinates of points stored component by
+// component. Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadCoordinates(vtkPoints* points, vtkIdType numPts)
+{
+  std::vector<float> buffer(3 * static_cast<size_t>(numPts));
+  const float* xCoords = buffer.data();
+  const float* yCoords = xCoords + numPts;
+  const float* zCoords = yCoords + numPts;
+  if (!this->ReadFloatArray(buffer.data(), numPts) ||
+    !this->ReadFloatArray(buffer.data() + numPts, numPts) ||
+    !this->ReadFloatArray(buffer.data() + 2 * numPts, numPts))
+  {
+    return 0;
+  }
+
+  vtkNew<vtkFloatArray> coords;
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(numPts);
+  float* interleaved = coords->GetPointer(0);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        interleaved[3 * i] = xCoords[i];
+        interleaved[3 * i + 1] = yCoords[i];
+        interleaved[3 * i + 2] = zCoords[i];
+      }
+    });
+  points->SetData(coords);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
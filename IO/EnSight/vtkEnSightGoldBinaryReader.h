@@ -33,6 +33,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkMultiBlockDataSet;
+class vtkPoints;
 
 class VTKIOENSIGHT_EXPORT vtkEnSightGoldBinaryReader : public vtkEnSightReader
 {
@@ -192,6 +193,13 @@ protected:
    */
   int ReadFloatArray(float* result, vtkIdType numFloats);
 
+  /**
+   * Internal function to read the x, y and z coordinate blocks of numPts
+   * points and store them interleaved in points.
+   * Returns zero if there was an error.
+   */
+  int ReadCoordinates(vtkPoints* points, vtkIdType numPts);
+
   /**
    * Counts the number of timesteps in the geometry file
    * This function assumes the file is already open and returns the
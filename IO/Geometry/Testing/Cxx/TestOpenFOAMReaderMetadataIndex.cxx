@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that a metadata index written after scanning a case gives the same
+// time steps, selections and output when it is reused by another reader, that
+// it is not reused when the settings of the reader change, when the reader is
+// refreshed or when a time directory is modified, and that it is rewritten
+// after a new scan.
+
+#include "vtkDataArraySelection.h"
+#include "vtkInformation.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_nlohmannjson.h"
+#include VTK_NLOHMANN_JSON(json.hpp)
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+int GetNumberOfTimeSteps(vtkOpenFOAMReader* reader)
+{
+  return reader->GetOutputInformation(0)->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+}
+
+//------------------------------------------------------------------------------
+double GetLastTimeStep(vtkOpenFOAMReader* reader)
+{
+  return reader->GetOutputInformation(0)->Get(
+    vtkStreamingDemandDrivenPipeline::TIME_STEPS(), ::GetNumberOfTimeSteps(reader) - 1);
+}
+
+//------------------------------------------------------------------------------
+nlohmann::json ReadIndex(const std::string& indexFileName)
+{
+  vtksys::ifstream file(indexFileName.c_str());
+  return nlohmann::json::parse(file);
+}
+
+//------------------------------------------------------------------------------
+void WriteIndex(const std::string& indexFileName, const nlohmann::json& index)
+{
+  vtksys::ofstream file(indexFileName.c_str());
+  file << index.dump();
+}
+
+//------------------------------------------------------------------------------
+bool SameSelection(vtkDataArraySelection* expected, vtkDataArraySelection* actual)
+{
+  if (expected->GetNumberOfArrays() != actual->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    if (actual->ArrayIsEnabled(expected->GetArrayName(i)) !=
+      expected->ArrayIsEnabled(expected->GetArrayName(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestOpenFOAMReaderMetadataIndex(int argc, char* argv[])
+{
+  char* fileNameCStr =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/OpenFOAM/cavity/cavity.foam");
+  const std::string dataFileName(fileNameCStr);
+  delete[] fileNameCStr;
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+  const std::string indexFileName = tempDir + "/TestOpenFOAMReaderMetadataIndex.json";
+  vtksys::SystemTools::RemoveFile(indexFileName);
+
+  // Work on a copy of the case, whose time directories are touched below.
+  const std::string caseDir = tempDir + "/TestOpenFOAMReaderMetadataIndex";
+  vtksys::SystemTools::RemoveADirectory(caseDir);
+  if (!vtksys::SystemTools::CopyADirectory(
+        vtksys::SystemTools::GetFilenamePath(dataFileName), caseDir))
+  {
+    vtkLog(ERROR, "Cannot copy the case to " << caseDir);
+    return EXIT_FAILURE;
+  }
+  const std::string fileName = caseDir + "/cavity.foam";
+
+  // The first reader scans the case and writes the index.
+  vtkNew<vtkOpenFOAMReader> scanReader;
+  scanReader->SetFileName(fileName.c_str());
+  scanReader->SetMetadataIndexFileName(indexFileName.c_str());
+  scanReader->UpdateInformation();
+  if (!vtksys::SystemTools::FileExists(indexFileName, true))
+  {
+    vtkLog(ERROR, "The metadata index was not written.");
+    return EXIT_FAILURE;
+  }
+
+  // The second reader restores the information from the index.
+  vtkNew<vtkOpenFOAMReader> indexReader;
+  indexReader->SetFileName(fileName.c_str());
+  indexReader->SetMetadataIndexFileName(indexFileName.c_str());
+  indexReader->UpdateInformation();
+  if (::GetNumberOfTimeSteps(indexReader) != ::GetNumberOfTimeSteps(scanReader) ||
+    !::SameSelection(scanReader->GetPatchDataArraySelection(),
+      indexReader->GetPatchDataArraySelection()) ||
+    !::SameSelection(
+      scanReader->GetCellDataArraySelection(), indexReader->GetCellDataArraySelection()) ||
+    !::SameSelection(
+      scanReader->GetPointDataArraySelection(), indexReader->GetPointDataArraySelection()))
+  {
+    vtkLog(ERROR, "The information restored from the index differs from the scanned one.");
+    return EXIT_FAILURE;
+  }
+
+  for (int step = 0; step < ::GetNumberOfTimeSteps(scanReader); ++step)
+  {
+    const double time = scanReader->GetOutputInformation(0)->Get(
+      vtkStreamingDemandDrivenPipeline::TIME_STEPS(), step);
+    scanReader->UpdateTimeStep(time);
+    indexReader->UpdateTimeStep(time);
+    if (!vtkTestUtilities::CompareDataObjects(scanReader->GetOutput(), indexReader->GetOutput()))
+    {
+      vtkLog(ERROR, "Output differs for time " << time);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Prove that the index is used: a time value edited in the index is reported.
+  const double lastTime = ::GetLastTimeStep(scanReader);
+  nlohmann::json index = ::ReadIndex(indexFileName);
+  index["timeValues"].back() = lastTime + 100.0;
+  ::WriteIndex(indexFileName, index);
+  vtkNew<vtkOpenFOAMReader> editedReader;
+  editedReader->SetFileName(fileName.c_str());
+  editedReader->SetMetadataIndexFileName(indexFileName.c_str());
+  editedReader->UpdateInformation();
+  if (::GetLastTimeStep(editedReader) != lastTime + 100.0)
+  {
+    vtkLog(ERROR, "The time values should be read from the index.");
+    return EXIT_FAILURE;
+  }
+
+  // A refresh scans the case again and rewrites the index.
+  editedReader->SetRefresh();
+  editedReader->UpdateInformation();
+  if (::GetLastTimeStep(editedReader) != lastTime ||
+    ::ReadIndex(indexFileName)["timeValues"].back().get<double>() != lastTime)
+  {
+    vtkLog(ERROR, "A refresh should ignore and rewrite the index.");
+    return EXIT_FAILURE;
+  }
+
+  // Touching a time directory invalidates the index, which is rebuilt.
+  index = ::ReadIndex(indexFileName);
+  index["timeValues"].back() = lastTime + 100.0;
+  ::WriteIndex(indexFileName, index);
+  const std::string timeDir = caseDir + "/" + index["timeNames"].back().get<std::string>();
+  const long int timeDirMTime = vtksys::SystemTools::ModifiedTime(timeDir);
+  while (vtksys::SystemTools::ModifiedTime(timeDir) == timeDirMTime)
+  {
+    // modification times are compared with a resolution of one second
+    vtksys::SystemTools::Delay(100);
+    vtksys::SystemTools::Touch(timeDir, false);
+  }
+  vtkNew<vtkOpenFOAMReader> touchedReader;
+  touchedReader->SetFileName(fileName.c_str());
+  touchedReader->SetMetadataIndexFileName(indexFileName.c_str());
+  touchedReader->UpdateInformation();
+  if (::GetLastTimeStep(touchedReader) != lastTime ||
+    ::ReadIndex(indexFileName)["timeValues"].back().get<double>() != lastTime)
+  {
+    vtkLog(ERROR, "The index should be rebuilt when a time directory is modified.");
+    return EXIT_FAILURE;
+  }
+
+  // Skipping the zero time changes the time steps, so the index must not be reused.
+  vtkNew<vtkOpenFOAMReader> skipZeroReader;
+  skipZeroReader->SetFileName(fileName.c_str());
+  skipZeroReader->SetMetadataIndexFileName(indexFileName.c_str());
+  skipZeroReader->SkipZeroTimeOn();
+  skipZeroReader->UpdateInformation();
+  if (::GetNumberOfTimeSteps(skipZeroReader) != ::GetNumberOfTimeSteps(scanReader) - 1)
+  {
+    vtkLog(ERROR, "The index should not be reused with different settings.");
+    return EXIT_FAILURE;
+  }
+
+  vtksys::SystemTools::RemoveFile(indexFileName);
+  vtksys::SystemTools::RemoveADirectory(caseDir);
+  return EXIT_SUCCESS;
+}
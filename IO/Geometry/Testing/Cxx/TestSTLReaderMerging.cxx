@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel merging of coincident points done by default gives
+// the same points and triangles as merging with a vtkMergePoints locator, for
+// binary and ASCII files, and that it is not used when the default locator is
+// overridden.
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Merge points locator counting the points inserted in it.
+class vtkCountingMergePoints : public vtkMergePoints
+{
+public:
+  vtkTypeMacro(vtkCountingMergePoints, vtkMergePoints);
+  static vtkCountingMergePoints* New() { VTK_STANDARD_NEW_BODY(vtkCountingMergePoints); }
+
+  int InsertUniquePoint(const double x[3], vtkIdType& ptId) override
+  {
+    ++NumberOfInsertions;
+    return this->Superclass::InsertUniquePoint(x, ptId);
+  }
+
+  static vtkIdType NumberOfInsertions;
+
+protected:
+  vtkCountingMergePoints() = default;
+  ~vtkCountingMergePoints() override = default;
+
+private:
+  vtkCountingMergePoints(const vtkCountingMergePoints&) = delete;
+  void operator=(const vtkCountingMergePoints&) = delete;
+};
+
+vtkIdType vtkCountingMergePoints::NumberOfInsertions = 0;
+
+//------------------------------------------------------------------------------
+// Reader overriding its default locator.
+class vtkCountingSTLReader : public vtkSTLReader
+{
+public:
+  vtkTypeMacro(vtkCountingSTLReader, vtkSTLReader);
+  static vtkCountingSTLReader* New() { VTK_STANDARD_NEW_BODY(vtkCountingSTLReader); }
+
+protected:
+  vtkCountingSTLReader() = default;
+  ~vtkCountingSTLReader() override = default;
+
+  vtkIncrementalPointLocator* NewDefaultLocator() override
+  {
+    return vtkCountingMergePoints::New();
+  }
+
+private:
+  vtkCountingSTLReader(const vtkCountingSTLReader&) = delete;
+  void operator=(const vtkCountingSTLReader&) = delete;
+};
+
+//------------------------------------------------------------------------------
+bool SamePolyData(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != actual->GetNumberOfPolys())
+  {
+    vtkLog(ERROR,
+      "Expected " << expected->GetNumberOfPoints() << " points and "
+                  << expected->GetNumberOfPolys() << " triangles, got "
+                  << actual->GetNumberOfPoints() << " and " << actual->GetNumberOfPolys());
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    double y[3];
+    expected->GetPoint(i, x);
+    actual->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      vtkLog(ERROR, "Wrong point " << i);
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType i = 0; i < expected->GetNumberOfPolys(); ++i)
+  {
+    expected->GetPolys()->GetCellAtId(i, expectedIds);
+    actual->GetPolys()->GetCellAtId(i, actualIds);
+    if (actualIds->GetNumberOfIds() != 3 || expectedIds->GetId(0) != actualIds->GetId(0) ||
+      expectedIds->GetId(1) != actualIds->GetId(1) || expectedIds->GetId(2) != actualIds->GetId(2))
+    {
+      vtkLog(ERROR, "Wrong triangle " << i);
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestMerging(const std::string& fileName, bool binary, vtkPolyData* input)
+{
+  vtkLogScopeF(INFO, "TestMerging %s", binary ? "binary" : "ASCII");
+
+  vtkNew<vtkSTLWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileName(fileName.c_str());
+  writer->SetFileType(binary ? VTK_BINARY : VTK_ASCII);
+  writer->Write();
+
+  vtkNew<vtkSTLReader> parallelReader;
+  parallelReader->SetFileName(fileName.c_str());
+  parallelReader->Update();
+
+  vtkNew<vtkSTLReader> locatorReader;
+  locatorReader->SetFileName(fileName.c_str());
+  vtkNew<vtkMergePoints> locator;
+  locatorReader->SetLocator(locator);
+  locatorReader->Update();
+
+  vtkNew<vtkSTLReader> soupReader;
+  soupReader->SetFileName(fileName.c_str());
+  soupReader->MergingOff();
+  soupReader->Update();
+  if (soupReader->GetOutput()->GetNumberOfPoints() != 3 * input->GetNumberOfPolys())
+  {
+    vtkLog(ERROR, "Each triangle should have its own points when merging is off.");
+    return false;
+  }
+
+  // The degenerate triangle is removed.
+  if (parallelReader->GetOutput()->GetNumberOfPolys() != input->GetNumberOfPolys() - 1)
+  {
+    vtkLog(ERROR, "Degenerate triangle should be removed.");
+    return false;
+  }
+
+  if (!::SamePolyData(locatorReader->GetOutput(), parallelReader->GetOutput()))
+  {
+    return false;
+  }
+
+  // The locator of an override of NewDefaultLocator is used.
+  vtkCountingMergePoints::NumberOfInsertions = 0;
+  vtkNew<vtkCountingSTLReader> overrideReader;
+  overrideReader->SetFileName(fileName.c_str());
+  overrideReader->Update();
+  if (vtkCountingMergePoints::NumberOfInsertions != 3 * input->GetNumberOfPolys())
+  {
+    vtkLog(ERROR,
+      "The default locator override got " << vtkCountingMergePoints::NumberOfInsertions
+                                          << " points instead of "
+                                          << 3 * input->GetNumberOfPolys());
+    return false;
+  }
+
+  return ::SamePolyData(locatorReader->GetOutput(), overrideReader->GetOutput());
+}
+}
+
+//------------------------------------------------------------------------------
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+
+  // Add a triangle which becomes degenerate once its points are merged.
+  const vtkIdType degenerate[3] = { 10, 10, 11 };
+  input->GetPolys()->InsertNextCell(3, degenerate);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestSTLReaderMerging.stl";
+  delete[] tempDir;
+
+  return (::TestMerging(fileName, true, input) && ::TestMerging(fileName, false, input))
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
@@ -177,6 +177,7 @@
 #include "vtkDataObjectTreeRange.h"
 #include "vtkDirectory.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -200,9 +201,13 @@
 #include "vtkTypeInt64Array.h"
 #include "vtkTypeInt8Array.h"
 #include "vtkTypeTraits.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "vtk_nlohmannjson.h"
+#include VTK_NLOHMANN_JSON(json.hpp)
 #include "vtk_zlib.h"
+#include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 #include "vtksys/SystemTools.hxx"
 
@@ -11215,6 +11220,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   // initialize file name
   this->FileName = nullptr;
+  this->MetadataIndexFileName = nullptr;
 
   // Case path
   this->CasePath = vtkCharArray::New();
@@ -11281,6 +11287,7 @@ vtkOpenFOAMReader::~vtkOpenFOAMReader()
   this->CasePath->Delete();
 
   this->SetFileName(nullptr);
+  this->SetMetadataIndexFileName(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -11351,6 +11358,8 @@ void vtkOpenFOAMReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CacheMesh: " << this->CacheMesh << endl;
   os << indent << "ReadZones: " << this->ReadZones << endl;
   os << indent << "AddDimensionsToArrayNames: " << this->AddDimensionsToArrayNames << endl;
+  os << indent << "MetadataIndexFileName: "
+     << (this->MetadataIndexFileName ? this->MetadataIndexFileName : "(none)") << endl;
 
   this->PrintTimes(os, indent);
 
@@ -11452,9 +11461,13 @@ int vtkOpenFOAMReader::RequestInformation(vtkInformation* vtkNotUsed(request),
     // vtkPOpenFOAMReader
     this->Readers.clear();
 
-    if (!this->MakeInformationVector(outputVector, {}) || !this->MakeMetaDataAtTimeStep(true))
+    if (!this->MakeInformationVectorFromIndex(outputVector))
     {
-      return 0;
+      if (!this->MakeInformationVector(outputVector, {}) || !this->MakeMetaDataAtTimeStep(true))
+      {
+        return 0;
+      }
+      this->WriteMetadataIndex();
     }
     this->Refresh = false;
   }
@@ -12011,6 +12024,247 @@ void vtkOpenFOAMReader::SetMarshalledMetadataPerReader(
   }
 }
 
+//------------------------------------------------------------------------------
+// Metadata index helpers
+namespace
+{
+// Modification times which must be unchanged for a metadata index to be valid
+nlohmann::json MetadataIndexStamps(
+  const std::string& controlDictPath, const std::string& casePath, vtkStringArray* timeNames)
+{
+  nlohmann::json stamps = nlohmann::json::object();
+  auto addStamp = [&stamps](const std::string& path)
+  { stamps[path] = vtksys::SystemTools::ModifiedTime(path); };
+  addStamp(controlDictPath);
+  addStamp(casePath);
+  addStamp(casePath + "constant");
+  for (vtkIdType timeI = 0; timeI < timeNames->GetNumberOfValues(); ++timeI)
+  {
+    addStamp(casePath + timeNames->GetValue(timeI));
+  }
+  return stamps;
+}
+
+nlohmann::json ToJson(vtkAbstractArray* array)
+{
+  nlohmann::json values = nlohmann::json::array();
+  if (auto* strings = vtkStringArray::SafeDownCast(array))
+  {
+    for (vtkIdType i = 0; i < strings->GetNumberOfValues(); ++i)
+    {
+      values.push_back(strings->GetValue(i));
+    }
+  }
+  else if (auto* numbers = vtkDataArray::SafeDownCast(array))
+  {
+    for (vtkIdType i = 0; i < numbers->GetNumberOfValues(); ++i)
+    {
+      values.push_back(numbers->GetComponent(i / numbers->GetNumberOfComponents(),
+        static_cast<int>(i % numbers->GetNumberOfComponents())));
+    }
+  }
+  return values;
+}
+
+void FromJson(const nlohmann::json& values, vtkStringArray* strings)
+{
+  strings->SetNumberOfValues(static_cast<vtkIdType>(values.size()));
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    strings->SetValue(static_cast<vtkIdType>(i), values[i].get<std::string>());
+  }
+}
+
+template <typename ArrayT>
+void FromJson(const nlohmann::json& values, ArrayT* numbers)
+{
+  numbers->SetNumberOfValues(static_cast<vtkIdType>(values.size()));
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    numbers->SetValue(
+      static_cast<vtkIdType>(i), values[i].get<typename ArrayT::ValueType>());
+  }
+}
+
+nlohmann::json SelectionToJson(vtkDataArraySelection* selection)
+{
+  nlohmann::json entries = nlohmann::json::array();
+  for (int i = 0; i < selection->GetNumberOfArrays(); ++i)
+  {
+    entries.push_back({ selection->GetArrayName(i), selection->GetArraySetting(i) });
+  }
+  return entries;
+}
+
+// Reader settings which change the metadata found when scanning a case
+nlohmann::json MetadataIndexSettings(
+  vtkOpenFOAMReader* parent, const char* fileName, const std::string& procDirName)
+{
+  return { { "version", 1 }, { "fileName", fileName }, { "processor", procDirName },
+    { "skipZeroTime", parent->GetSkipZeroTime() },
+    { "listTimeStepsByControlDict", parent->GetListTimeStepsByControlDict() != 0 },
+    { "ignoreRestartFiles", parent->GetIgnoreRestartFiles() } };
+}
+
+// Only add the names which are not known yet, to keep the current user selection
+void SelectionFromJson(const nlohmann::json& entries, vtkDataArraySelection* selection)
+{
+  for (const auto& entry : entries)
+  {
+    const std::string name = entry[0].get<std::string>();
+    if (!selection->ArrayExists(name.c_str()))
+    {
+      selection->SetArraySetting(name.c_str(), entry[1].get<int>());
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkOpenFOAMReader::MakeInformationVectorFromIndex(
+  vtkInformationVector* outputVector, const vtkStdString& procDirName)
+{
+  // A refresh is an explicit request to scan the case again, the index is then rewritten.
+  const char* indexFileName = this->Parent->GetMetadataIndexFileName();
+  if (this->Parent->Refresh || !indexFileName || !*indexFileName ||
+    !vtksys::SystemTools::FileExists(indexFileName, true))
+  {
+    return false;
+  }
+
+  try
+  {
+    vtksys::ifstream file(indexFileName);
+    const nlohmann::json index = nlohmann::json::parse(file);
+    if (index.at("settings") != MetadataIndexSettings(this->Parent, this->FileName, procDirName))
+    {
+      return false;
+    }
+
+    vtkNew<vtkStringArray> timeNames;
+    vtkNew<vtkDoubleArray> timeValues;
+    FromJson(index.at("timeNames"), timeNames.Get());
+    FromJson(index.at("timeValues"), timeValues.Get());
+    if (timeNames->GetNumberOfValues() == 0 ||
+      timeNames->GetNumberOfValues() != timeValues->GetNumberOfValues())
+    {
+      return false;
+    }
+
+    vtkStdString casePath, controlDictPath;
+    this->CreateCasePath(casePath, controlDictPath);
+    if (!procDirName.empty())
+    {
+      casePath += procDirName + "/";
+    }
+    if (index.at("modifiedTimes") != MetadataIndexStamps(controlDictPath, casePath, timeNames))
+    {
+      vtkDebugMacro(<< "Metadata index " << indexFileName << " is out of date");
+      return false;
+    }
+
+    std::vector<vtkSmartPointer<vtkTable>> fieldNameInfoPerReader;
+    std::vector<vtkSmartPointer<vtkUnsignedCharArray>> fileChecksPerReader;
+    for (const auto& readerEntry : index.at("readers"))
+    {
+      vtkNew<vtkUnsignedCharArray> fileChecks;
+      fileChecks->SetNumberOfComponents(3);
+      FromJson(readerEntry.at("fileChecks"), fileChecks.Get());
+      fileChecksPerReader.emplace_back(fileChecks);
+      vtkNew<vtkTable> fieldNameInfo;
+      for (const auto& names : readerEntry.at("fields"))
+      {
+        vtkNew<vtkStringArray> array;
+        FromJson(names, array.Get());
+        fieldNameInfo->GetFieldData()->AddArray(array);
+      }
+      fieldNameInfoPerReader.emplace_back(fieldNameInfo);
+    }
+    const auto& selections = index.at("selections");
+    const auto& patchSelection = selections.at("patch");
+    const auto& cellSelection = selections.at("cell");
+    const auto& pointSelection = selections.at("point");
+    const auto& lagrangianSelection = selections.at("lagrangian");
+
+    if (!this->MakeInformationVector(
+          outputVector, procDirName, timeNames, timeValues, fileChecksPerReader) ||
+      this->Readers.size() != fieldNameInfoPerReader.size())
+    {
+      this->Readers.clear();
+      return false;
+    }
+
+    SelectionFromJson(patchSelection, this->Parent->PatchDataArraySelection);
+    SelectionFromJson(cellSelection, this->Parent->CellDataArraySelection);
+    SelectionFromJson(pointSelection, this->Parent->PointDataArraySelection);
+    SelectionFromJson(lagrangianSelection, this->Parent->LagrangianDataArraySelection);
+    this->SetMarshalledMetadataPerReader(fieldNameInfoPerReader);
+  }
+  catch (const nlohmann::json::exception& e)
+  {
+    vtkWarningMacro(<< "Ignoring invalid metadata index " << indexFileName << ": " << e.what());
+    this->Readers.clear();
+    return false;
+  }
+
+  return this->MakeMetaDataAtTimeStep(true, /*skipComputingMetaData=*/true) != 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkOpenFOAMReader::WriteMetadataIndex(const vtkStdString& procDirName)
+{
+  const char* indexFileName = this->Parent->GetMetadataIndexFileName();
+  vtkStringArray* timeNames = this->GetTimeNames();
+  vtkDoubleArray* timeValues = this->GetTimeValues();
+  if (!indexFileName || !*indexFileName || !timeNames || !timeValues)
+  {
+    return;
+  }
+
+  vtkStdString casePath, controlDictPath;
+  this->CreateCasePath(casePath, controlDictPath);
+  if (!procDirName.empty())
+  {
+    casePath += procDirName + "/";
+  }
+
+  nlohmann::json index;
+  index["settings"] = MetadataIndexSettings(this->Parent, this->FileName, procDirName);
+  index["modifiedTimes"] = MetadataIndexStamps(controlDictPath, casePath, timeNames);
+  index["timeNames"] = ToJson(timeNames);
+  index["timeValues"] = ToJson(timeValues);
+
+  const auto fieldNameInfoPerReader = this->GetMarshalledMetadataPerReader();
+  const auto fileChecksPerReader = this->GetPopulateMeshIndicesFileChecksPerReader();
+  index["readers"] = nlohmann::json::array();
+  for (size_t i = 0; i < fieldNameInfoPerReader.size(); ++i)
+  {
+    if (!fieldNameInfoPerReader[i] || !fileChecksPerReader[i])
+    {
+      return;
+    }
+    nlohmann::json fields = nlohmann::json::array();
+    vtkFieldData* fieldData = fieldNameInfoPerReader[i]->GetFieldData();
+    for (int arrayI = 0; arrayI < fieldData->GetNumberOfArrays(); ++arrayI)
+    {
+      fields.push_back(ToJson(fieldData->GetAbstractArray(arrayI)));
+    }
+    index["readers"].push_back(
+      { { "fileChecks", ToJson(fileChecksPerReader[i]) }, { "fields", fields } });
+  }
+
+  index["selections"] = { { "patch", SelectionToJson(this->Parent->PatchDataArraySelection) },
+    { "cell", SelectionToJson(this->Parent->CellDataArraySelection) },
+    { "point", SelectionToJson(this->Parent->PointDataArraySelection) },
+    { "lagrangian", SelectionToJson(this->Parent->LagrangianDataArraySelection) } };
+
+  vtksys::ofstream file(indexFileName);
+  if (!(file << index.dump()))
+  {
+    vtkWarningMacro(<< "Cannot write metadata index " << indexFileName);
+  }
+}
+
 //------------------------------------------------------------------------------
 int vtkOpenFOAMReader::MakeMetaDataAtTimeStep(
   const bool listNextTimeStep, const bool skipComputingMetaData)
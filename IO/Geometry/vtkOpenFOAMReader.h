@@ -381,6 +381,24 @@ public:
   vtkBooleanMacro(IgnoreRestartFiles, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get the name of a metadata index file.
+   * When set, the time steps, the mesh layout over time and the field, patch
+   * and cloud names found when scanning the case are saved to this file. Later
+   * updates, and later readers opening the same case, restore them from the
+   * index instead of scanning all the time directories again, as long as the
+   * modification times of controlDict, of the case and constant directories and
+   * of every time directory are unchanged. Changes which do not touch these
+   * modification times, such as a file added to an existing polyMesh
+   * directory, are not detected: call SetRefresh() or remove the index file
+   * to force a new scan.
+   * Default is nullptr, no index is used.
+   */
+  vtkSetFilePathMacro(MetadataIndexFileName);
+  vtkGetFilePathMacro(MetadataIndexFileName);
+  ///@}
+
   void SetRefresh()
   {
     this->Refresh = true;
@@ -409,6 +427,23 @@ public:
 
   int MakeMetaDataAtTimeStep(bool listNextTimeStep, bool skipComputingMetaData = false);
 
+#ifndef __VTK_WRAP__
+  /**
+   * Restore the information and the metadata of the case from the metadata
+   * index of the parent reader. Returns false, without changing the selections,
+   * when there is no index, when it is out of date or when the parent reader
+   * is refreshed.
+   */
+  bool MakeInformationVectorFromIndex(
+    vtkInformationVector*, const vtkStdString& procDirName = vtkStdString());
+
+  /**
+   * Save the information and the metadata of the case in the metadata index
+   * of the parent reader, if any.
+   */
+  void WriteMetadataIndex(const vtkStdString& procDirName = vtkStdString());
+#endif
+
   /**
    * Compute the progress of the reader.
    */
@@ -471,6 +506,7 @@ protected:
   bool CopyDataToCellZones;
 
   char* FileName;
+  char* MetadataIndexFileName;
   vtkCharArray* CasePath;
   std::vector<vtkSmartPointer<vtkObject>> Readers;
 
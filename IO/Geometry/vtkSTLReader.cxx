@@ -8,6 +8,7 @@
 #include "vtkErrorCode.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -17,16 +18,21 @@
 #include "vtkPolyData.h"
 #include "vtkResourceParser.h"
 #include "vtkResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringScanner.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -38,6 +44,193 @@ constexpr int STL_HEADER_SIZE = 80;
 
 // twelve 32-bit-floating point numbers + 2 byte for attribute byte count = 50 bytes.
 constexpr vtkTypeInt64 STL_TRI_SIZE = 12 * sizeof(float) + sizeof(uint16_t);
+
+// number of binary triangles read at once and decoded in parallel.
+constexpr vtkTypeInt64 STL_TRI_CHUNK = 1 << 16;
+
+//------------------------------------------------------------------------------
+// Decode a binary facet: normal then the three vertices.
+void DecodeFacet(const unsigned char* facet, float values[12])
+{
+  std::memcpy(values, facet, 12 * sizeof(float));
+  vtkByteSwap::Swap4LERange(values, 12);
+}
+
+//------------------------------------------------------------------------------
+// Return the message describing why a decoded facet is invalid, nullptr if it is valid.
+const char* CheckFacet(const float values[12], bool checkNormal)
+{
+  static const char* const messages[4] = { "Normal vector non-finite.", "vertex 1 non-finite.",
+    "vertex 2 non-finite.", "vertex 3 non-finite." };
+  for (int v = checkNormal ? 0 : 1; v < 4; ++v)
+  {
+    const float* x = values + 3 * v;
+    if (!std::isfinite(x[0]) || !std::isfinite(x[1]) || !std::isfinite(x[2]))
+    {
+      return messages[v];
+    }
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Merge exactly coincident points of a triangle soup, as vtkMergePoints does,
+// using a parallel sort of the point ids by coordinates instead of inserting
+// the points one by one. Merged points keep the order of their first use, and
+// triangles that become degenerate are removed, along with their scalar.
+// Return false, without merging, if a coordinate is NaN.
+bool MergeCoincidentPoints(vtkFloatArray* coordinates, vtkCellArray* polys, vtkFloatArray* scalars,
+  vtkPoints* mergedPts, vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars)
+{
+  const float* coords = coordinates->GetPointer(0);
+  const vtkIdType numPts = coordinates->GetNumberOfTuples();
+  std::atomic<bool> hasNaN(false);
+  vtkSMPTools::For(0, 3 * numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      if (std::any_of(coords + begin, coords + end, [](float x) { return std::isnan(x); }))
+      {
+        hasNaN = true;
+      }
+    });
+  if (hasNaN)
+  {
+    return false;
+  }
+
+  const auto same = [coords](vtkIdType a, vtkIdType b)
+  {
+    return coords[3 * a] == coords[3 * b] && coords[3 * a + 1] == coords[3 * b + 1] &&
+      coords[3 * a + 2] == coords[3 * b + 2];
+  };
+
+  // Sort the point ids by coordinates, then by id: the first id of a group of
+  // coincident points is the one the group is merged into.
+  std::vector<vtkIdType> order(numPts);
+  std::iota(order.begin(), order.end(), 0);
+  vtkSMPTools::Sort(order.begin(), order.end(),
+    [coords](vtkIdType a, vtkIdType b)
+    {
+      const float* xa = coords + 3 * a;
+      const float* xb = coords + 3 * b;
+      if (xa[0] != xb[0])
+      {
+        return xa[0] < xb[0];
+      }
+      if (xa[1] != xb[1])
+      {
+        return xa[1] < xb[1];
+      }
+      if (xa[2] != xb[2])
+      {
+        return xa[2] < xb[2];
+      }
+      return a < b;
+    });
+
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      // Groups are handled by the range containing their first point.
+      for (vtkIdType k = begin; k < end; ++k)
+      {
+        if (k > 0 && same(order[k - 1], order[k]))
+        {
+          continue;
+        }
+        for (vtkIdType j = k; j < numPts && same(order[k], order[j]); ++j)
+        {
+          pointMap[order[j]] = order[k];
+        }
+      }
+    });
+
+  // Number the merged points by first use, remembering the point each one is
+  // copied from, so that every merged point is written once.
+  std::vector<vtkIdType> firstPoints;
+  firstPoints.reserve(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (pointMap[i] == i)
+    {
+      pointMap[i] = static_cast<vtkIdType>(firstPoints.size());
+      firstPoints.push_back(i);
+    }
+    else
+    {
+      pointMap[i] = pointMap[pointMap[i]];
+    }
+  }
+  const vtkIdType numMerged = static_cast<vtkIdType>(firstPoints.size());
+  mergedPts->SetDataTypeToFloat();
+  mergedPts->SetNumberOfPoints(numMerged);
+  float* mergedCoords = vtkArrayDownCast<vtkFloatArray>(mergedPts->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numMerged,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        std::copy_n(coords + 3 * firstPoints[id], 3, mergedCoords + 3 * id);
+      }
+    });
+
+  // Remove degenerate triangles.
+  const vtkIdType numTris = polys->GetNumberOfCells();
+  std::vector<vtkIdType> kept(numTris + 1, 0);
+  vtkSMPTools::For(0, numTris,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdType npts;
+      vtkIdType tri[3];
+      for (vtkIdType t = begin; t < end; ++t)
+      {
+        polys->GetCellAtId(t, npts, tri);
+        const vtkIdType a = pointMap[tri[0]];
+        const vtkIdType b = pointMap[tri[1]];
+        const vtkIdType c = pointMap[tri[2]];
+        kept[t + 1] = (a != b && a != c && b != c) ? 1 : 0;
+      }
+    });
+  std::partial_sum(kept.begin(), kept.end(), kept.begin());
+
+  const vtkIdType numKept = kept[numTris];
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numKept + 1);
+  vtkNew<vtkIdTypeArray> mergedConnectivity;
+  mergedConnectivity->SetNumberOfValues(3 * numKept);
+  if (mergedScalars)
+  {
+    mergedScalars->SetNumberOfValues(numKept);
+  }
+  vtkSMPTools::For(0, numTris,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdType npts;
+      vtkIdType tri[3];
+      for (vtkIdType t = begin; t < end; ++t)
+      {
+        const vtkIdType id = kept[t];
+        if (kept[t + 1] == id)
+        {
+          continue;
+        }
+        polys->GetCellAtId(t, npts, tri);
+        for (int i = 0; i < 3; ++i)
+        {
+          mergedConnectivity->SetValue(3 * id + i, pointMap[tri[i]]);
+        }
+        offsets->SetValue(id, 3 * id);
+        if (mergedScalars)
+        {
+          mergedScalars->SetValue(id, scalars->GetValue(t));
+        }
+      }
+    });
+  offsets->SetValue(numKept, 3 * numKept);
+  mergedPolys->SetData(offsets, mergedConnectivity);
+  return true;
+}
 }
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -162,7 +355,30 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkSmartPointer<vtkPoints> mergedPts = newPts;
   vtkSmartPointer<vtkCellArray> mergedPolys = newPolys;
   vtkSmartPointer<vtkFloatArray> mergedScalars = newScalars;
-  if (this->Merging)
+  bool merged = false;
+  vtkFloatArray* coordinates = vtkArrayDownCast<vtkFloatArray>(newPts->GetData());
+  vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+  if (this->Merging && !locator)
+  {
+    locator.TakeReference(this->NewDefaultLocator());
+  }
+  if (this->Merging && !this->Locator && coordinates &&
+    strcmp(locator->GetClassName(), "vtkMergePoints") == 0)
+  {
+    // The default locator merges exactly coincident points: do it in parallel.
+    // Locators returned by an override of NewDefaultLocator are used as is.
+    mergedPts = vtkSmartPointer<vtkPoints>::New();
+    mergedPolys = vtkSmartPointer<vtkCellArray>::New();
+    mergedScalars = newScalars ? vtkSmartPointer<vtkFloatArray>::New() : nullptr;
+    merged = ::MergeCoincidentPoints(
+      coordinates, newPolys, newScalars, mergedPts, mergedPolys, mergedScalars);
+    if (merged)
+    {
+      vtkDebugMacro(<< "Merged to: " << mergedPts->GetNumberOfPoints() << " points, "
+                    << mergedPolys->GetNumberOfCells() << " triangles");
+    }
+  }
+  if (this->Merging && !merged)
   {
     mergedPts = vtkSmartPointer<vtkPoints>::New();
     mergedPts->Reserve(newPts->GetNumberOfPoints() / 2);
@@ -174,11 +390,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
       mergedScalars->ReserveValues(newPolys->GetNumberOfCells());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
-    if (this->Locator == nullptr)
-    {
-      locator.TakeReference(this->NewDefaultLocator());
-    }
     locator->InitPointInsertion(mergedPts, newPts->GetBounds());
 
     vtkIdType nextCell = 0;
@@ -259,13 +470,6 @@ bool vtkSTLReader::ReadBinaryTrisFile(vtkResourceStream* stream, vtkTypeInt64& n
 bool vtkSTLReader::ReadBinarySTL(
   vtkResourceStream* stream, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    uint16_t attrByteCount;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -320,64 +524,91 @@ bool vtkSTLReader::ReadBinarySTL(
 
   // now allocate the memory we need for the triangles.
   // note we ignore the triangle count field and read until end of file.
-  newPts->Reserve(numTrisFile * 3);
-  newPolys->AllocateEstimate(numTrisFile, 3);
-
-  facet_t facet;
-  for (size_t i = 0; stream->Read(&facet, ::STL_TRI_SIZE) > 0; ++i)
+  // Points are appended to the ones that may have been read before.
+  const vtkIdType firstPoint = newPts->GetNumberOfPoints();
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(firstPoint + numTrisFile * 3);
+  float* coords = vtkArrayDownCast<vtkFloatArray>(newPts->GetData())->GetPointer(3 * firstPoint);
+
+  // Read the triangles by chunks, each one decoded in parallel.
+  const bool checkNormal = !this->GetRelaxedConformance();
+  std::vector<unsigned char> chunk;
+  vtkTypeInt64 numTris = 0;
+  while (numTris < numTrisFile)
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-    if (!this->GetRelaxedConformance()) // If not relaxed, enforce normal vector to be finite.
-    {
-      if (!std::isfinite(facet.n[0]) || !std::isfinite(facet.n[1]) || !std::isfinite(facet.n[2]))
-      {
-        vtkErrorMacro("Normal vector non-finite.");
-        return false;
-      }
-    }
-    // else we could compute the normal vector from the vertices, but it is not even used here.
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-    if (!std::isfinite(facet.v1[0]) || !std::isfinite(facet.v1[1]) || !std::isfinite(facet.v1[2]))
+    chunk.resize(std::min(::STL_TRI_CHUNK, numTrisFile - numTris) * ::STL_TRI_SIZE);
+    const vtkTypeInt64 chunkTris =
+      static_cast<vtkTypeInt64>(stream->Read(chunk.data(), chunk.size())) / ::STL_TRI_SIZE;
+    if (chunkTris == 0)
     {
-      vtkErrorMacro("vertex 1 non-finite.");
-      return false;
+      break;
     }
 
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-    if (!std::isfinite(facet.v2[0]) || !std::isfinite(facet.v2[1]) || !std::isfinite(facet.v2[2]))
-    {
-      vtkErrorMacro("vertex 2 non-finite.");
-      return false;
-    }
+    std::atomic<bool> valid(true);
+    float* chunkCoords = coords + 9 * numTris;
+    vtkSMPTools::For(0, chunkTris,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        float values[12];
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          ::DecodeFacet(chunk.data() + i * ::STL_TRI_SIZE, values);
+          if (::CheckFacet(values, checkNormal))
+          {
+            valid = false;
+          }
+          std::copy_n(values + 3, 9, chunkCoords + 9 * i);
+        }
+      });
 
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-    if (!std::isfinite(facet.v3[0]) || !std::isfinite(facet.v3[1]) || !std::isfinite(facet.v3[2]))
+    if (!valid)
     {
-      vtkErrorMacro("vertex 3 non-finite.");
+      // Report the first invalid triangle.
+      float values[12];
+      for (vtkTypeInt64 i = 0; i < chunkTris; ++i)
+      {
+        ::DecodeFacet(chunk.data() + i * ::STL_TRI_SIZE, values);
+        if (const char* message = ::CheckFacet(values, checkNormal))
+        {
+          vtkErrorMacro(<< message);
+          break;
+        }
+      }
       return false;
     }
 
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 100000) == 0 && i != 0)
+    numTris += chunkTris;
+    vtkDebugMacro(<< "triangle# " << numTris);
+    this->UpdateProgress(static_cast<double>(numTris) / numTrisFile);
+  }
+  newPts->SetNumberOfPoints(firstPoint + numTris * 3);
+
+  // Each triangle uses its own three points.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numTris + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numTris * 3);
+  vtkSMPTools::For(0, numTris + 1,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTrisFile);
-    }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        offsets->SetValue(i, 3 * i);
+      }
+      for (vtkIdType i = 3 * begin; i < std::min(3 * end, 3 * numTris); ++i)
+      {
+        connectivity->SetValue(i, firstPoint + i);
+      }
+    });
+  if (newPolys->GetNumberOfCells() == 0)
+  {
+    newPolys->SetData(offsets, connectivity);
+  }
+  else
+  {
+    vtkNew<vtkCellArray> triangles;
+    triangles->SetData(offsets, connectivity);
+    newPolys->Append(triangles);
   }
 
   return true;
@@ -128,8 +128,10 @@ protected:
 
   /**
    * Create default locator. Used to create one when none is specified.
+   * Points are merged in parallel, without locator, unless this returns
+   * something else than a vtkMergePoints.
    */
-  vtkIncrementalPointLocator* NewDefaultLocator();
+  virtual vtkIncrementalPointLocator* NewDefaultLocator();
 
   /**
    * Set header string. Internal use only.
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that reading the partitions of a piece with coalesced reads gives the
+// same data as reading each partition on its own, for unstructured grids and
+// poly data, and for all the pieces of a distributed read.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+namespace
+{
+constexpr unsigned int NumberOfPartitions = 7;
+
+//------------------------------------------------------------------------------
+void AddCellIds(vtkDataSet* data, int partition)
+{
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(data->GetNumberOfCells());
+  for (vtkIdType i = 0; i < data->GetNumberOfCells(); ++i)
+  {
+    ids->SetValue(i, static_cast<int>(1000 * partition + i));
+  }
+  data->GetCellData()->AddArray(ids);
+}
+
+//------------------------------------------------------------------------------
+bool CompareReads(const std::string& fileName)
+{
+  for (int numberOfPieces : { 1, 2, 3 })
+  {
+    for (int piece = 0; piece < numberOfPieces; ++piece)
+    {
+      for (int distribution : { vtkHDFReader::Block, vtkHDFReader::Interleave })
+      {
+        vtkNew<vtkHDFReader> coalesced;
+        coalesced->SetFileName(fileName.c_str());
+        coalesced->SetPieceDistribution(distribution);
+        coalesced->UpdatePiece(piece, numberOfPieces, 0);
+
+        vtkNew<vtkHDFReader> separate;
+        separate->SetFileName(fileName.c_str());
+        separate->SetPieceDistribution(distribution);
+        separate->CoalescePartitionReadsOff();
+        separate->UpdatePiece(piece, numberOfPieces, 0);
+
+        if (!vtkTestUtilities::CompareDataObjects(
+              coalesced->GetOutputDataObject(0), separate->GetOutputDataObject(0)))
+        {
+          vtkLog(ERROR,
+            "Coalesced read differs for piece " << piece << " of " << numberOfPieces
+                                                << " in " << fileName);
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestUnstructuredGrid(const std::string& tempDir)
+{
+  vtkNew<vtkPartitionedDataSet> partitions;
+  partitions->SetNumberOfPartitions(NumberOfPartitions);
+  for (unsigned int part = 0; part < NumberOfPartitions; ++part)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(part % 2 ? VTK_TETRA : VTK_HEXAHEDRON);
+    source->SetBlocksDimensions(static_cast<int>(part) + 1, 2, 3);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> grid;
+    grid->ShallowCopy(source->GetOutput());
+    ::AddCellIds(grid, part);
+    partitions->SetPartition(part, grid);
+  }
+
+  const std::string fileName = tempDir + "/TestHDFReaderCoalescedPartitions_ug.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(partitions);
+  writer->SetFileName(fileName.c_str());
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << fileName);
+    return false;
+  }
+  return ::CompareReads(fileName);
+}
+
+//------------------------------------------------------------------------------
+bool TestPolyData(const std::string& tempDir)
+{
+  vtkNew<vtkPartitionedDataSet> partitions;
+  partitions->SetNumberOfPartitions(NumberOfPartitions);
+  for (unsigned int part = 0; part < NumberOfPartitions; ++part)
+  {
+    vtkNew<vtkSphereSource> source;
+    source->SetCenter(part, 0, 0);
+    source->SetThetaResolution(4 + part);
+    source->SetPhiResolution(3 + 2 * part);
+    source->Update();
+    vtkNew<vtkPolyData> polyData;
+    polyData->ShallowCopy(source->GetOutput());
+    ::AddCellIds(polyData, part);
+    partitions->SetPartition(part, polyData);
+  }
+
+  const std::string fileName = tempDir + "/TestHDFReaderCoalescedPartitions_pd.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputData(partitions);
+  writer->SetFileName(fileName.c_str());
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << fileName);
+    return false;
+  }
+  return ::CompareReads(fileName);
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHDFReaderCoalescedPartitions(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  return (::TestUnstructuredGrid(tempDir) && ::TestPolyData(tempDir)) ? EXIT_SUCCESS
+                                                                      : EXIT_FAILURE;
+}
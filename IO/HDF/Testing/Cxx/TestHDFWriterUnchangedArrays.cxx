@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that arrays unchanged between time steps are written once when
+// ReuseUnchangedArrays is set, that writing in the background gives the same
+// file content, including when an HDF5 reader is upstream of the writer, that
+// an error of the background thread fails the write, and that all time steps
+// are read back identically.
+
+#include "vtkArrayCalculator.h"
+#include "vtkDataSet.h"
+#include "vtkExecutive.h"
+#include "vtkGenerateTimeSteps.h"
+#include "vtkHDF5ScopedHandle.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSpatioTemporalHarmonicsAttribute.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include "vtk_hdf5.h"
+
+#include <string>
+
+namespace
+{
+constexpr int NumberOfTimeSteps = 4;
+
+//------------------------------------------------------------------------------
+// Write all time steps of source and check the number of time steps written by the
+// background thread.
+bool Write(vtkAlgorithm* source, const std::string& fileName, bool reuse, bool background,
+  bool requireThreadSafe, int expectedInBackground)
+{
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetReuseUnchangedArrays(reuse);
+  writer->SetWriteAsynchronously(background);
+  writer->SetRequireThreadSafeHDF5(requireThreadSafe);
+  if (writer->Write() == 0)
+  {
+    vtkLog(ERROR, "Cannot write " << fileName);
+    return false;
+  }
+  if (writer->GetNumberOfTimeStepsWrittenInBackground() != expectedInBackground)
+  {
+    vtkLog(ERROR, "Wrong number of time steps written in the background for "
+        << fileName << ": " << writer->GetNumberOfTimeStepsWrittenInBackground()
+        << " instead of " << expectedInBackground);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+hsize_t GetNumberOfRows(const std::string& fileName, const std::string& datasetPath)
+{
+  vtkHDF::ScopedH5FHandle file = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  vtkHDF::ScopedH5DHandle dataset = H5Dopen(file, datasetPath.c_str(), H5P_DEFAULT);
+  vtkHDF::ScopedH5SHandle dataspace = H5Dget_space(dataset);
+  hsize_t dims[2] = { 0, 0 };
+  H5Sget_simple_extent_dims(dataspace, dims, nullptr);
+  return dims[0];
+}
+
+//------------------------------------------------------------------------------
+bool CompareTimeSteps(const std::string& expectedFileName, const std::string& fileName)
+{
+  vtkNew<vtkHDFReader> expectedReader;
+  expectedReader->SetFileName(expectedFileName.c_str());
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  if (reader->GetNumberOfSteps() != NumberOfTimeSteps)
+  {
+    vtkLog(ERROR, "Wrong number of time steps in " << fileName);
+    return false;
+  }
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    expectedReader->SetStep(step);
+    expectedReader->Update();
+    reader->SetStep(step);
+    reader->Update();
+    if (!vtkTestUtilities::CompareDataObjects(
+          expectedReader->GetOutputDataObject(0), reader->GetOutputDataObject(0)))
+    {
+      vtkLog(ERROR, "Time step " << step << " of " << fileName << " differs.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHDFWriterUnchangedArrays(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string tempDir(tempDirCStr);
+  delete[] tempDirCStr;
+
+  // "Normals" is never modified, "Ones" is computed again with the same values for each
+  // time step, and "SpatioTemporalHarmonics" changes with time.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(20);
+  sphere->SetPhiResolution(20);
+  vtkNew<vtkGenerateTimeSteps> generateTimeSteps;
+  generateTimeSteps->SetInputConnection(sphere->GetOutputPort());
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    generateTimeSteps->AddTimeStepValue(step);
+  }
+  vtkNew<vtkSpatioTemporalHarmonicsAttribute> harmonics;
+  harmonics->AddHarmonic(1.0, 1.0, 0.6283, 0.6283, 0.6283, 0.0);
+  harmonics->SetInputConnection(generateTimeSteps->GetOutputPort());
+  vtkNew<vtkArrayCalculator> ones;
+  ones->SetInputConnection(harmonics->GetOutputPort());
+  ones->SetFunction("1");
+  ones->SetResultArrayName("Ones");
+  ones->Update();
+  const hsize_t numberOfPoints =
+    static_cast<hsize_t>(vtkDataSet::SafeDownCast(ones->GetOutput())->GetNumberOfPoints());
+
+  const std::string fullFileName = tempDir + "/TestHDFWriterUnchangedArrays_full.vtkhdf";
+  const std::string reuseFileName = tempDir + "/TestHDFWriterUnchangedArrays_reuse.vtkhdf";
+  const std::string backgroundFileName =
+    tempDir + "/TestHDFWriterUnchangedArrays_background.vtkhdf";
+  // Nothing upstream uses HDF5, so the background thread can be used with any HDF5 library.
+  if (!::Write(ones, fullFileName, false, false, true, 0) ||
+    !::Write(ones, reuseFileName, true, false, true, 0) ||
+    !::Write(ones, backgroundFileName, true, true, false, NumberOfTimeSteps))
+  {
+    return EXIT_FAILURE;
+  }
+
+  for (const std::string& fileName : { reuseFileName, backgroundFileName })
+  {
+    if (::GetNumberOfRows(fileName, "/VTKHDF/PointData/Normals") != numberOfPoints ||
+      ::GetNumberOfRows(fileName, "/VTKHDF/PointData/Ones") != numberOfPoints ||
+      ::GetNumberOfRows(fileName, "/VTKHDF/PointData/SpatioTemporalHarmonics") !=
+        NumberOfTimeSteps * numberOfPoints)
+    {
+      vtkLog(ERROR, "Unchanged arrays should be written once in " << fileName);
+      return EXIT_FAILURE;
+    }
+    if (!::CompareTimeSteps(fullFileName, fileName))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (::GetNumberOfRows(fullFileName, "/VTKHDF/PointData/Normals") !=
+    NumberOfTimeSteps * numberOfPoints)
+  {
+    vtkLog(ERROR, "All time steps should be written by default.");
+    return EXIT_FAILURE;
+  }
+
+  // The reader runs while the previous time step is written, which is only done in the
+  // background with a thread-safe HDF5 library.
+  hbool_t threadSafe = false;
+  H5is_library_threadsafe(&threadSafe);
+  vtkLog(INFO, "HDF5 library thread safe: " << (threadSafe ? "yes" : "no"));
+  vtkNew<vtkHDFReader> upstreamReader;
+  upstreamReader->SetFileName(fullFileName.c_str());
+  const std::string upstreamFileName =
+    tempDir + "/TestHDFWriterUnchangedArrays_upstream_reader.vtkhdf";
+  if (!::Write(upstreamReader, upstreamFileName, true, true, true,
+        threadSafe ? NumberOfTimeSteps : 0) ||
+    !::CompareTimeSteps(fullFileName, upstreamFileName))
+  {
+    vtkLog(ERROR, "Cannot write in the background with an HDF5 reader upstream.");
+    return EXIT_FAILURE;
+  }
+
+  // An error of the background thread is reported by the next time step and stops writing.
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(ones->GetOutputPort());
+  writer->SetFileName((tempDir + "/missing_directory/TestHDFWriterUnchangedArrays.vtkhdf").c_str());
+  writer->SetWriteAsynchronously(true);
+  writer->SetRequireThreadSafeHDF5(false);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  vtkNew<vtkTest::ErrorObserver> executiveErrorObserver;
+  writer->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  writer->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, executiveErrorObserver);
+  if (writer->Write() != 0 || !errorObserver->GetError() ||
+    writer->GetNumberOfTimeStepsWrittenInBackground() != 0)
+  {
+    vtkLog(ERROR, "Failing to write in the background should fail the write.");
+    return EXIT_FAILURE;
+  }
+
+  // The writer can be used again after the error.
+  const std::string retryFileName = tempDir + "/TestHDFWriterUnchangedArrays_retry.vtkhdf";
+  writer->SetFileName(retryFileName.c_str());
+  if (writer->Write() == 0 ||
+    writer->GetNumberOfTimeStepsWrittenInBackground() != NumberOfTimeSteps ||
+    !::CompareTimeSteps(fullFileName, retryFileName))
+  {
+    vtkLog(ERROR, "Cannot write in the background after an error.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
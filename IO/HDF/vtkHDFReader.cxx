@@ -45,8 +45,10 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <numeric>
+#include <tuple>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -172,6 +174,53 @@ bool ReadPolyDataPiece(T* impl, std::shared_ptr<CacheT> cache, vtkIdType pointOf
   return true;
 }
 
+//----------------------------------------------------------------------------
+/**
+ * Read at once the slices of the dataset `name` needed by the given pieces, so
+ * that the following ReadFromFileOrCache calls for these pieces do not access
+ * the file. `sliceOf(piece)` returns the cache name modifier, the offset and the
+ * size of the slice of a piece. Slices already in the cache are not read.
+ */
+template <typename ImplT, typename CacheT, typename SliceFunctor>
+void PreloadFromFile(ImplT* impl, std::shared_ptr<CacheT> cache, int tag, const std::string& name,
+  const std::vector<int>& pieces, SliceFunctor&& sliceOf)
+{
+  std::vector<std::pair<hsize_t, hsize_t>> slices;
+  for (int piece : pieces)
+  {
+    auto [modifier, offset, size] = sliceOf(piece);
+    if (size > 0 && !(cache && cache->CheckExistsAndEqual(tag, name + modifier, offset, size)))
+    {
+      slices.emplace_back(offset, size);
+    }
+  }
+  // A single slice is read as usual.
+  if (slices.size() > 1)
+  {
+    impl->PreloadArray(tag, name, slices);
+  }
+}
+
+//----------------------------------------------------------------------------
+/**
+ * Release the preloaded slices when leaving the scope of a read, including
+ * on error, so that they are not served to the next read.
+ */
+template <typename ImplT>
+class PreloadedArraysGuard
+{
+public:
+  explicit PreloadedArraysGuard(ImplT* impl)
+    : Impl(impl)
+  {
+  }
+  ~PreloadedArraysGuard() { this->Impl->ClearPreloadedArrays(); }
+  PreloadedArraysGuard(const PreloadedArraysGuard&) = delete;
+  PreloadedArraysGuard& operator=(const PreloadedArraysGuard&) = delete;
+
+private:
+  ImplT* Impl;
+};
 }
 
 //----------------------------------------------------------------------------
@@ -423,6 +472,8 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "CoalescePartitionReads: " << (this->CoalescePartitionReads ? "true" : "false")
+     << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: "
@@ -1484,6 +1535,58 @@ int vtkHDFReader::Read(
       pData->SetPartition(part, nullptr);
     }
   }
+
+  ::PreloadedArraysGuard preloadedArraysGuard(this->Impl);
+  if (this->CoalescePartitionReads && localPieceNums.size() > 1)
+  {
+    // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
+    auto cache = this->UseCache ? this->Cache : nullptr;
+    // Slices of a dataset storing numberOf[part] + extra values for each non empty part
+    auto preload = [&](int tag, const std::string& name, const std::vector<vtkIdType>& numberOf,
+                     vtkIdType startingOffset, vtkIdType extra)
+    {
+      ::PreloadFromFile(this->Impl, cache, tag, name, localPieceNums,
+        [&](int filePiece)
+        {
+          return std::make_tuple("_" + vtk::to_string(filePiece) + "_" + this->CompositeCachePath,
+            std::accumulate(
+              numberOf.data(), &numberOf[filePiece], startingOffset + extra * filePiece),
+            numberOf[filePiece] ? numberOf[filePiece] + extra : 0);
+        });
+    };
+
+    vtkIdType startingCellOffset = !geoOffs.CellOffsets.empty() ? geoOffs.CellOffsets[0] : 0;
+    vtkIdType startingConnOffset =
+      !geoOffs.ConnectivityOffsets.empty() ? geoOffs.ConnectivityOffsets[0] : 0;
+    preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, "Points", numberOfPoints,
+      geoOffs.PointOffset, 0);
+    preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, "Offsets", numberOfCells,
+      startingCellOffset + geoOffs.PartOffset, 1);
+    preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, "Connectivity", numberOfConnectivityIds,
+      startingConnOffset, 0);
+    preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, "Types", numberOfCells, startingCellOffset, 0);
+
+    std::vector<vtkIdType> startingOffsets = { geoOffs.PointOffset, startingCellOffset };
+    std::vector<const std::vector<vtkIdType>*> numberOf = { &numberOfPoints, &numberOfCells };
+    for (int attributeType = vtkDataObject::AttributeTypes::POINT;
+         attributeType <= vtkDataObject::AttributeTypes::CELL; ++attributeType)
+    {
+      for (const std::string& name : this->Impl->GetArrayNames(attributeType))
+      {
+        if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+        {
+          vtkIdType arrayOffset = startingOffsets[attributeType];
+          if (this->GetHasTemporalData())
+          {
+            vtkIdType buff = this->Impl->GetArrayOffset(this->Step, attributeType, name);
+            arrayOffset = buff >= 0 ? buff : arrayOffset;
+          }
+          preload(attributeType, name, *numberOf[attributeType], arrayOffset, 0);
+        }
+      }
+    }
+  }
+
   for (const auto& filePiece : localPieceNums)
   {
     vtkUnstructuredGrid* pieceData = data;
@@ -1596,6 +1699,29 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
   std::vector<int> localPieceNums{ this->GetPieceAssignmentForDistribution(
     localPieceIdx, numPartsInFile, numPiecesPipeline) };
 
+  // The offsets arrays have (numberOfCells[part] + 1) elements per part, count the parts of
+  // the previous steps to retrieve the real offset of each topology.
+  std::vector<vtkIdType> connectivityPartOffsets(vtkHDFUtilities::NUM_POLY_DATA_TOPOS, 0);
+  for (std::size_t iTopo = 0; iTopo < vtkHDFUtilities::NUM_POLY_DATA_TOPOS; ++iTopo)
+  {
+    vtkIdType numCellSum = 0;
+    for (const auto& numCell : numberOfCellsBefore[vtkHDFUtilities::POLY_DATA_TOPOS[iTopo]])
+    {
+      // No need to iterate if there is no offsetting on the connectivity. Otherwise, we
+      // accumulate the number of part until we reach the current offset, it's useful to retrieve
+      // the real cell offset
+      if (numCellSum >= startingCellOffsets[iTopo])
+      {
+        break;
+      }
+      else
+      {
+        connectivityPartOffsets[iTopo] += 1;
+      }
+      numCellSum += numCell;
+    }
+  }
+
   // Set unread parts to null
   for (int part = 0; part < numPartsInFile; part++)
   {
@@ -1605,6 +1731,64 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
       pData->SetPartition(part, nullptr);
     }
   }
+
+  ::PreloadedArraysGuard preloadedArraysGuard(this->Impl);
+  if (this->CoalescePartitionReads && localPieceNums.size() > 1)
+  {
+    // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
+    auto cache = this->UseCache ? this->Cache : nullptr;
+    // Slices of a dataset storing numberOf[part] + extra values for each part
+    auto preload = [&](int tag, const std::string& name, const std::string& separator,
+                     const std::vector<vtkIdType>& numberOf, vtkIdType startingOffset,
+                     vtkIdType extra)
+    {
+      ::PreloadFromFile(this->Impl, cache, tag, name, localPieceNums,
+        [&](int filePiece)
+        {
+          return std::make_tuple(
+            "_" + vtk::to_string(filePiece) + separator + this->CompositeCachePath,
+            std::accumulate(
+              numberOf.data(), &numberOf[filePiece], startingOffset + extra * filePiece),
+            numberOf[filePiece] + extra);
+        });
+    };
+
+    preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, "Points", "_", numberOfPoints,
+      startingPointOffset, 0);
+    std::vector<vtkIdType> totalNumberOfCells(numPartsInFile, 0);
+    for (std::size_t iTopo = 0; iTopo < vtkHDFUtilities::NUM_POLY_DATA_TOPOS; ++iTopo)
+    {
+      const auto& name = vtkHDFUtilities::POLY_DATA_TOPOS[iTopo];
+      preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, name + "/Offsets", "_", numberOfCells[name],
+        startingCellOffsets[iTopo] + connectivityPartOffsets[iTopo], 1);
+      preload(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, name + "/Connectivity", "_",
+        numberOfConnectivityIds[name], startingConnectivityIdOffsets[iTopo], 0);
+      std::transform(totalNumberOfCells.begin(), totalNumberOfCells.end(),
+        numberOfCells[name].begin(), totalNumberOfCells.begin(), std::plus<vtkIdType>());
+    }
+
+    std::vector<vtkIdType> startingOffsets = { startingPointOffset, startingCellOffset };
+    std::vector<const std::vector<vtkIdType>*> numberOf = { &numberOfPoints,
+      &totalNumberOfCells };
+    for (int attributeType = vtkDataObject::AttributeTypes::POINT;
+         attributeType <= vtkDataObject::AttributeTypes::CELL; ++attributeType)
+    {
+      for (const std::string& name : this->Impl->GetArrayNames(attributeType))
+      {
+        if (this->DataArraySelection[attributeType]->ArrayIsEnabled(name.c_str()))
+        {
+          vtkIdType arrayOffset = startingOffsets[attributeType];
+          if (this->GetHasTemporalData())
+          {
+            vtkIdType buff = this->Impl->GetArrayOffset(this->Step, attributeType, name);
+            arrayOffset = buff >= 0 ? buff : arrayOffset;
+          }
+          preload(attributeType, name, "", *numberOf[attributeType], arrayOffset, 0);
+        }
+      }
+    }
+  }
+
   for (const auto& filePiece : localPieceNums)
   {
     // determine the exact offsetting for the piece that needs to be read
@@ -1617,25 +1801,8 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
     for (std::size_t iTopo = 0; iTopo < vtkHDFUtilities::NUM_POLY_DATA_TOPOS; ++iTopo)
     {
       const auto& nCells = numberOfCells[vtkHDFUtilities::POLY_DATA_TOPOS[iTopo]];
-      vtkIdType connectivityPartOffset = 0;
-      vtkIdType numCellSum = 0;
-      for (const auto& numCell : numberOfCellsBefore[vtkHDFUtilities::POLY_DATA_TOPOS[iTopo]])
-      {
-        // No need to iterate if there is no offsetting on the connectivity. Otherwise, we
-        // accumulate the number of part until we reach the current offset, it's useful to retrieve
-        // the real cell offset
-        if (numCellSum >= startingCellOffsets[iTopo])
-        {
-          break;
-        }
-        else
-        {
-          connectivityPartOffset += 1;
-        }
-        numCellSum += numCell;
-      }
       cellOffsets[iTopo] = std::accumulate(nCells.begin(), nCells.begin() + filePiece,
-        startingCellOffsets[iTopo] + connectivityPartOffset + filePiece);
+        startingCellOffsets[iTopo] + connectivityPartOffsets[iTopo] + filePiece);
       pieceNumberOfCells[iTopo] = nCells[filePiece];
       const auto& nConnectivity = numberOfConnectivityIds[vtkHDFUtilities::POLY_DATA_TOPOS[iTopo]];
       connectivityOffsets[iTopo] = std::accumulate(nConnectivity.begin(),
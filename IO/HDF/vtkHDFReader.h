@@ -118,6 +118,20 @@ public:
   vtkGetMacro(PieceDistribution, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the partitions of an unstructured grid or a poly data assigned
+   * to this reader are read with a single HDF5 read per array, selecting the
+   * union of their slices in the file, instead of one read per partition and
+   * array. This is faster for files with many small partitions, but keeps each
+   * array of the local partitions twice in memory while reading. The default
+   * is on.
+   */
+  vtkSetMacro(CoalescePartitionReads, bool);
+  vtkGetMacro(CoalescePartitionReads, bool);
+  vtkBooleanMacro(CoalescePartitionReads, bool);
+  ///@}
+
   /**
    * Return true if, after a quick check of file header, it looks like the provided file or stream
    * can be read. Return false if it is sure it cannot be read. The stream version may move the
@@ -430,6 +444,7 @@ private:
   bool HasTemporalData = false;
   std::string CompositeCachePath; // Identifier for the current composite piece
   int PieceDistribution = Interleave;
+  bool CoalescePartitionReads = true;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -211,6 +211,7 @@ int vtkHDFReader::Implementation::GetNumberOfPieces(vtkIdType step)
 //------------------------------------------------------------------------------
 void vtkHDFReader::Implementation::Close()
 {
+  this->ClearPreloadedArrays();
   this->DataSetType = -1;
   this->NumberOfPieces = 0;
   this->CloseMemberGroups();
@@ -342,6 +343,10 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
+  if (vtkDataArray* preloaded = this->NewPreloadedArray(attributeType, name, offset, size))
+  {
+    return preloaded;
+  }
   std::vector<hsize_t> fileExtent = { offset, offset + size };
   return vtkHDFUtilities::NewArrayForGroup(
     this->AttributeDataGroup[attributeType], name, fileExtent);
@@ -400,10 +405,101 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
 vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
   const char* name, hsize_t offset, hsize_t size)
 {
+  if (vtkDataArray* preloaded =
+        this->NewPreloadedArray(vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG, name, offset, size))
+  {
+    return preloaded;
+  }
   std::vector<hsize_t> fileExtent = { offset, offset + size };
   return this->NewMetadataArray(name, fileExtent);
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFReader::Implementation::PreloadArray(int attributeType, const std::string& name,
+  const std::vector<std::pair<hsize_t, hsize_t>>& slices)
+{
+  // Merge the slices into sorted disjoint rows ranges.
+  vtkHDFUtilities::RowRanges rows;
+  for (const auto& slice : slices)
+  {
+    if (slice.second > 0)
+    {
+      rows.push_back({ slice.first, slice.first + slice.second });
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  std::size_t last = 0;
+  for (std::size_t i = 1; i < rows.size(); ++i)
+  {
+    if (rows[i][0] <= rows[last][1])
+    {
+      rows[last][1] = std::max(rows[last][1], rows[i][1]);
+    }
+    else
+    {
+      rows[++last] = rows[i];
+    }
+  }
+  rows.resize(rows.empty() ? 0 : last + 1);
+  if (rows.empty())
+  {
+    return false;
+  }
+
+  hid_t group = attributeType == vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG
+    ? this->VTKGroup
+    : this->AttributeDataGroup[attributeType];
+  auto array =
+    vtk::TakeSmartPointer(vtkHDFUtilities::NewArrayForGroup(group, name.c_str(), rows));
+  if (!array)
+  {
+    return false;
+  }
+  PreloadedArray& preloaded = this->PreloadedArrays[std::make_pair(attributeType, name)];
+  preloaded.Rows = std::move(rows);
+  preloaded.Array = array;
+  preloaded.RemainingRequests = std::count_if(slices.begin(), slices.end(),
+    [](const std::pair<hsize_t, hsize_t>& slice) { return slice.second > 0; });
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFReader::Implementation::ClearPreloadedArrays()
+{
+  this->PreloadedArrays.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFReader::Implementation::NewPreloadedArray(
+  int attributeType, const char* name, hsize_t offset, hsize_t size)
+{
+  auto it = this->PreloadedArrays.find(std::make_pair(attributeType, std::string(name)));
+  if (it == this->PreloadedArrays.end() || size == 0)
+  {
+    return nullptr;
+  }
+  PreloadedArray& preloaded = it->second;
+  hsize_t rowOffset = 0;
+  for (const auto& range : preloaded.Rows)
+  {
+    if (offset >= range[0] && offset + size <= range[1])
+    {
+      vtkDataArray* array = preloaded.Array->NewInstance();
+      array->SetNumberOfComponents(preloaded.Array->GetNumberOfComponents());
+      array->SetNumberOfTuples(static_cast<vtkIdType>(size));
+      array->InsertTuples(0, static_cast<vtkIdType>(size),
+        static_cast<vtkIdType>(rowOffset + offset - range[0]), preloaded.Array);
+      if (--preloaded.RemainingRequests == 0)
+      {
+        this->PreloadedArrays.erase(it);
+      }
+      return array;
+    }
+    rowOffset += range[1] - range[0];
+  }
+  return nullptr;
+}
+
 //------------------------------------------------------------------------------
 std::vector<vtkIdType> vtkHDFReader::Implementation::GetMetadata(
   const char* name, hsize_t size, hsize_t offset)
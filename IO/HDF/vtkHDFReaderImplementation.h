@@ -12,11 +12,14 @@
 #include "vtkAMRBox.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkHDFReader.h"
+#include "vtkHDFUtilities.h" // for RowRanges
+#include "vtkSmartPointer.h" // for vtkSmartPointer
 #include "vtk_hdf5.h"
 
 #include <array>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -137,6 +140,21 @@ public:
   vtkDataArray* NewMetadataArray(const char* name, hsize_t offset, hsize_t size);
   std::vector<vtkIdType> GetMetadata(const char* name, hsize_t size, hsize_t offset = 0);
   ///@}
+
+  ///@{
+  /**
+   * Read at once the given (offset, size) slices of a linear array, with a
+   * single HDF5 read of the union of the slices. Use
+   * vtkHDFUtilities::GEOMETRY_ATTRIBUTE_TAG as attributeType for a metadata
+   * array. The following NewArray(attributeType, name, offset, size) and
+   * NewMetadataArray(name, offset, size) calls for one of these slices copy
+   * it from memory instead of reading the file. Slices are released once they
+   * have all been requested, or by ClearPreloadedArrays.
+   */
+  bool PreloadArray(int attributeType, const std::string& name,
+    const std::vector<std::pair<hsize_t, hsize_t>>& slices);
+  void ClearPreloadedArrays();
+  ///@}
   /**
    * Returns the dimensions of a HDF dataset.
    */
@@ -305,6 +323,23 @@ private:
   std::array<int, 2> Version;
   vtkHDFReader* Reader;
 
+  /**
+   * Rows read by PreloadArray for a dataset, stored one range after the other.
+   */
+  struct PreloadedArray
+  {
+    vtkHDFUtilities::RowRanges Rows;
+    vtkSmartPointer<vtkDataArray> Array;
+    std::size_t RemainingRequests = 0;
+  };
+  std::map<std::pair<int, std::string>, PreloadedArray> PreloadedArrays;
+
+  /**
+   * Return a new array with the rows [offset, offset + size) of a preloaded
+   * dataset, or nullptr if they were not preloaded.
+   */
+  vtkDataArray* NewPreloadedArray(int attributeType, const char* name, hsize_t offset, hsize_t size);
+
   ///@{
   /**
    * Specific methods and structure of AMR support.
@@ -167,8 +167,8 @@ vtkDataArray* NewVtkDataArray()
 
 //------------------------------------------------------------------------------
 template <typename T>
-bool NewArray(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents, T* data)
+bool NewArray(hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents,
+  const vtkHDFUtilities::RowRanges& rows, T* data)
 {
   hid_t nativeType = vtkHDFUtilities::TemplateTypeToHdfNativeType<T>();
   std::vector<hsize_t> count(fileExtent.size() / 2), start(fileExtent.size() / 2);
@@ -182,13 +182,6 @@ bool NewArray(
     count.push_back(numberOfComponents);
     start.push_back(0);
   }
-  vtkHDF::ScopedH5SHandle memspace =
-    H5Screate_simple(static_cast<int>(count.size()), count.data(), nullptr);
-  if (memspace < 0)
-  {
-    vtkErrorWithObjectMacro(nullptr, << "Error H5Screate_simple for memory space");
-    return false;
-  }
   // create the filespace and select the required fileExtent
   vtkHDF::ScopedH5SHandle filespace = H5Dget_space(dataset);
   if (filespace < 0)
@@ -196,16 +189,40 @@ bool NewArray(
     vtkErrorWithObjectMacro(nullptr, << "Error H5Dget_space for array");
     return false;
   }
-  if (H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr) <
-    0)
+  // with rows, select the union of the rows ranges of the first dimension,
+  // so that they are all read with a single H5Dread.
+  hsize_t numberOfRows = 0;
+  for (std::size_t i = 0; i < std::max<std::size_t>(rows.size(), 1); ++i)
   {
-    std::ostringstream ostr;
-    std::ostream_iterator<int> oi(ostr, " ");
-    ostr << "Error selecting hyperslab, \nstart: ";
-    std::copy(start.begin(), start.end(), oi);
-    ostr << "\ncount: ";
-    std::copy(count.begin(), count.end(), oi);
-    vtkErrorWithObjectMacro(nullptr, << ostr.str());
+    if (!rows.empty())
+    {
+      start[0] = rows[i][0];
+      count[0] = rows[i][1] - rows[i][0];
+      numberOfRows += count[0];
+    }
+    if (H5Sselect_hyperslab(filespace, i == 0 ? H5S_SELECT_SET : H5S_SELECT_OR, start.data(),
+          nullptr, count.data(), nullptr) < 0)
+    {
+      std::ostringstream ostr;
+      std::ostream_iterator<int> oi(ostr, " ");
+      ostr << "Error selecting hyperslab, \nstart: ";
+      std::copy(start.begin(), start.end(), oi);
+      ostr << "\ncount: ";
+      std::copy(count.begin(), count.end(), oi);
+      vtkErrorWithObjectMacro(nullptr, << ostr.str());
+      return false;
+    }
+  }
+  if (!rows.empty())
+  {
+    start[0] = 0;
+    count[0] = numberOfRows;
+  }
+  vtkHDF::ScopedH5SHandle memspace =
+    H5Screate_simple(static_cast<int>(count.size()), count.data(), nullptr);
+  if (memspace < 0)
+  {
+    vtkErrorWithObjectMacro(nullptr, << "Error H5Screate_simple for memory space");
     return false;
   }
 
@@ -232,21 +249,30 @@ bool NewArray(
 
 //------------------------------------------------------------------------------
 template <typename T>
-vtkDataArray* NewArray(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents)
+vtkDataArray* NewArray(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, const vtkHDFUtilities::RowRanges& rows)
 {
-  int numberOfTuples = 1;
+  vtkIdType numberOfTuples = 1;
   size_t ndims = fileExtent.size() / 2;
-  for (size_t i = 0; i < ndims; ++i)
+  for (size_t i = rows.empty() ? 0 : 1; i < ndims; ++i)
   {
     size_t j = i << 1;
     numberOfTuples *= (fileExtent[j + 1] - fileExtent[j]);
   }
+  if (!rows.empty())
+  {
+    hsize_t numberOfRows = 0;
+    for (const auto& range : rows)
+    {
+      numberOfRows += range[1] - range[0];
+    }
+    numberOfTuples *= numberOfRows;
+  }
   auto array = vtkAOSDataArrayTemplate<T>::SafeDownCast(::NewVtkDataArray<T>());
   array->SetNumberOfComponents(numberOfComponents);
   array->SetNumberOfTuples(numberOfTuples);
   T* data = array->GetPointer(0);
-  if (!::NewArray(dataset, fileExtent, numberOfComponents, data))
+  if (!::NewArray(dataset, fileExtent, numberOfComponents, rows, data))
   {
     array->Delete();
     array = nullptr;
@@ -254,8 +280,8 @@ vtkDataArray* NewArray(
   return array;
 }
 
-using ArrayReader = vtkDataArray*(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
+using ArrayReader = vtkDataArray*(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, const vtkHDFUtilities::RowRanges& rows);
 using TypeReaderMap = std::map<::TypeDescription, ArrayReader*>;
 
 //------------------------------------------------------------------------------
@@ -1014,6 +1040,14 @@ hid_t vtkHDFUtilities::OpenDataSet(
 //------------------------------------------------------------------------------
 vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
   const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent)
+{
+  return vtkHDFUtilities::NewArrayForGroup(dataset, nativeType, dims, parameterExtent, {});
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  const RowRanges& rows)
 {
   vtkDataArray* array = nullptr;
   try
@@ -1065,7 +1099,7 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
     }
     else
     {
-      array = builder(dataset, extent, numberOfComponents);
+      array = builder(dataset, extent, numberOfComponents, rows);
     }
   }
   catch (const std::exception& e)
@@ -1093,6 +1127,28 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(
   return vtkHDFUtilities::NewArrayForGroup(dataset, nativeType, dims, parameterExtent);
 }
 
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t group, const char* name, const RowRanges& rows)
+{
+  if (rows.empty())
+  {
+    return nullptr;
+  }
+  std::vector<hsize_t> dims;
+  hid_t tempNativeType = H5I_INVALID_HID;
+  vtkHDF::ScopedH5DHandle dataset =
+    vtkHDFUtilities::OpenDataSet(group, name, &tempNativeType, dims);
+  vtkHDF::ScopedH5THandle nativeType = tempNativeType;
+  if (dataset < 0)
+  {
+    return nullptr;
+  }
+
+  // The extent of the first rows range gives the other dimensions.
+  std::vector<hsize_t> extent = { rows[0][0], rows[0][1] };
+  return vtkHDFUtilities::NewArrayForGroup(dataset, nativeType, dims, extent, rows);
+}
+
 //------------------------------------------------------------------------------
 std::vector<vtkIdType> vtkHDFUtilities::GetMetadata(
   hid_t group, const char* name, hsize_t size, hsize_t offset)
@@ -271,6 +271,24 @@ VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(
   hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent);
 ///@}
 
+/**
+ * Ranges [begin, end) of rows in the first dimension of a dataset.
+ */
+using RowRanges = std::vector<std::array<hsize_t, 2>>;
+
+///@{
+/**
+ * Reads the rows ranges of a 1D dataset, or of a 2D dataset with one row per
+ * tuple, with a single H5Dread call on the union of the ranges. Ranges must be
+ * sorted and disjoint. The rows are stored one after the other in the
+ * returned array. Returns nullptr in case of an error.
+ */
+VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t dataset, hid_t nativeType,
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  const RowRanges& rows);
+VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t group, const char* name, const RowRanges& rows);
+///@}
+
 /**
  * Reads a 1D metadata array in a DataArray or a vector of vtkIdType.
  * We read either the whole array for the vector version or a slice
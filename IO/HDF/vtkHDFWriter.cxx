@@ -9,10 +9,12 @@
 #include "vtkDataAssemblyUtilities.h"
 #include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
 #include "vtkDummyController.h"
+#include "vtkErrorCode.h"
 #include "vtkFieldData.h"
 #include "vtkHDF5ScopedHandle.h"
 #include "vtkHDFUtilities.h"
@@ -37,12 +39,14 @@
 #include "vtkStringFormatter.h"
 #include "vtkStructuredGrid.h"
 #include "vtkTable.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkType.h"
 #include "vtkTypeUInt32Array.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <string>
 
@@ -97,11 +101,127 @@ bool HasPolyhedra(vtkUnstructuredGrid* input)
   return input && input->GetPolyhedronFaces() != nullptr &&
     input->GetPolyhedronFaces()->GetNumberOfCells() > 0;
 }
+
+/**
+ * Return true if the values of two data arrays stored contiguously are the
+ * same bytes. Return false for other arrays.
+ */
+bool SameArrayValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || !a->HasStandardMemoryLayout() || !b->HasStandardMemoryLayout() ||
+    a->GetDataType() != b->GetDataType() || a->GetDataTypeSize() == 0 ||
+    a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  const std::size_t size = static_cast<std::size_t>(a->GetNumberOfValues()) * a->GetDataTypeSize();
+  return size == 0 || std::memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0), size) == 0;
+}
+
+/**
+ * Return true if the HDF5 library can be used from several threads.
+ */
+bool IsHDF5ThreadSafe()
+{
+  hbool_t threadSafe = false;
+  return H5is_library_threadsafe(&threadSafe) >= 0 && threadSafe;
+}
+
+/**
+ * Map the datasets and arrays of a copy of the input to the MeshMTime and MTime of the
+ * original objects, so that unchanged geometry and arrays are still detected on the copy.
+ */
+void CollectSourceMTimes(
+  vtkDataObject* input, vtkDataObject* copy, std::map<vtkObject*, vtkMTimeType>& mtimes)
+{
+  auto inputLeaves = vtkCompositeDataSet::GetDataSets<vtkDataObject>(input, true);
+  auto copyLeaves = vtkCompositeDataSet::GetDataSets<vtkDataObject>(copy, true);
+  for (std::size_t leaf = 0; leaf < std::min(inputLeaves.size(), copyLeaves.size()); ++leaf)
+  {
+    vtkDataObject* inputLeaf = inputLeaves[leaf];
+    vtkDataObject* copyLeaf = copyLeaves[leaf];
+    if (!inputLeaf || !copyLeaf)
+    {
+      continue;
+    }
+    if (auto inputDataSet = vtkDataSet::SafeDownCast(inputLeaf))
+    {
+      mtimes[copyLeaf] = inputDataSet->GetMeshMTime();
+    }
+    for (int attributeType : { vtkDataObject::AttributeTypes::POINT,
+           vtkDataObject::AttributeTypes::CELL, vtkDataObject::AttributeTypes::ROW })
+    {
+      vtkDataSetAttributes* inputAttributes = inputLeaf->GetAttributes(attributeType);
+      vtkDataSetAttributes* copyAttributes = copyLeaf->GetAttributes(attributeType);
+      if (!inputAttributes || !copyAttributes)
+      {
+        continue;
+      }
+      for (int iArray = 0; iArray < copyAttributes->GetNumberOfArrays() &&
+           iArray < inputAttributes->GetNumberOfArrays();
+           ++iArray)
+      {
+        mtimes[copyAttributes->GetAbstractArray(iArray)] =
+          inputAttributes->GetAbstractArray(iArray)->GetMTime();
+      }
+    }
+  }
 }
+}
+
+//------------------------------------------------------------------------------
+/*
+ * State of the arrays written for the previous time step, used to detect unchanged arrays.
+ */
+struct vtkHDFWriter::ChangeTracker
+{
+  struct ArrayState
+  {
+    int TimeIndex = -1;
+    vtkMTimeType MTime = 0;
+    int DataType = VTK_VOID;
+    int NumberOfComponents = 0;
+    vtkIdType NumberOfTuples = 0;
+    // Values of the previous time step, compared to arrays modified since
+    vtkSmartPointer<vtkDataArray> Values;
+  };
+  // Indexed by the path of the array in the file
+  std::map<std::string, ArrayState> Arrays;
+};
+
+//------------------------------------------------------------------------------
+/*
+ * Thread writing time steps in the background, see WriteAsynchronously.
+ * Input and SourceMTimes are only used by the writing thread.
+ */
+struct vtkHDFWriter::BackgroundWriter
+{
+  vtkNew<vtkThreadedCallbackQueue> Queue;
+  vtkThreadedCallbackQueue::SharedFuturePointer<bool> Pending;
+  // Index of the next time step requested to the pipeline
+  int NextTimeIndex = 0;
+  bool Running = false;
+
+  // Copy of the input being written, and MTimes of the objects it was copied from
+  vtkSmartPointer<vtkDataObject> Input;
+  std::map<vtkObject*, vtkMTimeType> SourceMTimes;
+
+  bool Wait()
+  {
+    bool ret = true;
+    if (this->Pending)
+    {
+      ret = this->Queue->Get(this->Pending);
+      this->Pending = nullptr;
+    }
+    return ret;
+  }
+};
 
 //------------------------------------------------------------------------------
 vtkHDFWriter::vtkHDFWriter()
   : Impl(new Implementation(this))
+  , Tracker(new ChangeTracker())
 {
   this->Controller = vtkMultiProcessController::GetGlobalController();
   if (this->Controller == nullptr)
@@ -120,6 +240,10 @@ vtkHDFWriter::vtkHDFWriter()
 //------------------------------------------------------------------------------
 vtkHDFWriter::~vtkHDFWriter()
 {
+  if (this->Background)
+  {
+    this->Background->Wait();
+  }
   this->SetFileName(nullptr);
   if (this->UsesDummyController)
   {
@@ -181,8 +305,15 @@ int vtkHDFWriter::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   if (this->WriteAllTimeSteps && inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
   {
-    inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), this->timeSteps.data());
-    double timeReq = this->timeSteps[this->CurrentTimeIndex];
+    // When writing in the background, CurrentTimeIndex and the time values are used by the
+    // writing thread, and the time values have already been retrieved for the first time step.
+    const bool background = this->Background && this->Background->Running;
+    if (!background)
+    {
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), this->timeSteps.data());
+    }
+    double timeReq =
+      this->timeSteps[background ? this->Background->NextTimeIndex : this->CurrentTimeIndex];
 
     inputVector[0]->GetInformationObject(0)->Set(
       vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), timeReq);
@@ -199,6 +330,19 @@ int vtkHDFWriter::RequestData(vtkInformation* request,
     return 1;
   }
 
+  // Without a thread-safe HDF5 library, HDF5 calls of the pipeline producing the next time step
+  // could run concurrently with the writing thread: write synchronously instead.
+  if (this->IsTemporal && this->WriteAsynchronously && this->NbPieces == 1 &&
+    (!this->RequireThreadSafeHDF5 || ::IsHDF5ThreadSafe()))
+  {
+    return this->RequestDataInBackground(request) ? 1 : 0;
+  }
+
+  if (this->CurrentTimeIndex == 0)
+  {
+    this->NumberOfTimeStepsWrittenInBackground = 0;
+  }
+
   bool ret = this->WriteDataAndReturn();
 
   if (this->IsTemporal)
@@ -223,6 +367,71 @@ int vtkHDFWriter::RequestData(vtkInformation* request,
   return ret ? 1 : 0;
 }
 
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::RequestDataInBackground(vtkInformation* request)
+{
+  if (!this->Background)
+  {
+    this->Background = std::make_unique<BackgroundWriter>();
+  }
+  BackgroundWriter& background = *this->Background;
+  if (!background.Running)
+  {
+    background.Running = true;
+    background.NextTimeIndex = this->CurrentTimeIndex;
+    this->NumberOfTimeStepsWrittenInBackground = 0;
+    this->SetErrorCode(vtkErrorCode::NoError);
+  }
+
+  // Copy the input so that the pipeline can produce the next time step while this one is
+  // written, keeping the MTimes of the input to detect unchanged geometry and arrays.
+  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
+  auto copy = vtk::TakeSmartPointer(input->NewInstance());
+  copy->DeepCopy(input);
+  std::map<vtkObject*, vtkMTimeType> sourceMTimes;
+  ::CollectSourceMTimes(input, copy, sourceMTimes);
+
+  // At most one time step is written while the next one is copied.
+  bool ret = background.Wait();
+  const int timeIndex = background.NextTimeIndex++;
+  if (ret)
+  {
+    background.Pending = background.Queue->Push(
+      [this, timeIndex, copy, mtimes = std::move(sourceMTimes)]() mutable
+      {
+        this->CurrentTimeIndex = timeIndex;
+        this->Background->Input = copy;
+        this->Background->SourceMTimes = std::move(mtimes);
+        bool success = this->WriteDataAndReturn();
+        if (success)
+        {
+          this->NumberOfTimeStepsWrittenInBackground++;
+        }
+        this->Background->Input = nullptr;
+        this->Background->SourceMTimes.clear();
+        return success;
+      });
+  }
+
+  // Tell the pipeline to start looping in order to write all the timesteps
+  request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+  if (!ret || background.NextTimeIndex >= this->NumberOfTimeSteps)
+  {
+    // Stop looping once the last time step is written
+    ret = background.Wait() && ret;
+    if (!ret)
+    {
+      // Report the failure to Write(), the looping pipeline does not return it
+      this->SetErrorCode(vtkErrorCode::UnknownError);
+    }
+    request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 0);
+    background.Running = false;
+    this->CurrentTimeIndex = 0;
+    this->Impl->CloseFile();
+  }
+  return ret;
+}
+
 //------------------------------------------------------------------------------
 int vtkHDFWriter::FillInputPortInformation(int port, vtkInformation* info)
 {
@@ -253,10 +462,19 @@ void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "yes" : "no") << "\n";
   os << indent << "ChunkSize: " << this->ChunkSize << "\n";
   os << indent << "CompressionLevel: " << this->CompressionLevel << "\n";
+  os << indent << "CompressorType: " << this->CompressorType << "\n";
+  os << indent << "Shuffle: " << (this->Shuffle ? "true" : "false") << "\n";
 
   os << indent << "UseExternalComposite: " << (this->UseExternalComposite ? "yes" : "no") << "\n";
   os << indent << "UseExternalTimeSteps: " << (this->UseExternalTimeSteps ? "yes" : "no") << "\n";
   os << indent << "UseExternalPartitions: " << (this->UseExternalPartitions ? "yes" : "no") << "\n";
+  os << indent << "ReuseUnchangedArrays: " << (this->ReuseUnchangedArrays ? "yes" : "no") << "\n";
+  os << indent << "WriteAsynchronously: " << (this->WriteAsynchronously ? "yes" : "no") << "\n";
+  os << indent << "RequireThreadSafeHDF5: " << (this->RequireThreadSafeHDF5 ? "yes" : "no")
+     << "\n";
+  os << indent
+     << "NumberOfTimeStepsWrittenInBackground: " << this->NumberOfTimeStepsWrittenInBackground
+     << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -264,6 +482,8 @@ bool vtkHDFWriter::WriteDataAndReturn()
 {
   this->Impl->SetSubFilesReady(false);
   this->Impl->SetCompressionLevel(this->CompressionLevel);
+  this->Impl->SetCompressorType(this->CompressorType);
+  this->Impl->SetShuffle(this->Shuffle);
   this->Impl->SetChunkSize(this->ChunkSize);
 
   // Root file group only needs to be opened for the first timestep
@@ -292,9 +512,18 @@ bool vtkHDFWriter::WriteDataAndReturn()
   }
 
   // Wait for the file to be created
-  this->Controller->Barrier();
+  if (this->NbPieces > 1)
+  {
+    this->Controller->Barrier();
+  }
 
-  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
+  vtkDataObject* input = this->Background && this->Background->Input
+    ? this->Background->Input.Get()
+    : vtkDataObject::SafeDownCast(this->GetInput());
+  if (this->CurrentTimeIndex == 0)
+  {
+    this->Tracker->Arrays.clear();
+  }
 
   if (this->IsTemporal)
   {
@@ -323,6 +552,8 @@ bool vtkHDFWriter::WriteDataAndReturn()
     writer->SetInputData(input);
     writer->SetFileName(subFilePath.c_str());
     writer->SetCompressionLevel(this->CompressionLevel);
+    writer->SetCompressorType(this->CompressorType);
+    writer->SetShuffle(this->Shuffle);
     writer->SetChunkSize(this->ChunkSize);
     writer->SetUseExternalComposite(this->UseExternalComposite);
     writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -864,6 +1095,13 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkHyperTreeGrid* input, unsi
 bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
 {
   bool ret = true;
+  // Arrays of a time step can only reference the previous one when written in a single block
+  unsigned int numberOfPartitions = 0;
+  for (unsigned int partIndex = 0; partIndex < input->GetNumberOfPartitions(); partIndex++)
+  {
+    numberOfPartitions += input->GetPartitionAsDataObject(partIndex) ? 1 : 0;
+  }
+  this->HasSeveralPartitions = numberOfPartitions > 1;
   int nonNullPartCount = 0;
   vtkDataObject* partition = nullptr;
   for (unsigned int partIndex = 0; partIndex < input->GetNumberOfPartitions(); partIndex++)
@@ -887,6 +1125,8 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
       writer->SetInputData(partition);
       writer->SetFileName(subFilePath.c_str());
       writer->SetCompressionLevel(this->CompressionLevel);
+      writer->SetCompressorType(this->CompressorType);
+      writer->SetShuffle(this->Shuffle);
       writer->SetChunkSize(this->ChunkSize);
       if (!writer->Write())
       {
@@ -918,6 +1158,7 @@ bool vtkHDFWriter::WriteDatasetToFile(hid_t group, vtkPartitionedDataSet* input)
     ret &= this->DispatchDataObject(group, partition, partId);
     this->Impl->SetSubFilesReady(save);
   }
+  this->HasSeveralPartitions = false;
   return ret;
 }
 
@@ -1856,6 +2097,23 @@ bool vtkHDFWriter::AppendDataSetAttributes(hid_t baseGroup, vtkDataObject* input
         continue;
       }
 
+      // The values of an unchanged array are not written again, the offset of the current step
+      // is moved back to the values of the previous step.
+      const bool reuseArray = this->ReuseUnchangedArrays && this->IsTemporal && dims.empty() &&
+        this->NbPieces == 1 && !this->UseExternalTimeSteps && !this->HasSeveralPartitions &&
+        !vtkHyperTreeGrid::SafeDownCast(input) &&
+        this->IsArrayUnchanged(
+          this->Impl->GetGroupName(attributeGroup) + "/" + arrayName, array);
+      if (reuseArray &&
+        !this->Impl->AddOrCreateSingleRowDataset(this->Impl->GetStepsGroup(baseGroup),
+          (offsetsGroupNameStr + "/" + arrayName).c_str(), { -array->GetNumberOfTuples() }, true,
+          true))
+      {
+        vtkErrorMacro(<< "Could not reference the previous step values of " << arrayName
+                      << " when creating: " << this->FileName);
+        return false;
+      }
+
       // For temporal data, also add the offset in the steps group
       if (this->IsTemporal &&
         !this->AppendDataArrayOffset(
@@ -1864,8 +2122,12 @@ bool vtkHDFWriter::AppendDataSetAttributes(hid_t baseGroup, vtkDataObject* input
         return false;
       }
 
-      bool writeSuccess = false;
-      if (!dims.empty())
+      bool writeSuccess = reuseArray;
+      if (reuseArray)
+      {
+        vtkDebugMacro(<< "Array " << arrayName << " unchanged since the previous time step");
+      }
+      else if (!dims.empty())
       {
         // Compute dataset dimensions from point or cell data.
         std::vector<hsize_t> fileDims;
@@ -2058,7 +2320,7 @@ bool vtkHDFWriter::AppendBlocks(hid_t group, vtkPartitionedDataSetCollection* pd
       ret &= this->DispatchDataObject(datasetGroup, currentBlock);
       if (auto ds = vtkDataSet::SafeDownCast(currentBlock->GetPartition(0)))
       {
-        this->CompositeMeshMTime[datasetId] = ds->GetMeshMTime();
+        this->CompositeMeshMTime[datasetId] = this->GetSourceMeshMTime(ds);
       }
       else
       {
@@ -2082,6 +2344,8 @@ bool vtkHDFWriter::AppendExternalBlock(vtkDataObject* block, const std::string&
   writer->SetInputData(block);
   writer->SetFileName(subfileName.c_str());
   writer->SetCompressionLevel(this->CompressionLevel);
+  writer->SetCompressorType(this->CompressorType);
+  writer->SetShuffle(this->Shuffle);
   writer->SetChunkSize(this->ChunkSize);
   writer->SetUseExternalComposite(this->UseExternalComposite);
   writer->SetUseExternalPartitions(this->UseExternalPartitions);
@@ -2232,7 +2496,7 @@ bool vtkHDFWriter::AppendIterDataObject(
   auto pds = vtkPartitionedDataSet::SafeDownCast(treeIter->GetCurrentDataObject());
   if (ds)
   {
-    this->CompositeMeshMTime[leafIndex] = ds->GetMeshMTime();
+    this->CompositeMeshMTime[leafIndex] = this->GetSourceMeshMTime(ds);
   }
   else if (pds && pds->GetNumberOfPartitions() > 0)
   {
@@ -2248,7 +2512,7 @@ bool vtkHDFWriter::AppendIterDataObject(
       return true;
     }
     this->CompositeMeshMTime[leafIndex] =
-      vtkDataSet::SafeDownCast(pds->GetPartition(part))->GetMeshMTime();
+      this->GetSourceMeshMTime(vtkDataSet::SafeDownCast(pds->GetPartition(part)));
   }
   else
   {
@@ -2436,7 +2700,8 @@ bool vtkHDFWriter::AppendDataArraySizeOffset(hid_t baseGroup, vtkAbstractArray*
 //------------------------------------------------------------------------------
 bool vtkHDFWriter::HasGeometryChangedFromPreviousStep(vtkDataSet* input)
 {
-  return this->CurrentTimeIndex != 0 && input->GetMeshMTime() != this->PreviousStepMeshMTime;
+  return this->CurrentTimeIndex != 0 &&
+    this->GetSourceMeshMTime(input) != this->PreviousStepMeshMTime;
 }
 
 //------------------------------------------------------------------------------
@@ -2444,8 +2709,76 @@ void vtkHDFWriter::UpdatePreviousStepMeshMTime(vtkDataObject* input)
 {
   if (auto dsInput = vtkDataSet::SafeDownCast(input))
   {
-    this->PreviousStepMeshMTime = dsInput->GetMeshMTime();
+    this->PreviousStepMeshMTime = this->GetSourceMeshMTime(dsInput);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkHDFWriter::GetSourceMeshMTime(vtkDataSet* input)
+{
+  if (this->Background && this->Background->Input)
+  {
+    auto it = this->Background->SourceMTimes.find(input);
+    if (it != this->Background->SourceMTimes.end())
+    {
+      return it->second;
+    }
   }
+  return input->GetMeshMTime();
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkHDFWriter::GetSourceMTime(vtkAbstractArray* array)
+{
+  if (this->Background && this->Background->Input)
+  {
+    auto it = this->Background->SourceMTimes.find(array);
+    if (it != this->Background->SourceMTimes.end())
+    {
+      return it->second;
+    }
+  }
+  return array->GetMTime();
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::IsArrayUnchanged(const std::string& key, vtkAbstractArray* array)
+{
+  ChangeTracker::ArrayState& state = this->Tracker->Arrays[key];
+  const bool sameLayout = this->CurrentTimeIndex > 0 &&
+    state.TimeIndex == this->CurrentTimeIndex - 1 && state.DataType == array->GetDataType() &&
+    state.NumberOfComponents == array->GetNumberOfComponents() &&
+    state.NumberOfTuples == array->GetNumberOfTuples();
+  const vtkMTimeType mtime = this->GetSourceMTime(array);
+
+  bool unchanged = sameLayout && state.MTime == mtime;
+  if (!unchanged)
+  {
+    // The array may have been modified without changing its values
+    auto dataArray = vtkDataArray::SafeDownCast(array);
+    unchanged = sameLayout && ::SameArrayValues(state.Values, dataArray);
+    if (!unchanged)
+    {
+      state.Values = nullptr;
+      if (this->Background && this->Background->Input)
+      {
+        // The array belongs to the copy of the input, which is not modified afterwards
+        state.Values = dataArray;
+      }
+      else if (dataArray && dataArray->HasStandardMemoryLayout())
+      {
+        state.Values = vtk::TakeSmartPointer(dataArray->NewInstance());
+        state.Values->DeepCopy(dataArray);
+      }
+    }
+  }
+
+  state.TimeIndex = this->CurrentTimeIndex;
+  state.MTime = mtime;
+  state.DataType = array->GetDataType();
+  state.NumberOfComponents = array->GetNumberOfComponents();
+  state.NumberOfTuples = array->GetNumberOfTuples();
+  return unchanged;
 }
 
 VTK_ABI_NAMESPACE_END
@@ -38,9 +38,11 @@
 
 #include <map>
 #include <memory>
+#include <string>
 
 VTK_ABI_NAMESPACE_BEGIN
 
+class vtkAbstractArray;
 class vtkCellArray;
 class vtkDataObjectTree;
 class vtkDataSet;
@@ -142,6 +144,44 @@ public:
   vtkGetMacro(CompressionLevel, int);
   ///@}
 
+  enum CompressorType
+  {
+    DEFLATE,
+    ZSTD
+  };
+
+  ///@{
+  /**
+   * Get/set the HDF5 filter used to compress data when CompressionLevel is not 0.
+   * DEFLATE uses the deflate filter built in HDF5.
+   * ZSTD uses the Zstandard filter (HDF5 filter id 32015), which must be available
+   * as an HDF5 filter plugin, for example through the HDF5_PLUGIN_PATH environment
+   * variable. The plugin is also needed to read the file back. If the filter is not
+   * available, DEFLATE is used instead.
+   *
+   * Default to DEFLATE.
+   */
+  vtkSetClampMacro(CompressorType, int, DEFLATE, ZSTD);
+  vtkGetMacro(CompressorType, int);
+  void SetCompressorTypeToDeflate() { this->SetCompressorType(DEFLATE); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
+  ///@}
+
+  ///@{
+  /**
+   * When set, apply the HDF5 shuffle filter to data before compressing it.
+   * The shuffle filter groups the bytes of same significance of all values
+   * of a chunk, which usually improves the compression ratio of multi-byte
+   * values such as floating point fields. Has no effect when CompressionLevel is 0.
+   * The shuffle filter is built in HDF5, so files remain readable by any reader.
+   *
+   * Default to false.
+   */
+  vtkSetMacro(Shuffle, bool);
+  vtkGetMacro(Shuffle, bool);
+  vtkBooleanMacro(Shuffle, bool);
+  ///@}
+
   ///@{
   /**
    * When set, write composite leaf blocks in different files,
@@ -187,6 +227,66 @@ public:
   vtkGetMacro(UseExternalPartitions, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set, point, cell and row data arrays of temporal vtkUnstructuredGrid,
+   * vtkPolyData and vtkTable that are identical to the previous time step are
+   * not written again: the offsets of the current time step reference the
+   * values written for the previous one. An array is considered unchanged when
+   * it has not been modified since the previous time step, or when it has the
+   * same type, size and values as the previous time step. When writing
+   * synchronously, the values of the previous time step are kept in a copy to
+   * compare them.
+   *
+   * This does not apply when writing with several processes, when a
+   * partitioned dataset has more than one partition, or when
+   * UseExternalTimeSteps is set. Geometry is handled separately: it is only
+   * written when the MeshMTime of the input changes.
+   * Default is false.
+   */
+  vtkSetMacro(ReuseUnchangedArrays, bool);
+  vtkGetMacro(ReuseUnchangedArrays, bool);
+  vtkBooleanMacro(ReuseUnchangedArrays, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When set, time steps are written to the file by a background thread.
+   * Each time step is copied, and the pipeline produces the next time step
+   * while the copy is written, so at most two time steps are kept in memory.
+   * An error writing a time step is reported when the next time step is
+   * processed. Write() returns once all time steps are written.
+   *
+   * Only used for temporal data written by a single process, and with an HDF5
+   * library built thread safe, as reported by H5is_library_threadsafe, unless
+   * RequireThreadSafeHDF5 is unset. Time steps are written synchronously
+   * otherwise, since HDF5 based readers or writers upstream of this writer
+   * could run while writing.
+   * Default is false.
+   */
+  vtkSetMacro(WriteAsynchronously, bool);
+  vtkGetMacro(WriteAsynchronously, bool);
+  vtkBooleanMacro(WriteAsynchronously, bool);
+  ///@}
+
+  ///@{
+  /**
+   * When unset, WriteAsynchronously also writes in the background with an HDF5
+   * library that is not thread safe. Only unset it when no HDF5 based reader
+   * or writer is upstream of this writer.
+   * Default is true.
+   */
+  vtkSetMacro(RequireThreadSafeHDF5, bool);
+  vtkGetMacro(RequireThreadSafeHDF5, bool);
+  vtkBooleanMacro(RequireThreadSafeHDF5, bool);
+  ///@}
+
+  /**
+   * Return the number of time steps written by the background thread during
+   * the last write, see WriteAsynchronously.
+   */
+  vtkGetMacro(NumberOfTimeStepsWrittenInBackground, int);
+
 protected:
   /**
    * Override vtkWriter's ProcessRequest method, in order to dispatch the request
@@ -217,6 +317,12 @@ private:
    */
   bool WriteDataAndReturn() override;
 
+  /**
+   * Copy the input and write it in a background thread, waiting for the
+   * previous time step to be written. Close the file after the last time step.
+   */
+  bool RequestDataInBackground(vtkInformation* request);
+
   /**
    * Dispatch the input vtkDataObject to the right writing function, depending on its dynamic type.
    * Data will be written in the specified group, which must already exist.
@@ -463,9 +569,29 @@ private:
    */
   void UpdatePreviousStepMeshMTime(vtkDataObject* input);
 
+  /**
+   * Return true if the array has the same values as the array of the same key
+   * written for the previous time step, and record its state for the next one.
+   */
+  bool IsArrayUnchanged(const std::string& key, vtkAbstractArray* array);
+
+  ///@{
+  /**
+   * Return the MeshMTime or MTime of the input object, or of the object it was
+   * copied from when writing in the background.
+   */
+  vtkMTimeType GetSourceMeshMTime(vtkDataSet* input);
+  vtkMTimeType GetSourceMTime(vtkAbstractArray* array);
+  ///@}
+
   class Implementation;
   std::unique_ptr<Implementation> Impl;
 
+  struct ChangeTracker;
+  std::unique_ptr<ChangeTracker> Tracker;
+  struct BackgroundWriter;
+  std::unique_ptr<BackgroundWriter> Background;
+
   // Configurable properties
   char* FileName = nullptr;
   bool Overwrite = true;
@@ -475,6 +601,12 @@ private:
   bool UseExternalPartitions = false;
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  int CompressorType = DEFLATE;
+  bool Shuffle = false;
+  bool ReuseUnchangedArrays = false;
+  bool WriteAsynchronously = false;
+  bool RequireThreadSafeHDF5 = true;
+  int NumberOfTimeStepsWrittenInBackground = 0;
 
   // Temporal-related private variables
   std::vector<double> timeSteps;
@@ -483,6 +615,7 @@ private:
   int NumberOfTimeSteps = 1;
   vtkMTimeType PreviousStepMeshMTime = 0;
   std::map<vtkIdType, vtkMTimeType> CompositeMeshMTime;
+  bool HasSeveralPartitions = false;
 
   // Distributed-related variables
   vtkMultiProcessController* Controller = nullptr;
@@ -1800,7 +1800,7 @@ bool vtkHDFWriter::Implementation::InitDynamicDataset(hid_t group, const char* n
   H5Pset_chunk(plist, static_cast<int>(dims.size()), chunkSize.data());
   if (this->CompressionLevel != 0)
   {
-    H5Pset_deflate(plist, this->CompressionLevel);
+    this->AddCompressionFilter(plist);
   }
 
   vtkHDF::ScopedH5DHandle dataset =
@@ -1808,6 +1808,38 @@ bool vtkHDFWriter::Implementation::InitDynamicDataset(hid_t group, const char* n
   return dataset != H5I_INVALID_HID;
 }
 
+//------------------------------------------------------------------------------
+void vtkHDFWriter::Implementation::AddCompressionFilter(hid_t plist)
+{
+  // Filters are applied in order: shuffle must come before compression.
+  if (this->Shuffle)
+  {
+    H5Pset_shuffle(plist);
+  }
+
+  if (this->CompressorType == vtkHDFWriter::ZSTD)
+  {
+    // Identifier of the Zstandard filter registered to The HDF Group,
+    // provided by an HDF5 filter plugin.
+    constexpr H5Z_filter_t zstdFilter = 32015;
+    if (H5Zfilter_avail(zstdFilter) > 0)
+    {
+      // Same mapping of levels 1..9 as vtkZstdDataCompressor.
+      constexpr std::array<unsigned int, 9> zstdLevels = { 1, 2, 3, 4, 6, 9, 12, 16, 19 };
+      const unsigned int level = zstdLevels[this->CompressionLevel - 1];
+      H5Pset_filter(plist, zstdFilter, H5Z_FLAG_OPTIONAL, 1, &level);
+      return;
+    }
+    if (!this->ZstdUnavailableReported)
+    {
+      vtkWarningWithObjectMacro(this->Writer,
+        "The HDF5 Zstandard filter plugin is not available, using deflate compression instead.");
+      this->ZstdUnavailableReported = true;
+    }
+  }
+  H5Pset_deflate(plist, this->CompressionLevel);
+}
+
 //------------------------------------------------------------------------------
 void vtkHDFWriter::Implementation::CreateArraysFromNonNullPart(hid_t group, vtkDataObject* data)
 {
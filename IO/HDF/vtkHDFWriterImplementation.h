@@ -31,6 +31,8 @@ public:
 
   void SetChunkSize(int chunkSize) { this->ChunkSize = chunkSize; };
   void SetCompressionLevel(int level) { this->CompressionLevel = level; };
+  void SetCompressorType(int type) { this->CompressorType = type; };
+  void SetShuffle(bool shuffle) { this->Shuffle = shuffle; };
 
   /**
    * Write version and type attributes to the root group
@@ -255,6 +257,14 @@ public:
     const std::vector<hsize_t>& dims, const std::vector<hsize_t>& chunkSize);
   ///@}
 
+  /**
+   * Add the compression filter selected by CompressorType and CompressionLevel
+   * to the dataset creation property list, preceded by the shuffle filter if
+   * Shuffle is set. Fall back to deflate when the Zstandard filter plugin is
+   * not available.
+   */
+  void AddCompressionFilter(hid_t plist);
+
   /**
    * Add a single row of integer type to an existing dataspace.
    * The trim parameter allows to overwrite the last data instead
@@ -337,6 +347,9 @@ private:
   // Forwarded constant properties from the writer
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  int CompressorType = 0;
+  bool Shuffle = false;
+  bool ZstdUnavailableReported = false;
 
   const std::array<std::string, 4> PrimitiveNames = { { "Vertices", "Lines", "Polygons",
     "Strips" } };
@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Test that ASCII arrays are parsed by chunks correctly: large arrays split
+// between threads, values that need the legacy parsing, and arrays followed
+// by other sections of the file.
+
+#include "vtkCellArray.h"
+#include "vtkDataReader.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool TestRoundTrip()
+{
+  vtkLogScopeFunction(INFO);
+
+  // Values with a short exact decimal representation, so that the round trip is exact.
+  constexpr vtkIdType numberOfPoints = 200000;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName("Bytes");
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i * 0.25, -i * 0.5, (i % 1000) * 0.125);
+    verts->InsertNextCell(1, &i);
+    doubles->InsertNextValue(i * -0.0625);
+    ints->InsertNextValue(static_cast<int>(i * 7919 % 100003) - 50000);
+    bytes->InsertNextValue(static_cast<unsigned char>(i % 256));
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->GetPointData()->AddArray(doubles);
+  input->GetPointData()->AddArray(ints);
+  input->GetPointData()->AddArray(bytes);
+
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(input);
+  writer->SetFileTypeToASCII();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputStdString());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  if (output->GetNumberOfPoints() != numberOfPoints || output->GetNumberOfVerts() != numberOfPoints)
+  {
+    vtkLog(ERROR, "Wrong number of points or cells read back.");
+    return false;
+  }
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double expected[3];
+    double actual[3];
+    input->GetPoint(i, expected);
+    output->GetPoint(i, actual);
+    for (int c = 0; c < 3; ++c)
+    {
+      if (expected[c] != actual[c])
+      {
+        vtkLog(ERROR, "Wrong coordinate " << c << " for point " << i);
+        return false;
+      }
+    }
+  }
+  for (const char* name : { "Doubles", "Ints", "Bytes" })
+  {
+    vtkDataArray* expected = input->GetPointData()->GetArray(name);
+    vtkDataArray* actual = output->GetPointData()->GetArray(name);
+    if (!actual || actual->GetNumberOfTuples() != numberOfPoints ||
+      actual->GetDataType() != expected->GetDataType())
+    {
+      vtkLog(ERROR, "Cannot read back array " << name);
+      return false;
+    }
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      if (expected->GetComponent(i, 0) != actual->GetComponent(i, 0))
+      {
+        vtkLog(ERROR, "Wrong value " << i << " for array " << name);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ArrayType>
+bool TestValues(const char* dataType, const std::string& text,
+  const std::vector<typename ArrayType::ValueType>& expected, const char* next)
+{
+  vtkNew<vtkDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(text);
+  reader->OpenVTKFile();
+  const vtkIdType numberOfValues = static_cast<vtkIdType>(expected.size());
+  auto array =
+    vtk::TakeSmartPointer(ArrayType::SafeDownCast(reader->ReadArray(dataType, numberOfValues, 1)));
+  if (!array)
+  {
+    vtkLog(ERROR, "Cannot read " << dataType << " values from <<" << text << ">>");
+    return false;
+  }
+  for (vtkIdType i = 0; i < numberOfValues; ++i)
+  {
+    if (array->GetValue(i) != expected[i])
+    {
+      vtkLog(ERROR, "Wrong value " << i << " read from <<" << text << ">>");
+      return false;
+    }
+  }
+
+  // The stream must be left just after the last value.
+  char line[256];
+  if (!reader->ReadString(line) || std::string(line) != next)
+  {
+    vtkLog(ERROR, "Wrong position after reading <<" << text << ">>");
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestLegacyValues()
+{
+  vtkLogScopeFunction(INFO);
+  return ::TestValues<vtkFloatArray>("float", "\n+1.5 .5 1e3 -0 2.\nPOINT_DATA",
+           { 1.5f, 0.5f, 1000.f, 0.f, 2.f }, "POINT_DATA") &&
+    ::TestValues<vtkIntArray>("int", " 007 +3 -2\n0 9 10", { 7, 3, -2, 0, 9 }, "10") &&
+    ::TestValues<vtkUnsignedCharArray>(
+      "unsigned_char", "0 255 12\nLOOKUP_TABLE", { 0, 255, 12 }, "LOOKUP_TABLE");
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLegacyASCIIParsing(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+  return (::TestRoundTrip() && ::TestLegacyValues()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -34,6 +34,7 @@
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStringArray.h"
 #include "vtkStringScanner.h"
@@ -44,6 +45,7 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
+#include "vtkValueFromString.h"
 #include "vtkVariantArray.h"
 
 #include "vtksys/FStream.hxx"
@@ -52,6 +54,7 @@
 #include <algorithm>
 #include <cctype>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
@@ -233,6 +236,202 @@ void read_stream_fp(std::istream& stream, Number& xx)
   parse_on_fail<Number>(stream, xx, neg);
 }
 
+bool IsASCIISpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Parse a token rejected by vtkValueFromString (leading '+' of floats,
+// "infinity"...) the way vtkDataReader::Read does.
+template <typename T>
+bool ParseASCIITokenLegacy(const char* begin, const char* end, T& value)
+{
+  std::istringstream tokenStream(std::string(begin, end));
+  tokenStream.imbue(std::locale::classic());
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    read_stream_fp(tokenStream, value);
+  }
+  else
+  {
+    tokenStream >> value;
+  }
+  return !tokenStream.fail() && tokenStream.peek() == std::istream::traits_type::eof();
+}
+
+// Parse count whitespace separated values from the stream into data, reading
+// it by large chunks instead of one value at a time. Large chunks are split at
+// whitespace and parsed concurrently. Values of single byte types are read as
+// int, like vtkDataReader::Read does.
+// Parsing stops at the first token that is not a single valid value, so that
+// the caller reads it with vtkDataReader::Read and reports errors as before.
+// The stream is left just after the last parsed value, which needs a seekable
+// stream: nothing is parsed otherwise.
+// Return the number of parsed values.
+template <typename T>
+vtkIdType ParseASCIIData(istream* stream, T* data, vtkIdType count)
+{
+  using ValueType = typename std::conditional<sizeof(T) == 1, int, T>::type;
+  if (count <= 0 || !stream->good() || stream->tellg() == std::streampos(-1))
+  {
+    return 0;
+  }
+
+  constexpr std::size_t maxChunkSize = 1 << 20;
+  constexpr std::size_t minPieceSize = 1 << 16;
+  const std::size_t maxPieces =
+    static_cast<std::size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+
+  struct Piece
+  {
+    std::size_t Begin = 0;
+    std::size_t End = 0;
+    vtkIdType FirstToken = 0;
+    vtkIdType NumberOfTokens = 0;
+    // Position after the last parsed token, and position of the rejected one if any.
+    std::size_t ParsedEnd = 0;
+    std::size_t Rejected = 0;
+    vtkIdType RejectedToken = -1;
+  };
+
+  std::vector<char> buffer;
+  std::vector<Piece> pieces;
+  std::size_t carried = 0; // start of a token read with the previous chunk
+  vtkIdType parsed = 0;
+  while (true)
+  {
+    // Do not read much more than the remaining values, most likely followed by other sections.
+    const std::size_t chunkSize = std::min(
+      maxChunkSize, std::max<std::size_t>(4096, static_cast<std::size_t>(count - parsed) * 16));
+    buffer.resize(carried + chunkSize);
+    stream->read(buffer.data() + carried, chunkSize);
+    const std::size_t size = carried + static_cast<std::size_t>(stream->gcount());
+    const bool atEnd = size < buffer.size();
+
+    // Only complete tokens are parsed: the last one may continue in the next chunk.
+    std::size_t complete = size;
+    while (!atEnd && complete > 0 && !::IsASCIISpace(buffer[complete - 1]))
+    {
+      --complete;
+    }
+
+    // Split at whitespace and count the tokens of each piece.
+    const std::size_t numPieces =
+      std::max<std::size_t>(1, std::min(maxPieces, complete / minPieceSize));
+    pieces.assign(numPieces, Piece());
+    for (std::size_t p = 1; p < numPieces; ++p)
+    {
+      std::size_t bound = std::max(pieces[p - 1].Begin, p * complete / numPieces);
+      while (bound < complete && !::IsASCIISpace(buffer[bound]))
+      {
+        ++bound;
+      }
+      pieces[p - 1].End = pieces[p].Begin = bound;
+    }
+    pieces.back().End = complete;
+
+    const char* chars = buffer.data();
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numPieces), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType p = begin; p < end; ++p)
+        {
+          Piece& piece = pieces[p];
+          bool inSpace = true;
+          for (std::size_t i = piece.Begin; i < piece.End; ++i)
+          {
+            const bool space = ::IsASCIISpace(chars[i]);
+            piece.NumberOfTokens += (inSpace && !space) ? 1 : 0;
+            inSpace = space;
+          }
+        }
+      });
+    vtkIdType numTokens = 0;
+    for (Piece& piece : pieces)
+    {
+      piece.FirstToken = numTokens;
+      numTokens += piece.NumberOfTokens;
+    }
+
+    const vtkIdType remaining = count - parsed;
+    T* output = data + parsed;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numPieces), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType p = begin; p < end; ++p)
+        {
+          Piece& piece = pieces[p];
+          piece.ParsedEnd = piece.Begin;
+          vtkIdType token = piece.FirstToken;
+          std::size_t i = piece.Begin;
+          while (token < remaining)
+          {
+            while (i < piece.End && ::IsASCIISpace(chars[i]))
+            {
+              ++i;
+            }
+            if (i == piece.End)
+            {
+              break;
+            }
+            std::size_t tokenEnd = i;
+            while (tokenEnd < piece.End && !::IsASCIISpace(chars[tokenEnd]))
+            {
+              ++tokenEnd;
+            }
+            ValueType value;
+            if (vtkValueFromString(chars + i, chars + tokenEnd, value) != tokenEnd - i &&
+              !::ParseASCIITokenLegacy(chars + i, chars + tokenEnd, value))
+            {
+              piece.Rejected = i;
+              piece.RejectedToken = token;
+              break;
+            }
+            output[token++] = static_cast<T>(value);
+            i = piece.ParsedEnd = tokenEnd;
+          }
+        }
+      });
+
+    // Find where parsing stopped in this chunk, if it did.
+    std::size_t stop = size;
+    bool done = false;
+    for (const Piece& piece : pieces)
+    {
+      if (piece.RejectedToken >= 0)
+      {
+        parsed += piece.RejectedToken;
+        stop = piece.Rejected;
+        done = true;
+        break;
+      }
+      if (piece.FirstToken + piece.NumberOfTokens >= remaining)
+      {
+        parsed = count;
+        stop = piece.ParsedEnd;
+        done = true;
+        break;
+      }
+    }
+    if (!done)
+    {
+      parsed += numTokens;
+      if (atEnd)
+      {
+        return parsed;
+      }
+      carried = size - complete;
+      std::copy(buffer.begin() + complete, buffer.begin() + size, buffer.begin());
+      continue;
+    }
+
+    // Give back what was read beyond the last parsed value.
+    stream->clear();
+    stream->seekg(-static_cast<std::streamoff>(size - stop), std::ios_base::cur);
+    return parsed;
+  }
+}
+
 } // anonmyous namespace
 
 static int my_getline(istream& in, std::string& output, char delim = '\n');
@@ -1745,17 +1944,16 @@ int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdTyp
   {
     return 0;
   }
-  for (vtkIdType i = 0; i < numTuples; i++)
+  const vtkIdType count = numTuples * numComp;
+  vtkIdType i = 0;
+  while ((i += ::ParseASCIIData(self->GetIStream(), data + i, count - i)) < count)
   {
-    for (vtkIdType j = 0; j < numComp; j++)
+    if (!self->Read(data + i++))
     {
-      if (!self->Read(data++))
-      {
-        vtkErrorWithObjectMacro(self,
-          "Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
-      }
+      vtkErrorWithObjectMacro(self,
+        "Error reading ascii data. Possible mismatch of "
+        "datasize with declaration.");
+      return 0;
     }
   }
   return 1;
@@ -3424,7 +3622,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3442,9 +3639,10 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    vtkIdType parsed = 0;
+    while ((parsed += ::ParseASCIIData(this->IS, data + parsed, size - parsed)) < size)
     {
-      if (!this->Read(data + i))
+      if (!this->Read(data + parsed++))
       {
         const char* fname = this->CurrentFileName.c_str();
         vtkErrorMacro(<< "Error reading ascii cell data!"
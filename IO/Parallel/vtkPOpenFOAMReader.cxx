@@ -545,11 +545,15 @@ int vtkPOpenFOAMReader::RequestInformation(
 
           auto masterReader = ::NewFoamReader(this);
 
-          if (!masterReader->MakeInformationVector(outputVector, procDirName) ||
-            !masterReader->MakeMetaDataAtTimeStep(true, /*skipComputingMetaData=*/false))
+          if (!masterReader->MakeInformationVectorFromIndex(outputVector, procDirName))
           {
-            returnCode = 0;
-            break; // Failed
+            if (!masterReader->MakeInformationVector(outputVector, procDirName) ||
+              !masterReader->MakeMetaDataAtTimeStep(true, /*skipComputingMetaData=*/false))
+            {
+              returnCode = 0;
+              break; // Failed
+            }
+            masterReader->WriteMetadataIndex(procDirName);
           }
           this->Superclass::Readers.emplace_back(masterReader);
           timeNames = masterReader->GetTimeNames();
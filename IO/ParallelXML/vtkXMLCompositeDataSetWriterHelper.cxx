@@ -82,6 +82,7 @@ vtkXMLWriterBase* vtkXMLCompositeDataSetWriterHelper::GetWriter(int dataType)
     writer->SetByteOrder(this->Writer->GetByteOrder());
     writer->SetCompressor(this->Writer->GetCompressor());
     writer->SetBlockSize(this->Writer->GetBlockSize());
+    writer->SetCompressionFilter(this->Writer->GetCompressionFilter());
     writer->SetDataMode(this->Writer->GetDataMode());
     writer->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
     writer->SetHeaderType(this->Writer->GetHeaderType());
@@ -99,6 +99,7 @@ int vtkXMLPDataSetWriter::WriteInternal()
   writer->SetByteOrder(this->GetByteOrder());
   writer->SetCompressor(this->GetCompressor());
   writer->SetBlockSize(this->GetBlockSize());
+  writer->SetCompressionFilter(this->GetCompressionFilter());
   writer->SetDataMode(this->GetDataMode());
   writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
   writer->SetHeaderType(this->GetHeaderType());
@@ -117,6 +117,7 @@ int vtkXMLPHyperTreeGridWriter::WritePiece(int index)
   pWriter->SetEncodeAppendedData(this->EncodeAppendedData);
   pWriter->SetHeaderType(this->HeaderType);
   pWriter->SetBlockSize(this->BlockSize);
+  pWriter->SetCompressionFilter(this->CompressionFilter);
   pWriter->SetWriteTimeValue(this->GetWriteTimeValue());
 
   // Write the piece.
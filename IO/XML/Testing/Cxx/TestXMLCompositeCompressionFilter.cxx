@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the composite XML writers pass their compression filter to the
+// writers of their leaves, and that the leaves are read back unchanged.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTesting.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLPartitionedDataSetCollectionReader.h"
+#include "vtkXMLPartitionedDataSetCollectionWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#include <vtksys/Glob.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> MakeLeaf(int index)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(index, 0.0, 0.0);
+  sphere->SetThetaResolution(24 + index);
+  sphere->SetPhiResolution(16);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> leaf = sphere->GetOutput();
+
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("Floats");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  doubles->SetNumberOfComponents(3);
+  for (vtkIdType i = 0; i < leaf->GetNumberOfPoints(); i++)
+  {
+    double point[3];
+    leaf->GetPoint(i, point);
+    floats->InsertNextValue(static_cast<float>(point[0] * point[1] + index));
+    doubles->InsertNextTuple3(point[2], 1.0 / (i + 1), i * 0.5);
+  }
+  leaf->GetPointData()->AddArray(floats);
+  leaf->GetPointData()->AddArray(doubles);
+  return leaf;
+}
+
+//------------------------------------------------------------------------------
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); i++)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameLeaf(vtkPolyData* expected, vtkDataObject* read)
+{
+  vtkPolyData* leaf = vtkPolyData::SafeDownCast(read);
+  if (!leaf)
+  {
+    std::cerr << "Missing leaf.\n";
+    return false;
+  }
+  bool same = ::SameArrays(expected->GetPoints()->GetData(), leaf->GetPoints()->GetData());
+  for (const char* name : { "Floats", "Doubles" })
+  {
+    same = same &&
+      ::SameArrays(expected->GetPointData()->GetArray(name), leaf->GetPointData()->GetArray(name));
+  }
+  if (!same)
+  {
+    std::cerr << "Leaf read back with different values.\n";
+  }
+  return same;
+}
+
+//------------------------------------------------------------------------------
+// Every file written for the leaves must declare the filtered headers.
+bool CheckLeafFiles(const std::string& directory)
+{
+  vtksys::Glob glob;
+  glob.RecurseOn();
+  glob.FindFiles(directory + "/*.vtp");
+  const std::vector<std::string>& files = glob.GetFiles();
+  if (files.empty())
+  {
+    std::cerr << "No leaf file found in " << directory << ".\n";
+    return false;
+  }
+  for (const std::string& file : files)
+  {
+    std::ifstream stream(file, std::ios::binary);
+    const std::string content(
+      (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (content.find("compression_header=\"2\"") == std::string::npos)
+    {
+      std::cerr << file << " was written without the compression filter.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void SetupWriter(vtkXMLWriterBase* writer, int filter)
+{
+  writer->SetCompressorTypeToZLib();
+  writer->SetDataModeToAppended();
+  writer->EncodeAppendedDataOff();
+  writer->SetBlockSize(1024);
+  writer->SetCompressionFilter(filter);
+}
+
+//------------------------------------------------------------------------------
+bool TestMultiBlock(const std::string& directory, int filter)
+{
+  vtkSmartPointer<vtkPolyData> leaves[] = { ::MakeLeaf(0), ::MakeLeaf(1) };
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetBlock(0, leaves[0]);
+  input->SetBlock(1, leaves[1]);
+
+  vtksys::SystemTools::MakeDirectory(directory);
+  const std::string fileName = directory + "/multiblock.vtm";
+  vtkNew<vtkXMLMultiBlockDataWriter> writer;
+  ::SetupWriter(writer, filter);
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(input);
+  if (!writer->Write() || !::CheckLeafFiles(directory))
+  {
+    return false;
+  }
+
+  vtkNew<vtkXMLMultiBlockDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  return output && output->GetNumberOfBlocks() == 2 &&
+    ::SameLeaf(leaves[0], output->GetBlock(0)) && ::SameLeaf(leaves[1], output->GetBlock(1));
+}
+
+//------------------------------------------------------------------------------
+bool TestPartitionedDataSetCollection(const std::string& directory, int filter)
+{
+  vtkSmartPointer<vtkPolyData> leaves[] = { ::MakeLeaf(2), ::MakeLeaf(3) };
+  vtkNew<vtkPartitionedDataSetCollection> input;
+  input->SetPartition(0, 0, leaves[0]);
+  input->SetPartition(1, 0, leaves[1]);
+
+  vtksys::SystemTools::MakeDirectory(directory);
+  const std::string fileName = directory + "/collection.vtpc";
+  vtkNew<vtkXMLPartitionedDataSetCollectionWriter> writer;
+  ::SetupWriter(writer, filter);
+  writer->SetFileName(fileName.c_str());
+  writer->SetInputData(input);
+  if (!writer->Write() || !::CheckLeafFiles(directory))
+  {
+    return false;
+  }
+
+  vtkNew<vtkXMLPartitionedDataSetCollectionReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPartitionedDataSetCollection* output =
+    vtkPartitionedDataSetCollection::SafeDownCast(reader->GetOutputDataObject(0));
+  return output && output->GetNumberOfPartitionedDataSets() == 2 &&
+    ::SameLeaf(leaves[0], output->GetPartitionAsDataObject(0, 0)) &&
+    ::SameLeaf(leaves[1], output->GetPartitionAsDataObject(1, 0));
+}
+}
+
+//------------------------------------------------------------------------------
+int TestXMLCompositeCompressionFilter(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDirectory =
+    std::string(testing->GetTempDirectory()) + "/TestXMLCompositeCompressionFilter";
+
+  for (int filter : { vtkXMLWriterBase::ByteShuffle, vtkXMLWriterBase::XORDeltaByteShuffle })
+  {
+    const std::string suffix = std::to_string(filter);
+    vtksys::SystemTools::RemoveADirectory(tempDirectory);
+    if (!::TestMultiBlock(tempDirectory + "/multiblock_" + suffix, filter))
+    {
+      std::cerr << "Multiblock round trip failed with filter " << filter << ".\n";
+      return EXIT_FAILURE;
+    }
+    if (!::TestPartitionedDataSetCollection(tempDirectory + "/collection_" + suffix, filter))
+    {
+      std::cerr << "Partitioned dataset collection round trip failed with filter " << filter
+                << ".\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the prefetch mode of XML readers gives the same time steps as
+// the regular reads, and that sequential requests are served from the cache.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfTimeSteps = 6;
+constexpr vtkIdType NumberOfPoints = 1000;
+
+//------------------------------------------------------------------------------
+void WriteTimeSteps(const std::string& fileName)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  vtkNew<vtkUnstructuredGrid> grid;
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i, 0, 0);
+    values->InsertNextValue(0);
+    grid->InsertNextCell(VTK_VERTEX, 1, &i);
+  }
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(values);
+
+  vtkNew<vtkXMLUnstructuredGridWriter> writer;
+  writer->SetInputData(grid);
+  writer->SetFileName(fileName.c_str());
+  writer->SetNumberOfTimeSteps(NumberOfTimeSteps);
+  writer->Start();
+  for (int step = 0; step < NumberOfTimeSteps; ++step)
+  {
+    for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+    {
+      values->SetValue(i, step * NumberOfPoints + i);
+    }
+    values->Modified();
+    // Points only change every other time step.
+    if (step % 2 == 0)
+    {
+      for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+      {
+        points->SetPoint(i, i, step, 0);
+      }
+      points->Modified();
+    }
+    writer->WriteNextTime(step);
+  }
+  writer->Stop();
+}
+
+//------------------------------------------------------------------------------
+bool CheckTimeStep(vtkUnstructuredGrid* output, int step)
+{
+  vtkDataArray* values = output->GetPointData()->GetArray("Values");
+  if (output->GetNumberOfPoints() != NumberOfPoints || !values)
+  {
+    vtkLog(ERROR, "Wrong output for time step " << step);
+    return false;
+  }
+  const int pointsStep = step - step % 2;
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double x[3];
+    output->GetPoint(i, x);
+    if (values->GetComponent(i, 0) != step * NumberOfPoints + i || x[0] != i ||
+      x[1] != pointsStep)
+    {
+      vtkLog(ERROR, "Wrong value or point " << i << " for time step " << step);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestXMLReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestXMLReaderPrefetch.vtu";
+  delete[] tempDir;
+  ::WriteTimeSteps(fileName);
+
+  vtkNew<vtkXMLUnstructuredGridReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->PrefetchOn();
+  reader->UpdateInformation();
+  if (reader->GetNumberOfTimeSteps() != NumberOfTimeSteps)
+  {
+    vtkLog(ERROR, "Wrong number of time steps: " << reader->GetNumberOfTimeSteps());
+    return EXIT_FAILURE;
+  }
+
+  // Forward, then backward with a stride of 2.
+  const std::vector<int> requests = { 0, 1, 2, 3, 4, 5, 3, 1 };
+  for (int step : requests)
+  {
+    reader->UpdateTimeStep(step);
+    if (!::CheckTimeStep(reader->GetOutput(), step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  // 0 and 3 are read on demand, the others are prefetched.
+  if (reader->GetNumberOfPrefetchHits() != 6 || reader->GetNumberOfPrefetchMisses() != 2)
+  {
+    vtkLog(ERROR,
+      "Expected 6 hits and 2 misses, got " << reader->GetNumberOfPrefetchHits() << " and "
+                                           << reader->GetNumberOfPrefetchMisses());
+    return EXIT_FAILURE;
+  }
+
+  // Changing the array selection discards prefetched time steps.
+  reader->ResetPrefetchStatistics();
+  reader->SetPointArrayStatus("Values", 0);
+  reader->UpdateTimeStep(0);
+  if (reader->GetNumberOfPrefetchMisses() != 1 ||
+    reader->GetOutput()->GetPointData()->GetArray("Values"))
+  {
+    vtkLog(ERROR, "Prefetched time steps should be discarded when the settings change.");
+    return EXIT_FAILURE;
+  }
+
+  // Going back to regular reads after prefetching gives the right time steps.
+  reader->SetPointArrayStatus("Values", 1);
+  reader->UpdateTimeStep(4);
+  reader->PrefetchOff();
+  for (int step : { 5, 2, 1 })
+  {
+    reader->UpdateTimeStep(step);
+    if (!::CheckTimeStep(reader->GetOutput(), step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
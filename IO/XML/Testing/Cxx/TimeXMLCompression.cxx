@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Write and read back a smooth floating point field with each compressor and
+// compression filter, check the round trip and report the compression ratio
+// and throughput. The blocks are compressed and uncompressed concurrently, so
+// the throughput scales with the number of vtkSMPTools threads.
+
+#include "vtkFeatures.h" // for VTK_USE_ZSTD
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+int TimeXMLCompression(int, char*[])
+{
+  constexpr int dim = 160;
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(dim, dim, dim);
+  vtkNew<vtkFloatArray> field;
+  field->SetName("Field");
+  field->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < field->GetNumberOfTuples(); ++i)
+  {
+    double x[3];
+    image->GetPoint(i, x);
+    field->SetValue(i, static_cast<float>(std::sin(0.05 * x[0]) * std::cos(0.03 * x[1]) + x[2]));
+  }
+  image->GetPointData()->AddArray(field);
+
+  // Single byte values are never filtered.
+  vtkNew<vtkUnsignedCharArray> mask;
+  mask->SetName("Mask");
+  mask->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < mask->GetNumberOfTuples(); ++i)
+  {
+    mask->SetValue(i, static_cast<unsigned char>(i % 7 == 0));
+  }
+  image->GetPointData()->AddArray(mask);
+  const double megabytes =
+    (field->GetDataSize() * sizeof(float) + mask->GetDataSize()) / 1048576.0;
+
+  std::vector<std::string> names = { "None", "ZLib", "LZ4", "LZMA" };
+  std::vector<int> types = { vtkXMLWriterBase::NONE, vtkXMLWriterBase::ZLIB,
+    vtkXMLWriterBase::LZ4, vtkXMLWriterBase::LZMA };
+#ifdef VTK_USE_ZSTD
+  names.emplace_back("Zstd");
+  types.push_back(vtkXMLWriterBase::ZSTD);
+#endif
+
+  std::cout << "Using " << vtkSMPTools::GetEstimatedNumberOfThreads() << " "
+            << vtkSMPTools::GetBackend() << " threads, " << megabytes << " MiB\n";
+
+  const std::vector<std::string> filterNames = { "", " + ByteShuffle", " + XORDeltaByteShuffle" };
+  const std::vector<int> filters = { vtkXMLWriterBase::NoFilter, vtkXMLWriterBase::ByteShuffle,
+    vtkXMLWriterBase::XORDeltaByteShuffle };
+
+  vtkNew<vtkTimerLog> timer;
+  for (size_t run = 0; run < types.size() * filters.size(); ++run)
+  {
+    const size_t c = run / filters.size();
+    const size_t f = run % filters.size();
+    if (types[c] == vtkXMLWriterBase::NONE && filters[f] != vtkXMLWriterBase::NoFilter)
+    {
+      continue;
+    }
+    const std::string name = names[c] + filterNames[f];
+
+    vtkNew<vtkXMLImageDataWriter> writer;
+    writer->SetInputData(image);
+    writer->SetCompressorType(types[c]);
+    writer->SetCompressionFilter(filters[f]);
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    writer->WriteToOutputStringOn();
+    timer->StartTimer();
+    writer->Write();
+    timer->StopTimer();
+    const double writeTime = timer->GetElapsedTime();
+    const std::string output = writer->GetOutputString();
+
+    vtkNew<vtkXMLImageDataReader> reader;
+    reader->ReadFromInputStringOn();
+    reader->SetInputString(output);
+    timer->StartTimer();
+    reader->Update();
+    timer->StopTimer();
+    const double readTime = timer->GetElapsedTime();
+
+    vtkDataArray* result = reader->GetOutput()->GetPointData()->GetArray("Field");
+    vtkDataArray* resultMask = reader->GetOutput()->GetPointData()->GetArray("Mask");
+    if (!result || result->GetNumberOfTuples() != field->GetNumberOfTuples() || !resultMask ||
+      resultMask->GetNumberOfTuples() != mask->GetNumberOfTuples())
+    {
+      vtkLog(ERROR, "Cannot read back data written with " << name);
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < field->GetNumberOfTuples(); ++i)
+    {
+      if (result->GetComponent(i, 0) != field->GetValue(i) ||
+        resultMask->GetComponent(i, 0) != mask->GetValue(i))
+      {
+        vtkLog(ERROR, "Wrong value " << i << " read back with " << name);
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << name << ": ratio " << megabytes * 1048576.0 / output.size() << ", write "
+              << megabytes / writeTime << " MiB/s, read " << megabytes / readTime << " MiB/s\n";
+  }
+
+  return EXIT_SUCCESS;
+}
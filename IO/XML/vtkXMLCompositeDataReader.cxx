@@ -97,6 +97,13 @@ void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::CopyPrefetchSettings(vtkXMLReader* reader)
+{
+  this->Superclass::CopyPrefetchSettings(reader);
+  static_cast<vtkXMLCompositeDataReader*>(reader)->SetPieceDistribution(this->PieceDistribution);
+}
+
 //------------------------------------------------------------------------------
 const char* vtkXMLCompositeDataReader::GetDataSetName()
 {
@@ -86,6 +86,8 @@ protected:
   // Setup the output with no data available.  Used in error cases.
   void SetupEmptyOutput() override;
 
+  void CopyPrefetchSettings(vtkXMLReader* reader) override;
+
   int FillOutputPortInformation(int, vtkInformation* info) override;
 
   // Create a default executive.
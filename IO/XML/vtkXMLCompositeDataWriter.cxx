@@ -473,6 +473,7 @@ void vtkXMLCompositeDataWriter::CreateWriters(vtkCompositeDataSet* hdInput)
       writer->SetByteOrder(this->GetByteOrder());
       writer->SetCompressor(this->GetCompressor());
       writer->SetBlockSize(this->GetBlockSize());
+      writer->SetCompressionFilter(this->GetCompressionFilter());
       writer->SetDataMode(this->GetDataMode());
       writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
       writer->SetHeaderType(this->GetHeaderType());
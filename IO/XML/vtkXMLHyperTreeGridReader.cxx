@@ -64,6 +64,20 @@ void vtkXMLHyperTreeGridReader::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLHyperTreeGridReader::CopyPrefetchSettings(vtkXMLReader* reader)
+{
+  this->Superclass::CopyPrefetchSettings(reader);
+  auto htgReader = static_cast<vtkXMLHyperTreeGridReader*>(reader);
+  htgReader->FixedLevel = this->FixedLevel;
+  htgReader->FixedHTs = this->FixedHTs;
+  htgReader->SelectedHTs = this->SelectedHTs;
+  std::copy_n(this->CoordinatesBoundingBox, 6, htgReader->CoordinatesBoundingBox);
+  std::copy_n(this->IndicesBoundingBox, 6, htgReader->IndicesBoundingBox);
+  htgReader->IdsSelected = this->IdsSelected;
+  htgReader->Verbose = this->Verbose;
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLHyperTreeGridReader::SetCoordinatesBoundingBox(
   double xmin, double xmax, double ymin, double ymax, double zmin, double zmax)
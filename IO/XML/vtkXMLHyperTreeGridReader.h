@@ -116,6 +116,8 @@ protected:
 
   const char* GetDataSetName() override;
 
+  void CopyPrefetchSettings(vtkXMLReader* reader) override;
+
   void DestroyPieces();
 
   void GetOutputUpdateExtent(int& piece, int& numberOfPieces);
@@ -54,6 +54,13 @@ void vtkXMLMultiBlockDataReader::PrintSelf(ostream& os, vtkIndent indent)
   os << std::endl;
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLMultiBlockDataReader::CopyPrefetchSettings(vtkXMLReader* reader)
+{
+  this->Superclass::CopyPrefetchSettings(reader);
+  static_cast<vtkXMLMultiBlockDataReader*>(reader)->Selectors = this->Selectors;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLMultiBlockDataReader::FillOutputPortInformation(
   int vtkNotUsed(port), vtkInformation* info)
@@ -83,6 +83,8 @@ protected:
 
   int FillOutputPortInformation(int, vtkInformation* info) override;
 
+  void CopyPrefetchSettings(vtkXMLReader* reader) override;
+
   // Read the XML element for the subtree of a composite dataset.
   // dataSetIndex is used to rank the leaf nodes in an inorder traversal.
   void ReadComposite(vtkXMLDataElement* element, vtkCompositeDataSet* composite,
@@ -12,6 +12,7 @@
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkErrorCode.h"
+#include "vtkFeatures.h" // for VTK_USE_ZSTD
 #include "vtkFileResourceStream.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
@@ -27,26 +28,33 @@
 #include "vtkInformationVector.h"
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkQuadratureSchemeDefinition.h"
 #include "vtkResourceStream.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkTypeList.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <locale> // C++ locale
 #include <numeric>
@@ -262,6 +270,10 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << "," << this->TimeStepRange[1]
      << ")\n";
+  os << indent << "Prefetch: " << (this->Prefetch ? "On" : "Off") << "\n";
+  os << indent << "PrefetchCacheSize: " << this->PrefetchCacheSize << "\n";
+  os << indent << "NumberOfPrefetchHits: " << this->NumberOfPrefetchHits << "\n";
+  os << indent << "NumberOfPrefetchMisses: " << this->NumberOfPrefetchMisses << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -568,6 +580,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#ifdef VTK_USE_ZSTD
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -771,6 +789,13 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), steps[this->CurrentTimeStep]);
+
+    if (this->Prefetch && this->RequestPrefetchedData(outInfo, output))
+    {
+      this->UpdateProgress(1.);
+      this->CurrentOutput = nullptr;
+      return 1;
+    }
   }
 
   // Re-open the input file.  If it fails, the error was already
@@ -842,6 +867,198 @@ int vtkXMLReader::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Pipeline request of a time step, used as prefetch cache key.
+struct vtkXMLReaderTimeStepRequest
+{
+  int TimeStep = 0;
+  int Piece = 0;
+  int NumberOfPieces = 1;
+  int GhostLevels = 0;
+  bool HasExtent = false;
+  std::array<int, 6> Extent{};
+
+  bool operator==(const vtkXMLReaderTimeStepRequest& other) const
+  {
+    return this->TimeStep == other.TimeStep && this->Piece == other.Piece &&
+      this->NumberOfPieces == other.NumberOfPieces && this->GhostLevels == other.GhostLevels &&
+      this->HasExtent == other.HasExtent && (!this->HasExtent || this->Extent == other.Extent);
+  }
+};
+
+//------------------------------------------------------------------------------
+// Read a time step with a reader used by this request only, and return a
+// shallow copy of its output, or nullptr on error.
+vtkSmartPointer<vtkDataObject> ReadPrefetchTimeStep(
+  vtkSmartPointer<vtkXMLReader> reader, double time, vtkXMLReaderTimeStepRequest request)
+{
+  if (!reader->UpdateTimeStep(time, request.Piece, request.NumberOfPieces, request.GhostLevels,
+        request.HasExtent ? request.Extent.data() : nullptr) ||
+    reader->GetErrorCode() != vtkErrorCode::NoError)
+  {
+    return nullptr;
+  }
+  vtkDataObject* output = reader->GetOutputDataObject(0);
+  auto result = vtk::TakeSmartPointer(output->NewInstance());
+  result->ShallowCopy(output);
+  return result;
+}
+}
+
+//------------------------------------------------------------------------------
+struct vtkXMLReader::vtkPrefetchInternals
+{
+  struct Entry
+  {
+    vtkXMLReaderTimeStepRequest Request;
+    vtkThreadedCallbackQueue::SharedFuturePointer<vtkSmartPointer<vtkDataObject>> Future;
+  };
+
+  // One background thread, owned by the reader.
+  vtkNew<vtkThreadedCallbackQueue> Queue;
+  // Least recently used entries first.
+  std::deque<Entry> Entries;
+  // Reader MTime when the entries were requested.
+  vtkMTimeType SettingsTime = 0;
+  int LastTimeStep = -1;
+  int Stride = 1;
+};
+
+//------------------------------------------------------------------------------
+bool vtkXMLReader::RequestPrefetchedData(vtkInformation* outInfo, vtkDataObject* output)
+{
+  double* steps = outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const int numberOfSteps = outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  if (numberOfSteps < 2 || !this->FileName || this->ReadFromInputString ||
+    this->ReadFromInputStream || this->InformationError)
+  {
+    return false;
+  }
+
+  vtkXMLReaderTimeStepRequest request;
+  request.TimeStep = this->CurrentTimeStep;
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()))
+  {
+    request.Piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    request.NumberOfPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    request.GhostLevels =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()))
+  {
+    request.HasExtent = true;
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), request.Extent.data());
+  }
+
+  if (!this->PrefetchInternals)
+  {
+    this->PrefetchInternals = std::make_unique<vtkPrefetchInternals>();
+  }
+  vtkPrefetchInternals& internals = *this->PrefetchInternals;
+
+  // Cached time steps are obsolete when the reader settings changed.
+  if (internals.SettingsTime != this->GetMTime())
+  {
+    this->ClearPrefetchCache();
+    internals.SettingsTime = this->GetMTime();
+  }
+
+  auto newReader = [this]()
+  {
+    auto reader = vtk::TakeSmartPointer(this->NewInstance());
+    this->CopyPrefetchSettings(reader);
+    // Errors are reported by the regular read done after a failure.
+    vtkNew<vtkCallbackCommand> ignoreErrors;
+    reader->AddObserver(vtkCommand::ErrorEvent, ignoreErrors);
+    return reader;
+  };
+
+  vtkSmartPointer<vtkDataObject> result;
+  auto found = std::find_if(internals.Entries.begin(), internals.Entries.end(),
+    [&request](const vtkPrefetchInternals::Entry& entry) { return entry.Request == request; });
+  if (found != internals.Entries.end())
+  {
+    vtkPrefetchInternals::Entry entry = *found;
+    internals.Entries.erase(found);
+    result = internals.Queue->Get(entry.Future);
+    if (result)
+    {
+      internals.Entries.push_back(entry);
+      ++this->NumberOfPrefetchHits;
+    }
+  }
+  if (!result)
+  {
+    // The main reader is not used at all in prefetch mode, so that its state
+    // about the last time step read stays consistent with its output.
+    ++this->NumberOfPrefetchMisses;
+    result = ::ReadPrefetchTimeStep(newReader(), steps[this->CurrentTimeStep], request);
+    if (!result)
+    {
+      return false;
+    }
+  }
+
+  output->ShallowCopy(result);
+  output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), steps[this->CurrentTimeStep]);
+
+  // Expect the next request to follow the last stride.
+  if (internals.LastTimeStep >= 0 && internals.LastTimeStep != this->CurrentTimeStep)
+  {
+    internals.Stride = this->CurrentTimeStep - internals.LastTimeStep;
+  }
+  internals.LastTimeStep = this->CurrentTimeStep;
+
+  vtkXMLReaderTimeStepRequest next = request;
+  next.TimeStep = this->CurrentTimeStep + internals.Stride;
+  if (next.TimeStep >= std::max(this->TimeStepRange[0], 0) &&
+    next.TimeStep <= std::min(this->TimeStepRange[1], numberOfSteps - 1) &&
+    std::none_of(internals.Entries.begin(), internals.Entries.end(),
+      [&next](const vtkPrefetchInternals::Entry& entry) { return entry.Request == next; }))
+  {
+    internals.Entries.push_back({ next,
+      internals.Queue->Push(&::ReadPrefetchTimeStep, newReader(), steps[next.TimeStep], next) });
+  }
+  while (static_cast<int>(internals.Entries.size()) > this->PrefetchCacheSize)
+  {
+    internals.Entries.pop_front();
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReader::CopyPrefetchSettings(vtkXMLReader* reader)
+{
+  reader->SetFileName(this->FileName);
+  reader->SetActiveTimeDataArrayName(this->ActiveTimeDataArrayName);
+  reader->SetTimeStep(this->TimeStep);
+  reader->PointDataArraySelection->CopySelections(this->PointDataArraySelection);
+  reader->CellDataArraySelection->CopySelections(this->CellDataArraySelection);
+  reader->ColumnArraySelection->CopySelections(this->ColumnArraySelection);
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReader::ResetPrefetchStatistics()
+{
+  this->NumberOfPrefetchHits = 0;
+  this->NumberOfPrefetchMisses = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLReader::ClearPrefetchCache()
+{
+  if (this->PrefetchInternals)
+  {
+    this->PrefetchInternals->Entries.clear();
+    this->PrefetchInternals->LastTimeStep = -1;
+    this->PrefetchInternals->Stride = 1;
+  }
+}
+
 namespace
 {
 //------------------------------------------------------------------------------
@@ -222,6 +222,51 @@ public:
   vtkSetVector2Macro(TimeStepRange, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the reader speculatively reads the time step it expects to be
+   * requested next while the rest of the pipeline executes. The prediction
+   * follows the direction and stride of the last two requested time steps.
+   * Prefetched time steps are kept in a cache of PrefetchCacheSize entries,
+   * and a request for one of them is served from the cache, waiting for the
+   * background read to complete if needed.
+   * Prefetching only applies to files with time steps read from FileName:
+   * it is ignored when reading from a string or a vtkResourceStream.
+   * Default is off.
+   */
+  vtkSetMacro(Prefetch, bool);
+  vtkGetMacro(Prefetch, bool);
+  vtkBooleanMacro(Prefetch, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of time steps kept by the prefetch cache, including the
+   * last one served. Least recently used entries are evicted. Default is 2.
+   */
+  vtkSetClampMacro(PrefetchCacheSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(PrefetchCacheSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics of the prefetch mode: number of requests served from the
+   * prefetch cache, and number of requests that had to be read on demand.
+   */
+  vtkGetMacro(NumberOfPrefetchHits, vtkIdType);
+  vtkGetMacro(NumberOfPrefetchMisses, vtkIdType);
+  ///@}
+
+  /**
+   * Reset prefetch hits and misses counters.
+   */
+  void ResetPrefetchStatistics();
+
+  /**
+   * Discard all prefetched time steps.
+   */
+  void ClearPrefetchCache();
+
   /**
    * Returns the internal XML parser. This can be used to access
    * the XML DOM after RequestInformation() was called.
@@ -550,9 +595,32 @@ protected:
    */
   void ReadFieldData();
 
+  /**
+   * Copy the settings affecting what is read to reader, a new instance of
+   * this class used to read time steps for the prefetch mode.
+   * Subclasses with their own settings should extend it.
+   */
+  virtual void CopyPrefetchSettings(vtkXMLReader* reader);
+
 private:
   int OpenVTKStream();
 
+  /**
+   * Serve the request of the time step CurrentTimeStep from the prefetch
+   * cache, or read it with a new reader instance, then schedule the read of
+   * the next expected time step. Return false if the request should be
+   * handled by the regular code path.
+   */
+  bool RequestPrefetchedData(vtkInformation* outInfo, vtkDataObject* output);
+
+  bool Prefetch = false;
+  int PrefetchCacheSize = 2;
+  vtkIdType NumberOfPrefetchHits = 0;
+  vtkIdType NumberOfPrefetchMisses = 0;
+
+  struct vtkPrefetchInternals;
+  std::unique_ptr<vtkPrefetchInternals> PrefetchInternals;
+
   // The stream used to read the input if it is in a resource stream
   vtkSmartPointer<vtkResourceStream> ResourceStream;
 
@@ -55,6 +55,13 @@ void vtkXMLStructuredDataReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "WholeSlices: " << this->WholeSlices << "\n";
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLStructuredDataReader::CopyPrefetchSettings(vtkXMLReader* reader)
+{
+  this->Superclass::CopyPrefetchSettings(reader);
+  static_cast<vtkXMLStructuredDataReader*>(reader)->SetWholeSlices(this->WholeSlices);
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLStructuredDataReader::ReadPrimaryElement(vtkXMLDataElement* ePrimary)
 {
@@ -64,6 +64,7 @@ protected:
   void ReadXMLData() override;
 
   void SetupOutputInformation(vtkInformation* outInfo) override;
+  void CopyPrefetchSettings(vtkXMLReader* reader) override;
 
   // Internal representation of pieces in the file that may have come
   // from a streamed write.
@@ -33,6 +33,9 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringFormatter.h"
@@ -48,11 +51,13 @@
 
 #include "vtksys/FStream.hxx"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #if !defined(_WIN32) || defined(__CYGWIN__)
 #include <unistd.h> /* unlink */
@@ -422,6 +427,23 @@ int vtkXMLWriterWriteBinaryDataBlocks(vtkXMLWriter* writer, vtkStringArray* iter
 } // end anon namespace
 //*****************************************************************************
 
+//------------------------------------------------------------------------------
+// Uncompressed copies of the blocks of the current array, compressed together
+// once the batch is full.
+struct vtkXMLWriter::CompressionBatchType
+{
+  std::vector<std::vector<unsigned char>> Blocks;
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> CompressedBlocks;
+  size_t NumberOfBlocks = 0;
+
+  // Filter applied to the blocks of the current array, and size of its words.
+  int Filter = vtkXMLCompressionFilter::None;
+  size_t WordSize = 0;
+
+  // Index of the first compressed block size in the compression header.
+  size_t SizesOffset = 3;
+};
+
 //------------------------------------------------------------------------------
 vtkXMLWriter::vtkXMLWriter()
 {
@@ -432,6 +454,7 @@ vtkXMLWriter::vtkXMLWriter()
 
   // Initialize compression data.
   this->CompressionHeader = nullptr;
+  this->CompressionBatch = new CompressionBatchType;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
@@ -464,6 +487,7 @@ vtkXMLWriter::~vtkXMLWriter()
   delete this->OutStringStream;
   this->OutStringStream = nullptr;
   delete this->FieldDataOM;
+  delete this->CompressionBatch;
   delete[] this->NumberOfTimeValues;
 }
 
@@ -784,6 +808,12 @@ void vtkXMLWriter::WriteFileAttributes()
   if (this->Compressor)
   {
     os << " compressor=\"" << this->Compressor->GetClassName() << "\"";
+
+    // Compression headers store the block filter since version 2.
+    if (this->CompressionFilter != vtkXMLWriterBase::NoFilter)
+    {
+      os << " compression_header=\"2\"";
+    }
   }
 }
 
@@ -986,6 +1016,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
 
   if (this->Compressor)
   {
+    // Filter the blocks of multi-byte words only.
+    CompressionBatchType& batch = *this->CompressionBatch;
+    batch.WordSize =
+      (wordType != VTK_BIT && wordType != VTK_STRING) ? this->GetOutputWordTypeSize(wordType) : 1;
+    batch.Filter = batch.WordSize > 1 ? this->CompressionFilter : vtkXMLCompressionFilter::None;
+
     // Need to compress the data.  Create compression header.  This
     // reserves enough space in the output.
     if (!this->CreateCompressionHeader(dataSize))
@@ -1001,6 +1037,12 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks remaining in the batch.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1327,14 +1369,18 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   //    HeaderType number_of_blocks;
   //    HeaderType uncompressed_block_size;
   //    HeaderType uncompressed_last_block_size;
+  //    HeaderType filter; // version 2 only, see vtkXMLCompressionFilter
   //    HeaderType compressed_block_sizes[number_of_blocks];
   //  }
+  CompressionBatchType& batch = *this->CompressionBatch;
+  batch.SizesOffset = this->CompressionFilter != vtkXMLWriterBase::NoFilter ? 4 : 3;
 
   // Find the size and number of blocks.
   size_t numFullBlocks = size / this->BlockSize;
   size_t lastBlockSize = size % this->BlockSize;
   size_t numBlocks = numFullBlocks + (lastBlockSize ? 1 : 0);
-  this->CompressionHeader = vtkXMLDataHeader::New(this->HeaderType, 3 + numBlocks);
+  this->CompressionHeader =
+    vtkXMLDataHeader::New(this->HeaderType, batch.SizesOffset + numBlocks);
 
   // Write out dummy header data.
   this->CompressionHeaderPosition = this->Stream->tellp();
@@ -1353,9 +1399,17 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
   this->CompressionHeader->Set(0, numBlocks);
   this->CompressionHeader->Set(1, this->BlockSize);
   this->CompressionHeader->Set(2, lastBlockSize);
+  if (batch.SizesOffset == 4)
+  {
+    this->CompressionHeader->Set(3,
+      batch.Filter != vtkXMLCompressionFilter::None
+        ? vtkXMLCompressionFilter::MakeHeaderValue(batch.Filter, batch.WordSize)
+        : 0);
+  }
 
   // Initialize counter for block writing.
   this->CompressionBlockNumber = 0;
+  batch.NumberOfBlocks = 0;
 
   return result;
 }
@@ -1363,25 +1417,93 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // Blocks are independent from each other: queue a copy of this one and
+  // compress a full batch at once, using all the threads.
+  CompressionBatchType& batch = *this->CompressionBatch;
+  if (batch.Blocks.empty())
+  {
+    batch.Blocks.resize(std::max(16, 4 * vtkSMPTools::GetEstimatedNumberOfThreads()));
+  }
+  batch.Blocks[batch.NumberOfBlocks++].assign(data, data + size);
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+  if (batch.NumberOfBlocks < batch.Blocks.size())
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
-  this->Stream->flush();
-  if (this->Stream->fail())
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  CompressionBatchType& batch = *this->CompressionBatch;
+  const size_t numBlocks = batch.NumberOfBlocks;
+  batch.NumberOfBlocks = 0;
+  if (numBlocks == 0)
   {
-    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    return 1;
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  // Each thread uses its own compressor, with the same settings,
+  // and its own buffer for filtered blocks.
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataCompressor>> localCompressors;
+  vtkSMPThreadLocal<std::vector<unsigned char>> localFiltered;
+  batch.CompressedBlocks.resize(numBlocks);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      auto& localCompressor = localCompressors.Local();
+      if (!localCompressor)
+      {
+        localCompressor = vtk::TakeSmartPointer(compressor->NewInstance());
+        localCompressor->CopyParameters(compressor);
+      }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const std::vector<unsigned char>& block = batch.Blocks[i];
+        const unsigned char* data = block.data();
+        if (batch.Filter != vtkXMLCompressionFilter::None)
+        {
+          std::vector<unsigned char>& filtered = localFiltered.Local();
+          filtered.resize(block.size());
+          vtkXMLCompressionFilter::Encode(
+            batch.Filter, batch.WordSize, block.data(), block.size(), filtered.data());
+          data = filtered.data();
+        }
+        batch.CompressedBlocks[i] =
+          vtk::TakeSmartPointer(localCompressor->Compress(data, block.size()));
+      }
+    });
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks && result; ++i)
+  {
+    vtkUnsignedCharArray* outputArray = batch.CompressedBlocks[i];
+    if (!outputArray)
+    {
+      vtkErrorMacro("Compression of block " << this->CompressionBlockNumber << " failed.");
+      result = 0;
+      break;
+    }
+
+    // Find the compressed size.
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArray->GetPointer(0);
+
+    // Write the compressed data.
+    result = this->DataStream->Write(outputPointer, outputSize);
+    this->Stream->flush();
+    if (this->Stream->fail())
+    {
+      this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+    }
 
-  outputArray->Delete();
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(batch.SizesOffset + this->CompressionBlockNumber++, outputSize);
+  }
+  batch.CompressedBlocks.clear();
 
   return result;
 }
@@ -142,6 +142,10 @@ protected:
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // Blocks waiting to be compressed concurrently.
+  struct CompressionBatchType;
+  CompressionBatchType* CompressionBatch;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -257,6 +261,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -5,11 +5,15 @@
 #include "vtkXMLWriterBase.h"
 
 #include "vtkDataCompressor.h"
+#include "vtkFeatures.h" // for VTK_USE_ZSTD
 #include "vtkLZ4DataCompressor.h"
 #include "vtkLZMADataCompressor.h"
 #include "vtkObjectFactory.h"
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
@@ -33,6 +37,7 @@ vtkXMLWriterBase::vtkXMLWriterBase()
   , Compressor(vtkZLibDataCompressor::New())
   , BlockSize(32768) // 2^15
   , CompressionLevel(5)
+  , CompressionFilter(vtkXMLWriterBase::NoFilter)
   , UsePreviousVersion(true)
 {
   this->SetNumberOfInputPorts(1);
@@ -122,6 +127,20 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#ifdef VTK_USE_ZSTD
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkErrorMacro("Zstandard compression requires VTK to be built with VTK_USE_ZSTD.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -256,5 +275,6 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "CompressionFilter: " << this->CompressionFilter << "\n";
 }
 VTK_ABI_NAMESPACE_END
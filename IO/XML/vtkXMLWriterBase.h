@@ -139,18 +139,21 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD is available only if VTK is built with VTK_USE_ZSTD.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{
@@ -162,6 +165,43 @@ public:
   vtkGetMacro(CompressionLevel, int);
   ///@}
 
+  /**
+   * Enumerate the supported filters applied to binary data blocks before
+   * compression.
+   * NoFilter = Blocks are compressed as they are.
+   * ByteShuffle = Bytes of same significance of all the values of a block
+   * are grouped together.
+   * XORDeltaByteShuffle = Each value is XOR-ed with the previous one before
+   * the byte shuffle. Well suited to smooth floating point fields.
+   */
+  enum CompressionFilterType
+  {
+    NoFilter,
+    ByteShuffle,
+    XORDeltaByteShuffle
+  };
+
+  ///@{
+  /**
+   * Get/Set the filter applied to each block of binary data before it is
+   * compressed. Filters reorder the bytes so that the compressor sees long
+   * runs of similar bytes, which improves the compression ratio of
+   * multi-byte values at a small cost. It is used only when a compressor is
+   * set, and is ignored for arrays of single-byte values.
+   * Files written with a filter use a new compression header layout, and
+   * cannot be read by VTK versions that predate this option.
+   * Default is NoFilter.
+   */
+  vtkSetClampMacro(CompressionFilter, int, NoFilter, XORDeltaByteShuffle);
+  vtkGetMacro(CompressionFilter, int);
+  void SetCompressionFilterToNone() { this->SetCompressionFilter(NoFilter); }
+  void SetCompressionFilterToByteShuffle() { this->SetCompressionFilter(ByteShuffle); }
+  void SetCompressionFilterToXORDeltaByteShuffle()
+  {
+    this->SetCompressionFilter(XORDeltaByteShuffle);
+  }
+  ///@}
+
   ///@{
   /**
    * Get/Set the block size used in compression.  When reading, this
@@ -263,6 +303,9 @@ protected:
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel;
 
+  // Filter applied to blocks before compression.
+  int CompressionFilter;
+
   // This variable is used to ease transition to new versions of VTK XML files.
   // If data that needs to be written satisfies certain conditions,
   // the writer can use the previous file version version.
@@ -9,6 +9,7 @@
 #define vtkXMLDataHeaderPrivate_h
 
 #include "vtkType.h"
+#include <algorithm>
 #include <vector>
 
 // Abstract interface using type vtkTypeUInt64 to access an array
@@ -63,6 +64,70 @@ vtkXMLDataHeader* vtkXMLDataHeader::New(int width, size_t count)
   return nullptr;
 }
 
+// Reversible transforms applied to each block before compression, grouping
+// the bytes of same significance of consecutive words. Smooth floating point
+// fields compress much better once transformed. Shared by vtkXMLWriter and
+// vtkXMLDataParser to write/read compressed blocks.
+class vtkXMLCompressionFilter
+{
+public:
+  enum Type
+  {
+    None = 0,
+    // Byte i of every word is stored in the i-th plane of the block.
+    ByteShuffle = 1,
+    // Each word is XOR-ed with the previous one before the byte shuffle.
+    XORDeltaByteShuffle = 2
+  };
+
+  // The compression header stores the filter type and the word size in one value.
+  static vtkTypeUInt64 MakeHeaderValue(int type, size_t wordSize)
+  {
+    return static_cast<vtkTypeUInt64>(type) | (static_cast<vtkTypeUInt64>(wordSize) << 8);
+  }
+  static int GetType(vtkTypeUInt64 value) { return static_cast<int>(value & 0xff); }
+  static size_t GetWordSize(vtkTypeUInt64 value) { return static_cast<size_t>(value >> 8); }
+
+  // Transform size bytes from in to out. Trailing bytes that do not make a
+  // full word are copied unchanged.
+  static void Encode(
+    int type, size_t wordSize, const unsigned char* in, size_t size, unsigned char* out)
+  {
+    const size_t numWords = wordSize ? size / wordSize : 0;
+    for (size_t b = 0; b < wordSize; ++b)
+    {
+      unsigned char* plane = out + b * numWords;
+      unsigned char previous = 0;
+      for (size_t i = 0; i < numWords; ++i)
+      {
+        const unsigned char current = in[i * wordSize + b];
+        plane[i] = type == XORDeltaByteShuffle ? current ^ previous : current;
+        previous = current;
+      }
+    }
+    std::copy(in + numWords * wordSize, in + size, out + numWords * wordSize);
+  }
+
+  // Inverse of Encode.
+  static void Decode(
+    int type, size_t wordSize, const unsigned char* in, size_t size, unsigned char* out)
+  {
+    const size_t numWords = wordSize ? size / wordSize : 0;
+    for (size_t b = 0; b < wordSize; ++b)
+    {
+      const unsigned char* plane = in + b * numWords;
+      unsigned char previous = 0;
+      for (size_t i = 0; i < numWords; ++i)
+      {
+        const unsigned char current = type == XORDeltaByteShuffle ? plane[i] ^ previous : plane[i];
+        out[i * wordSize + b] = current;
+        previous = current;
+      }
+    }
+    std::copy(in + numWords * wordSize, in + size, out + numWords * wordSize);
+  }
+};
+
 VTK_ABI_NAMESPACE_END
 #endif
 // VTK-HeaderTest-Exclude: vtkXMLDataHeaderPrivate.h
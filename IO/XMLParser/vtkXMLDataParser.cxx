@@ -8,6 +8,9 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStringScanner.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
@@ -15,6 +18,7 @@
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -43,6 +47,7 @@ vtkXMLDataParser::vtkXMLDataParser()
 
   this->BlockCompressedSizes = nullptr;
   this->BlockStartOffsets = nullptr;
+  this->CompressionFilter = 0;
   this->Compressor = nullptr;
 
   this->AsciiDataBuffer = nullptr;
@@ -59,6 +64,7 @@ vtkXMLDataParser::vtkXMLDataParser()
   this->ByteOrder = vtkXMLDataParser::LittleEndian;
 #endif
   this->HeaderType = 32;
+  this->CompressionHeaderVersion = 1;
 
   this->AttributesEncoding = VTK_ENCODING_NONE;
 
@@ -259,6 +265,22 @@ int vtkXMLDataParser::CheckPrimaryAttributes()
       return 0;
     }
   }
+  if (const char* compression_header = this->RootElement->GetAttribute("compression_header"))
+  {
+    if (strcmp(compression_header, "1") == 0)
+    {
+      this->CompressionHeaderVersion = 1;
+    }
+    else if (strcmp(compression_header, "2") == 0)
+    {
+      this->CompressionHeaderVersion = 2;
+    }
+    else
+    {
+      vtkErrorMacro("Unsupported compression_header=\"" << compression_header << "\"");
+      return 0;
+    }
+  }
   return 1;
 }
 
@@ -517,7 +539,11 @@ void vtkXMLDataParser::PerformByteSwap(void* data, size_t numWords, size_t wordS
 //------------------------------------------------------------------------------
 int vtkXMLDataParser::ReadCompressionHeader()
 {
-  std::unique_ptr<vtkXMLDataHeader> ch(vtkXMLDataHeader::New(this->HeaderType, 3));
+  // Version 2 headers have a fourth standard word, the block filter, after
+  // the number of blocks and the two uncompressed block sizes, and before
+  // the compressed block sizes.
+  const size_t standardSize = this->CompressionHeaderVersion >= 2 ? 4 : 3;
+  std::unique_ptr<vtkXMLDataHeader> ch(vtkXMLDataHeader::New(this->HeaderType, standardSize));
 
   this->DataStream->StartReading();
 
@@ -538,6 +564,14 @@ int vtkXMLDataParser::ReadCompressionHeader()
   this->NumberOfBlocks = size_t(ch->Get(0));
   this->BlockUncompressedSize = size_t(ch->Get(1));
   this->PartialLastBlockUncompressedSize = size_t(ch->Get(2));
+  this->CompressionFilter = standardSize > 3 ? ch->Get(3) : 0;
+  if (vtkXMLCompressionFilter::GetType(this->CompressionFilter) >
+    vtkXMLCompressionFilter::XORDeltaByteShuffle)
+  {
+    vtkErrorMacro("Unsupported compression filter "
+      << vtkXMLCompressionFilter::GetType(this->CompressionFilter) << ".");
+    return 0;
+  }
 
   // Allocate the size and offset parts of the header.
   ch->Resize(this->NumberOfBlocks);
@@ -609,8 +643,24 @@ int vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block, unsigned char* buffer)
     return 0;
   }
 
+  // Filtered blocks are uncompressed in a temporary buffer and decoded in place.
+  const int filter = vtkXMLCompressionFilter::GetType(this->CompressionFilter);
+  std::vector<unsigned char> filtered;
+  if (filter != vtkXMLCompressionFilter::None)
+  {
+    filtered.resize(uncompressedSize);
+  }
+  unsigned char* uncompressed = filtered.empty() ? buffer : filtered.data();
+
   size_t result =
-    this->Compressor->Uncompress(readBuffer, compressedSize, buffer, uncompressedSize);
+    this->Compressor->Uncompress(readBuffer, compressedSize, uncompressed, uncompressedSize);
+
+  if (result > 0 && !filtered.empty())
+  {
+    vtkXMLCompressionFilter::Decode(filter,
+      vtkXMLCompressionFilter::GetWordSize(this->CompressionFilter), uncompressed,
+      uncompressedSize, buffer);
+  }
 
   delete[] readBuffer;
   return result > 0;
@@ -628,6 +678,71 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(
+  vtkTypeUInt64 firstBlock, vtkTypeUInt64 numberOfBlocks, unsigned char* buffer)
+{
+  // The compressed blocks are stored one after the other: read them at once,
+  // then uncompress them concurrently, each one at its place in buffer.
+  std::vector<size_t> compressedOffsets(numberOfBlocks + 1, 0);
+  for (vtkTypeUInt64 i = 0; i < numberOfBlocks; ++i)
+  {
+    compressedOffsets[i + 1] = compressedOffsets[i] + this->BlockCompressedSizes[firstBlock + i];
+  }
+
+  if (!this->DataStream->Seek(this->BlockStartOffsets[firstBlock]))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedOffsets[numberOfBlocks]);
+  if (this->DataStream->Read(readBuffer.data(), readBuffer.size()) < readBuffer.size())
+  {
+    return 0;
+  }
+
+  vtkDataCompressor* compressor = this->Compressor;
+  const int filter = vtkXMLCompressionFilter::GetType(this->CompressionFilter);
+  const size_t filterWordSize = vtkXMLCompressionFilter::GetWordSize(this->CompressionFilter);
+  vtkSMPThreadLocal<vtkSmartPointer<vtkDataCompressor>> localCompressors;
+  vtkSMPThreadLocal<std::vector<unsigned char>> localFiltered;
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfBlocks), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      auto& localCompressor = localCompressors.Local();
+      if (!localCompressor)
+      {
+        localCompressor = vtk::TakeSmartPointer(compressor->NewInstance());
+        localCompressor->CopyParameters(compressor);
+      }
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkTypeUInt64 block = firstBlock + i;
+        const size_t blockSize = this->FindBlockSize(block);
+        unsigned char* blockBuffer = buffer + i * this->BlockUncompressedSize;
+        unsigned char* uncompressed = blockBuffer;
+        if (filter != vtkXMLCompressionFilter::None)
+        {
+          std::vector<unsigned char>& filtered = localFiltered.Local();
+          filtered.resize(blockSize);
+          uncompressed = filtered.data();
+        }
+        if (!localCompressor->Uncompress(readBuffer.data() + compressedOffsets[i],
+              this->BlockCompressedSizes[block], uncompressed, blockSize))
+        {
+          success = false;
+        }
+        else if (uncompressed != blockBuffer)
+        {
+          vtkXMLCompressionFilter::Decode(
+            filter, filterWordSize, uncompressed, blockSize, blockBuffer);
+        }
+      }
+    });
+
+  return success ? 1 : 0;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -794,21 +909,26 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks by batches, uncompressed concurrently.
+    const vtkTypeUInt64 batchSize =
+      std::max(16, 4 * vtkSMPTools::GetEstimatedNumberOfThreads());
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock != lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      // Read these blocks.
+      const vtkTypeUInt64 numBlocks = std::min(batchSize, lastBlock - currentBlock);
+      if (!this->ReadBlocks(currentBlock, numBlocks, outputPointer))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
+      // Byte swap these blocks.  Note that blockSize will always be an
       // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      this->PerformByteSwap(outputPointer, numBlocks * blockSize / wordSize, wordSize);
 
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += numBlocks * blockSize;
+      currentBlock += numBlocks;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
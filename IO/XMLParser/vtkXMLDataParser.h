@@ -175,6 +175,7 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(vtkTypeUInt64 firstBlock, vtkTypeUInt64 numberOfBlocks, unsigned char* buffer);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -213,6 +214,10 @@ protected:
   // The word type of binary input headers.
   int HeaderType;
 
+  // The layout of compression headers: 1 for the original one, 2 when
+  // headers also store the filter applied to blocks before compression.
+  int CompressionHeaderVersion;
+
   // The input stream used to read data.  Set by ReadAppendedData and
   // ReadInlineData methods.
   vtkInputStream* DataStream;
@@ -231,6 +236,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  vtkTypeUInt64 CompressionFilter;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
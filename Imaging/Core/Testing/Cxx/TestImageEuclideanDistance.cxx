@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the distances computed by the Felzenszwalb algorithm of
+// vtkImageEuclideanDistance against a brute force search, with anisotropic
+// spacing, signed distances and closest points, and against Saito's algorithm.
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+//------------------------------------------------------------------------------
+double SquaredDistance(vtkImageData* image, vtkIdType id0, vtkIdType id1)
+{
+  double p0[3];
+  double p1[3];
+  image->GetPoint(id0, p0);
+  image->GetPoint(id1, p1);
+  return (p0[0] - p1[0]) * (p0[0] - p1[0]) + (p0[1] - p1[1]) * (p0[1] - p1[1]) +
+    (p0[2] - p1[2]) * (p0[2] - p1[2]);
+}
+
+//------------------------------------------------------------------------------
+bool CheckDistances(vtkImageData* mask, vtkImageData* output, bool isSigned)
+{
+  vtkDataArray* distances = output->GetPointData()->GetScalars();
+  vtkIdTypeArray* closest =
+    vtkArrayDownCast<vtkIdTypeArray>(output->GetPointData()->GetArray("ClosestPointIds"));
+  if (!closest)
+  {
+    std::cerr << "Missing closest point ids.\n";
+    return false;
+  }
+
+  vtkDataArray* values = mask->GetPointData()->GetScalars();
+  for (vtkIdType id = 0; id < mask->GetNumberOfPoints(); ++id)
+  {
+    const bool inside = values->GetComponent(id, 0) != 0;
+    double expected = 0.0;
+    if (inside || isSigned)
+    {
+      expected = std::numeric_limits<double>::max();
+      for (vtkIdType other = 0; other < mask->GetNumberOfPoints(); ++other)
+      {
+        if ((values->GetComponent(other, 0) != 0) != inside)
+        {
+          expected = std::min(expected, ::SquaredDistance(mask, id, other));
+        }
+      }
+    }
+    if (!inside)
+    {
+      expected = -expected;
+    }
+
+    const double distance = distances->GetComponent(id, 0);
+    const vtkIdType closestId = closest->GetValue(id);
+    if (std::abs(distance - expected) > 1e-9 || closestId < 0 ||
+      std::abs(::SquaredDistance(mask, id, closestId) - std::abs(expected)) > 1e-9)
+    {
+      std::cerr << "Wrong distance " << distance << " or closest point " << closestId
+                << " for point " << id << ", expected " << expected << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageEuclideanDistance(int, char*[])
+{
+  vtkNew<vtkImageData> mask;
+  mask->SetDimensions(13, 9, 7);
+  mask->SetSpacing(1.0, 2.0, 0.5);
+  mask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
+  for (vtkIdType id = 0; id < mask->GetNumberOfPoints(); ++id)
+  {
+    maskPtr[id] = random->GetNextValue() < 0.8 ? 1 : 0;
+  }
+
+  for (bool isSigned : { false, true })
+  {
+    vtkNew<vtkImageEuclideanDistance> distance;
+    distance->SetInputData(mask);
+    distance->SetSignedDistance(isSigned);
+    distance->ComputeClosestPointsOn();
+    distance->Update();
+    if (!::CheckDistances(mask, distance->GetOutput(), isSigned))
+    {
+      std::cerr << "Failed with signed distance " << (isSigned ? "on" : "off") << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Saito's algorithm computes the same unsigned distances.
+  vtkNew<vtkImageEuclideanDistance> felzenszwalb;
+  felzenszwalb->SetInputData(mask);
+  felzenszwalb->Update();
+  vtkNew<vtkImageEuclideanDistance> saito;
+  saito->SetInputData(mask);
+  saito->SetAlgorithmToSaito();
+  saito->Update();
+  vtkDataArray* expected = saito->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* actual = felzenszwalb->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType id = 0; id < mask->GetNumberOfPoints(); ++id)
+  {
+    if (std::abs(expected->GetComponent(id, 0) - actual->GetComponent(id, 0)) > 1e-9)
+    {
+      std::cerr << "Saito and Felzenszwalb differ for point " << id << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (felzenszwalb->GetOutput()->GetPointData()->GetArray("ClosestPointIds"))
+  {
+    std::cerr << "Closest point ids should only be computed when requested.\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the spectra computed by vtkImageFFT for real input, which uses a real
+// transform, against the ones of the same values given as complex input and
+// against a direct discrete Fourier transform, for odd, even and prime sizes.
+// Also check that vtkImageRFFT gives the input back.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkImageFFT.h"
+#include "vtkImageRFFT.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <array>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Image of random values with 1 component, or 2 with a null imaginary part.
+vtkSmartPointer<vtkImageData> MakeImage(const int dims[3], bool complex)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(dims[0] * 10000 + dims[1] * 100 + dims[2]);
+  vtkNew<vtkDoubleArray> values;
+  values->SetNumberOfComponents(complex ? 2 : 1);
+  values->SetNumberOfTuples(static_cast<vtkIdType>(dims[0]) * dims[1] * dims[2]);
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    values->SetComponent(i, 0, random->GetNextRangeValue(-10.0, 10.0));
+    if (complex)
+    {
+      values->SetComponent(i, 1, 0.0);
+    }
+  }
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dims);
+  image->GetPointData()->SetScalars(values);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> Transform(
+  vtkImageData* input, int dimensionality, bool inverse = false)
+{
+  vtkSmartPointer<vtkImageFourierFilter> filter;
+  if (inverse)
+  {
+    filter = vtkSmartPointer<vtkImageRFFT>::New();
+  }
+  else
+  {
+    filter = vtkSmartPointer<vtkImageFFT>::New();
+  }
+  filter->SetDimensionality(dimensionality);
+  filter->SetInputData(input);
+  filter->Update();
+  return filter->GetOutput();
+}
+
+//------------------------------------------------------------------------------
+// Compare the first components of two images, which must have as many.
+bool Compare(vtkImageData* expected, vtkImageData* actual, int numberOfComponents,
+  double tolerance, const char* what)
+{
+  vtkDataArray* a = expected->GetPointData()->GetScalars();
+  vtkDataArray* b = actual->GetPointData()->GetScalars();
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    b->GetNumberOfComponents() < numberOfComponents)
+  {
+    std::cerr << what << ": wrong output size.\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < numberOfComponents; ++c)
+    {
+      if (std::abs(a->GetComponent(i, c) - b->GetComponent(i, c)) > tolerance)
+      {
+        std::cerr << what << ": value " << i << "," << c << " is " << b->GetComponent(i, c)
+                  << " instead of " << a->GetComponent(i, c) << ".\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Compare the spectrum of a line of values with a direct transform.
+bool CompareWithDFT(vtkImageData* input, vtkImageData* spectrum, double tolerance)
+{
+  vtkDataArray* values = input->GetPointData()->GetScalars();
+  vtkDataArray* result = spectrum->GetPointData()->GetScalars();
+  const vtkIdType n = values->GetNumberOfTuples();
+  for (vtkIdType k = 0; k < n; ++k)
+  {
+    double real = 0.0;
+    double imag = 0.0;
+    for (vtkIdType i = 0; i < n; ++i)
+    {
+      const double angle = -2.0 * vtkMath::Pi() * static_cast<double>((k * i) % n) / n;
+      real += values->GetComponent(i, 0) * std::cos(angle);
+      imag += values->GetComponent(i, 0) * std::sin(angle);
+    }
+    if (std::abs(result->GetComponent(k, 0) - real) > tolerance ||
+      std::abs(result->GetComponent(k, 1) - imag) > tolerance)
+    {
+      std::cerr << "Size " << n << ": frequency " << k << " is (" << result->GetComponent(k, 0)
+                << ", " << result->GetComponent(k, 1) << ") instead of (" << real << ", " << imag
+                << ").\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestImage(const int dims[3], int dimensionality)
+{
+  vtkSmartPointer<vtkImageData> real = ::MakeImage(dims, false);
+  vtkSmartPointer<vtkImageData> complex = ::MakeImage(dims, true);
+  const double tolerance = 1e-11 * 10.0 * dims[0] * dims[1] * dims[2];
+
+  vtkSmartPointer<vtkImageData> realSpectrum = ::Transform(real, dimensionality);
+  vtkSmartPointer<vtkImageData> complexSpectrum = ::Transform(complex, dimensionality);
+  if (!::Compare(complexSpectrum, realSpectrum, 2, tolerance, "Real input spectrum"))
+  {
+    return false;
+  }
+  if (dimensionality == 1 && dims[1] == 1 && dims[2] == 1 &&
+    !::CompareWithDFT(real, realSpectrum, tolerance))
+  {
+    return false;
+  }
+
+  // The inverse transform gives the values back, with a null imaginary part.
+  vtkSmartPointer<vtkImageData> roundTrip = ::Transform(realSpectrum, dimensionality, true);
+  if (!::Compare(complex, roundTrip, 2, tolerance, "Round trip"))
+  {
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageFFTSizes(int, char*[])
+{
+  for (int size : { 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 13, 16, 17, 30, 31, 64, 97, 100, 127, 128 })
+  {
+    const int dims[3] = { size, 1, 1 };
+    if (!::TestImage(dims, 1))
+    {
+      std::cerr << "Failed for a line of " << size << " values.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (const auto& dims : { std::array<int, 3>{ 7, 6, 5 }, std::array<int, 3>{ 12, 9, 11 },
+         std::array<int, 3>{ 16, 13, 2 } })
+  {
+    if (!::TestImage(dims.data(), 3))
+    {
+      std::cerr << "Failed for a " << dims[0] << "x" << dims[1] << "x" << dims[2] << " image.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the interpolation along lines of vtkImageInterpolator gives the
+// same values as the interpolation point by point, and that vtkImageReslice
+// gives the same output with a linear transform, which interpolates whole
+// rows at once, and with a general transform, which does not.
+
+#include "vtkGeneralTransform.h"
+#include "vtkImageData.h"
+#include "vtkImageInterpolator.h"
+#include "vtkImageReslice.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool CheckLines(vtkImageData* image, int interpolationMode, vtkImageBorderMode borderMode)
+{
+  vtkNew<vtkImageInterpolator> interpolator;
+  interpolator->SetInterpolationMode(interpolationMode);
+  interpolator->SetBorderMode(borderMode);
+  interpolator->Initialize(image);
+  interpolator->Update();
+
+  const int nc = image->GetNumberOfScalarComponents();
+  const double origins[3][3] = { { 0.3, 0.7, 0.1 }, { -2.5, 3.25, 4.0 }, { 7.0, 5.0, 3.0 } };
+  const double steps[3][3] = { { 0.91, 0.17, 0.05 }, { 0.5, 0.0, 0.25 }, { 0.0, 0.0, 1.0 } };
+  for (int line = 0; line < 3; ++line)
+  {
+    const int n = 20;
+    const int idX = line - 1;
+    std::vector<double> values(n * nc);
+    interpolator->InterpolateLineIJK(origins[line], steps[line], idX, values.data(), n);
+    std::vector<float> floatValues(n * nc);
+    const float floatOrigin[3] = { static_cast<float>(origins[line][0]),
+      static_cast<float>(origins[line][1]), static_cast<float>(origins[line][2]) };
+    const float floatStep[3] = { static_cast<float>(steps[line][0]),
+      static_cast<float>(steps[line][1]), static_cast<float>(steps[line][2]) };
+    interpolator->InterpolateLineIJK(floatOrigin, floatStep, idX, floatValues.data(), n);
+
+    for (int i = 0; i < n; ++i)
+    {
+      double point[3];
+      float floatPoint[3];
+      for (int k = 0; k < 3; ++k)
+      {
+        point[k] = origins[line][k] + (idX + i) * steps[line][k];
+        floatPoint[k] = floatOrigin[k] + (idX + i) * floatStep[k];
+      }
+      std::vector<double> expected(nc);
+      interpolator->InterpolateIJK(point, expected.data());
+      std::vector<float> floatExpected(nc);
+      interpolator->InterpolateIJK(floatPoint, floatExpected.data());
+      for (int c = 0; c < nc; ++c)
+      {
+        if (values[i * nc + c] != expected[c] || floatValues[i * nc + c] != floatExpected[c])
+        {
+          std::cerr << "Line " << line << " gives " << values[i * nc + c] << " instead of "
+                    << expected[c] << " at point " << i << " for component " << c
+                    << " with interpolation mode " << interpolationMode << ", border mode "
+                    << borderMode << ", scalar type " << image->GetScalarTypeAsString() << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool CheckReslice(vtkImageData* image, int interpolationMode, int slabSamples)
+{
+  vtkNew<vtkTransform> transform;
+  transform->Translate(6.0, 5.0, 4.0);
+  transform->RotateWXYZ(17.0, 1.0, 2.0, 3.0);
+  transform->Translate(-6.0, -5.0, -4.0);
+  vtkNew<vtkGeneralTransform> general;
+  general->Concatenate(transform);
+
+  vtkNew<vtkImageReslice> reslice[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    reslice[i]->SetInputData(image);
+    reslice[i]->SetInterpolationMode(interpolationMode);
+    reslice[i]->SetSlabNumberOfSlices(slabSamples);
+    reslice[i]->SetSlabModeToMean();
+    reslice[i]->SetOutputScalarType(VTK_FLOAT);
+    reslice[i]->SetResliceTransform(i == 0 ? static_cast<vtkAbstractTransform*>(transform)
+                                           : static_cast<vtkAbstractTransform*>(general));
+    reslice[i]->Update();
+  }
+
+  vtkDataArray* expected = reslice[1]->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* actual = reslice[0]->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType id = 0; id < expected->GetNumberOfValues(); ++id)
+  {
+    const double e = expected->GetComponent(id / image->GetNumberOfScalarComponents(),
+      id % image->GetNumberOfScalarComponents());
+    const double a = actual->GetComponent(id / image->GetNumberOfScalarComponents(),
+      id % image->GetNumberOfScalarComponents());
+    if (std::abs(e - a) > 1e-3 * (1.0 + std::abs(e)))
+    {
+      std::cerr << "Reslice gives " << a << " instead of " << e << " for value " << id
+                << " with interpolation mode " << interpolationMode << " and " << slabSamples
+                << " slab samples\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageInterpolatorLines(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  for (int scalarType : { VTK_FLOAT, VTK_SHORT, VTK_UNSIGNED_CHAR })
+  {
+    for (int nc : { 1, 3 })
+    {
+      vtkNew<vtkImageData> image;
+      image->SetExtent(0, 15, 0, 12, 0, 9);
+      image->AllocateScalars(scalarType, nc);
+      vtkDataArray* scalars = image->GetPointData()->GetScalars();
+      for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+      {
+        scalars->SetComponent(i / nc, i % nc, std::floor(random->GetNextRangeValue(0.0, 255.0)));
+      }
+
+      for (int interpolationMode :
+        { VTK_NEAREST_INTERPOLATION, VTK_LINEAR_INTERPOLATION, VTK_CUBIC_INTERPOLATION })
+      {
+        for (vtkImageBorderMode borderMode :
+          { VTK_IMAGE_BORDER_CLAMP, VTK_IMAGE_BORDER_REPEAT, VTK_IMAGE_BORDER_MIRROR })
+        {
+          if (!::CheckLines(image, interpolationMode, borderMode))
+          {
+            return EXIT_FAILURE;
+          }
+        }
+        for (int slabSamples : { 1, 5 })
+        {
+          if (!::CheckReslice(image, interpolationMode, slabSamples))
+          {
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
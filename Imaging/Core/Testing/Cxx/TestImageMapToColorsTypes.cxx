@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check vtkImageMapToColors, which copies the colors from a table for 8-bit
+// and 16-bit integer input, against the lookup table applied to the whole
+// array at once, for each output format, also for the second component of
+// an image with two components and for images too small for the table.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMapToColors.h"
+#include "vtkLookupTable.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <iostream>
+#include <vector>
+
+//------------------------------------------------------------------------------
+int TestImageMapToColorsTypes(int, char*[])
+{
+  vtkNew<vtkLookupTable> table;
+  table->SetRange(-1000.0, 3000.0);
+  table->SetHueRange(0.0, 0.7);
+  table->SetAlphaRange(0.2, 1.0);
+  table->SetBelowRangeColor(0.1, 0.2, 0.3, 1.0);
+  table->SetAboveRangeColor(0.9, 0.8, 0.7, 0.5);
+  table->UseBelowRangeColorOn();
+  table->UseAboveRangeColorOn();
+  table->Build();
+
+  for (int scalarType : { VTK_UNSIGNED_CHAR, VTK_SIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT })
+  {
+    for (int components : { 1, 2 })
+    {
+      // The large image has enough values for the color table to be used.
+      for (int size : { 10, 300 })
+      {
+        vtkNew<vtkImageData> input;
+        input->SetDimensions(size, size, 4);
+        input->AllocateScalars(scalarType, components);
+        vtkDataArray* scalars = input->GetPointData()->GetScalars();
+        const double minimum = scalars->GetDataTypeMin();
+        const vtkIdType count = static_cast<vtkIdType>(scalars->GetDataTypeMax() - minimum) + 1;
+        for (vtkIdType id = 0; id < scalars->GetNumberOfValues(); id++)
+        {
+          scalars->SetComponent(id / components, id % components, minimum + (id * 7919) % count);
+        }
+
+        for (int format : { VTK_RGBA, VTK_RGB, VTK_LUMINANCE_ALPHA, VTK_LUMINANCE })
+        {
+          vtkNew<vtkImageMapToColors> mapper;
+          mapper->SetInputData(input);
+          mapper->SetLookupTable(table);
+          mapper->SetOutputFormat(format);
+          mapper->SetActiveComponent(components - 1);
+          mapper->Update();
+
+          const vtkIdType numTuples = scalars->GetNumberOfTuples();
+          std::vector<unsigned char> expected(numTuples * format);
+          table->MapScalarsThroughTable(
+            scalars, expected.data(), numTuples, components, components - 1, format);
+          vtkUnsignedCharArray* colors = vtkUnsignedCharArray::SafeDownCast(
+            mapper->GetOutput()->GetPointData()->GetScalars());
+          if (!colors || colors->GetNumberOfComponents() != format)
+          {
+            std::cerr << "Wrong output colors for format " << format << "\n";
+            return EXIT_FAILURE;
+          }
+          for (vtkIdType id = 0; id < numTuples * format; id++)
+          {
+            if (colors->GetValue(id) != expected[id])
+            {
+              std::cerr << scalars->GetDataTypeAsString() << " value "
+                        << scalars->GetComponent(id / format, components - 1) << " gives "
+                        << static_cast<int>(colors->GetValue(id)) << " instead of "
+                        << static_cast<int>(expected[id]) << " for format " << format << "\n";
+              return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
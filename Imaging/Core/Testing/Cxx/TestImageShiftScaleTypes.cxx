@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check vtkImageShiftScale, which looks up the output values in a table for
+// 8-bit and 16-bit integer input, against the shift and scale done value by
+// value, for large images that use the table and small images that don't.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageShiftScale.h"
+#include "vtkMathUtilities.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// An image whose values cycle through the whole range of the type.
+void FillImage(vtkImageData* image, int scalarType, int size)
+{
+  image->SetDimensions(size, size, 4);
+  image->AllocateScalars(scalarType, 1);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  const double minimum = scalars->GetDataTypeMin();
+  const vtkIdType count = static_cast<vtkIdType>(scalars->GetDataTypeMax() - minimum) + 1;
+  for (vtkIdType id = 0; id < scalars->GetNumberOfValues(); id++)
+  {
+    scalars->SetComponent(id, 0, minimum + (id * 7919) % count);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class OT>
+OT ShiftScale(double value, double shift, double scale, bool clamp)
+{
+  double val = (value + shift) * scale;
+  return (clamp ? vtkMathUtilities::SafeCastFromDouble<OT>(val) : static_cast<OT>(val));
+}
+
+//------------------------------------------------------------------------------
+bool Check(vtkImageData* input, int outputType, double shift, double scale, bool clamp)
+{
+  vtkNew<vtkImageShiftScale> shiftScale;
+  shiftScale->SetInputData(input);
+  shiftScale->SetOutputScalarType(outputType);
+  shiftScale->SetShift(shift);
+  shiftScale->SetScale(scale);
+  shiftScale->SetClampOverflow(clamp);
+  shiftScale->Update();
+
+  vtkDataArray* inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray* outScalars = shiftScale->GetOutput()->GetPointData()->GetScalars();
+  if (outScalars->GetDataType() != outputType)
+  {
+    std::cerr << "Output type is " << outScalars->GetDataTypeAsString() << "\n";
+    return false;
+  }
+  for (vtkIdType id = 0; id < inScalars->GetNumberOfValues(); id++)
+  {
+    double value = inScalars->GetComponent(id, 0);
+    double expected = 0.0;
+    switch (outputType)
+    {
+      case VTK_UNSIGNED_CHAR:
+        expected = ::ShiftScale<unsigned char>(value, shift, scale, clamp);
+        break;
+      case VTK_SHORT:
+        expected = ::ShiftScale<short>(value, shift, scale, clamp);
+        break;
+      case VTK_FLOAT:
+        expected = ::ShiftScale<float>(value, shift, scale, clamp);
+        break;
+    }
+    if (outScalars->GetComponent(id, 0) != expected)
+    {
+      std::cerr << inScalars->GetDataTypeAsString() << " value " << value << " gives "
+                << outScalars->GetComponent(id, 0) << " instead of " << expected << " for "
+                << outScalars->GetDataTypeAsString() << (clamp ? " with clamping\n" : "\n");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageShiftScaleTypes(int, char*[])
+{
+  for (int inputType : { VTK_UNSIGNED_CHAR, VTK_SIGNED_CHAR, VTK_SHORT, VTK_UNSIGNED_SHORT })
+  {
+    // The large image has enough values for the lookup table to be used.
+    for (int size : { 10, 300 })
+    {
+      vtkNew<vtkImageData> input;
+      ::FillImage(input, inputType, size);
+      if (!::Check(input, VTK_UNSIGNED_CHAR, -100.0, 0.37, true) ||
+        !::Check(input, VTK_SHORT, 12.5, -0.75, true) ||
+        !::Check(input, VTK_FLOAT, -3.0, 1.0 / 3.0, false) ||
+        !::Check(input, VTK_FLOAT, 0.5, 2.0, true))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the Add, Subtract and Replace methods of vtkImageStencilData, which
+// combine the rows in parallel and pack them with Squeeze, against the same
+// operations done voxel by voxel, also when the stencils are combined again.
+
+#include "vtkImageStencilData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Fill a stencil with random runs, with many runs on some rows.
+void RandomStencil(vtkImageStencilData* stencil, const int extent[6],
+  vtkMinimalStandardRandomSequence* random)
+{
+  stencil->SetExtent(extent);
+  stencil->AllocateExtents();
+  for (int idz = extent[4]; idz <= extent[5]; idz++)
+  {
+    for (int idy = extent[2]; idy <= extent[3]; idy++)
+    {
+      const double density = random->GetNextRangeValue(0.0, 1.0);
+      bool inside = false;
+      int r1 = 0;
+      for (int idx = extent[0]; idx <= extent[1] + 1; idx++)
+      {
+        bool next = (idx <= extent[1] && random->GetNextRangeValue(0.0, 1.0) < density);
+        if (next && !inside)
+        {
+          r1 = idx;
+        }
+        else if (!next && inside)
+        {
+          stencil->InsertNextExtent(r1, idx - 1, idy, idz);
+        }
+        inside = next;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool IsInside(vtkImageStencilData* stencil, int idx, int idy, int idz)
+{
+  const int* extent = stencil->GetExtent();
+  return idx >= extent[0] && idx <= extent[1] && stencil->IsInside(idx, idy, idz);
+}
+
+//------------------------------------------------------------------------------
+bool Check(vtkImageStencilData* result, vtkImageStencilData* a, vtkImageStencilData* b,
+  const int expectedExtent[6], int operation)
+{
+  const int* extent = result->GetExtent();
+  for (int i = 0; i < 6; i++)
+  {
+    if (extent[i] != expectedExtent[i])
+    {
+      std::cerr << "Wrong extent for operation " << operation << "\n";
+      return false;
+    }
+  }
+  const int* bExtent = b->GetExtent();
+  for (int idz = extent[4] - 1; idz <= extent[5] + 1; idz++)
+  {
+    for (int idy = extent[2] - 1; idy <= extent[3] + 1; idy++)
+    {
+      for (int idx = extent[0] - 1; idx <= extent[1] + 1; idx++)
+      {
+        bool inA = ::IsInside(a, idx, idy, idz);
+        bool inB = ::IsInside(b, idx, idy, idz);
+        bool expected = inA;
+        if (operation == 0)
+        {
+          expected = inA || inB;
+        }
+        else if (operation == 1)
+        {
+          expected = inA && !inB;
+        }
+        else if (idx >= bExtent[0] && idx <= bExtent[1] && idy >= bExtent[2] &&
+          idy <= bExtent[3] && idz >= bExtent[4] && idz <= bExtent[5])
+        {
+          expected = inB;
+        }
+        if (idx < extent[0] || idx > extent[1] || idy < extent[2] || idy > extent[3] ||
+          idz < extent[4] || idz > extent[5])
+        {
+          expected = false;
+        }
+        bool inside = ::IsInside(result, idx, idy, idz);
+        if (inside != expected)
+        {
+          std::cerr << "Operation " << operation << " gives " << inside << " at " << idx << " "
+                    << idy << " " << idz << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageStencilDataBooleans(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  const int extentA[6] = { 0, 40, 0, 9, 0, 7 };
+  const int extentB[6] = { -5, 30, 3, 14, 2, 9 };
+  const int extentC[6] = { 10, 50, -2, 5, 1, 4 };
+
+  for (int operation = 0; operation < 3; operation++)
+  {
+    vtkNew<vtkImageStencilData> a;
+    vtkNew<vtkImageStencilData> b;
+    vtkNew<vtkImageStencilData> c;
+    ::RandomStencil(a, extentA, random);
+    ::RandomStencil(b, extentB, random);
+    ::RandomStencil(c, extentC, random);
+
+    // The result of the first operation is packed, combine it again.
+    vtkNew<vtkImageStencilData> result;
+    vtkNew<vtkImageStencilData> expected;
+    result->DeepCopy(a);
+    int expectedExtent[6];
+    for (int i = 0; i < 6; i++)
+    {
+      expectedExtent[i] = extentA[i];
+    }
+    vtkImageStencilData* operands[2] = { b, c };
+    for (vtkImageStencilData* operand : operands)
+    {
+      expected->DeepCopy(result);
+      if (operation == 0)
+      {
+        result->Add(operand);
+        const int* operandExtent = operand->GetExtent();
+        for (int i = 0; i < 3; i++)
+        {
+          expectedExtent[2 * i] = std::min(expectedExtent[2 * i], operandExtent[2 * i]);
+          expectedExtent[2 * i + 1] =
+            std::max(expectedExtent[2 * i + 1], operandExtent[2 * i + 1]);
+        }
+      }
+      else if (operation == 1)
+      {
+        result->Subtract(operand);
+      }
+      else
+      {
+        result->Replace(operand);
+      }
+      if (!::Check(result, expected, operand, expectedExtent, operation))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Rows that outgrow the packed block are reallocated.
+    expected->DeepCopy(result);
+    result->InsertAndMergeExtent(extentA[0], extentA[1], 1, 1);
+    for (int idx = extentA[0]; idx <= extentA[1]; idx += 2)
+    {
+      result->RemoveExtent(idx, idx, 2, 2);
+    }
+    for (int idx = extentA[0]; idx <= extentA[1]; idx++)
+    {
+      bool inside = (idx % 2 != 0 && ::IsInside(expected, idx, 2, 2));
+      if (!result->IsInside(idx, 1, 1) || result->IsInside(idx, 2, 2) != inside)
+      {
+        std::cerr << "Merging into packed rows failed at " << idx << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
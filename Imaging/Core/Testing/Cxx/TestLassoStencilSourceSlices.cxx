@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkLassoStencilSource, which rasterizes the slices in parallel
+// when they are stacked along z, gives the same stencil as when the slices
+// are stacked along x and rasterized one after the other, for polygons and
+// splines, with contours that are set for a few slices only.
+
+#include "vtkImageStencilData.h"
+#include "vtkLassoStencilSource.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A star shaped contour whose points are (a, b) in the plane of the slices,
+// with the slice along the axis "zj".
+void Contour(vtkPoints* points, int zj, double size)
+{
+  const int xj = (zj == 0 ? 1 : 0);
+  const int yj = (zj == 0 ? 2 : 1);
+  for (int i = 0; i < 14; i++)
+  {
+    const double angle = 2.0 * vtkMath::Pi() * i / 14;
+    const double r = size * (i % 2 == 0 ? 1.0 : 0.55);
+    double p[3] = { 0.0, 0.0, 0.0 };
+    p[xj] = 20.3 + r * std::cos(angle);
+    p[yj] = 18.7 + r * std::sin(angle);
+    points->InsertNextPoint(p);
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLassoStencilSourceSlices(int, char*[])
+{
+  for (int shape : { vtkLassoStencilSource::POLYGON, vtkLassoStencilSource::SPLINE })
+  {
+    vtkNew<vtkLassoStencilSource> lasso[2];
+    vtkNew<vtkPoints> points[2];
+    vtkNew<vtkPoints> slicePoints[2][2];
+    for (int k = 0; k < 2; k++)
+    {
+      const int zj = (k == 0 ? 2 : 0);
+      ::Contour(points[k], zj, 12.0);
+      ::Contour(slicePoints[k][0], zj, 6.0);
+      ::Contour(slicePoints[k][1], zj, 16.0);
+      lasso[k]->SetShape(shape);
+      lasso[k]->SetSliceOrientation(zj);
+      lasso[k]->SetPoints(points[k]);
+      lasso[k]->SetSlicePoints(7, slicePoints[k][0]);
+      lasso[k]->SetSlicePoints(8, slicePoints[k][0]);
+      lasso[k]->SetSlicePoints(20, slicePoints[k][1]);
+      lasso[k]->SetOutputOrigin(0.0, 0.0, 0.0);
+      lasso[k]->SetOutputSpacing(1.0, 1.0, 1.0);
+    }
+    lasso[0]->SetOutputWholeExtent(0, 39, 0, 39, 0, 29);
+    lasso[1]->SetOutputWholeExtent(0, 29, 0, 39, 0, 39);
+    lasso[0]->Update();
+    lasso[1]->Update();
+
+    vtkImageStencilData* sliced = lasso[0]->GetOutput();
+    vtkImageStencilData* stacked = lasso[1]->GetOutput();
+    int count = 0;
+    for (int s = 0; s <= 29; s++)
+    {
+      for (int b = 0; b <= 39; b++)
+      {
+        for (int a = 0; a <= 39; a++)
+        {
+          const int inside = sliced->IsInside(a, b, s);
+          if (inside != stacked->IsInside(s, a, b))
+          {
+            std::cerr << "Slice " << s << " differs at " << a << " " << b << " for shape "
+                      << lasso[0]->GetShapeAsString() << "\n";
+            return EXIT_FAILURE;
+          }
+          count += inside;
+        }
+      }
+    }
+    if (count == 0)
+    {
+      std::cerr << "Empty stencil for shape " << lasso[0]->GetShapeAsString() << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
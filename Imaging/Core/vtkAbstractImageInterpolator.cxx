@@ -91,6 +91,8 @@ vtkAbstractImageInterpolator::vtkAbstractImageInterpolator()
   this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
   this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
   this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -735,6 +737,8 @@ void vtkAbstractImageInterpolator::Update()
     this->InterpolationFuncFloat = &(vtkInterpolateNOP<float>::InterpolationFunc);
     this->RowInterpolationFuncDouble = &(vtkInterpolateNOP<double>::RowInterpolationFunc);
     this->RowInterpolationFuncFloat = &(vtkInterpolateNOP<float>::RowInterpolationFunc);
+    this->LineInterpolationFuncDouble = nullptr;
+    this->LineInterpolationFuncFloat = nullptr;
 
     return;
   }
@@ -813,6 +817,10 @@ void vtkAbstractImageInterpolator::Update()
   // get the functions that will perform the interpolation
   this->GetInterpolationFunc(&this->InterpolationFuncDouble);
   this->GetInterpolationFunc(&this->InterpolationFuncFloat);
+  this->LineInterpolationFuncDouble = nullptr;
+  this->LineInterpolationFuncFloat = nullptr;
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncDouble);
+  this->GetLineInterpolationFunc(&this->LineInterpolationFuncFloat);
 
   if (this->SlidingWindow)
   {
@@ -901,6 +909,20 @@ void vtkAbstractImageInterpolator::GetInterpolationFunc(
 {
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(VTK_FUTURE_CONST vtkInterpolationInfo*, const double[3], const double[3], int, double*,
+    int))
+{
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractImageInterpolator::GetLineInterpolationFunc(
+  void (**)(VTK_FUTURE_CONST vtkInterpolationInfo*, const float[3], const float[3], int, float*,
+    int))
+{
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractImageInterpolator::GetRowInterpolationFunc(
   void (**)(vtkInterpolationWeights*, int, int, int, double*, int))
@@ -149,6 +149,20 @@ public:
   bool CheckBoundsIJK(const float x[3]);
   ///@}
 
+  ///@{
+  /**
+   * Interpolate n points along a line in structured coords, the points
+   * being origin + i*step for i = idX ... idX + n - 1.  The points must be
+   * within bounds, as checked by CheckBoundsIJK.  The values are the same
+   * as given by InterpolateIJK for each point, but interpolators that
+   * provide a line function compute them without a function call per
+   * point.  This is used by vtkImageReslice for oblique reslicing.
+   */
+  void InterpolateLineIJK(
+    const double origin[3], const double step[3], int idX, double* value, int n);
+  void InterpolateLineIJK(const float origin[3], const float step[3], int idX, float* value, int n);
+  ///@}
+
   ///@{
   /**
    * The border mode (default: clamp).  This controls how out-of-bounds
@@ -285,6 +299,18 @@ protected:
     void (**floatfunc)(VTK_FUTURE_CONST vtkInterpolationInfo*, const float[3], float*));
   ///@}
 
+  ///@{
+  /**
+   * Get the line interpolation functions.  The default is to set them to
+   * nullptr, in which case InterpolateLineIJK calls the interpolation
+   * function for each point.
+   */
+  virtual void GetLineInterpolationFunc(void (**doublefunc)(
+    VTK_FUTURE_CONST vtkInterpolationInfo*, const double[3], const double[3], int, double*, int));
+  virtual void GetLineInterpolationFunc(void (**floatfunc)(
+    VTK_FUTURE_CONST vtkInterpolationInfo*, const float[3], const float[3], int, float*, int));
+  ///@}
+
   ///@{
   /**
    * Get the row interpolation functions.
@@ -329,6 +355,11 @@ protected:
   void (*InterpolationFuncFloat)(
     VTK_FUTURE_CONST vtkInterpolationInfo* info, const float point[3], float* outPtr);
 
+  void (*LineInterpolationFuncDouble)(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+    const double origin[3], const double step[3], int idX, double* outPtr, int n);
+  void (*LineInterpolationFuncFloat)(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+    const float origin[3], const float step[3], int idX, float* outPtr, int n);
+
   void (*RowInterpolationFuncDouble)(
     vtkInterpolationWeights* weights, int idX, int idY, int idZ, double* outPtr, int n);
   void (*RowInterpolationFuncFloat)(
@@ -411,5 +442,45 @@ struct vtkInterpolationWeights : public vtkInterpolationInfo
   }
 };
 
+inline void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const double origin[3], const double step[3], int idX, double* value, int n)
+{
+  if (this->LineInterpolationFuncDouble)
+  {
+    this->LineInterpolationFuncDouble(this->InterpolationInfo, origin, step, idX, value, n);
+    return;
+  }
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; ++i)
+  {
+    double point[3];
+    point[0] = origin[0] + i * step[0];
+    point[1] = origin[1] + i * step[1];
+    point[2] = origin[2] + i * step[2];
+    this->InterpolationFuncDouble(this->InterpolationInfo, point, value);
+    value += numscalars;
+  }
+}
+
+inline void vtkAbstractImageInterpolator::InterpolateLineIJK(
+  const float origin[3], const float step[3], int idX, float* value, int n)
+{
+  if (this->LineInterpolationFuncFloat)
+  {
+    this->LineInterpolationFuncFloat(this->InterpolationInfo, origin, step, idX, value, n);
+    return;
+  }
+  int numscalars = this->InterpolationInfo->NumberOfComponents;
+  for (int i = idX; i < idX + n; ++i)
+  {
+    float point[3];
+    point[0] = origin[0] + i * step[0];
+    point[1] = origin[1] + i * step[1];
+    point[2] = origin[2] + i * step[2];
+    this->InterpolationFuncFloat(this->InterpolationInfo, point, value);
+    value += numscalars;
+  }
+}
+
 VTK_ABI_NAMESPACE_END
 #endif
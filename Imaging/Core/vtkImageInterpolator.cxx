@@ -479,6 +479,362 @@ void vtkImageInterpolatorGetInterpolationFunc(
   }
 }
 
+//------------------------------------------------------------------------------
+// Interpolation along a line, for the points origin + i*step with
+// i = idX ... idX + n - 1.  The border mode is resolved once per line and
+// the number of components is a template parameter, so that the loops over
+// the points have no branches or indirect calls and can be vectorized.
+
+template <class F, class T>
+struct vtkImageNLCLineInterpolate
+{
+  static void Nearest(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+  static void Trilinear(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+  static void Tricubic(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+private:
+  template <int NC>
+  static void NearestClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+  template <int NC>
+  static void TrilinearClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+  template <int NC>
+  static void TricubicClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3],
+    const F step[3], int idX, F* outPtr, int n);
+
+  // call the point function for each point, for the other border modes
+  static void PointByPoint(void (*func)(VTK_FUTURE_CONST vtkInterpolationInfo*, const F[3], F*),
+    VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3], const F step[3], int idX,
+    F* outPtr, int n);
+};
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::PointByPoint(
+  void (*func)(VTK_FUTURE_CONST vtkInterpolationInfo*, const F[3], F*),
+  VTK_FUTURE_CONST vtkInterpolationInfo* info, const F origin[3], const F step[3], int idX,
+  F* outPtr, int n)
+{
+  int numscalars = info->NumberOfComponents;
+  for (int i = idX; i < idX + n; ++i)
+  {
+    F point[3];
+    point[0] = origin[0] + i * step[0];
+    point[1] = origin[1] + i * step[1];
+    point[2] = origin[2] + i * step[2];
+    func(info, point, outPtr);
+    outPtr += numscalars;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::Nearest(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  if (info->BorderMode != VTK_IMAGE_BORDER_CLAMP)
+  {
+    PointByPoint(&vtkImageNLCInterpolate<F, T>::Nearest, info, origin, step, idX, outPtr, n);
+  }
+  else if (info->NumberOfComponents == 1)
+  {
+    NearestClamp<1>(info, origin, step, idX, outPtr, n);
+  }
+  else
+  {
+    NearestClamp<0>(info, origin, step, idX, outPtr, n);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::Trilinear(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  if (info->BorderMode != VTK_IMAGE_BORDER_CLAMP)
+  {
+    PointByPoint(&vtkImageNLCInterpolate<F, T>::Trilinear, info, origin, step, idX, outPtr, n);
+  }
+  else if (info->NumberOfComponents == 1)
+  {
+    TrilinearClamp<1>(info, origin, step, idX, outPtr, n);
+  }
+  else
+  {
+    TrilinearClamp<0>(info, origin, step, idX, outPtr, n);
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageNLCLineInterpolate<F, T>::Tricubic(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  if (info->BorderMode != VTK_IMAGE_BORDER_CLAMP)
+  {
+    PointByPoint(&vtkImageNLCInterpolate<F, T>::Tricubic, info, origin, step, idX, outPtr, n);
+  }
+  else if (info->NumberOfComponents == 1)
+  {
+    TricubicClamp<1>(info, origin, step, idX, outPtr, n);
+  }
+  else
+  {
+    TricubicClamp<0>(info, origin, step, idX, outPtr, n);
+  }
+}
+
+//------------------------------------------------------------------------------
+// nearest neighbor along a line, with the same arithmetic as Nearest()
+template <class F, class T>
+template <int NC>
+void vtkImageNLCLineInterpolate<F, T>::NearestClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+  const int numscalars = (NC > 0 ? NC : info->NumberOfComponents);
+
+  for (int i = idX; i < idX + n; ++i)
+  {
+    int inIdX0 = vtkInterpolationMath::Round(origin[0] + i * step[0]);
+    int inIdY0 = vtkInterpolationMath::Round(origin[1] + i * step[1]);
+    int inIdZ0 = vtkInterpolationMath::Round(origin[2] + i * step[2]);
+
+    inIdX0 = vtkInterpolationMath::Clamp(inIdX0, inExt[0], inExt[1]);
+    inIdY0 = vtkInterpolationMath::Clamp(inIdY0, inExt[2], inExt[3]);
+    inIdZ0 = vtkInterpolationMath::Clamp(inIdZ0, inExt[4], inExt[5]);
+
+    const T* tmpPtr = inPtr + inIdX0 * inInc[0] + inIdY0 * inInc[1] + inIdZ0 * inInc[2];
+    int m = numscalars;
+    do
+    {
+      *outPtr++ = *tmpPtr++;
+    } while (--m);
+  }
+}
+
+//------------------------------------------------------------------------------
+// trilinear interpolation along a line, with the same arithmetic as
+// Trilinear() so that the results are identical
+template <class F, class T>
+template <int NC>
+void vtkImageNLCLineInterpolate<F, T>::TrilinearClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+  const int numscalars = (NC > 0 ? NC : info->NumberOfComponents);
+
+  // change arrays into locals
+  vtkIdType inIncX = inInc[0];
+  vtkIdType inIncY = inInc[1];
+  vtkIdType inIncZ = inInc[2];
+
+  int minX = inExt[0];
+  int maxX = inExt[1];
+  int minY = inExt[2];
+  int maxY = inExt[3];
+  int minZ = inExt[4];
+  int maxZ = inExt[5];
+
+  // This is a hot loop.
+  for (int i = idX; i < idX + n; ++i)
+  {
+    F fx, fy, fz;
+    int inIdX0 = vtkInterpolationMath::Floor(origin[0] + i * step[0], fx);
+    int inIdY0 = vtkInterpolationMath::Floor(origin[1] + i * step[1], fy);
+    int inIdZ0 = vtkInterpolationMath::Floor(origin[2] + i * step[2], fz);
+
+    int inIdX1 = inIdX0 + (fx != 0);
+    int inIdY1 = inIdY0 + (fy != 0);
+    int inIdZ1 = inIdZ0 + (fz != 0);
+
+    vtkIdType factX0 = vtkInterpolationMath::Clamp(inIdX0, minX, maxX) * inIncX;
+    vtkIdType factX1 = vtkInterpolationMath::Clamp(inIdX1, minX, maxX) * inIncX;
+    vtkIdType factY0 = vtkInterpolationMath::Clamp(inIdY0, minY, maxY) * inIncY;
+    vtkIdType factY1 = vtkInterpolationMath::Clamp(inIdY1, minY, maxY) * inIncY;
+    vtkIdType factZ0 = vtkInterpolationMath::Clamp(inIdZ0, minZ, maxZ) * inIncZ;
+    vtkIdType factZ1 = vtkInterpolationMath::Clamp(inIdZ1, minZ, maxZ) * inIncZ;
+
+    vtkIdType i00 = factY0 + factZ0;
+    vtkIdType i01 = factY0 + factZ1;
+    vtkIdType i10 = factY1 + factZ0;
+    vtkIdType i11 = factY1 + factZ1;
+
+    F rx = 1 - fx;
+    F ry = 1 - fy;
+    F rz = 1 - fz;
+
+    F ryrz = ry * rz;
+    F fyrz = fy * rz;
+    F ryfz = ry * fz;
+    F fyfz = fy * fz;
+
+    const T* inPtr0 = inPtr + factX0;
+    const T* inPtr1 = inPtr + factX1;
+
+    int m = numscalars;
+    do
+    {
+      *outPtr++ =
+        (rx * (ryrz * inPtr0[i00] + ryfz * inPtr0[i01] + fyrz * inPtr0[i10] + fyfz * inPtr0[i11]) +
+          fx * (ryrz * inPtr1[i00] + ryfz * inPtr1[i01] + fyrz * inPtr1[i10] + fyfz * inPtr1[i11]));
+      inPtr0++;
+      inPtr1++;
+    } while (--m);
+  }
+}
+
+//------------------------------------------------------------------------------
+// tricubic interpolation along a line, with the same arithmetic as
+// Tricubic() so that the results are identical
+template <class F, class T>
+template <int NC>
+void vtkImageNLCLineInterpolate<F, T>::TricubicClamp(VTK_FUTURE_CONST vtkInterpolationInfo* info,
+  const F origin[3], const F step[3], int idX, F* outPtr, int n)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+  const int numscalars = (NC > 0 ? NC : info->NumberOfComponents);
+
+  // change arrays into locals
+  vtkIdType inIncX = inInc[0];
+  vtkIdType inIncY = inInc[1];
+  vtkIdType inIncZ = inInc[2];
+
+  int minX = inExt[0];
+  int maxX = inExt[1];
+  int minY = inExt[2];
+  int maxY = inExt[3];
+  int minZ = inExt[4];
+  int maxZ = inExt[5];
+
+  // check if only one slice in a particular direction
+  int singleY = (minY == maxY);
+  int singleZ = (minZ == maxZ);
+
+  // This is a hot loop.
+  for (int i = idX; i < idX + n; ++i)
+  {
+    F fx, fy, fz;
+    int inIdX0 = vtkInterpolationMath::Floor(origin[0] + i * step[0], fx);
+    int inIdY0 = vtkInterpolationMath::Floor(origin[1] + i * step[1], fy);
+    int inIdZ0 = vtkInterpolationMath::Floor(origin[2] + i * step[2], fz);
+
+    // the memory offsets
+    vtkIdType factX[4], factY[4], factZ[4];
+    for (int j = 0; j < 4; ++j)
+    {
+      factX[j] = vtkInterpolationMath::Clamp(inIdX0 + j - 1, minX, maxX) * inIncX;
+      factY[j] = vtkInterpolationMath::Clamp(inIdY0 + j - 1, minY, maxY) * inIncY;
+      factZ[j] = vtkInterpolationMath::Clamp(inIdZ0 + j - 1, minZ, maxZ) * inIncZ;
+    }
+
+    // get the interpolation coefficients
+    F fX[4], fY[4], fZ[4];
+    vtkTricubicInterpWeights(fX, fx);
+    vtkTricubicInterpWeights(fY, fy);
+    vtkTricubicInterpWeights(fZ, fz);
+
+    // the limits to use when doing the interpolation
+    int multipleY = !singleY && (fy != 0);
+    int multipleZ = !singleZ && (fz != 0);
+
+    int j1 = 1 - multipleY;
+    int j2 = 1 + 2 * multipleY;
+
+    int k1 = 1 - multipleZ;
+    int k2 = 1 + 2 * multipleZ;
+
+    // if only one coefficient will be used
+    if (multipleY == 0)
+    {
+      fY[1] = 1;
+    }
+    if (multipleZ == 0)
+    {
+      fZ[1] = 1;
+    }
+
+    const T* inPtr0 = inPtr;
+    int m = numscalars;
+    do // loop over components
+    {
+      F val = 0;
+      int k = k1;
+      do // loop over z
+      {
+        F ifz = fZ[k];
+        vtkIdType factz = factZ[k];
+        int j = j1;
+        do // loop over y
+        {
+          F ify = fY[j];
+          F fzy = ifz * ify;
+          vtkIdType factzy = factz + factY[j];
+          const T* tmpPtr = inPtr0 + factzy;
+          // loop over x is unrolled (significant performance boost)
+          val += fzy *
+            (fX[0] * tmpPtr[factX[0]] + fX[1] * tmpPtr[factX[1]] + fX[2] * tmpPtr[factX[2]] +
+              fX[3] * tmpPtr[factX[3]]);
+        } while (++j <= j2);
+      } while (++k <= k2);
+
+      *outPtr++ = val;
+      inPtr0++;
+    } while (--m);
+  }
+}
+
+//------------------------------------------------------------------------------
+// get line interpolation function for different interpolation modes
+// and different scalar types
+template <class F>
+void vtkImageInterpolatorGetLineInterpolationFunc(
+  void (**interpolate)(VTK_FUTURE_CONST vtkInterpolationInfo*, const F[3], const F[3], int, F*, int),
+  int dataType, int interpolationMode)
+{
+  switch (interpolationMode)
+  {
+    case VTK_NEAREST_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(*interpolate = &(vtkImageNLCLineInterpolate<F, VTK_TT>::Nearest));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    case VTK_LINEAR_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(*interpolate = &(vtkImageNLCLineInterpolate<F, VTK_TT>::Trilinear));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+    case VTK_CUBIC_INTERPOLATION:
+      switch (dataType)
+      {
+        vtkTemplateAliasMacro(*interpolate = &(vtkImageNLCLineInterpolate<F, VTK_TT>::Tricubic));
+        default:
+          *interpolate = nullptr;
+      }
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 // Interpolation for precomputed weights
 
@@ -1014,6 +1370,24 @@ void vtkImageInterpolator::GetInterpolationFunc(
     func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
 }
 
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(VTK_FUTURE_CONST vtkInterpolationInfo*, const double[3], const double[3], int,
+    double*, int))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
+//------------------------------------------------------------------------------
+void vtkImageInterpolator::GetLineInterpolationFunc(
+  void (**func)(VTK_FUTURE_CONST vtkInterpolationInfo*, const float[3], const float[3], int,
+    float*, int))
+{
+  vtkImageInterpolatorGetLineInterpolationFunc(
+    func, this->InterpolationInfo->ScalarType, this->InterpolationMode);
+}
+
 //------------------------------------------------------------------------------
 void vtkImageInterpolator::GetRowInterpolationFunc(
   void (**func)(vtkInterpolationWeights*, int, int, int, double*, int))
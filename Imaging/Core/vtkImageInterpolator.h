@@ -101,6 +101,16 @@ protected:
     void (**floatfunc)(VTK_FUTURE_CONST vtkInterpolationInfo*, const float[3], float*)) override;
   ///@}
 
+  ///@{
+  /**
+   * Get the line interpolation functions.
+   */
+  void GetLineInterpolationFunc(void (**doublefunc)(VTK_FUTURE_CONST vtkInterpolationInfo*,
+    const double[3], const double[3], int, double*, int)) override;
+  void GetLineInterpolationFunc(void (**floatfunc)(VTK_FUTURE_CONST vtkInterpolationInfo*,
+    const float[3], const float[3], int, float*, int)) override;
+  ///@}
+
   ///@{
   /**
    * Get the row interpolation functions.
@@ -11,6 +11,11 @@
 #include "vtkPointData.h"
 #include "vtkScalarsToColors.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageMapToColors);
@@ -53,6 +58,78 @@ vtkMTimeType vtkImageMapToColors::GetMTime()
   return t;
 }
 
+//------------------------------------------------------------------------------
+// Input types for which the colors of every possible input value are
+// stored in a table, which is then indexed by the unsigned input value.
+template <class T>
+constexpr bool vtkImageMapToColorsHasTable = std::is_integral_v<T> && sizeof(T) <= 2;
+
+//------------------------------------------------------------------------------
+// Set the values to all the possible values of the type, in the order of
+// the unsigned values.
+template <class T>
+void vtkImageMapToColorsFillValues(vtkDataArray* values, T*)
+{
+  if constexpr (vtkImageMapToColorsHasTable<T>)
+  {
+    using UT = std::make_unsigned_t<T>;
+    T* valuePtr = static_cast<T*>(values->GetVoidPointer(0));
+    for (int i = 0; i <= std::numeric_limits<UT>::max(); ++i)
+    {
+      valuePtr[i] = static_cast<T>(static_cast<UT>(i));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Map all the possible values of 8-bit and 16-bit integer input through the
+// lookup table, or return nullptr if the image is too small for the table to
+// pay off.
+static vtkSmartPointer<vtkUnsignedCharArray> vtkImageMapToColorsBuildTable(
+  vtkScalarsToColors* lookupTable, vtkDataArray* inArray, int outputFormat)
+{
+  // This lookup table enables or disables the colors of each tuple, so its
+  // colors do not depend only on the values.
+  if (!inArray || lookupTable->IsA("vtkLookupTableWithEnabling") || outputFormat < VTK_LUMINANCE ||
+    outputFormat > VTK_RGBA)
+  {
+    return nullptr;
+  }
+
+  int dataType = inArray->GetDataType();
+  vtkIdType tableSize = 0;
+  switch (dataType)
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+      tableSize = 256;
+      break;
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+      tableSize = 65536;
+      break;
+  }
+  if (tableSize == 0 || inArray->GetNumberOfTuples() < 4 * tableSize)
+  {
+    return nullptr;
+  }
+
+  auto values = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(dataType));
+  values->SetNumberOfValues(tableSize);
+  switch (dataType)
+  {
+    vtkTemplateMacro(vtkImageMapToColorsFillValues(values, static_cast<VTK_TT*>(nullptr)));
+  }
+
+  auto table = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  table->SetNumberOfComponents(outputFormat);
+  table->SetNumberOfTuples(tableSize);
+  lookupTable->MapScalarsThroughTable(
+    values->GetVoidPointer(0), table->GetPointer(0), dataType, tableSize, 1, outputFormat);
+  return table;
+}
+
 //------------------------------------------------------------------------------
 // This method checks to see if we can simply reference the input data
 int vtkImageMapToColors::RequestData(
@@ -84,7 +161,12 @@ int vtkImageMapToColors::RequestData(
       this->DataWasPassed = 0;
     }
 
-    return this->Superclass::RequestData(request, inputVector, outputVector);
+    this->ColorTable = vtkImageMapToColorsBuildTable(
+      this->LookupTable, this->GetInputArrayToProcess(0, inputVector), this->OutputFormat);
+
+    int result = this->Superclass::RequestData(request, inputVector, outputVector);
+    this->ColorTable = nullptr;
+    return result;
   }
 
   return 1;
@@ -142,6 +224,48 @@ int vtkImageMapToColors::RequestInformation(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Copy the colors of a row of input values from the table.
+template <int N, class T>
+void vtkImageMapToColorsGather(
+  const T* inPtr, int inIncX, unsigned char* outPtr, int count, const unsigned char* table)
+{
+  using UT = std::make_unsigned_t<T>;
+  for (int i = 0; i < count; ++i)
+  {
+    const unsigned char* color = table + N * static_cast<vtkIdType>(static_cast<UT>(*inPtr));
+    memcpy(outPtr, color, N);
+    inPtr += inIncX;
+    outPtr += N;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageMapToColorsLookup(const void* inPtr, int inIncX, unsigned char* outPtr, int count,
+  int outputFormat, const unsigned char* table, T*)
+{
+  if constexpr (vtkImageMapToColorsHasTable<T>)
+  {
+    const T* valuePtr = static_cast<const T*>(inPtr);
+    switch (outputFormat)
+    {
+      case VTK_RGBA:
+        vtkImageMapToColorsGather<4>(valuePtr, inIncX, outPtr, count, table);
+        break;
+      case VTK_RGB:
+        vtkImageMapToColorsGather<3>(valuePtr, inIncX, outPtr, count, table);
+        break;
+      case VTK_LUMINANCE_ALPHA:
+        vtkImageMapToColorsGather<2>(valuePtr, inIncX, outPtr, count, table);
+        break;
+      case VTK_LUMINANCE:
+        vtkImageMapToColorsGather<1>(valuePtr, inIncX, outPtr, count, table);
+        break;
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // This non-templated function executes the filter for any type of data.
 // All the data to process should be achieved outside this method as
@@ -149,7 +273,7 @@ int vtkImageMapToColors::RequestInformation(vtkInformation* vtkNotUsed(request),
 
 static void vtkImageMapToColorsExecute(vtkImageMapToColors* self, vtkImageData* inData,
   vtkDataArray* inArray, vtkCharArray* maskArray, vtkImageData* outData, vtkDataArray* outArray,
-  VTK_FUTURE_CONST int outExt[6], int id, unsigned char* nanColor)
+  VTK_FUTURE_CONST int outExt[6], int id, unsigned char* nanColor, vtkUnsignedCharArray* table)
 {
   int idxY, idxZ;
   int extX, extY, extZ;
@@ -198,6 +322,14 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors* self, vtkImageData*
   outputFormat = self->GetOutputFormat();
   rowLength = extX * scalarSize * numberOfComponents;
 
+  // Use the table only if it was made for this array and output format
+  const unsigned char* colors = nullptr;
+  if (table && scalarSize <= 2 && table->GetNumberOfComponents() == outputFormat &&
+    table->GetNumberOfTuples() == (vtkIdType(1) << (8 * scalarSize)))
+  {
+    colors = table->GetPointer(0);
+  }
+
   // Loop through output pixels
   outPtr1 = outPtr;
   inPtr1 = static_cast<void*>(static_cast<char*>(inPtr) + self->GetActiveComponent() * scalarSize);
@@ -213,8 +345,19 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors* self, vtkImageData*
         }
         count++;
       }
-      lookupTable->MapScalarsThroughTable(
-        inPtr1, outPtr1, dataType, extX, numberOfComponents, outputFormat);
+      if (colors)
+      {
+        switch (dataType)
+        {
+          vtkTemplateMacro(vtkImageMapToColorsLookup(inPtr1, numberOfComponents, outPtr1, extX,
+            outputFormat, colors, static_cast<VTK_TT*>(nullptr)));
+        }
+      }
+      else
+      {
+        lookupTable->MapScalarsThroughTable(
+          inPtr1, outPtr1, dataType, extX, numberOfComponents, outputFormat);
+      }
       // Handle NaN color when mask
       if (inMask != nullptr)
       {
@@ -281,8 +424,8 @@ void vtkImageMapToColors::ThreadedRequestData(vtkInformation* vtkNotUsed(request
   vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
 
   // Working method
-  vtkImageMapToColorsExecute(
-    this, inData[0][0], inArray, maskArray, outData[0], outArray, outExt, id, this->NaNColor);
+  vtkImageMapToColorsExecute(this, inData[0][0], inArray, maskArray, outData[0], outArray, outExt,
+    id, this->NaNColor, this->ColorTable);
 }
 
 //------------------------------------------------------------------------------
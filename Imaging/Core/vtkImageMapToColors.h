@@ -10,6 +10,10 @@
  * If the lookup table is not set, or is set to nullptr, then the input
  * data will be passed through if it is already of type VTK_UNSIGNED_CHAR.
  *
+ * For 8-bit and 16-bit integer input, every possible input value is mapped
+ * through the lookup table once before the threads start, and the colors of
+ * the pixels are then copied from this table.
+ *
  * @sa
  * vtkLookupTable vtkScalarsToColors
  */
@@ -18,10 +22,12 @@
 #define vtkImageMapToColors_h
 
 #include "vtkImagingCoreModule.h" // For export macro
+#include "vtkSmartPointer.h"      // For ColorTable
 #include "vtkThreadedImageAlgorithm.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkScalarsToColors;
+class vtkUnsignedCharArray;
 
 class VTKIMAGINGCORE_EXPORT VTK_MARSHALAUTO vtkImageMapToColors : public vtkThreadedImageAlgorithm
 {
@@ -108,6 +114,9 @@ protected:
 private:
   vtkImageMapToColors(const vtkImageMapToColors&) = delete;
   void operator=(const vtkImageMapToColors&) = delete;
+
+  // The colors for all the input values, set during RequestData
+  vtkSmartPointer<vtkUnsignedCharArray> ColorTable;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -1989,6 +1989,11 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
   bool rescaleScalars = (scalarShift != 0.0 || scalarScale != 1.0);
 
+  // if the transformation is linear, the points of each row lie on a line,
+  // so they can be interpolated with a single call instead of one call per
+  // point (slab samples are not, so that they keep their exact positions)
+  bool interpolateRows = (!(newtrans || perspective) && nsamples <= 1);
+
   // is nearest neighbor optimization possible?
   bool optimizeNearest = false;
   if (interpolationMode == VTK_NEAREST_INTERPOLATION && borderMode == VTK_IMAGE_BORDER_CLAMP &&
@@ -2161,10 +2166,13 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
               if (interpolator->CheckBoundsIJK(inPoint))
               {
-                // do the interpolation
+                // do the interpolation, or leave it for the whole segment
                 sampleCount++;
                 isInBounds = true;
-                interpolator->InterpolateIJK(inPoint, tmpPtr);
+                if (!interpolateRows)
+                {
+                  interpolator->InterpolateIJK(inPoint, tmpPtr);
+                }
                 tmpPtr += inComponents;
               }
             }
@@ -2186,6 +2194,12 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
           if (wasInBounds)
           {
+            if (interpolateRows)
+            {
+              interpolator->InterpolateLineIJK(
+                inPoint1, xAxis, startIdX, floatPtr + (startIdX - idXmin) * inComponents, numpixels);
+            }
+
             if (outputStencil)
             {
               outputStencil->InsertNextExtent(startIdX, endIdX, idY, idZ);
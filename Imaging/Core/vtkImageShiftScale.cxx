@@ -2,14 +2,19 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkImageShiftScale.h"
 
+#include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageProgressIterator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMathUtilities.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <limits>
+#include <type_traits>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageShiftScale);
 
@@ -48,13 +53,51 @@ int vtkImageShiftScale::RequestInformation(
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Input types for which the output value of every possible input value
+// is stored in a table, which is then indexed by the unsigned input value.
+template <class T>
+constexpr bool vtkImageShiftScaleHasTable = std::is_integral_v<T> && sizeof(T) <= 2;
+
+//------------------------------------------------------------------------------
+template <class IT, class OT>
+void vtkImageShiftScaleFillTable(vtkImageShiftScale* self, vtkDataArray* table, IT*, OT*)
+{
+  if constexpr (vtkImageShiftScaleHasTable<IT>)
+  {
+    using UT = std::make_unsigned_t<IT>;
+    double shift = self->GetShift();
+    double scale = self->GetScale();
+    int clamp = self->GetClampOverflow();
+    OT* outPtr = static_cast<OT*>(table->GetVoidPointer(0));
+
+    // Same pixel operations as in vtkImageShiftScaleExecute
+    for (int i = 0; i <= std::numeric_limits<UT>::max(); ++i)
+    {
+      double val = (static_cast<double>(static_cast<IT>(static_cast<UT>(i))) + shift) * scale;
+      outPtr[i] = (clamp ? vtkMathUtilities::SafeCastFromDouble<OT>(val) : static_cast<OT>(val));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkImageShiftScaleFillTable1(vtkImageShiftScale* self, vtkDataArray* table, T*)
+{
+  switch (table->GetDataType())
+  {
+    vtkTemplateMacro(vtkImageShiftScaleFillTable(
+      self, table, static_cast<T*>(nullptr), static_cast<VTK_TT*>(nullptr)));
+  }
+}
+
 //------------------------------------------------------------------------------
 // This function template implements the filter for any type of data.
 // The last two arguments help the vtkTemplateMacro calls below
 // instantiate the proper input and output types.
 template <class IT, class OT>
 void vtkImageShiftScaleExecute(vtkImageShiftScale* self, vtkImageData* inData,
-  vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], int id, IT*, OT*)
+  vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], int id, vtkDataArray* table, IT*, OT*)
 {
   // Create iterators for the input and output extents assigned to
   // this thread.
@@ -74,6 +117,24 @@ void vtkImageShiftScaleExecute(vtkImageShiftScale* self, vtkImageData* inData,
     IT* inSI = inIt.BeginSpan();
     OT* outSI = outIt.BeginSpan();
     OT* outSIEnd = outIt.EndSpan();
+    if constexpr (vtkImageShiftScaleHasTable<IT>)
+    {
+      if (table)
+      {
+        // Look up the output values, computed once by RequestData
+        using UT = std::make_unsigned_t<IT>;
+        const OT* values = static_cast<const OT*>(table->GetVoidPointer(0));
+        while (outSI != outSIEnd)
+        {
+          *outSI = values[static_cast<UT>(*inSI)];
+          ++outSI;
+          ++inSI;
+        }
+        inIt.NextSpan();
+        outIt.NextSpan();
+        continue;
+      }
+    }
     if (clamp)
     {
       while (outSI != outSIEnd)
@@ -106,18 +167,61 @@ void vtkImageShiftScaleExecute(vtkImageShiftScale* self, vtkImageData* inData,
 //------------------------------------------------------------------------------
 template <class T>
 void vtkImageShiftScaleExecute1(vtkImageShiftScale* self, vtkImageData* inData,
-  vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], int id, T*)
+  vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], int id, vtkDataArray* table, T*)
 {
   switch (outData->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageShiftScaleExecute(
-      self, inData, outData, outExt, id, static_cast<T*>(nullptr), static_cast<VTK_TT*>(nullptr)));
+    vtkTemplateMacro(vtkImageShiftScaleExecute(self, inData, outData, outExt, id, table,
+      static_cast<T*>(nullptr), static_cast<VTK_TT*>(nullptr)));
     default:
       vtkErrorWithObjectMacro(self, "ThreadedRequestData: Unknown output ScalarType");
       return;
   }
 }
 
+//------------------------------------------------------------------------------
+int vtkImageShiftScale::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // For 8-bit and 16-bit integer input, compute the output value of every
+  // possible input value once, unless the image has too few values for the
+  // table to pay off.
+  vtkImageData* input = vtkImageData::GetData(inputVector[0]);
+  vtkDataArray* inScalars = (input ? input->GetPointData()->GetScalars() : nullptr);
+  vtkIdType tableSize = 0;
+  if (inScalars)
+  {
+    switch (inScalars->GetDataType())
+    {
+      case VTK_CHAR:
+      case VTK_SIGNED_CHAR:
+      case VTK_UNSIGNED_CHAR:
+        tableSize = 256;
+        break;
+      case VTK_SHORT:
+      case VTK_UNSIGNED_SHORT:
+        tableSize = 65536;
+        break;
+    }
+  }
+  if (tableSize > 0 && inScalars->GetNumberOfValues() >= 4 * tableSize)
+  {
+    int inType = inScalars->GetDataType();
+    int outType = (this->OutputScalarType != -1 ? this->OutputScalarType : inType);
+    this->ValueTable = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(outType));
+    this->ValueTable->SetNumberOfValues(tableSize);
+    switch (inType)
+    {
+      vtkTemplateMacro(
+        vtkImageShiftScaleFillTable1(this, this->ValueTable, static_cast<VTK_TT*>(nullptr)));
+    }
+  }
+
+  int result = this->Superclass::RequestData(request, inputVector, outputVector);
+  this->ValueTable = nullptr;
+  return result;
+}
+
 //------------------------------------------------------------------------------
 // This method is passed a input and output data, and executes the filter
 // algorithm to fill the output from the input.
@@ -129,10 +233,18 @@ void vtkImageShiftScale::ThreadedRequestData(vtkInformation*, vtkInformationVect
 {
   vtkImageData* input = inData[0][0];
   vtkImageData* output = outData[0];
+
+  // Use the table only if it was made for the output scalar type
+  vtkDataArray* table = this->ValueTable;
+  if (table && table->GetDataType() != output->GetScalarType())
+  {
+    table = nullptr;
+  }
+
   switch (input->GetScalarType())
   {
     vtkTemplateMacro(vtkImageShiftScaleExecute1(
-      this, input, output, outExt, threadId, static_cast<VTK_TT*>(nullptr)));
+      this, input, output, outExt, threadId, table, static_cast<VTK_TT*>(nullptr)));
     default:
       vtkErrorMacro("ThreadedRequestData: Unknown input ScalarType");
       return;
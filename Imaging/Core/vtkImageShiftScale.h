@@ -8,15 +8,22 @@
  * and then scaled (multiplied by a scalar. As a convenience, this class
  * allows you to set the output scalar type similar to vtkImageCast.
  * This is because shift scale operations frequently convert data types.
+ *
+ * For 8-bit and 16-bit integer input, the output value for every possible
+ * input value is computed once before the threads start, and the pixels are
+ * then converted with a table lookup.
  */
 
 #ifndef vtkImageShiftScale_h
 #define vtkImageShiftScale_h
 
 #include "vtkImagingCoreModule.h" // For export macro
+#include "vtkSmartPointer.h"      // For ValueTable
 #include "vtkThreadedImageAlgorithm.h"
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkDataArray;
+
 class VTKIMAGINGCORE_EXPORT vtkImageShiftScale : public vtkThreadedImageAlgorithm
 {
 public:
@@ -83,6 +90,7 @@ protected:
   vtkTypeBool ClampOverflow;
 
   int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   void ThreadedRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*,
     vtkImageData*** inData, vtkImageData** outData, VTK_FUTURE_CONST int outExt[6],
@@ -91,6 +99,9 @@ protected:
 private:
   vtkImageShiftScale(const vtkImageShiftScale&) = delete;
   void operator=(const vtkImageShiftScale&) = delete;
+
+  // The output values for all the input values, set during RequestData
+  vtkSmartPointer<vtkDataArray> ValueTable;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -10,9 +10,11 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageStencilData);
@@ -30,14 +32,52 @@ int vtkImageStencilDataIndex(const int extent[6], int yIdx, int zIdx)
   return (yMax - yMin + 1) * (zIdx - zMin) + (yIdx - yMin);
 }
 
+// The ExtentListLengths array holds the lengths of the rows, followed by
+// two values per row for rows with at most one extent, followed by the
+// longer rows that were packed by Squeeze().  The extent lists that lie
+// within this block were not allocated individually.  Like the lists that
+// were allocated individually, the space for a packed list is the smallest
+// power of two that is not less than its length.
+struct vtkImageStencilDataBlock
+{
+  vtkImageStencilDataBlock(const int* lengths, int n, vtkIdType size)
+    : Begin(lengths + n)
+    , End(lengths + n + size)
+  {
+  }
+
+  bool Contains(const int* clist) const { return (clist >= this->Begin && clist < this->End); }
+
+  const int* Begin;
+  const int* End;
+};
+
+// Free the extent lists that were allocated individually, and the arrays.
+void vtkImageStencilDataFree(int** lists, int* listLengths, int n, vtkIdType size)
+{
+  if (lists)
+  {
+    vtkImageStencilDataBlock block(listLengths, n, size);
+    for (int i = 0; i < n; i++)
+    {
+      if (!block.Contains(lists[i]))
+      {
+        delete[] lists[i];
+      }
+    }
+    delete[] lists;
+  }
+  delete[] listLengths;
+}
+
 // Build up the stencil by appending the extent [r1,r2] to the end of
 // "clist".  The extent list "clist" will be expanded and reallocated
 // as necessary.  If this extent is adjacent to the extent that was
-// previously added, then the extents will be joined. The parameter
-// "clistsmall" is used as "clist" when only a single extent is stored
+// previously added, then the extents will be joined. The "block" holds
+// the space that is used as "clist" when only a single extent is stored
 // in "clist", in order to reduce the need for dynamic memory allocation.
 void vtkImageStencilDataInsertNextExtent(
-  int r1, int r2, int*& clist, int& clistlen, int* clistsmall)
+  int r1, int r2, int*& clist, int& clistlen, const vtkImageStencilDataBlock& block)
 {
   if (clistlen > 0)
   {
@@ -58,7 +98,7 @@ void vtkImageStencilDataInsertNextExtent(
       {
         newclist[k] = clist[k];
       }
-      if (clist != clistsmall)
+      if (!block.Contains(clist))
       {
         delete[] clist;
       }
@@ -106,11 +146,12 @@ struct vtkImageStencilDataAndFunctor
 };
 
 // Combine extent lists "clist1" and "clist2" with "operation",
-// and place the result in "clist".  The operation is done over
+// and place the result in "clist", which must have space for at least
+// clistlen1 + clistlen2 + 2 values.  The operation is done over
 // the range [ext1, ext2].
 template <typename F>
-void vtkImageStencilDataBoolean(int* clist1, int clistlen1, int* clist2, int clistlen2, int*& clist,
-  int& clistlen, int* clistsmall, F operation, int ext1, int ext2)
+void vtkImageStencilDataBoolean(const int* clist1, int clistlen1, const int* clist2,
+  int clistlen2, int* clist, int& clistlen, F operation, int ext1, int ext2)
 {
   // If "not" is set for operand 1 or 2 of the operation, then
   // we start in state "true" instead of the default of "false"
@@ -165,12 +206,121 @@ void vtkImageStencilDataBoolean(int* clist1, int clistlen1, int* clist2, int cli
       rnext = t2;
     }
 
-    // If logical operation is true, then add this extent
+    // If logical operation is true, then add this extent, or continue
+    // the previous extent if they are adjacent
     if (value)
     {
-      vtkImageStencilDataInsertNextExtent(r, rnext - 1, clist, clistlen, clistsmall);
+      if (clistlen > 0 && clist[clistlen - 1] == r)
+      {
+        clist[clistlen - 1] = rnext;
+      }
+      else
+      {
+        clist[clistlen++] = r;
+        clist[clistlen++] = rnext;
+      }
+    }
+  }
+}
+
+// Store the "m" values of "values" as the extent list "clist" of a row.
+// The values are stored in place if they fit within the space that was
+// allocated for the row, otherwise the row is reallocated.
+void vtkImageStencilDataStore(const int* values, int m, int*& clist, int& clistlen,
+  int* clistsmall, const vtkImageStencilDataBlock& block)
+{
+  // the space of a list is the smallest power of two not less than its length
+  int clistmaxlen = 2;
+  if (clist != clistsmall)
+  {
+    while (clistmaxlen < clistlen)
+    {
+      clistmaxlen *= 2;
+    }
+  }
+
+  if (m <= 2 || m > clistmaxlen)
+  {
+    int* newclist = clistsmall;
+    if (m > 2)
+    {
+      clistmaxlen = 4;
+      while (clistmaxlen < m)
+      {
+        clistmaxlen *= 2;
+      }
+      newclist = new int[clistmaxlen];
+    }
+    if (!block.Contains(clist))
+    {
+      delete[] clist;
+    }
+    clist = newclist;
+  }
+
+  std::copy(values, values + m, clist);
+  clistlen = m;
+}
+
+// Combine the extent list "clist" of a row with "clist2" using "operation",
+// and place the result back in "clist".  The operation is done over the
+// range [ext1, ext2], with "scratch" as temporary space for the result.
+template <typename F>
+void vtkImageStencilDataCombine(int*& clist, int& clistlen, int* clistsmall,
+  const vtkImageStencilDataBlock& block, const int* clist2, int clistlen2, F operation, int ext1,
+  int ext2, std::vector<int>& scratch)
+{
+  size_t n = static_cast<size_t>(clistlen) + clistlen2 + 2;
+  if (scratch.size() < n)
+  {
+    scratch.resize(n);
+  }
+
+  int m = 0;
+  vtkImageStencilDataBoolean(
+    clist, clistlen, clist2, clistlen2, scratch.data(), m, operation, ext1, ext2);
+
+  vtkImageStencilDataStore(scratch.data(), m, clist, clistlen, clistsmall, block);
+}
+
+// Pack the extent lists of "n" rows into a new block, see
+// vtkImageStencilDataBlock, and point "lists" to their new location.
+// The size of the block after the lengths is returned in "size".
+int* vtkImageStencilDataPack(
+  int* const* clists, const int* clistlens, int n, int** lists, vtkIdType& size)
+{
+  // rows with more than one extent are placed one after the other
+  std::vector<vtkIdType> offsets(static_cast<size_t>(n));
+  size = 2 * static_cast<vtkIdType>(n);
+  for (int i = 0; i < n; i++)
+  {
+    offsets[i] = 2 * static_cast<vtkIdType>(i);
+    if (clistlens[i] > 2)
+    {
+      int clistmaxlen = 4;
+      while (clistmaxlen < clistlens[i])
+      {
+        clistmaxlen *= 2;
+      }
+      offsets[i] = size;
+      size += clistmaxlen;
     }
   }
+
+  int* listLengths = new int[n + size];
+  vtkSMPTools::For(0, n,
+    [&](int begin, int end)
+    {
+      for (int i = begin; i < end; i++)
+      {
+        int m = clistlens[i];
+        listLengths[i] = m;
+        lists[i] = &listLengths[n + offsets[i]];
+        std::copy(clists[i], clists[i] + m, lists[i]);
+      }
+    });
+
+  return listLengths;
 }
 
 // Clip the sub-extents in "clist" to the range [ext1,ext2]
@@ -243,6 +393,7 @@ vtkImageStencilData::vtkImageStencilData()
   this->NumberOfExtentEntries = 0;
   this->ExtentLists = nullptr;
   this->ExtentListLengths = nullptr;
+  this->ExtentStorageSize = 0;
 
   this->Extent[0] = 0;
   this->Extent[1] = -1;
@@ -281,23 +432,12 @@ void vtkImageStencilData::PrintSelf(ostream& os, vtkIndent indent)
 //------------------------------------------------------------------------------
 void vtkImageStencilData::Initialize()
 {
-  if (this->ExtentLists)
-  {
-    int n = this->NumberOfExtentEntries;
-    for (int i = 0; i < n; i++)
-    {
-      if (this->ExtentLists[i] != &this->ExtentListLengths[n + 2 * i])
-      {
-        delete[] this->ExtentLists[i];
-      }
-    }
-    delete[] this->ExtentLists;
-  }
+  vtkImageStencilDataFree(this->ExtentLists, this->ExtentListLengths, this->NumberOfExtentEntries,
+    this->ExtentStorageSize);
   this->ExtentLists = nullptr;
-  this->NumberOfExtentEntries = 0;
-
-  delete[] this->ExtentListLengths;
   this->ExtentListLengths = nullptr;
+  this->ExtentStorageSize = 0;
+  this->NumberOfExtentEntries = 0;
 
   if (this->Information)
   {
@@ -393,50 +533,20 @@ void vtkImageStencilData::InternalImageStencilDataCopy(vtkImageStencilData* s)
   this->SetOrigin(s->Origin);
 
   // delete old data
-  if (this->ExtentLists)
-  {
-    int n = this->NumberOfExtentEntries;
-    for (int i = 0; i < n; i++)
-    {
-      if (this->ExtentLists[i] != &this->ExtentListLengths[n + 2 * i])
-      {
-        delete[] this->ExtentLists[i];
-      }
-    }
-    delete[] this->ExtentLists;
-  }
+  vtkImageStencilDataFree(this->ExtentLists, this->ExtentListLengths, this->NumberOfExtentEntries,
+    this->ExtentStorageSize);
   this->ExtentLists = nullptr;
-  this->NumberOfExtentEntries = 0;
-
-  delete[] this->ExtentListLengths;
   this->ExtentListLengths = nullptr;
+  this->ExtentStorageSize = 0;
+  this->NumberOfExtentEntries = 0;
 
-  // copy new data
+  // copy new data, packed into a single block
   if (s->NumberOfExtentEntries != 0)
   {
     this->NumberOfExtentEntries = s->NumberOfExtentEntries;
-    int n = this->NumberOfExtentEntries;
-    this->ExtentListLengths = new int[3 * n];
-    this->ExtentLists = new int*[n];
-    for (int i = 0; i < n; i++)
-    {
-      this->ExtentListLengths[i] = s->ExtentListLengths[i];
-      int m = this->ExtentListLengths[i];
-      int clistmaxlen = 1;
-      do
-      {
-        clistmaxlen *= 2;
-      } while (m > clistmaxlen);
-      this->ExtentLists[i] = &this->ExtentListLengths[n + 2 * i];
-      if (clistmaxlen > 2)
-      {
-        this->ExtentLists[i] = new int[clistmaxlen];
-      }
-      for (int j = 0; j < m; j++)
-      {
-        this->ExtentLists[i][j] = s->ExtentLists[i][j];
-      }
-    }
+    this->ExtentLists = new int*[this->NumberOfExtentEntries];
+    this->ExtentListLengths = vtkImageStencilDataPack(s->ExtentLists, s->ExtentListLengths,
+      this->NumberOfExtentEntries, this->ExtentLists, this->ExtentStorageSize);
   }
   memcpy(this->Extent, s->GetExtent(), 6 * sizeof(int));
 }
@@ -458,22 +568,16 @@ void vtkImageStencilData::ChangeExtent(const int extent[6])
     int numberOfEntries = this->NumberOfExtentEntries;
     int* listLengths = this->ExtentListLengths;
     int** lists = this->ExtentLists;
-    int* smallstore = &listLengths[numberOfEntries];
+    vtkIdType storageSize = this->ExtentStorageSize;
 
-    // Clear the stencil
-    this->NumberOfExtentEntries = 0;
-    this->ExtentListLengths = nullptr;
-    this->ExtentLists = nullptr;
-
-    // Re-allocate
-    this->AllocateExtents();
+    // Gather the rows that lie within the new extent
+    int ySize = extent[3] - extent[2] + 1;
+    int zSize = extent[5] - extent[4] + 1;
+    int n = std::max(ySize, 0) * std::max(zSize, 0);
+    std::vector<int*> newLists(static_cast<size_t>(n), nullptr);
+    std::vector<int> newListLengths(static_cast<size_t>(n), 0);
 
-    // Get the location for storing single extents
-    int* ss = &this->ExtentListLengths[this->NumberOfExtentEntries];
-
-    // Copy the information back again
     int k = 0;
-    int zinc = extent[3] - extent[2] + 1;
     for (int idz = oldExtent[4]; idz <= oldExtent[5]; idz++)
     {
       for (int idy = oldExtent[2]; idy <= oldExtent[3]; idy++)
@@ -485,32 +589,27 @@ void vtkImageStencilData::ChangeExtent(const int extent[6])
             vtkImageStencilDataClipExtent(extent[0], extent[1], lists[k], listLengths[k]);
           }
 
-          int j = (idz - extent[4]) * zinc + (idy - extent[2]);
-          this->ExtentListLengths[j] = listLengths[k];
-          if (lists[k] == &smallstore[2 * k])
-          {
-            ss[2 * j] = smallstore[2 * k];
-            ss[2 * j + 1] = smallstore[2 * k + 1];
-            this->ExtentLists[j] = &ss[2 * j];
-          }
-          else
-          {
-            this->ExtentLists[j] = lists[k];
-          }
-        }
-        else // free out-of-bounds info that wasn't copied
-        {
-          if (lists[k] != &smallstore[2 * k])
-          {
-            delete[] lists[k];
-          }
+          int j = (idz - extent[4]) * ySize + (idy - extent[2]);
+          newLists[j] = lists[k];
+          newListLengths[j] = listLengths[k];
         }
         k++;
       }
     }
 
-    delete[] lists;
-    delete[] listLengths;
+    // Pack the rows into a new block, then free the old rows
+    this->ExtentLists = nullptr;
+    this->ExtentListLengths = nullptr;
+    this->ExtentStorageSize = 0;
+    this->NumberOfExtentEntries = n;
+    if (n)
+    {
+      this->ExtentLists = new int*[n];
+      this->ExtentListLengths = vtkImageStencilDataPack(
+        newLists.data(), newListLengths.data(), n, this->ExtentLists, this->ExtentStorageSize);
+    }
+
+    vtkImageStencilDataFree(lists, listLengths, numberOfEntries, storageSize);
   }
   else if (extent[0] > oldExtent[0] || extent[1] < oldExtent[1])
   {
@@ -540,23 +639,13 @@ void vtkImageStencilData::AllocateExtents()
   int numEntries = ySize * zSize;
   if (numEntries != this->NumberOfExtentEntries)
   {
-    if (this->NumberOfExtentEntries != 0)
-    {
-      int n = this->NumberOfExtentEntries;
-      for (int i = 0; i < n; i++)
-      {
-        if (this->ExtentLists[i] != &this->ExtentListLengths[n + 2 * i])
-        {
-          delete[] this->ExtentLists[i];
-        }
-      }
-      delete[] this->ExtentLists;
-      delete[] this->ExtentListLengths;
-    }
+    vtkImageStencilDataFree(this->ExtentLists, this->ExtentListLengths,
+      this->NumberOfExtentEntries, this->ExtentStorageSize);
 
     this->NumberOfExtentEntries = numEntries;
     this->ExtentLists = nullptr;
     this->ExtentListLengths = nullptr;
+    this->ExtentStorageSize = 0;
 
     if (numEntries)
     {
@@ -564,6 +653,7 @@ void vtkImageStencilData::AllocateExtents()
       // the ExtentLists array, which is why it has 3*numEntries values
       this->ExtentLists = new int*[numEntries];
       this->ExtentListLengths = new int[3 * numEntries];
+      this->ExtentStorageSize = 2 * static_cast<vtkIdType>(numEntries);
       for (int i = 0; i < numEntries; i++)
       {
         this->ExtentListLengths[i] = 0;
@@ -573,9 +663,10 @@ void vtkImageStencilData::AllocateExtents()
   }
   else
   {
+    vtkImageStencilDataBlock block(this->ExtentListLengths, numEntries, this->ExtentStorageSize);
     for (int i = 0; i < numEntries; i++)
     {
-      if (this->ExtentLists[i] != &this->ExtentListLengths[numEntries + 2 * i])
+      if (!block.Contains(this->ExtentLists[i]))
       {
         delete[] this->ExtentLists[i];
       }
@@ -734,9 +825,10 @@ void vtkImageStencilData::Fill()
   int r2 = this->Extent[1];
 
   int n = this->NumberOfExtentEntries;
+  vtkImageStencilDataBlock block(this->ExtentListLengths, n, this->ExtentStorageSize);
   for (int i = 0; i < n; i++)
   {
-    if (this->ExtentLists[i] != &this->ExtentListLengths[n + 2 * i])
+    if (!block.Contains(this->ExtentLists[i]))
     {
       delete[] this->ExtentLists[i];
     }
@@ -756,7 +848,8 @@ void vtkImageStencilData::InsertNextExtent(int r1, int r2, int yIdx, int zIdx)
 
   vtkImageStencilDataInsertNextExtent(r1, r2, this->ExtentLists[incr],
     this->ExtentListLengths[incr],
-    &this->ExtentListLengths[this->NumberOfExtentEntries + 2 * incr]);
+    vtkImageStencilDataBlock(
+      this->ExtentListLengths, this->NumberOfExtentEntries, this->ExtentStorageSize));
 }
 
 //------------------------------------------------------------------------------
@@ -769,36 +862,22 @@ void vtkImageStencilData::LogicalOperationExtent(
   int& clistlen = this->ExtentListLengths[incr];
   int*& clist = this->ExtentLists[incr];
   int* clistsmall = &this->ExtentListLengths[this->NumberOfExtentEntries + 2 * incr];
+  vtkImageStencilDataBlock block(
+    this->ExtentListLengths, this->NumberOfExtentEntries, this->ExtentStorageSize);
 
   int clistlen2 = 2;
   int clist2[2] = { r1, r2 + 1 };
-  int clistsmall1[2];
-  int clistlen1 = clistlen;
-  int* clist1 = clist;
-  if (clist == clistsmall)
-  {
-    clistsmall1[0] = clistsmall[0];
-    clistsmall1[1] = clistsmall[1];
-    clist1 = clistsmall1;
-  }
-
-  clist = clistsmall;
-  clistlen = 0;
+  std::vector<int> scratch;
 
   if (operation == Merge)
   {
-    vtkImageStencilDataBoolean(clist1, clistlen1, clist2, clistlen2, clist, clistlen, clistsmall,
-      vtkImageStencilDataOrFunctor(false, false), this->Extent[0], this->Extent[1]);
+    vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist2, clistlen2,
+      vtkImageStencilDataOrFunctor(false, false), this->Extent[0], this->Extent[1], scratch);
   }
   else if (operation == Erase)
   {
-    vtkImageStencilDataBoolean(clist1, clistlen1, clist2, clistlen2, clist, clistlen, clistsmall,
-      vtkImageStencilDataAndFunctor(false, true), this->Extent[0], this->Extent[1]);
-  }
-
-  if (clist1 != clistsmall1)
-  {
-    delete[] clist1;
+    vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist2, clistlen2,
+      vtkImageStencilDataAndFunctor(false, true), this->Extent[0], this->Extent[1], scratch);
   }
 }
 
@@ -843,50 +922,58 @@ void vtkImageStencilData::LogicalOperationInPlace(vtkImageStencilData* stencil,
     }
   }
 
-  // Iterate over the intersected extent
-  for (int idz = extent[4]; idz <= extent[5]; idz++)
-  {
-    for (int idy = extent[2]; idy <= extent[3]; idy++)
+  // Iterate over the rows of the intersected extent, each row is
+  // independent of the others so they are combined in parallel
+  int ySize = extent[3] - extent[2] + 1;
+  int zSize = extent[5] - extent[4] + 1;
+  vtkImageStencilDataBlock block(
+    this->ExtentListLengths, this->NumberOfExtentEntries, this->ExtentStorageSize);
+  vtkSMPTools::For(0, ySize * zSize,
+    [&](int begin, int end)
     {
-      int incr = vtkImageStencilDataIndex(stencil->Extent, idy, idz);
-      int clistlen2 = stencil->ExtentListLengths[incr];
-      int* clist2 = stencil->ExtentLists[incr];
-
-      incr = vtkImageStencilDataIndex(this->Extent, idy, idz);
-      int& clistlen = this->ExtentListLengths[incr];
-      int*& clist = this->ExtentLists[incr];
-      int* clistsmall = &this->ExtentListLengths[this->NumberOfExtentEntries + 2 * incr];
-
-      int clistsmall1[2];
-      int clistlen1 = clistlen;
-      int* clist1 = clist;
-      if (clist == clistsmall)
+      // the result of each row is computed in this space before it is
+      // stored back in place, to avoid allocating memory for each row
+      std::vector<int> scratch;
+
+      for (int row = begin; row < end; row++)
       {
-        clistsmall1[0] = clistsmall[0];
-        clistsmall1[1] = clistsmall[1];
-        clist1 = clistsmall1;
-      }
+        int idy = extent[2] + row % ySize;
+        int idz = extent[4] + row / ySize;
 
-      clist = clistsmall;
-      clistlen = 0;
+        int incr = vtkImageStencilDataIndex(stencil->Extent, idy, idz);
+        int clistlen2 = stencil->ExtentListLengths[incr];
+        const int* clist2 = stencil->ExtentLists[incr];
 
-      if (operation == Merge)
-      {
-        vtkImageStencilDataBoolean(clist1, clistlen1, clist2, clistlen2, clist, clistlen,
-          clistsmall, vtkImageStencilDataOrFunctor(false, false), this->Extent[0], this->Extent[1]);
-      }
-      else if (operation == Erase)
-      {
-        vtkImageStencilDataBoolean(clist1, clistlen1, clist2, clistlen2, clist, clistlen,
-          clistsmall, vtkImageStencilDataAndFunctor(false, true), this->Extent[0], this->Extent[1]);
-      }
+        incr = vtkImageStencilDataIndex(this->Extent, idy, idz);
+        int& clistlen = this->ExtentListLengths[incr];
+        int*& clist = this->ExtentLists[incr];
+        int* clistsmall = &this->ExtentListLengths[this->NumberOfExtentEntries + 2 * incr];
 
-      if (clist1 != clistsmall1)
-      {
-        delete[] clist1;
+        if (operation == Merge)
+        {
+          vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist2,
+            clistlen2, vtkImageStencilDataOrFunctor(false, false), this->Extent[0],
+            this->Extent[1], scratch);
+        }
+        else if (operation == Erase)
+        {
+          vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist2,
+            clistlen2, vtkImageStencilDataAndFunctor(false, true), this->Extent[0],
+            this->Extent[1], scratch);
+        }
+        else if (operation == Overwrite)
+        {
+          // erase the intersected extent, then merge the stencil into it
+          int clist3[2] = { extent[0], extent[1] + 1 };
+          vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist3, 2,
+            vtkImageStencilDataAndFunctor(false, true), this->Extent[0], this->Extent[1],
+            scratch);
+          vtkImageStencilDataCombine(clist, clistlen, clistsmall, block, clist2,
+            clistlen2, vtkImageStencilDataOrFunctor(false, false), this->Extent[0],
+            this->Extent[1], scratch);
+        }
       }
-    }
-  }
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -938,7 +1025,7 @@ void vtkImageStencilData::Subtract(vtkImageStencilData* stencil1)
 //------------------------------------------------------------------------------
 void vtkImageStencilData::Replace(vtkImageStencilData* stencil1)
 {
-  int extent[6], extent1[6], extent2[6], r1, r2, idy, idz, iter = 0;
+  int extent1[6], extent2[6];
   stencil1->GetExtent(extent1);
   this->GetExtent(extent2);
 
@@ -949,34 +1036,29 @@ void vtkImageStencilData::Replace(vtkImageStencilData* stencil1)
     return;
   }
 
-  // Find the smallest box intersection of the extents
-  extent[0] = (extent1[0] < extent2[0]) ? extent2[0] : extent1[0];
-  extent[1] = (extent1[1] > extent2[1]) ? extent2[1] : extent1[1];
-  extent[2] = (extent1[2] < extent2[2]) ? extent2[2] : extent1[2];
-  extent[3] = (extent1[3] > extent2[3]) ? extent2[3] : extent1[3];
-  extent[4] = (extent1[4] < extent2[4]) ? extent2[4] : extent1[4];
-  extent[5] = (extent1[5] > extent2[5]) ? extent2[5] : extent1[5];
-
-  for (idz = extent[4]; idz <= extent[5]; idz++, iter = 0)
-  {
-    for (idy = extent[2]; idy <= extent[3]; idy++, iter = 0)
-    {
-      this->RemoveExtent(extent[0], extent[1], idy, idz);
+  this->LogicalOperationInPlace(stencil1, Overwrite);
 
-      int moreSubExtents = 1;
-      while (moreSubExtents)
-      {
-        moreSubExtents = stencil1->GetNextExtent(r1, r2, extent[0], extent[1], idy, idz, iter);
+  this->Modified();
+}
 
-        if (r1 <= r2) // sanity check
-        {
-          this->InsertAndMergeExtent(r1, r2, idy, idz);
-        }
-      }
-    }
+//------------------------------------------------------------------------------
+void vtkImageStencilData::Squeeze()
+{
+  int n = this->NumberOfExtentEntries;
+  if (n == 0)
+  {
+    return;
   }
 
-  this->Modified();
+  int** lists = new int*[n];
+  vtkIdType size;
+  int* listLengths =
+    vtkImageStencilDataPack(this->ExtentLists, this->ExtentListLengths, n, lists, size);
+
+  vtkImageStencilDataFree(this->ExtentLists, this->ExtentListLengths, n, this->ExtentStorageSize);
+  this->ExtentLists = lists;
+  this->ExtentListLengths = listLengths;
+  this->ExtentStorageSize = size;
 }
 
 //------------------------------------------------------------------------------
@@ -996,6 +1078,7 @@ int vtkImageStencilData::Clip(int extent[6])
   int* listLengths = this->ExtentListLengths;
   int** lists = this->ExtentLists;
   int* smallstore = &listLengths[numberOfEntries];
+  vtkImageStencilDataBlock block(listLengths, numberOfEntries, this->ExtentStorageSize);
 
   // Perform the clip
   bool modified = false;
@@ -1020,11 +1103,11 @@ int vtkImageStencilData::Clip(int extent[6])
       else if (listLengths[k] > 0)
       {
         listLengths[k] = 0;
-        if (lists[k] != &smallstore[2 * k])
+        if (!block.Contains(lists[k]))
         {
           delete[] lists[k];
-          lists[k] = &smallstore[2 * k];
         }
+        lists[k] = &smallstore[2 * k];
         modified = true;
       }
       k++;
@@ -8,6 +8,9 @@
  * efficient both in terms of speed and storage space.  The stencil extents
  * are stored for each x-row across the image (multiple extents per row if
  * necessary) and can be retrieved via the GetNextExtent() method.
+ * The extents of all the rows can be packed into a single block of memory
+ * with Squeeze().  The boolean operations combine the rows in parallel,
+ * and reuse the memory of each row whenever the result fits within it.
  * @sa
  * vtkImageStencilSource vtkImageStencil
  */
@@ -129,6 +132,14 @@ public:
    */
   void Fill();
 
+  /**
+   * Pack the sub-extents of all the rows into a single contiguous block
+   * of memory, releasing the memory that was allocated for each row as
+   * the sub-extents were inserted.  This is called by the stencil sources
+   * once they are done, and the stencil is packed as well by DeepCopy().
+   */
+  void Squeeze();
+
   ///@{
   /**
    * Override these to handle origin, spacing, scalar type, and scalar
@@ -176,7 +187,8 @@ protected:
   enum Operation
   {
     Merge,
-    Erase
+    Erase,
+    Overwrite
   };
 
   /**
@@ -218,6 +230,7 @@ protected:
   int NumberOfExtentEntries;
   int* ExtentListLengths;
   int** ExtentLists;
+  vtkIdType ExtentStorageSize;
   ///@}
 
 private:
@@ -9,6 +9,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageFFT);
@@ -104,6 +105,8 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
   // Allocate the arrays of complex numbers
   inComplex = new vtkImageComplex[inSize0];
   outComplex = new vtkImageComplex[inSize0];
+  // Real input is transformed with a real to complex fft
+  std::vector<double> inReal(numberOfComponents == 1 ? inSize0 : 0);
 
   target = static_cast<unsigned long>(
     (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) * self->GetNumberOfIterations() / 50.0);
@@ -126,23 +129,33 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
         }
         count++;
       }
-      // copy into complex numbers
       inPtr0 = inPtr1;
-      pComplex = inComplex;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+      if (numberOfComponents == 1)
       {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
-        { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);
+        for (idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          inReal[idx0] = static_cast<double>(*inPtr0);
+          inPtr0 += inInc0;
         }
-        inPtr0 += inInc0;
-        ++pComplex;
+
+        // Call the method that performs the real fft
+        self->ExecuteRealFft(inReal.data(), outComplex, inSize0);
       }
+      else
+      {
+        // copy into complex numbers (we have an imaginary input)
+        pComplex = inComplex;
+        for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
+        {
+          pComplex->Real = static_cast<double>(*inPtr0);
+          pComplex->Imag = static_cast<double>(inPtr0[1]);
+          inPtr0 += inInc0;
+          ++pComplex;
+        }
 
-      // Call the method that performs the fft
-      self->ExecuteFft(inComplex, outComplex, inSize0);
+        // Call the method that performs the fft
+        self->ExecuteFft(inComplex, outComplex, inSize0);
+      }
 
       // copy into output
       outPtr0 = outPtr1;
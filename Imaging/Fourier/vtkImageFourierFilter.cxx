@@ -3,14 +3,83 @@
 #include "vtkImageFourierFilter.h"
 
 #include "vtkMath.h"
+
+#include "vtk_kissfft.h"
+// clang-format off
+#include VTK_KISSFFT_HEADER(kiss_fft.h)
+// clang-format on
+
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+static_assert(std::is_same<kiss_fft_scalar, double>::value &&
+    sizeof(kiss_fft_cpx) == sizeof(vtkImageComplex),
+  "vtkImageComplex must have the memory layout of kiss_fft_cpx");
 
 /*=========================================================================
         Vectors of complex numbers.
 =========================================================================*/
 
-//------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
+// Transform plans, created once for each size and direction. A plan is only
+// read while computing a transform, so the threads share it.
+class vtkImageFourierFilter::vtkInternals
+{
+public:
+  kiss_fft_cfg GetPlan(int n, bool inverse)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto& plan = this->Plans[std::make_pair(n, inverse)];
+    if (!plan)
+    {
+      plan.reset(kiss_fft_alloc(n, inverse ? 1 : 0, nullptr, nullptr));
+    }
+    return plan.get();
+  }
+
+  // exp(-2 i pi k / n) for k in [0, n / 2[, used to split the fft of n real
+  // values computed with a complex fft of size n / 2.
+  const vtkImageComplex* GetRealTwiddles(int n)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto& twiddles = this->RealTwiddles[n];
+    if (twiddles.empty())
+    {
+      twiddles.resize(n / 2);
+      for (int k = 0; k < n / 2; ++k)
+      {
+        vtkImageComplexPolarSet(twiddles[k], 1.0, -2.0 * vtkMath::Pi() * k / n);
+      }
+    }
+    return twiddles.data();
+  }
+
+private:
+  struct PlanDeleter
+  {
+    void operator()(kiss_fft_cfg plan) const { kiss_fft_free(plan); }
+  };
+
+  std::map<std::pair<int, bool>, std::unique_ptr<kiss_fft_state, PlanDeleter>> Plans;
+  std::map<int, std::vector<vtkImageComplex>> RealTwiddles;
+  std::mutex Mutex;
+};
+
+//------------------------------------------------------------------------------
+vtkImageFourierFilter::vtkImageFourierFilter()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkImageFourierFilter::~vtkImageFourierFilter() = default;
+
+//------------------------------------------------------------------------------
 void vtkImageFourierFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -136,63 +205,63 @@ void vtkImageFourierFilter::ExecuteFftStepN(
 //------------------------------------------------------------------------------
 // This function calculates the whole fft (or rfft) of an array.
 // The contents of the input array are changed.
-// It is engineered for no decimation so input and output cannot be equal.
+// Input and output cannot be equal.
 // (fb = 1) => fft, (fb = -1) => rfft;
 void vtkImageFourierFilter::ExecuteFftForwardBackward(
   vtkImageComplex* in, vtkImageComplex* out, int N, int fb)
 {
-  vtkImageComplex *p1, *p2, *p3;
-  int block_size = 1;
-  int rest_size = N;
-  int n = 2;
-  int idx;
-
   // If this is a reverse transform (scale accordingly).
   if (fb == -1)
   {
-    p1 = in;
-    for (idx = 0; idx < N; ++idx)
+    for (int idx = 0; idx < N; ++idx)
     {
-      p1->Real = p1->Real / N;
-      p1->Imag = p1->Imag / N;
-      ++p1;
+      vtkImageComplexScale(in[idx], 1.0 / N, in[idx]);
     }
   }
-  p1 = in;
-  p2 = out;
-  while (block_size < N && n <= N)
+  if (N == 1)
+  {
+    *out = *in;
+    return;
+  }
+
+  kiss_fft_cfg plan = this->Internals->GetPlan(N, fb == -1);
+  if (plan)
+  {
+    kiss_fft(plan, reinterpret_cast<kiss_fft_cpx*>(in), reinterpret_cast<kiss_fft_cpx*>(out));
+    return;
+  }
+
+  // Without a plan, perform one "butterfly" stage per prime factor of N.
+  vtkImageComplex* p1 = in;
+  vtkImageComplex* p2 = out;
+  int blockSize = 1;
+  int restSize = N;
+  int n = 2;
+  while (blockSize < N && n <= N)
   {
-    if ((rest_size % n) == 0)
+    if (restSize % n == 0)
     {
-      // n is a prime factor, perform one "butterfly" stage of the fft.
       if (n == 2)
       {
-        this->ExecuteFftStep2(p1, p2, N, block_size, fb);
+        this->ExecuteFftStep2(p1, p2, N, blockSize, fb);
       }
       else
       {
-        this->ExecuteFftStepN(p1, p2, N, block_size, n, fb);
+        this->ExecuteFftStepN(p1, p2, N, blockSize, n, fb);
       }
-      block_size = block_size * n;
-      rest_size = rest_size / n;
-      // switch input and output.
-      p3 = p1;
-      p1 = p2;
-      p2 = p3;
+      blockSize *= n;
+      restSize /= n;
+      std::swap(p1, p2);
     }
     else
     {
-      // n is not a prime factor. increment n to see if n+1 is.
       ++n;
     }
   }
   // If the results ended up in the input, copy to output.
   if (p1 != out)
   {
-    for (n = 0; n < N; ++n)
-    {
-      *out++ = *p1++;
-    }
+    std::copy_n(p1, N, out);
   }
 }
 
@@ -214,6 +283,61 @@ void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex* in, vtkImageComplex* ou
   this->ExecuteFftForwardBackward(in, out, N, -1);
 }
 
+//------------------------------------------------------------------------------
+// This function calculates the whole fft of an array of real values.
+// For an even N, the even and odd values are the real and imaginary parts of
+// N / 2 complex values whose fft gives the ffts of the even and odd values,
+// which are then combined. The second half of the output is the conjugate of
+// the first one.
+void vtkImageFourierFilter::ExecuteRealFft(const double* in, vtkImageComplex* out, int N)
+{
+  const int half = N / 2;
+  kiss_fft_cfg plan = N < 4 || N % 2 ? nullptr : this->Internals->GetPlan(half, false);
+  if (!plan)
+  {
+    std::vector<vtkImageComplex> complexIn(N);
+    for (int idx = 0; idx < N; ++idx)
+    {
+      vtkImageComplexEuclidSet(complexIn[idx], in[idx], 0.0);
+    }
+    this->ExecuteFft(complexIn.data(), out, N);
+    return;
+  }
+
+  kiss_fft(plan, reinterpret_cast<const kiss_fft_cpx*>(in), reinterpret_cast<kiss_fft_cpx*>(out));
+
+  const vtkImageComplex* twiddles = this->Internals->GetRealTwiddles(N);
+  // out[k] = even[k] + twiddles[k] * odd[k], with
+  // even[k] = (z[k] + conj(z[half - k])) / 2 and odd[k] = (z[k] - conj(z[half - k])) / 2i
+  auto split = [](const vtkImageComplex& zk, const vtkImageComplex& zHalfMinusK,
+                 const vtkImageComplex& twiddle, vtkImageComplex& result)
+  {
+    vtkImageComplex conjugate, even, difference, odd;
+    vtkImageComplexConjugate(zHalfMinusK, conjugate);
+    vtkImageComplexAdd(zk, conjugate, even);
+    vtkImageComplexScale(even, 0.5, even);
+    vtkImageComplexSubtract(zk, conjugate, difference);
+    vtkImageComplexEuclidSet(odd, 0.5 * difference.Imag, -0.5 * difference.Real);
+    vtkImageComplexMultiply(twiddle, odd, odd);
+    vtkImageComplexAdd(even, odd, result);
+  };
+
+  const vtkImageComplex z0 = out[0];
+  vtkImageComplexEuclidSet(out[0], z0.Real + z0.Imag, 0.0);
+  vtkImageComplexEuclidSet(out[half], z0.Real - z0.Imag, 0.0);
+  for (int k = 1; k <= half / 2; ++k)
+  {
+    const vtkImageComplex zk = out[k];
+    const vtkImageComplex zHalfMinusK = out[half - k];
+    split(zk, zHalfMinusK, twiddles[k], out[k]);
+    split(zHalfMinusK, zk, twiddles[half - k], out[half - k]);
+  }
+  for (int k = 1; k < half; ++k)
+  {
+    vtkImageComplexConjugate(out[k], out[N - k]);
+  }
+}
+
 //------------------------------------------------------------------------------
 // Called each axis over which the filter is executed.
 int vtkImageFourierFilter::RequestData(
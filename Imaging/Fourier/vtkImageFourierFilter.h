@@ -17,6 +17,8 @@
 #include "vtkImagingFourierModule.h" // For export macro
 #include "vtkStringFormatter.h"      // For vtk::print
 
+#include <memory> // For std::unique_ptr
+
 /*******************************************************************
                         COMPLEX number stuff
 *******************************************************************/
@@ -119,13 +121,26 @@ public:
    */
   void ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
+  /**
+   * This function calculates the whole fft of an array of real values.
+   * When N is even, it uses a complex fft of half the size.
+   * The contents of the input array are not changed.
+   */
+  void ExecuteRealFft(const double* in, vtkImageComplex* out, int N);
+
 protected:
-  vtkImageFourierFilter() = default;
-  ~vtkImageFourierFilter() override = default;
+  vtkImageFourierFilter();
+  ~vtkImageFourierFilter() override;
 
+  ///@{
+  /**
+   * Generic radix stages, used when no kissfft plan can be created for a size.
+   */
   void ExecuteFftStep2(vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int fb);
   void ExecuteFftStepN(
     vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int n, int fb);
+  ///@}
+
   void ExecuteFftForwardBackward(vtkImageComplex* in, vtkImageComplex* out, int N, int fb);
 
   /**
@@ -137,6 +152,9 @@ protected:
 private:
   vtkImageFourierFilter(const vtkImageFourierFilter&) = delete;
   void operator=(const vtkImageFourierFilter&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 VTK_ABI_NAMESPACE_END
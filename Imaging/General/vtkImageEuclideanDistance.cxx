@@ -2,13 +2,20 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkImageEuclideanDistance.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageEuclideanDistance);
@@ -20,7 +27,9 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->MaximumDistance = VTK_INT_MAX;
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
-  this->Algorithm = VTK_EDT_SAITO;
+  this->Algorithm = VTK_EDT_FELZENSZWALB;
+  this->SignedDistance = 0;
+  this->ComputeClosestPoints = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -603,6 +612,194 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(vtkImageEuclideanDistanc
   free(temp);
   free(sq);
 }
+//------------------------------------------------------------------------------
+// Execute Felzenszwalb and Huttenlocher's algorithm.
+//
+// P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+// Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+namespace
+{
+const char* ClosestPointIdsName = "ClosestPointIds";
+
+// Buffers used to process one line.
+struct vtkImageEuclideanDistanceLine
+{
+  std::vector<double> Values;
+  std::vector<double> Sampled;
+  std::vector<double> Distances;
+  std::vector<vtkIdType> ClosestPoints;
+  std::vector<int> Closest;
+  std::vector<int> Envelope;
+  std::vector<double> Boundaries;
+
+  void Allocate(int size)
+  {
+    this->Values.resize(size);
+    this->Sampled.resize(size);
+    this->Distances.resize(size);
+    this->ClosestPoints.resize(size);
+    this->Closest.resize(size);
+    this->Envelope.resize(size);
+    this->Boundaries.resize(size + 1);
+  }
+
+  // Computes Distances[p] = min_q Sampled[q] + weight * (p - q)^2 and the q
+  // giving the minimum, using the lower envelope of the parabolas rooted at
+  // each q.
+  void ComputeLowerEnvelope(int size, double weight)
+  {
+    const double* f = this->Sampled.data();
+    int* v = this->Envelope.data();
+    double* z = this->Boundaries.data();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<double>::infinity();
+    z[1] = std::numeric_limits<double>::infinity();
+    for (int q = 1; q < size; ++q)
+    {
+      const double fq = f[q] + weight * q * q;
+      double s = (fq - (f[v[k]] + weight * v[k] * v[k])) / (2.0 * weight * (q - v[k]));
+      while (s <= z[k])
+      {
+        --k;
+        s = (fq - (f[v[k]] + weight * v[k] * v[k])) / (2.0 * weight * (q - v[k]));
+      }
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    k = 0;
+    for (int p = 0; p < size; ++p)
+    {
+      while (z[k + 1] < p)
+      {
+        ++k;
+      }
+      const double d = p - v[k];
+      this->Distances[p] = weight * d * d + f[v[k]];
+      this->Closest[p] = v[k];
+    }
+  }
+};
+}
+
+template <class T>
+void vtkImageEuclideanDistanceExecuteFelzenszwalb(vtkImageEuclideanDistance* self,
+  vtkImageData* inData, T* inPtr, vtkImageData* outData, VTK_FUTURE_CONST int outExt[6],
+  double* outPtr, const vtkIdType* inIds, vtkIdType* outIds)
+{
+  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
+  vtkIdType inInc0, inInc1, inInc2;
+  vtkIdType outInc0, outInc1, outInc2;
+
+  // Reorder axes
+  self->PermuteExtent(outExt, outMin0, outMax0, outMin1, outMax1, outMin2, outMax2);
+
+  vtkIdType inIncrements[3];
+  vtkIdType outIncrements[3];
+  inData->GetIncrements(inIncrements);
+  outData->GetIncrements(outIncrements);
+
+  self->PermuteIncrements(inIncrements, inInc0, inInc1, inInc2);
+  self->PermuteIncrements(outIncrements, outInc0, outInc1, outInc2);
+
+  const int size0 = outMax0 - outMin0 + 1;
+  const vtkIdType size1 = outMax1 - outMin1 + 1;
+  const vtkIdType numberOfLines = size1 * (outMax2 - outMin2 + 1);
+
+  const bool initialize = self->GetIteration() == 0 && self->GetInitialize();
+  const bool isSigned = self->GetSignedDistance() != 0;
+  const double maxDist = self->GetMaximumDistance();
+  double weight = 1.0;
+  if (self->GetConsiderAnisotropy())
+  {
+    weight = outData->GetSpacing()[self->GetIteration()];
+    weight *= weight;
+  }
+
+  vtkSMPTools::For(0, numberOfLines,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkImageEuclideanDistanceLine line;
+      line.Allocate(size0);
+      double* f = line.Values.data();
+      double* g = line.Sampled.data();
+
+      for (vtkIdType lineId = begin; lineId < end; ++lineId)
+      {
+        const vtkIdType idx1 = lineId % size1;
+        const vtkIdType idx2 = lineId / size1;
+        const T* inPtr0 = inPtr + idx1 * inInc1 + idx2 * inInc2;
+        double* outPtr0 = outPtr + idx1 * outInc1 + idx2 * outInc2;
+        // The output has one component and covers the whole extent, so the
+        // offset of a value is the id of its point.
+        const vtkIdType firstId = outPtr0 - outPtr;
+
+        for (int idx0 = 0; idx0 < size0; ++idx0)
+        {
+          const double value = static_cast<double>(inPtr0[idx0 * inInc0]);
+          if (initialize)
+          {
+            f[idx0] = value != 0 ? maxDist : (isSigned ? -maxDist : 0.0);
+          }
+          else
+          {
+            f[idx0] = value;
+          }
+          line.ClosestPoints[idx0] = inIds ? inIds[firstId + idx0 * outInc0] : -1;
+        }
+
+        // Distances of the positive voxels to the others. The voxels on the
+        // other side are their own closest point.
+        for (int idx0 = 0; idx0 < size0; ++idx0)
+        {
+          g[idx0] = std::max(f[idx0], 0.0);
+        }
+        line.ComputeLowerEnvelope(size0, weight);
+        for (int idx0 = 0; idx0 < size0; ++idx0)
+        {
+          if (f[idx0] > 0 || !isSigned)
+          {
+            outPtr0[idx0 * outInc0] = line.Distances[idx0];
+            if (outIds)
+            {
+              const int q = line.Closest[idx0];
+              outIds[firstId + idx0 * outInc0] =
+                f[q] <= 0 ? firstId + q * outInc0 : line.ClosestPoints[q];
+            }
+          }
+        }
+        if (!isSigned)
+        {
+          continue;
+        }
+
+        // Distances of the negative voxels to the positive ones.
+        for (int idx0 = 0; idx0 < size0; ++idx0)
+        {
+          g[idx0] = std::max(-f[idx0], 0.0);
+        }
+        line.ComputeLowerEnvelope(size0, weight);
+        for (int idx0 = 0; idx0 < size0; ++idx0)
+        {
+          if (f[idx0] <= 0)
+          {
+            outPtr0[idx0 * outInc0] = -line.Distances[idx0];
+            if (outIds)
+            {
+              const int q = line.Closest[idx0];
+              outIds[firstId + idx0 * outInc0] =
+                f[q] > 0 ? firstId + q * outInc0 : line.ClosestPoints[q];
+            }
+          }
+        }
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(
   vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], vtkInformation* outInfo)
@@ -666,6 +863,40 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
     return 1;
   }
 
+  outData->GetPointData()->RemoveArray(ClosestPointIdsName);
+  if (this->GetAlgorithm() == VTK_EDT_FELZENSZWALB)
+  {
+    // The closest points are carried from one iteration to the next.
+    vtkIdTypeArray* inIds = nullptr;
+    vtkIdTypeArray* outIds = nullptr;
+    if (this->ComputeClosestPoints)
+    {
+      if (this->GetIteration() > 0)
+      {
+        inIds = vtkArrayDownCast<vtkIdTypeArray>(
+          inData->GetPointData()->GetAbstractArray(ClosestPointIdsName));
+      }
+      vtkNew<vtkIdTypeArray> ids;
+      ids->SetName(ClosestPointIdsName);
+      ids->SetNumberOfValues(outData->GetNumberOfPoints());
+      outData->GetPointData()->AddArray(ids);
+      outIds = ids;
+    }
+
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageEuclideanDistanceExecuteFelzenszwalb(this, inData,
+        static_cast<VTK_TT*>(inPtr), outData, outExt, static_cast<double*>(outPtr),
+        inIds ? inIds->GetPointer(0) : nullptr, outIds ? outIds->GetPointer(0) : nullptr));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return 1;
+    }
+
+    this->UpdateProgress((this->GetIteration() + 1.0) / 3.0);
+    return 1;
+  }
+
   if (this->GetIteration() == 0)
   {
     switch (inData->GetScalarType())
@@ -719,7 +950,11 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Maximum Distance: " << this->MaximumDistance << "\n";
 
   os << indent << "Algorithm: ";
-  if (this->Algorithm == VTK_EDT_SAITO)
+  if (this->Algorithm == VTK_EDT_FELZENSZWALB)
+  {
+    os << "Felzenszwalb\n";
+  }
+  else if (this->Algorithm == VTK_EDT_SAITO)
   {
     os << "Saito\n";
   }
@@ -727,5 +962,7 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << "Saito Cached\n";
   }
+  os << indent << "Signed Distance: " << (this->SignedDistance ? "On\n" : "Off\n");
+  os << indent << "Compute Closest Points: " << (this->ComputeClosestPoints ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
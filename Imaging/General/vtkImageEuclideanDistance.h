@@ -5,13 +5,17 @@
  * @brief   computes 3D Euclidean DT
  *
  * vtkImageEuclideanDistance implements the Euclidean DT using
- * Saito's algorithm. The distance map produced contains the square of the
- * Euclidean distance values.
+ * Felzenszwalb and Huttenlocher's algorithm or Saito's algorithm. The
+ * distance map produced contains the square of the Euclidean distance values.
  *
- * The algorithm has a o(n^(D+1)) complexity over nxnx...xn images in D
- * dimensions. It is very efficient on relatively small images. Cuisenaire's
- * algorithms should be used instead if n >> 500. These are not implemented
- * yet.
+ * Felzenszwalb and Huttenlocher's algorithm, the default, computes the exact
+ * distances in linear time: each axis is processed by computing the lower
+ * envelope of the parabolas rooted at the voxels of each line, and the lines
+ * are processed in parallel. It can also compute signed distances and the
+ * closest voxel of each voxel.
+ *
+ * Saito's algorithm has a o(n^(D+1)) complexity over nxnx...xn images in D
+ * dimensions. It is very efficient on relatively small images.
  *
  * For the special case of images where the slice-size is a multiple of
  * 2^N with a large N (typically for 256x256 slices), Saito's algorithm
@@ -21,6 +25,9 @@
  *
  * References:
  *
+ * P. F. Felzenszwalb and D. P. Huttenlocher. Distance Transforms of Sampled
+ * Functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+ *
  * T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
  * transformations of an n-dimensional digitised picture with applications.
  * Pattern Recognition, 27(11). pp. 1551--1565, 1994.
@@ -38,6 +45,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 VTK_ABI_NAMESPACE_BEGIN
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
@@ -81,16 +89,41 @@ public:
   ///@{
   /**
    * Selects a Euclidean DT algorithm.
-   * 1. Saito
-   * 2. Saito-cached
-   * More algorithms will be added later on.
+   * 1. Felzenszwalb (default)
+   * 2. Saito
+   * 3. Saito-cached
    */
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
+  void SetAlgorithmToFelzenszwalb() { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
   void SetAlgorithmToSaito() { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached() { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
   ///@}
 
+  ///@{
+  /**
+   * When on, the zero voxels get minus the squared distance to the closest
+   * non-zero voxel, instead of 0. When Initialize is off, the voxels with
+   * a value lower than or equal to 0 are the ones on the negative side.
+   * Only used by the Felzenszwalb algorithm. Default is off.
+   */
+  vtkSetMacro(SignedDistance, vtkTypeBool);
+  vtkGetMacro(SignedDistance, vtkTypeBool);
+  vtkBooleanMacro(SignedDistance, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * When on, the output gets a "ClosestPointIds" point data array holding
+   * the id of the closest voxel on the other side of the boundary, the one
+   * the distance is measured to. The voxels which are not reached by any
+   * boundary get -1. Only used by the Felzenszwalb algorithm. Default is off.
+   */
+  vtkSetMacro(ComputeClosestPoints, vtkTypeBool);
+  vtkGetMacro(ComputeClosestPoints, vtkTypeBool);
+  vtkBooleanMacro(ComputeClosestPoints, vtkTypeBool);
+  ///@}
+
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
 protected:
@@ -101,6 +134,8 @@ protected:
   vtkTypeBool Initialize;
   vtkTypeBool ConsiderAnisotropy;
   int Algorithm;
+  vtkTypeBool SignedDistance;
+  vtkTypeBool ComputeClosestPoints;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(
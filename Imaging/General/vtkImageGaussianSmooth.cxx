@@ -2,13 +2,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkImageGaussianSmooth.h"
 
+#include "vtkDataSetAttributes.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageGaussianSmooth);
@@ -23,6 +27,10 @@ vtkImageGaussianSmooth::vtkImageGaussianSmooth()
   this->RadiusFactors[0] = 1.5;
   this->RadiusFactors[1] = 1.5;
   this->RadiusFactors[2] = 1.5;
+  this->Algorithm = Convolution;
+  this->DerivativeOrders[0] = 0;
+  this->DerivativeOrders[1] = 0;
+  this->DerivativeOrders[2] = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -44,6 +52,12 @@ void vtkImageGaussianSmooth::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "StandardDeviations: ( " << this->StandardDeviations[0] << ", "
      << this->StandardDeviations[1] << ", " << this->StandardDeviations[2] << " )\n";
+
+  os << indent << "Algorithm: " << (this->Algorithm == Recursive ? "Recursive" : "Convolution")
+     << "\n";
+
+  os << indent << "DerivativeOrders: ( " << this->DerivativeOrders[0] << ", "
+     << this->DerivativeOrders[1] << ", " << this->DerivativeOrders[2] << " )\n";
 }
 
 //------------------------------------------------------------------------------
@@ -73,6 +87,38 @@ void vtkImageGaussianSmooth::ComputeKernel(double* kernel, int min, int max, dou
   }
 }
 
+//------------------------------------------------------------------------------
+// Derivatives of integer images are computed as double.
+int vtkImageGaussianSmooth::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != Recursive)
+  {
+    return 1;
+  }
+
+  bool derivative = false;
+  for (int idx = 0; idx < this->Dimensionality && idx < 3; ++idx)
+  {
+    derivative |= (this->DerivativeOrders[idx] > 0);
+  }
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkInformation* inScalarInfo = vtkDataObject::GetActiveFieldInformation(
+    inInfo, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
+  if (derivative && inScalarInfo)
+  {
+    int scalarType = inScalarInfo->Get(vtkDataObject::FIELD_ARRAY_TYPE());
+    if (scalarType != VTK_FLOAT && scalarType != VTK_DOUBLE)
+    {
+      vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_DOUBLE, -1);
+    }
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkImageGaussianSmooth::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -102,6 +148,14 @@ void vtkImageGaussianSmooth::InternalRequestUpdateExtent(
   // Expand filtered axes
   for (int idx = 0; idx < this->Dimensionality; ++idx)
   {
+    // The recursive filter needs whole rows
+    if (this->Algorithm == Recursive)
+    {
+      inExt[idx * 2] = wholeExtent[idx * 2];
+      inExt[idx * 2 + 1] = wholeExtent[idx * 2 + 1];
+      continue;
+    }
+
     int radius = static_cast<int>(this->StandardDeviations[idx] * this->RadiusFactors[idx]);
     inExt[idx * 2] -= radius;
     inExt[idx * 2] = std::max(inExt[idx * 2], wholeExtent[idx * 2]);
@@ -426,4 +480,325 @@ void vtkImageGaussianSmooth::ThreadedRequestData(vtkInformation* vtkNotUsed(requ
       break;
   }
 }
+
+namespace
+{
+//------------------------------------------------------------------------------
+// The recursive gaussian of Young and van Vliet, applied forward and then
+// backward along a row.  The row is extended with its first and last values
+// beyond its ends, with the initial conditions of Triggs and Sdika.
+class vtkRecursiveGaussian
+{
+public:
+  explicit vtkRecursiveGaussian(double sigma)
+  {
+    // Coefficients from the standard deviation (Young and van Vliet 1995)
+    sigma = std::max(sigma, 0.5);
+    double q = (sigma >= 2.5 ? 0.98711 * sigma - 0.96330
+                             : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma));
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+    this->A[0] = (2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q) / b0;
+    this->A[1] = -(1.4281 * q * q + 1.26661 * q * q * q) / b0;
+    this->A[2] = (0.422205 * q * q * q) / b0;
+    this->B = 1.0 - (this->A[0] + this->A[1] + this->A[2]);
+
+    // The backward values beyond the end of the row are a linear function of
+    // the last three forward values minus the constant extension.  Compute
+    // this function from the response to each of them, which decays
+    // geometrically since the filter is stable.
+    for (int j = 0; j < 3; ++j)
+    {
+      double history[3] = { 0.0, 0.0, 0.0 };
+      history[j] = 1.0;
+      std::vector<double> forward;
+      while (forward.size() < 3 ||
+        std::max({ std::abs(history[0]), std::abs(history[1]), std::abs(history[2]) }) > 1e-17)
+      {
+        double value =
+          this->A[0] * history[0] + this->A[1] * history[1] + this->A[2] * history[2];
+        forward.push_back(value);
+        history[2] = history[1];
+        history[1] = history[0];
+        history[0] = value;
+      }
+      double backward[3] = { 0.0, 0.0, 0.0 };
+      for (size_t n = forward.size(); n-- > 0;)
+      {
+        double value = this->B * forward[n] + this->A[0] * backward[0] +
+          this->A[1] * backward[1] + this->A[2] * backward[2];
+        backward[2] = backward[1];
+        backward[1] = backward[0];
+        backward[0] = value;
+        if (n < 3)
+        {
+          this->M[n][j] = value;
+        }
+      }
+    }
+  }
+
+  // Filter a row in place.
+  void Filter(double* row, int n) const
+  {
+    const double a0 = this->A[0];
+    const double a1 = this->A[1];
+    const double a2 = this->A[2];
+    const double b = this->B;
+
+    if (n <= 0)
+    {
+      return;
+    }
+    const double first = row[0];
+    const double last = row[n - 1];
+
+    // Forward, with the first value extended before the row
+    double w1 = first;
+    double w2 = first;
+    double w3 = first;
+    for (int i = 0; i < n; ++i)
+    {
+      double w = b * row[i] + a0 * w1 + a1 * w2 + a2 * w3;
+      row[i] = w;
+      w3 = w2;
+      w2 = w1;
+      w1 = w;
+    }
+
+    // Backward, with the last value extended after the row.  For a constant
+    // input, the output of both passes is that same constant.
+    double u[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      u[k] = (n - 1 - k >= 0 ? row[n - 1 - k] : first) - last;
+    }
+    double y1 = last + this->M[0][0] * u[0] + this->M[0][1] * u[1] + this->M[0][2] * u[2];
+    double y2 = last + this->M[1][0] * u[0] + this->M[1][1] * u[1] + this->M[1][2] * u[2];
+    double y3 = last + this->M[2][0] * u[0] + this->M[2][1] * u[1] + this->M[2][2] * u[2];
+    for (int i = n - 1; i >= 0; --i)
+    {
+      double y = b * row[i] + a0 * y1 + a1 * y2 + a2 * y3;
+      row[i] = y;
+      y3 = y2;
+      y2 = y1;
+      y1 = y;
+    }
+  }
+
+private:
+  double A[3];
+  double B;
+  double M[3][3];
+};
+
+//------------------------------------------------------------------------------
+// Replace a row with its first or second derivative, from central
+// differences, where the row is extended with its first and last values.
+void vtkRecursiveGaussianDerivative(double* row, int n, int order, double spacing)
+{
+  if (n < 2 || order <= 0)
+  {
+    if (order > 0)
+    {
+      std::fill(row, row + n, 0.0);
+    }
+    return;
+  }
+  double previous = row[0];
+  if (order == 1)
+  {
+    const double scale = 0.5 / spacing;
+    for (int i = 0; i < n; ++i)
+    {
+      double next = row[std::min(i + 1, n - 1)];
+      double current = row[i];
+      row[i] = (next - previous) * scale;
+      previous = current;
+    }
+  }
+  else
+  {
+    const double scale = 1.0 / (spacing * spacing);
+    for (int i = 0; i < n; ++i)
+    {
+      double next = row[std::min(i + 1, n - 1)];
+      double current = row[i];
+      row[i] = (next - 2.0 * current + previous) * scale;
+      previous = current;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkRecursiveGaussianCopyIn(vtkImageData* inData, T* inPtr, const int ext[6], double* buffer)
+{
+  vtkIdType inIncs[3];
+  inData->GetIncrements(inIncs);
+  const int numComps = inData->GetNumberOfScalarComponents();
+  for (int idx2 = ext[4]; idx2 <= ext[5]; ++idx2)
+  {
+    for (int idx1 = ext[2]; idx1 <= ext[3]; ++idx1)
+    {
+      const T* inPtr0 = inPtr + (idx1 - ext[2]) * inIncs[1] + (idx2 - ext[4]) * inIncs[2];
+      for (int idx0 = ext[0]; idx0 <= ext[1]; ++idx0)
+      {
+        for (int c = 0; c < numComps; ++c)
+        {
+          *buffer++ = static_cast<double>(inPtr0[c]);
+        }
+        inPtr0 += inIncs[0];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkRecursiveGaussianCopyOut(
+  const double* buffer, const int bufferExt[6], vtkImageData* outData, T* outPtr)
+{
+  const int* outExt = outData->GetExtent();
+  vtkIdType outIncs[3];
+  outData->GetIncrements(outIncs);
+  const int numComps = outData->GetNumberOfScalarComponents();
+  const vtkIdType bufferInc0 = numComps;
+  const vtkIdType bufferInc1 = bufferInc0 * (bufferExt[1] - bufferExt[0] + 1);
+  const vtkIdType bufferInc2 = bufferInc1 * (bufferExt[3] - bufferExt[2] + 1);
+  for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+  {
+    for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+    {
+      T* outPtr0 = outPtr + (idx1 - outExt[2]) * outIncs[1] + (idx2 - outExt[4]) * outIncs[2];
+      const double* bufferPtr = buffer + (outExt[0] - bufferExt[0]) * bufferInc0 +
+        (idx1 - bufferExt[2]) * bufferInc1 + (idx2 - bufferExt[4]) * bufferInc2;
+      for (int idx0 = outExt[0]; idx0 <= outExt[1]; ++idx0)
+      {
+        for (int c = 0; c < numComps; ++c)
+        {
+          outPtr0[c] = static_cast<T>(bufferPtr[c]);
+        }
+        bufferPtr += bufferInc0;
+        outPtr0 += outIncs[0];
+      }
+    }
+  }
+}
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+// The convolution is done by ThreadedRequestData(), while the recursive
+// filter processes whole rows and is threaded over the rows of each axis.
+int vtkImageGaussianSmooth::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != Recursive)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkImageData* outData = nullptr;
+  this->PrepareImageData(inputVector, outputVector, nullptr, &outData);
+  vtkImageData* inData = vtkImageData::GetData(inputVector[0]);
+  if (!inData || !outData)
+  {
+    return 1;
+  }
+  const int* outExt = outData->GetExtent();
+  if (outExt[0] > outExt[1] || outExt[2] > outExt[3] || outExt[4] > outExt[5])
+  {
+    return 1;
+  }
+
+  // The buffer holds whole rows along the filtered axes.
+  int wholeExt[6];
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
+  int bufferExt[6];
+  std::copy(outExt, outExt + 6, bufferExt);
+  this->InternalRequestUpdateExtent(bufferExt, wholeExt);
+  const int* inExt = inData->GetExtent();
+  for (int idx = 0; idx < 3; ++idx)
+  {
+    if (bufferExt[2 * idx] < inExt[2 * idx] || bufferExt[2 * idx + 1] > inExt[2 * idx + 1])
+    {
+      vtkErrorMacro("Execute: the input does not cover the requested extent");
+      return 0;
+    }
+  }
+
+  const int numComps = inData->GetNumberOfScalarComponents();
+  const vtkIdType dims[3] = { bufferExt[1] - bufferExt[0] + 1, bufferExt[3] - bufferExt[2] + 1,
+    bufferExt[5] - bufferExt[4] + 1 };
+  const vtkIdType incs[3] = { numComps, numComps * dims[0], numComps * dims[0] * dims[1] };
+  std::vector<double> buffer(static_cast<size_t>(incs[2] * dims[2]));
+
+  void* inPtr = inData->GetScalarPointerForExtent(bufferExt);
+  switch (inData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkRecursiveGaussianCopyIn(
+      inData, static_cast<VTK_TT*>(inPtr), bufferExt, buffer.data()));
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return 0;
+  }
+
+  // Filter the rows of each axis in parallel
+  double spacing[3];
+  inData->GetSpacing(spacing);
+  const int dimensionality = std::min(this->Dimensionality, 3);
+  for (int axis = 0; axis < dimensionality && !this->AbortExecute; ++axis)
+  {
+    const double sigma = this->StandardDeviations[axis];
+    const int order = std::max(std::min(this->DerivativeOrders[axis], 2), 0);
+    if (sigma <= 0.0 && order == 0)
+    {
+      continue;
+    }
+    const vtkRecursiveGaussian gaussian(sigma);
+    const int axis1 = (axis == 0 ? 1 : 0);
+    const int axis2 = (axis == 2 ? 1 : 2);
+    const int n = static_cast<int>(dims[axis]);
+    const vtkIdType numRows = dims[axis1] * dims[axis2] * numComps;
+    double* bufferPtr = buffer.data();
+    vtkSMPTools::For(0, numRows,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::vector<double> row(n);
+        for (vtkIdType rowId = begin; rowId < end; ++rowId)
+        {
+          const vtkIdType c = rowId % numComps;
+          const vtkIdType idx1 = (rowId / numComps) % dims[axis1];
+          const vtkIdType idx2 = (rowId / numComps) / dims[axis1];
+          double* rowPtr = bufferPtr + c + idx1 * incs[axis1] + idx2 * incs[axis2];
+          for (int i = 0; i < n; ++i)
+          {
+            row[i] = rowPtr[i * incs[axis]];
+          }
+          if (sigma > 0.0)
+          {
+            gaussian.Filter(row.data(), n);
+          }
+          vtkRecursiveGaussianDerivative(row.data(), n, order, spacing[axis]);
+          for (int i = 0; i < n; ++i)
+          {
+            rowPtr[i * incs[axis]] = row[i];
+          }
+        }
+      });
+    this->UpdateProgress(static_cast<double>(axis + 1) / (dimensionality + 1));
+  }
+
+  void* outPtr = outData->GetScalarPointer();
+  switch (outData->GetScalarType())
+  {
+    vtkTemplateMacro(vtkRecursiveGaussianCopyOut(
+      buffer.data(), bufferExt, outData, static_cast<VTK_TT*>(outPtr)));
+    default:
+      vtkErrorMacro("Unknown scalar type");
+      return 0;
+  }
+
+  return 1;
+}
 VTK_ABI_NAMESPACE_END
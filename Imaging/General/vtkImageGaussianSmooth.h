@@ -6,6 +6,21 @@
  *
  * vtkImageGaussianSmooth implements a convolution of the input image
  * with a gaussian. Supports from one to three dimensional convolutions.
+ *
+ * By default, the gaussian is a kernel that is truncated at RadiusFactors
+ * times the standard deviation, so the cost per pixel grows with the
+ * standard deviation.  The recursive algorithm instead approximates the
+ * gaussian with the recursive filter of Young and van Vliet, whose cost per
+ * pixel does not depend on the standard deviation, and can also compute the
+ * first and second derivatives of the smoothed image.  It is the better
+ * choice for standard deviations of a few pixels or more.
+ *
+ * I.T. Young and L.J. van Vliet. Recursive implementation of the Gaussian
+ * filter. Signal Processing, 44(2). pp. 139--151, 1995.
+ *
+ * B. Triggs and M. Sdika. Boundary conditions for Young-van Vliet recursive
+ * filtering. IEEE Transactions on Signal Processing, 54(6). pp. 2365--2367,
+ * 2006.
  */
 
 #ifndef vtkImageGaussianSmooth_h
@@ -66,6 +81,40 @@ public:
   vtkGetMacro(Dimensionality, int);
   ///@}
 
+  enum AlgorithmEnum
+  {
+    Convolution = 0,
+    Recursive = 1
+  };
+
+  ///@{
+  /**
+   * Set/Get the algorithm used to smooth the image.  Convolution (the
+   * default) uses a kernel truncated at RadiusFactors times the standard
+   * deviation.  Recursive uses a recursive filter whose cost does not depend
+   * on the standard deviation, and needs whole rows of the input along the
+   * smoothed axes.  Its accuracy decreases for standard deviations below one
+   * pixel.
+   */
+  vtkSetClampMacro(Algorithm, int, Convolution, Recursive);
+  void SetAlgorithmToConvolution() { this->SetAlgorithm(Convolution); }
+  void SetAlgorithmToRecursive() { this->SetAlgorithm(Recursive); }
+  vtkGetMacro(Algorithm, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the order of the derivative computed along each axis, from 0 to
+   * 2, after the image has been smoothed.  The derivatives are computed with
+   * central differences of the smoothed image and take the spacing into
+   * account.  They are only computed by the recursive algorithm, which
+   * produces double output for them unless the input is float or double.
+   * The default is 0 for all axes.
+   */
+  vtkSetVector3Macro(DerivativeOrders, int);
+  vtkGetVector3Macro(DerivativeOrders, int);
+  ///@}
+
 protected:
   vtkImageGaussianSmooth();
   ~vtkImageGaussianSmooth() override;
@@ -73,9 +122,13 @@ protected:
   int Dimensionality;
   double StandardDeviations[3];
   double RadiusFactors[3];
+  int Algorithm;
+  int DerivativeOrders[3];
 
   void ComputeKernel(double* kernel, int min, int max, double std);
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   void InternalRequestUpdateExtent(int[6], VTK_FUTURE_CONST int[6]);
   void ExecuteAxis(int axis, vtkImageData* inData, VTK_FUTURE_CONST int inExt[6],
     vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], int* pcycle, int target, int* pcount,
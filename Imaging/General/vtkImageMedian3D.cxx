@@ -14,6 +14,9 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm> // for std::nth_element
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageMedian3D);
@@ -23,6 +26,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Algorithm = Automatic;
   this->SetKernelSize(1, 1, 1);
   this->HandleBoundaries = 1;
 }
@@ -36,6 +40,10 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Algorithm: "
+     << (this->Algorithm == Sort ? "Sort"
+                                 : (this->Algorithm == Histogram ? "Histogram" : "Automatic"))
+     << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -92,6 +100,184 @@ T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
   return m;
 }
 
+//------------------------------------------------------------------------------
+// A histogram of 8-bit or 16-bit integer values, with coarse bins that count
+// the values of 2^Shift fine bins, so that the value of a given rank is found
+// without scanning all the fine bins.
+template <class T>
+class vtkMedianHistogram
+{
+public:
+  static constexpr int Shift = (sizeof(T) == 1 ? 4 : 8);
+  static constexpr int NumberOfBins = 1 << (8 * sizeof(T));
+
+  vtkMedianHistogram()
+    : Fine(NumberOfBins, 0)
+    , Coarse(NumberOfBins >> Shift, 0)
+  {
+  }
+
+  void Add(T value)
+  {
+    int bin = vtkMedianHistogram::Bin(value);
+    ++this->Fine[bin];
+    ++this->Coarse[bin >> Shift];
+    ++this->Count;
+  }
+
+  void Remove(T value)
+  {
+    int bin = vtkMedianHistogram::Bin(value);
+    --this->Fine[bin];
+    --this->Coarse[bin >> Shift];
+    --this->Count;
+  }
+
+  // Return the value of rank k, starting from zero.
+  T Select(int k) const
+  {
+    int coarse = 0;
+    int below = 0;
+    while (below + this->Coarse[coarse] <= k)
+    {
+      below += this->Coarse[coarse++];
+    }
+    int bin = coarse << Shift;
+    while (below + this->Fine[bin] <= k)
+    {
+      below += this->Fine[bin++];
+    }
+    return static_cast<T>(bin + static_cast<int>(std::numeric_limits<T>::lowest()));
+  }
+
+  // Return the same median as vtkComputeMedianOfArray().
+  T Median() const
+  {
+    T m = this->Select(this->Count / 2);
+    if (this->Count % 2 == 0)
+    {
+      T low = this->Select(this->Count / 2 - 1);
+      m = low + (m - low) / 2;
+    }
+    return m;
+  }
+
+private:
+  static int Bin(T value)
+  {
+    return static_cast<int>(value) - static_cast<int>(std::numeric_limits<T>::lowest());
+  }
+
+  std::vector<int> Fine;
+  std::vector<int> Coarse;
+  int Count = 0;
+};
+
+//------------------------------------------------------------------------------
+// Compute the median by sliding a histogram of the neighborhood along X.
+// Each step adds and removes the columns of the neighborhood that enter and
+// leave it, so the cost per pixel is proportional to the kernel cross section.
+template <class TInArray, class TOutArray, class T>
+void vtkImageMedian3DHistogramExecute(TInArray* inArray, TOutArray* outArray,
+  vtkImageMedian3D* self, vtkImageData* inData, vtkImageData* outData,
+  VTK_FUTURE_CONST int outExt[6], int id)
+{
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
+  const int* inExt = inData->GetExtent();
+  vtkIdType outInc0, outInc1, outInc2;
+  outData->GetIncrements(outInc0, outInc1, outInc2);
+  const int* kernelMiddle = self->GetKernelMiddle();
+  const int* kernelSize = self->GetKernelSize();
+  int numComp = inArray->GetNumberOfComponents();
+
+  unsigned long count = 0;
+  unsigned long target =
+    static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
+  target++;
+
+  auto inBegin = vtk::DataArrayValueRange(inArray).begin();
+  auto outBegin = vtk::DataArrayValueRange(outArray).begin() +
+    outData->GetValueIndexForExtent(outArray, outExt);
+
+  vtkMedianHistogram<T> histogram;
+  for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+  {
+    int hoodMin2 = std::max(outIdx2 - kernelMiddle[2], inExt[4]);
+    int hoodMax2 = std::min(outIdx2 - kernelMiddle[2] + kernelSize[2] - 1, inExt[5]);
+    for (int outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+    {
+      if (!id)
+      {
+        if (!(count % target))
+        {
+          self->UpdateProgress(count / (50.0 * target));
+        }
+        count++;
+      }
+      int hoodMin1 = std::max(outIdx1 - kernelMiddle[1], inExt[2]);
+      int hoodMax1 = std::min(outIdx1 - kernelMiddle[1] + kernelSize[1] - 1, inExt[3]);
+
+      for (int outIdxC = 0; outIdxC < numComp; ++outIdxC)
+      {
+        // Add (or remove) the column of the neighborhood at the given X index
+        auto inPtr = inBegin + outIdxC + (hoodMin1 - inExt[2]) * inInc[1] +
+          (hoodMin2 - inExt[4]) * inInc[2];
+        auto addColumn = [&](int idx0, bool add)
+        {
+          auto tmpPtr2 = inPtr + (idx0 - inExt[0]) * inInc[0];
+          for (int hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
+          {
+            auto tmpPtr1 = tmpPtr2;
+            for (int hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+            {
+              if (add)
+              {
+                histogram.Add(*tmpPtr1);
+              }
+              else
+              {
+                histogram.Remove(*tmpPtr1);
+              }
+              tmpPtr1 += inInc[1];
+            }
+            tmpPtr2 += inInc[2];
+          }
+        };
+
+        auto outPtr = outBegin + outIdxC + (outIdx1 - outExt[2]) * outInc1 +
+          (outIdx2 - outExt[4]) * outInc2;
+        int hoodMin0 = std::max(outExt[0] - kernelMiddle[0], inExt[0]);
+        int hoodMax0 = hoodMin0 - 1;
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+        {
+          // Slide the neighborhood, considering boundaries
+          int newMin0 = std::max(outIdx0 - kernelMiddle[0], inExt[0]);
+          int newMax0 = std::min(outIdx0 - kernelMiddle[0] + kernelSize[0] - 1, inExt[1]);
+          for (; hoodMax0 < newMax0; ++hoodMax0)
+          {
+            addColumn(hoodMax0 + 1, true);
+          }
+          for (; hoodMin0 < newMin0; ++hoodMin0)
+          {
+            addColumn(hoodMin0, false);
+          }
+
+          // Replace this pixel with the hood median
+          *outPtr = histogram.Median();
+          outPtr += outInc0;
+        }
+
+        // Empty the histogram for the next row
+        for (; hoodMin0 <= hoodMax0; ++hoodMin0)
+        {
+          addColumn(hoodMin0, false);
+        }
+      }
+    }
+  }
+}
+
 } // end anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -125,6 +311,21 @@ struct vtkImageMedian3DWorker
       return;
     }
 
+    // The histogram is only used for 8-bit and 16-bit integer data, and
+    // automatically when the kernel is large enough for it to be faster.
+    if constexpr (std::is_integral<T>::value && sizeof(T) <= 2)
+    {
+      int algorithm = self->GetAlgorithm();
+      if (algorithm == vtkImageMedian3D::Histogram ||
+        (algorithm == vtkImageMedian3D::Automatic &&
+          self->GetNumberOfElements() >= (sizeof(T) == 1 ? 27 : 125)))
+      {
+        vtkImageMedian3DHistogramExecute<TInArray, TOutArray, T>(
+          inArray, outArray, self, inData, outData, outExt, id);
+        return;
+      }
+    }
+
     // Array used to compute the median
     T* workArray = new T[self->GetNumberOfElements()];
 
@@ -171,9 +372,9 @@ struct vtkImageMedian3DWorker
     target++;
 
     // loop through pixel of output
-    auto inPtr = vtk::DataArrayValueRange<1>(inArray).begin() + (hoodMin0 - inExt[0]) * inInc0 +
+    auto inPtr = vtk::DataArrayValueRange(inArray).begin() + (hoodMin0 - inExt[0]) * inInc0 +
       (hoodMin1 - inExt[2]) * inInc1 + (hoodMin2 - inExt[4]) * inInc2;
-    auto outPtr = vtk::DataArrayValueRange<1>(outArray).begin() +
+    auto outPtr = vtk::DataArrayValueRange(outArray).begin() +
       outData->GetValueIndexForExtent(outArray, outExt);
     auto inPtr2 = inPtr;
     for (outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
@@ -9,6 +9,12 @@
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
  * into a 2D median.
+ *
+ * For 8-bit and 16-bit integer data, the median can be computed from a
+ * histogram of the neighborhood that slides along the X axis, so that the
+ * cost per pixel grows with the cross section of the kernel instead of its
+ * volume.  This is the approach of Huang et al., extended to 3D with the
+ * coarse and fine bins of Perreault and Hebert.
  */
 
 #ifndef vtkImageMedian3D_h
@@ -38,11 +44,35 @@ public:
   vtkGetMacro(NumberOfElements, int);
   ///@}
 
+  enum AlgorithmEnum
+  {
+    Automatic = 0,
+    Sort = 1,
+    Histogram = 2
+  };
+
+  ///@{
+  /**
+   * Set the algorithm used to compute the median.  Sort does a partial sort
+   * of each neighborhood, and works for all data types.  Histogram slides a
+   * histogram of the neighborhood along X, and is only used for 8-bit and
+   * 16-bit integer data, the other types are sorted.  Automatic, the
+   * default, uses the histogram for these types when the kernel is large
+   * enough for it to be faster.
+   */
+  vtkSetClampMacro(Algorithm, int, Automatic, Histogram);
+  void SetAlgorithmToAutomatic() { this->SetAlgorithm(Automatic); }
+  void SetAlgorithmToSort() { this->SetAlgorithm(Sort); }
+  void SetAlgorithmToHistogram() { this->SetAlgorithm(Histogram); }
+  vtkGetMacro(Algorithm, int);
+  ///@}
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D() override;
 
   int NumberOfElements;
+  int Algorithm;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -0,0 +1,317 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkImageNeighborhoodExtremum
+ * @brief   minimum or maximum over a kernel in constant time per voxel
+ *
+ * vtkImageNeighborhoodExtremum computes the minimum or the maximum of an
+ * image over an ellipsoidal or box neighborhood, for the morphological and
+ * rank filters.  One dimensional extrema are computed with the algorithm of
+ * van Herk and Gil-Werman, whose cost does not depend on the window size.
+ * A box kernel is processed as three one dimensional passes.  An ellipsoidal
+ * kernel is decomposed into spans along X, one per kernel row, so that its
+ * cost grows with the kernel cross section instead of the kernel volume.
+ *
+ * M. van Herk. A fast algorithm for local minimum and maximum filters on
+ * rectangular and octagonal kernels. Pattern Recognition Letters, 13(7).
+ * pp. 517--521, 1992.
+ *
+ * J. Gil and M. Werman. Computing 2-D min, median, and max filters. IEEE
+ * Transactions on Pattern Analysis and Machine Intelligence, 15(5).
+ * pp. 504--507, 1993.
+ */
+
+#ifndef vtkImageNeighborhoodExtremum_h
+#define vtkImageNeighborhoodExtremum_h
+
+#include "vtkImageData.h"
+#include "vtkType.h"
+
+#include <algorithm>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+struct vtkImageNeighborhoodExtremum
+{
+  // A span of the kernel along X, in the kernel row at the given Y and Z
+  // offsets.  All offsets are relative to the kernel middle.
+  struct Span
+  {
+    int Offset1;
+    int Offset2;
+    int Min0;
+    int Max0;
+  };
+
+  // Decompose a mask (such as the output of vtkImageEllipsoidSource) into
+  // the spans of its non-zero voxels.
+  static void ComputeSpans(vtkImageData* mask, const int kernelMiddle[3], std::vector<Span>& spans);
+
+  // Check whether the spans cover the whole box of the kernel, in which case
+  // the separable box computation can be used instead.
+  static bool IsBox(const std::vector<Span>& spans, const int kernelSize[3]);
+
+  // Compute out[i] = extremum of in[i + lo, i + hi] for i in [0, n), where
+  // the window is clipped to [0, n).  The extremum is defined by better(a, b),
+  // which is true if a should be kept instead of b, and identity must never
+  // be better than any value.
+  template <class T, class TBetter>
+  static void Line(const T* in, int n, int lo, int hi, T* out, std::vector<T>& work,
+    TBetter better, const T& identity);
+
+  // Compute the extremum over the kernel for each voxel of outExt, for the
+  // component whose first value is at inBegin.  The input covers inExt, with
+  // the value increments inInc, and the neighborhood is clipped to inExt.
+  // With spans set to nullptr, the kernel is the whole box.  The result is
+  // ordered like outExt, with X varying fastest.
+  template <class TIter, class T, class TBetter>
+  static void Compute(TIter inBegin, const vtkIdType inInc[3], const int inExt[6],
+    const int outExt[6], const int kernelSize[3], const int kernelMiddle[3],
+    const std::vector<Span>* spans, TBetter better, const T& identity, std::vector<T>& result);
+};
+
+//------------------------------------------------------------------------------
+inline void vtkImageNeighborhoodExtremum::ComputeSpans(
+  vtkImageData* mask, const int kernelMiddle[3], std::vector<Span>& spans)
+{
+  spans.clear();
+  const int* ext = mask->GetExtent();
+  const unsigned char* maskPtr = static_cast<const unsigned char*>(mask->GetScalarPointer());
+  if (!maskPtr)
+  {
+    return;
+  }
+  const int numComps = mask->GetNumberOfScalarComponents();
+  for (int idx2 = ext[4]; idx2 <= ext[5]; ++idx2)
+  {
+    for (int idx1 = ext[2]; idx1 <= ext[3]; ++idx1)
+    {
+      int start = ext[1] + 1;
+      for (int idx0 = ext[0]; idx0 <= ext[1] + 1; ++idx0)
+      {
+        const bool inside = idx0 <= ext[1] && *maskPtr != 0;
+        if (inside && start > ext[1])
+        {
+          start = idx0;
+        }
+        else if (!inside && start <= ext[1])
+        {
+          spans.push_back(Span{ idx1 - ext[2] - kernelMiddle[1], idx2 - ext[4] - kernelMiddle[2],
+            start - ext[0] - kernelMiddle[0], idx0 - 1 - ext[0] - kernelMiddle[0] });
+          start = ext[1] + 1;
+        }
+        if (idx0 <= ext[1])
+        {
+          maskPtr += numComps;
+        }
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+inline bool vtkImageNeighborhoodExtremum::IsBox(
+  const std::vector<Span>& spans, const int kernelSize[3])
+{
+  if (spans.size() != static_cast<size_t>(kernelSize[1]) * kernelSize[2])
+  {
+    return false;
+  }
+  for (const Span& span : spans)
+  {
+    if (span.Max0 - span.Min0 + 1 != kernelSize[0])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+template <class T, class TBetter>
+void vtkImageNeighborhoodExtremum::Line(const T* in, int n, int lo, int hi, T* out,
+  std::vector<T>& work, TBetter better, const T& identity)
+{
+  // The window of out[i] is p[i, i + w - 1] of the sequence p[k] = in[k + lo]
+  // padded with the identity.  Prefix extrema are computed forward and suffix
+  // extrema backward within blocks of w values, so that each window is
+  // covered by the suffix of one block and the prefix of the next one.
+  const int w = hi - lo + 1;
+  const int m = ((n + w - 1 + w - 1) / w) * w;
+  work.resize(2 * static_cast<size_t>(m));
+  T* g = work.data();
+  T* h = g + m;
+  for (int k = 0, b = 0; k < m; ++k, ++b)
+  {
+    const int j = k + lo;
+    const T v = (j >= 0 && j < n) ? in[j] : identity;
+    if (b == w)
+    {
+      b = 0;
+    }
+    g[k] = (b == 0 || better(v, g[k - 1])) ? v : g[k - 1];
+    h[k] = v;
+  }
+  for (int k = m - 2; k >= 0; --k)
+  {
+    if ((k + 1) % w != 0 && better(h[k + 1], h[k]))
+    {
+      h[k] = h[k + 1];
+    }
+  }
+  for (int i = 0; i < n; ++i)
+  {
+    out[i] = better(g[i + w - 1], h[i]) ? g[i + w - 1] : h[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class TIter, class T, class TBetter>
+void vtkImageNeighborhoodExtremum::Compute(TIter inBegin, const vtkIdType inInc[3],
+  const int inExt[6], const int outExt[6], const int kernelSize[3], const int kernelMiddle[3],
+  const std::vector<Span>* spans, TBetter better, const T& identity, std::vector<T>& result)
+{
+  const int outSize0 = outExt[1] - outExt[0] + 1;
+  const int outSize1 = outExt[3] - outExt[2] + 1;
+  const int outSize2 = outExt[5] - outExt[4] + 1;
+  if (outSize0 <= 0 || outSize1 <= 0 || outSize2 <= 0)
+  {
+    result.clear();
+    return;
+  }
+  result.resize(static_cast<size_t>(outSize0) * outSize1 * outSize2);
+
+  std::vector<T> line;
+  std::vector<T> extremum;
+  std::vector<T> work;
+
+  if (spans)
+  {
+    // Start with the center voxel, then merge the extremum of each span.
+    const int inSize0 = inExt[1] - inExt[0] + 1;
+    line.resize(inSize0);
+    extremum.resize(inSize0);
+    T* resultPtr = result.data();
+    for (int idx2 = outExt[4]; idx2 <= outExt[5]; ++idx2)
+    {
+      for (int idx1 = outExt[2]; idx1 <= outExt[3]; ++idx1)
+      {
+        TIter rowIter =
+          inBegin + (idx1 - inExt[2]) * inInc[1] + (idx2 - inExt[4]) * inInc[2];
+        for (int idx0 = 0; idx0 < outSize0; ++idx0)
+        {
+          resultPtr[idx0] = rowIter[(idx0 + outExt[0] - inExt[0]) * inInc[0]];
+        }
+        for (const Span& span : *spans)
+        {
+          const int hoodIdx1 = idx1 + span.Offset1;
+          const int hoodIdx2 = idx2 + span.Offset2;
+          if (hoodIdx1 < inExt[2] || hoodIdx1 > inExt[3] || hoodIdx2 < inExt[4] ||
+            hoodIdx2 > inExt[5])
+          {
+            continue;
+          }
+          TIter hoodIter =
+            inBegin + (hoodIdx1 - inExt[2]) * inInc[1] + (hoodIdx2 - inExt[4]) * inInc[2];
+          for (int idx0 = 0; idx0 < inSize0; ++idx0)
+          {
+            line[idx0] = hoodIter[idx0 * inInc[0]];
+          }
+          vtkImageNeighborhoodExtremum::Line(
+            line.data(), inSize0, span.Min0, span.Max0, extremum.data(), work, better, identity);
+          const T* extremumPtr = extremum.data() + (outExt[0] - inExt[0]);
+          for (int idx0 = 0; idx0 < outSize0; ++idx0)
+          {
+            if (better(extremumPtr[idx0], resultPtr[idx0]))
+            {
+              resultPtr[idx0] = extremumPtr[idx0];
+            }
+          }
+        }
+        resultPtr += outSize0;
+      }
+    }
+    return;
+  }
+
+  // The rows and slices of the input that are within reach of the output.
+  int lo[3];
+  int hi[3];
+  int first[3];
+  int last[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    lo[axis] = -kernelMiddle[axis];
+    hi[axis] = kernelSize[axis] - 1 - kernelMiddle[axis];
+    first[axis] = std::max(inExt[2 * axis], outExt[2 * axis] + lo[axis]);
+    last[axis] = std::min(inExt[2 * axis + 1], outExt[2 * axis + 1] + hi[axis]);
+  }
+  const int size0 = last[0] - first[0] + 1;
+  const int size1 = last[1] - first[1] + 1;
+  const int size2 = last[2] - first[2] + 1;
+
+  // Pass along X, for all the rows within reach.
+  std::vector<T> pass0(static_cast<size_t>(outSize0) * size1 * size2);
+  line.resize(size0);
+  extremum.resize(size0);
+  for (int j2 = 0; j2 < size2; ++j2)
+  {
+    for (int j1 = 0; j1 < size1; ++j1)
+    {
+      TIter rowIter = inBegin + (first[0] - inExt[0]) * inInc[0] +
+        (first[1] + j1 - inExt[2]) * inInc[1] + (first[2] + j2 - inExt[4]) * inInc[2];
+      for (int j0 = 0; j0 < size0; ++j0)
+      {
+        line[j0] = rowIter[j0 * inInc[0]];
+      }
+      vtkImageNeighborhoodExtremum::Line(
+        line.data(), size0, lo[0], hi[0], extremum.data(), work, better, identity);
+      std::copy_n(extremum.data() + (outExt[0] - first[0]), outSize0,
+        pass0.data() + (static_cast<size_t>(j2) * size1 + j1) * outSize0);
+    }
+  }
+
+  // Pass along Y, for all the slices within reach.
+  std::vector<T> pass1(static_cast<size_t>(outSize0) * outSize1 * size2);
+  line.resize(size1);
+  extremum.resize(size1);
+  for (int j2 = 0; j2 < size2; ++j2)
+  {
+    for (int idx0 = 0; idx0 < outSize0; ++idx0)
+    {
+      const T* column = pass0.data() + static_cast<size_t>(j2) * size1 * outSize0 + idx0;
+      for (int j1 = 0; j1 < size1; ++j1)
+      {
+        line[j1] = column[static_cast<size_t>(j1) * outSize0];
+      }
+      vtkImageNeighborhoodExtremum::Line(
+        line.data(), size1, lo[1], hi[1], extremum.data(), work, better, identity);
+      T* outColumn = pass1.data() + static_cast<size_t>(j2) * outSize1 * outSize0 + idx0;
+      for (int idx1 = 0; idx1 < outSize1; ++idx1)
+      {
+        outColumn[static_cast<size_t>(idx1) * outSize0] = extremum[idx1 + outExt[2] - first[1]];
+      }
+    }
+  }
+
+  // Pass along Z, into the result.
+  const size_t sliceSize = static_cast<size_t>(outSize0) * outSize1;
+  line.resize(size2);
+  extremum.resize(size2);
+  for (size_t offset = 0; offset < sliceSize; ++offset)
+  {
+    for (int j2 = 0; j2 < size2; ++j2)
+    {
+      line[j2] = pass1[j2 * sliceSize + offset];
+    }
+    vtkImageNeighborhoodExtremum::Line(
+      line.data(), size2, lo[2], hi[2], extremum.data(), work, better, identity);
+    for (int idx2 = 0; idx2 < outSize2; ++idx2)
+    {
+      result[idx2 * sliceSize + offset] = extremum[idx2 + outExt[4] - first[2]];
+    }
+  }
+}
+
+VTK_ABI_NAMESPACE_END
+#endif
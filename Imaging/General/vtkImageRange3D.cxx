@@ -4,11 +4,16 @@
 
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageNeighborhoodExtremum.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <functional>
+#include <limits>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageRange3D);
 
@@ -18,9 +23,12 @@ vtkStandardNewMacro(vtkImageRange3D);
 vtkImageRange3D::vtkImageRange3D()
 {
   this->HandleBoundaries = 1;
-  this->KernelSize[0] = 1;
-  this->KernelSize[1] = 1;
-  this->KernelSize[2] = 1;
+  this->KernelShape = Ellipsoid;
+
+  // Initialize to 0 so that the SetKernelSize() below does its work.
+  this->KernelSize[0] = 0;
+  this->KernelSize[1] = 0;
+  this->KernelSize[2] = 0;
 
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
@@ -41,6 +49,8 @@ vtkImageRange3D::~vtkImageRange3D()
 void vtkImageRange3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "KernelShape: " << (this->KernelShape == Box ? "Box" : "Ellipsoid") << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -99,161 +109,57 @@ int vtkImageRange3D::RequestInformation(
 
 //------------------------------------------------------------------------------
 // This templated function executes the filter on any region,
-// whether it needs boundary checking or not.
-// If the filter needs to be faster, the function could be duplicated
-// for strictly center (no boundary ) processing.
+// whether it needs boundary checking or not.  The maximum and the minimum
+// over the kernel are computed for one component at a time, and the
+// neighborhood is clipped by the input extent.
 template <class T>
-void vtkImageRange3DExecute(vtkImageRange3D* self, vtkImageData* mask, vtkImageData* inData,
-  T* inPtr, vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], float* outPtr, int id,
-  vtkInformation* inInfo)
+void vtkImageRange3DExecute(vtkImageRange3D* self,
+  const std::vector<vtkImageNeighborhoodExtremum::Span>* spans, vtkImageData* inData, T* inPtr,
+  vtkImageData* outData, VTK_FUTURE_CONST int outExt[6], float* outPtr, int id)
 {
-  int *kernelMiddle, *kernelSize;
-  // For looping though output (and input) pixels.
-  int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
-  int outIdx0, outIdx1, outIdx2;
-  vtkIdType inInc0, inInc1, inInc2;
-  vtkIdType outInc0, outInc1, outInc2;
-  T *inPtr0, *inPtr1, *inPtr2;
-  float *outPtr0, *outPtr1, *outPtr2;
-  int numComps, outIdxC;
-  // For looping through hood pixels
-  int hoodMin0, hoodMax0, hoodMin1, hoodMax1, hoodMin2, hoodMax2;
-  int hoodIdx0, hoodIdx1, hoodIdx2;
-  T *hoodPtr0, *hoodPtr1, *hoodPtr2;
-  // For looping through the mask.
-  unsigned char *maskPtr, *maskPtr0, *maskPtr1, *maskPtr2;
-  vtkIdType maskInc0, maskInc1, maskInc2;
-  // The extent of the whole input image
-  int inImageMin0, inImageMin1, inImageMin2;
-  int inImageMax0, inImageMax1, inImageMax2;
-  int inImageExt[6];
-  // to compute the range
-  T pixelMin, pixelMax;
-  unsigned long count = 0;
-  unsigned long target;
-
   // Get information to march through data
-  inData->GetIncrements(inInc0, inInc1, inInc2);
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
-  inImageMin0 = inImageExt[0];
-  inImageMax0 = inImageExt[1];
-  inImageMin1 = inImageExt[2];
-  inImageMax1 = inImageExt[3];
-  inImageMin2 = inImageExt[4];
-  inImageMax2 = inImageExt[5];
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
+  const int* inExt = inData->GetExtent();
+  vtkIdType outInc0, outInc1, outInc2;
   outData->GetIncrements(outInc0, outInc1, outInc2);
-  outMin0 = outExt[0];
-  outMax0 = outExt[1];
-  outMin1 = outExt[2];
-  outMax1 = outExt[3];
-  outMin2 = outExt[4];
-  outMax2 = outExt[5];
-  numComps = outData->GetNumberOfScalarComponents();
+  int numComps = outData->GetNumberOfScalarComponents();
 
-  // Get ivars of this object (easier than making friends)
-  kernelSize = self->GetKernelSize();
-  kernelMiddle = self->GetKernelMiddle();
-  hoodMin0 = -kernelMiddle[0];
-  hoodMin1 = -kernelMiddle[1];
-  hoodMin2 = -kernelMiddle[2];
-  hoodMax0 = hoodMin0 + kernelSize[0] - 1;
-  hoodMax1 = hoodMin1 + kernelSize[1] - 1;
-  hoodMax2 = hoodMin2 + kernelSize[2] - 1;
-
-  // Setup mask info
-  maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
-  mask->GetIncrements(maskInc0, maskInc1, maskInc2);
-
-  // in and out should be marching through corresponding pixels.
-  inPtr = static_cast<T*>(inData->GetScalarPointer(outMin0, outMin1, outMin2));
-
-  target =
-    static_cast<unsigned long>(numComps * (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) / 50.0);
-  target++;
-
-  // loop through components
-  for (outIdxC = 0; outIdxC < numComps; ++outIdxC)
+  std::vector<T> pixelMax;
+  std::vector<T> pixelMin;
+  for (int outIdxC = 0; !self->AbortExecute && outIdxC < numComps; ++outIdxC)
   {
-    // loop through pixels of output
-    outPtr2 = outPtr;
-    inPtr2 = inPtr;
-    for (outIdx2 = outMin2; outIdx2 <= outMax2; ++outIdx2)
+    vtkImageNeighborhoodExtremum::Compute(inPtr + outIdxC, inInc, inExt, outExt,
+      self->GetKernelSize(), self->GetKernelMiddle(), spans, std::greater<T>(),
+      std::numeric_limits<T>::lowest(), pixelMax);
+    vtkImageNeighborhoodExtremum::Compute(inPtr + outIdxC, inInc, inExt, outExt,
+      self->GetKernelSize(), self->GetKernelMiddle(), spans, std::less<T>(),
+      std::numeric_limits<T>::max(), pixelMin);
+
+    // Store the range in the output
+    const T* maxPtr = pixelMax.data();
+    const T* minPtr = pixelMin.data();
+    float* outPtr2 = outPtr + outIdxC;
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
     {
-      outPtr1 = outPtr2;
-      inPtr1 = inPtr2;
-      for (outIdx1 = outMin1; !self->AbortExecute && outIdx1 <= outMax1; ++outIdx1)
+      float* outPtr1 = outPtr2;
+      for (int outIdx1 = outExt[2]; outIdx1 <= outExt[3]; ++outIdx1)
       {
-        if (!id)
+        float* outPtr0 = outPtr1;
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
         {
-          if (!(count % target))
-          {
-            self->UpdateProgress(count / (50.0 * target));
-          }
-          count++;
-        }
-
-        outPtr0 = outPtr1;
-        inPtr0 = inPtr1;
-        for (outIdx0 = outMin0; outIdx0 <= outMax0; ++outIdx0)
-        {
-          // Find min and max
-          pixelMin = pixelMax = *inPtr0;
-          // loop through neighborhood pixels
-          // as sort of a hack to handle boundaries,
-          // input pointer will be marching through data that does not exist.
-          hoodPtr2 =
-            inPtr0 - kernelMiddle[0] * inInc0 - kernelMiddle[1] * inInc1 - kernelMiddle[2] * inInc2;
-          maskPtr2 = maskPtr;
-          for (hoodIdx2 = hoodMin2; hoodIdx2 <= hoodMax2; ++hoodIdx2)
-          {
-            hoodPtr1 = hoodPtr2;
-            maskPtr1 = maskPtr2;
-            for (hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
-            {
-              hoodPtr0 = hoodPtr1;
-              maskPtr0 = maskPtr1;
-              for (hoodIdx0 = hoodMin0; hoodIdx0 <= hoodMax0; ++hoodIdx0)
-              {
-                // A quick but rather expensive way to handle boundaries
-                if (outIdx0 + hoodIdx0 >= inImageMin0 && outIdx0 + hoodIdx0 <= inImageMax0 &&
-                  outIdx1 + hoodIdx1 >= inImageMin1 && outIdx1 + hoodIdx1 <= inImageMax1 &&
-                  outIdx2 + hoodIdx2 >= inImageMin2 && outIdx2 + hoodIdx2 <= inImageMax2)
-                {
-                  if (*maskPtr0)
-                  {
-                    if (*hoodPtr0 < pixelMin)
-                    {
-                      pixelMin = *hoodPtr0;
-                    }
-                    if (*hoodPtr0 > pixelMax)
-                    {
-                      pixelMax = *hoodPtr0;
-                    }
-                  }
-                }
-
-                hoodPtr0 += inInc0;
-                maskPtr0 += maskInc0;
-              }
-              hoodPtr1 += inInc1;
-              maskPtr1 += maskInc1;
-            }
-            hoodPtr2 += inInc2;
-            maskPtr2 += maskInc2;
-          }
-          *outPtr0 = static_cast<float>(pixelMax - pixelMin);
-
-          inPtr0 += inInc0;
+          *outPtr0 = static_cast<float>(*maxPtr++ - *minPtr++);
           outPtr0 += outInc0;
         }
-        inPtr1 += inInc1;
         outPtr1 += outInc1;
       }
-      inPtr2 += inInc2;
       outPtr2 += outInc2;
     }
-    ++inPtr;
-    ++outPtr;
+
+    if (!id)
+    {
+      self->UpdateProgress(static_cast<double>(outIdxC + 1) / numComps);
+    }
   }
 }
 
@@ -262,14 +168,10 @@ void vtkImageRange3DExecute(vtkImageRange3D* self, vtkImageData* mask, vtkImageD
 // templated function for the input and output Data types.
 // It handles image boundaries, so the image does not shrink.
 void vtkImageRange3D::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector),
   vtkImageData*** inData, vtkImageData** outData, VTK_FUTURE_CONST int outExt[6], int id)
 {
-  int inExt[6], wholeExt[6];
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
-  this->InternalRequestUpdateExtent(inExt, outExt, wholeExt);
-  void* inPtr = inData[0][0]->GetScalarPointerForExtent(inExt);
+  void* inPtr = inData[0][0]->GetScalarPointer();
   void* outPtr = outData[0]->GetScalarPointerForExtent(outExt);
   vtkImageData* mask;
 
@@ -289,10 +191,22 @@ void vtkImageRange3D::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
     return;
   }
 
+  // An ellipsoid is decomposed into spans along X, unless it fills the box.
+  std::vector<vtkImageNeighborhoodExtremum::Span> spans;
+  const std::vector<vtkImageNeighborhoodExtremum::Span>* spansPtr = nullptr;
+  if (this->KernelShape == Ellipsoid)
+  {
+    vtkImageNeighborhoodExtremum::ComputeSpans(mask, this->KernelMiddle, spans);
+    if (!vtkImageNeighborhoodExtremum::IsBox(spans, this->KernelSize))
+    {
+      spansPtr = &spans;
+    }
+  }
+
   switch (inData[0][0]->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageRange3DExecute(this, mask, inData[0][0], static_cast<VTK_TT*>(inPtr),
-      outData[0], outExt, static_cast<float*>(outPtr), id, inInfo));
+    vtkTemplateMacro(vtkImageRange3DExecute(this, spansPtr, inData[0][0],
+      static_cast<VTK_TT*>(inPtr), outData[0], outExt, static_cast<float*>(outPtr), id));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
       return;
@@ -5,8 +5,11 @@
  * @brief   Max - min of a circular neighborhood.
  *
  * vtkImageRange3D replaces a pixel with the maximum minus minimum over
- * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
- * is done on that axis.
+ * an ellipsoidal or box neighborhood.  If KernelSize of an axis is 1, no
+ * processing is done on that axis.  The maximum and minimum are computed with
+ * the algorithm of van Herk and Gil-Werman, so the cost per voxel does not
+ * depend on the kernel size for a box kernel, and only grows with the kernel
+ * cross section for an ellipsoidal kernel.
  */
 
 #ifndef vtkImageRange3D_h
@@ -31,11 +34,29 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the neighborhood, either the ellipsoid that fits in
+   * the kernel (the default) or the whole box of the kernel.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Box);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
 protected:
   vtkImageRange3D();
   ~vtkImageRange3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int KernelShape;
 
   int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
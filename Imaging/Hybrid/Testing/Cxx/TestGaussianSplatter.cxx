@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the volume computed by vtkGaussianSplatter, which splats the slices
+// in parallel, against a brute force splatting of the points one after the
+// other, for each accumulation mode, with and without normal warping.
+
+#include "vtkDoubleArray.h"
+#include "vtkGaussianSplatter.h"
+#include "vtkImageData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+std::vector<double> BruteForce(vtkPolyData* input, vtkGaussianSplatter* splatter)
+{
+  const int* dims = splatter->GetSampleDimensions();
+  const double* bounds = splatter->GetModelBounds();
+  const double spacing = (bounds[1] - bounds[0]) / (dims[0] - 1);
+  const double radius = splatter->GetRadius() * (bounds[1] - bounds[0]);
+  const double eccentricity2 = splatter->GetEccentricity() * splatter->GetEccentricity();
+  vtkDataArray* normals = input->GetPointData()->GetNormals();
+  vtkDataArray* scalars = input->GetPointData()->GetScalars();
+
+  std::vector<double> values(static_cast<size_t>(dims[0]) * dims[1] * dims[2]);
+  std::vector<bool> visited(values.size(), false);
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3], n[3] = { 0.0, 0.0, 0.0 };
+    input->GetPoint(ptId, p);
+    if (normals)
+    {
+      normals->GetTuple(ptId, n);
+    }
+    const double factor = splatter->GetScaleFactor() * scalars->GetComponent(ptId, 0);
+    int min[3], max[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double loc = (p[i] - bounds[2 * i]) / spacing;
+      min[i] = std::max(static_cast<int>(std::floor(loc - radius / spacing)), 0);
+      max[i] = std::min(static_cast<int>(std::ceil(loc + radius / spacing)), dims[i] - 1);
+    }
+    for (int k = min[2]; k <= max[2]; ++k)
+    {
+      for (int j = min[1]; j <= max[1]; ++j)
+      {
+        for (int i = min[0]; i <= max[0]; ++i)
+        {
+          const double v[3] = { bounds[0] + i * spacing - p[0], bounds[2] + j * spacing - p[1],
+            bounds[4] + k * spacing - p[2] };
+          double dist2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+          if (normals)
+          {
+            const double z = (v[0] * n[0] + v[1] * n[1] + v[2] * n[2]) /
+              std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            dist2 = (dist2 - z * z) / eccentricity2 + z * z;
+          }
+          if (dist2 > radius * radius)
+          {
+            continue;
+          }
+          const double value =
+            factor * std::exp(splatter->GetExponentFactor() * dist2 / (radius * radius));
+          const size_t idx = (static_cast<size_t>(k) * dims[1] + j) * dims[0] + i;
+          if (!visited[idx])
+          {
+            visited[idx] = true;
+            values[idx] = value;
+          }
+          else if (splatter->GetAccumulationMode() == VTK_ACCUMULATION_MODE_MIN)
+          {
+            values[idx] = std::min(values[idx], value);
+          }
+          else if (splatter->GetAccumulationMode() == VTK_ACCUMULATION_MODE_MAX)
+          {
+            values[idx] = std::max(values[idx], value);
+          }
+          else
+          {
+            values[idx] += value;
+          }
+        }
+      }
+    }
+  }
+  for (size_t idx = 0; idx < values.size(); ++idx)
+  {
+    if (!visited[idx])
+    {
+      values[idx] = splatter->GetNullValue();
+    }
+  }
+  return values;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestGaussianSplatter(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  vtkNew<vtkDoubleArray> normals;
+  normals->SetNumberOfComponents(3);
+  for (int i = 0; i < 300; ++i)
+  {
+    points->InsertNextPoint(random->GetNextRangeValue(-0.1, 1.1),
+      random->GetNextRangeValue(-0.1, 1.1), random->GetNextRangeValue(-0.1, 1.1));
+    scalars->InsertNextValue(random->GetNextRangeValue(0.5, 2.0));
+    normals->InsertNextTuple3(random->GetNextRangeValue(-1.0, 1.0),
+      random->GetNextRangeValue(-1.0, 1.0), random->GetNextRangeValue(-1.0, 1.0));
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+
+  for (bool warpNormals : { false, true })
+  {
+    input->GetPointData()->SetNormals(warpNormals ? normals.Get() : nullptr);
+    for (int mode :
+      { VTK_ACCUMULATION_MODE_MIN, VTK_ACCUMULATION_MODE_MAX, VTK_ACCUMULATION_MODE_SUM })
+    {
+      vtkNew<vtkGaussianSplatter> splatter;
+      splatter->SetInputData(input);
+      splatter->SetSampleDimensions(21, 21, 21);
+      splatter->SetModelBounds(0.0, 1.0, 0.0, 1.0, 0.0, 1.0);
+      splatter->SetRadius(0.12);
+      splatter->SetAccumulationMode(mode);
+      splatter->SetNullValue(-1.0);
+      splatter->CappingOff();
+      splatter->Update();
+
+      const std::vector<double> expected = ::BruteForce(input, splatter);
+      vtkDataArray* actual = splatter->GetOutput()->GetPointData()->GetScalars();
+      for (vtkIdType idx = 0; idx < actual->GetNumberOfTuples(); ++idx)
+      {
+        if (std::abs(actual->GetComponent(idx, 0) - expected[idx]) >
+          1e-12 * (1.0 + std::abs(expected[idx])))
+        {
+          std::cerr << "Splatting gives " << actual->GetComponent(idx, 0) << " instead of "
+                    << expected[idx] << " at " << idx << " with accumulation mode "
+                    << splatter->GetAccumulationModeAsString()
+                    << (warpNormals ? " and normal warping\n" : "\n");
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the signed distance computed by vtkSurfaceReconstructionFilter
+// from points on two spheres approximates the distance to the spheres, with
+// normals oriented consistently over each sphere.
+
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSurfaceReconstructionFilter.h"
+
+#include <cmath>
+#include <iostream>
+
+//------------------------------------------------------------------------------
+int TestSurfaceReconstructionFilter(int, char*[])
+{
+  // Points spread evenly on two disjoint unit spheres.
+  const double centers[2][3] = { { 0.0, 0.0, 0.0 }, { 3.0, 0.0, 0.0 } };
+  const int numPts = 2000;
+  vtkNew<vtkPoints> points;
+  for (const auto& center : centers)
+  {
+    for (int i = 0; i < numPts; ++i)
+    {
+      const double z = 1.0 - (2.0 * i + 1.0) / numPts;
+      const double r = std::sqrt(1.0 - z * z);
+      const double phi = 2.39996322972865332 * i;
+      points->InsertNextPoint(
+        center[0] + r * std::cos(phi), center[1] + r * std::sin(phi), center[2] + z);
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  vtkNew<vtkSurfaceReconstructionFilter> reconstruction;
+  reconstruction->SetInputData(input);
+  reconstruction->SetSampleSpacing(0.1);
+  reconstruction->Update();
+  vtkImageData* output = reconstruction->GetOutput();
+
+  // The sign of the distance is consistent over each sphere, and its
+  // magnitude is the distance to the sphere close to the surface.
+  int signs[2] = { 0, 0 };
+  for (vtkIdType id = 0; id < output->GetNumberOfPoints(); ++id)
+  {
+    double x[3];
+    output->GetPoint(id, x);
+    const int sphere = (x[0] < 1.5 ? 0 : 1);
+    const double dx = x[0] - centers[sphere][0];
+    const double distance = std::sqrt(dx * dx + x[1] * x[1] + x[2] * x[2]) - 1.0;
+    if (std::abs(distance) < 0.2 || distance > 0.9)
+    {
+      continue;
+    }
+    const double value = output->GetPointData()->GetScalars()->GetComponent(id, 0);
+    const int sign = ((value > 0) == (distance > 0) ? 1 : -1);
+    if (signs[sphere] == 0)
+    {
+      signs[sphere] = sign;
+    }
+    if (sign != signs[sphere])
+    {
+      std::cerr << "Inconsistent orientation at " << x[0] << " " << x[1] << " " << x[2] << "\n";
+      return EXIT_FAILURE;
+    }
+    if (std::abs(distance) < 0.3 && std::abs(std::abs(value) - std::abs(distance)) > 0.05)
+    {
+      std::cerr << "Distance " << value << " instead of " << distance << " at " << x[0] << " "
+                << x[1] << " " << x[2] << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (signs[0] == 0 || signs[1] == 0)
+  {
+    std::cerr << "No samples were checked\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -18,12 +18,62 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkGaussianSplatter);
 
 //------------------------------------------------------------------------------
-// Algorithm and integration into vtkSMPTools
+// The sampling functions, with the point and normal passed as arguments so
+// that they can be used by several threads at once.
+namespace
+{
+double GaussianSample(const double p[3], const double cx[3])
+{
+  return ((cx[0] - p[0]) * (cx[0] - p[0]) + (cx[1] - p[1]) * (cx[1] - p[1]) +
+    (cx[2] - p[2]) * (cx[2] - p[2]));
+}
+
+double EccentricGaussianSample(
+  const double p[3], const double n[3], double eccentricity2, const double cx[3])
+{
+  double v[3], r2, z2, rxy2, mag;
+
+  v[0] = cx[0] - p[0];
+  v[1] = cx[1] - p[1];
+  v[2] = cx[2] - p[2];
+
+  r2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+
+  if ((mag = n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) != 1.0)
+  {
+    if (mag == 0.0)
+    {
+      mag = 1.0;
+    }
+    else
+    {
+      mag = sqrt(mag);
+    }
+  }
+
+  z2 = (v[0] * n[0] + v[1] * n[1] + v[2] * n[2]) / mag;
+  z2 = z2 * z2;
+
+  rxy2 = r2 - z2;
+
+  return (rxy2 / eccentricity2 + z2);
+}
+}
+
+//------------------------------------------------------------------------------
+// Algorithm and integration into vtkSMPTools.  The points of each input
+// dataset are sorted by the first slice of their footprint, then the slices
+// are splatted in parallel, each by one thread that goes through the points
+// whose footprint contains the slice.  No two threads write to the same
+// voxel, so no locks or thread local volumes are needed, and the result
+// does not depend on the number of threads.
 class vtkGaussianSplatterAlgorithm
 {
 public:
@@ -32,49 +82,160 @@ public:
   vtkIdType Dims[3], SliceSize;
   double Origin[3], Spacing[3], Radius2;
 
-  class Splat
+  // the dataset being splatted
+  vtkDataSet* Input;
+  vtkDataArray* InNormals;
+  vtkDataArray* InScalars;
+
+  // the points whose footprint starts at slice k are
+  // SortedIds[SliceOffsets[k]] ... SortedIds[SliceOffsets[k+1]-1]
+  std::vector<vtkIdType> SliceOffsets;
+  std::vector<vtkIdType> SortedIds;
+  int MaxDepth;
+
+  // Compute the footprint of a point, return false if it is empty.
+  bool GetFootprint(const double x[3], int min[3], int max[3])
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      // Determine the voxel that the point is in
+      double loc = (x[i] - this->Origin[i]) / this->Spacing[i];
+      // Determine splat footprint
+      min[i] = static_cast<int>(floor(loc - this->Splatter->SplatDistance[i]));
+      max[i] = static_cast<int>(ceil(loc + this->Splatter->SplatDistance[i]));
+      min[i] = std::max(min[i], 0);
+      max[i] = std::min(max[i], this->Splatter->SampleDimensions[i] - 1);
+      if (min[i] > max[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Sort the points of the dataset by the first slice of their footprint,
+  // keeping the order of the ids within each slice.
+  void SortPoints()
   {
-  public:
-    vtkGaussianSplatterAlgorithm* Algo;
-    vtkIdType XMin, XMax, YMin, YMax, ZMin, ZMax;
-    Splat(vtkGaussianSplatterAlgorithm* algo) { this->Algo = algo; }
-    void SetBounds(int min[3], int max[3])
+    vtkIdType numPts = this->Input->GetNumberOfPoints();
+    std::vector<int> firstSlice(numPts);
+    this->SliceOffsets.assign(this->Dims[2] + 1, 0);
+    this->MaxDepth = 0;
+    double x[3];
+    int min[3], max[3];
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
     {
-      this->XMin = min[0];
-      this->XMax = max[0];
-      this->YMin = min[1];
-      this->YMax = max[1];
-      this->ZMin = min[2];
-      this->ZMax = max[2];
+      this->Input->GetPoint(ptId, x);
+      if (this->GetFootprint(x, min, max))
+      {
+        firstSlice[ptId] = min[2];
+        this->SliceOffsets[min[2] + 1]++;
+        this->MaxDepth = std::max(this->MaxDepth, max[2] - min[2] + 1);
+      }
+      else
+      {
+        firstSlice[ptId] = -1;
+      }
     }
-    void operator()(vtkIdType slice, vtkIdType end)
+    std::partial_sum(
+      this->SliceOffsets.begin(), this->SliceOffsets.end(), this->SliceOffsets.begin());
+    this->SortedIds.resize(this->SliceOffsets[this->Dims[2]]);
+    std::vector<vtkIdType> cursors(this->SliceOffsets.begin(), this->SliceOffsets.end() - 1);
+    for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+    {
+      if (firstSlice[ptId] >= 0)
+      {
+        this->SortedIds[cursors[firstSlice[ptId]]++] = ptId;
+      }
+    }
+  }
+
+  // Splat a range of slices.
+  void operator()(vtkIdType slice, vtkIdType end)
+  {
+    vtkGaussianSplatter* self = this->Splatter;
+    char* visited = self->Visited;
+    vtkIdType i, j, jOffset, kOffset, idx;
+    double cx[3], dist2, p[3], n[3] = { 0.0, 0.0, 0.0 }, s = 0.0;
+    int min[3], max[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (; slice < end; ++slice)
     {
-      vtkIdType i, j, jOffset, kOffset, idx;
-      double cx[3], dist2;
-      for (; slice < end; ++slice)
+      if (isFirst)
       {
-        // Loop over all sample points in volume within footprint and
+        self->CheckAbort();
+      }
+      if (self->GetAbortOutput())
+      {
+        break;
+      }
+      cx[2] = this->Origin[2] + this->Spacing[2] * slice;
+      kOffset = slice * this->SliceSize;
+
+      // the points whose footprint can contain this slice
+      vtkIdType first = this->SliceOffsets[std::max<vtkIdType>(slice - this->MaxDepth + 1, 0)];
+      vtkIdType last = this->SliceOffsets[slice + 1];
+      for (vtkIdType sortedId = first; sortedId < last; ++sortedId)
+      {
+        vtkIdType ptId = this->SortedIds[sortedId];
+        this->Input->GetPoint(ptId, p);
+        this->GetFootprint(p, min, max);
+        if (max[2] < slice)
+        {
+          continue;
+        }
+        if (this->InNormals)
+        {
+          this->InNormals->GetTuple(ptId, n);
+        }
+        if (this->InScalars)
+        {
+          s = this->InScalars->GetComponent(ptId, 0);
+        }
+        double factor = (self->*(self->SampleFactor))(s);
+
+        // Loop over all sample points in the slice within footprint and
         // evaluate the splat
-        cx[2] = this->Algo->Origin[2] + this->Algo->Spacing[2] * slice;
-        kOffset = slice * this->Algo->SliceSize;
-        for (j = this->YMin; j <= this->YMax; j++)
+        for (j = min[1]; j <= max[1]; j++)
         {
-          cx[1] = this->Algo->Origin[1] + this->Algo->Spacing[1] * j;
-          jOffset = j * this->Algo->Dims[0];
-          for (i = this->XMin; i <= this->XMax; i++)
+          cx[1] = this->Origin[1] + this->Spacing[1] * j;
+          jOffset = j * this->Dims[0];
+          for (i = min[0]; i <= max[0]; i++)
           {
-            cx[0] = this->Algo->Origin[0] + this->Algo->Spacing[0] * i;
-            dist2 = this->Algo->Splatter->SamplePoint(cx);
-            if (dist2 <= this->Algo->Radius2)
+            cx[0] = this->Origin[0] + this->Spacing[0] * i;
+            dist2 = (this->InNormals ? EccentricGaussianSample(p, n, self->Eccentricity2, cx)
+                                     : GaussianSample(p, cx));
+            if (dist2 <= this->Radius2)
             {
               idx = i + jOffset + kOffset;
-              this->Algo->Splatter->SetScalar(idx, dist2, this->Algo->Scalars + idx);
+              double v = factor * std::exp(self->ExponentFactor * dist2 / this->Radius2);
+              double* sPtr = this->Scalars + idx;
+              if (!visited[idx])
+              {
+                visited[idx] = 1;
+                *sPtr = v;
+              }
+              else
+              {
+                switch (self->AccumulationMode)
+                {
+                  case VTK_ACCUMULATION_MODE_MIN:
+                    *sPtr = std::min(*sPtr, v);
+                    break;
+                  case VTK_ACCUMULATION_MODE_MAX:
+                    *sPtr = std::max(*sPtr, v);
+                    break;
+                  case VTK_ACCUMULATION_MODE_SUM:
+                    *sPtr += v;
+                    break;
+                }
+              } // not first visit
             } // if within splat radius
           } // i
         } // j
-      } // k within splat footprint
-    }
-  };
+      } // points with footprint in this slice
+    } // slices
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -160,11 +321,9 @@ int vtkGaussianSplatter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetExtent(outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
   output->AllocateScalars(outInfo);
 
-  vtkIdType totalNumPts, numNewPts, ptId, i;
-  int min[3], max[3];
+  vtkIdType totalNumPts, numNewPts, i;
   vtkPointData* pd;
   vtkDataArray* inNormals = nullptr;
-  double loc[3];
   vtkDoubleArray* newScalars =
     vtkArrayDownCast<vtkDoubleArray>(output->GetPointData()->GetScalars());
   newScalars->SetName("SplatterValues");
@@ -267,7 +426,7 @@ int vtkGaussianSplatter::RequestData(vtkInformation* vtkNotUsed(request),
     algo.Origin[i] = this->Origin[i];
     algo.Spacing[i] = this->Spacing[i];
   }
-  vtkGaussianSplatterAlgorithm::Splat splat(&algo);
+  vtkIdType numSplattedPts = 0;
 
   // Process all input datasets
   for (dataItr->InitTraversal(); !dataItr->IsDoneWithTraversal(); dataItr->GoToNextItem())
@@ -304,53 +463,21 @@ int vtkGaussianSplatter::RequestData(vtkInformation* vtkNotUsed(request),
       vtkWarningMacro(<< "Piece does not have required normals array");
       continue;
     }
-    vtkIdType numPts = input->GetNumberOfPoints();
-
-    // Traverse all points - splatting each into the volume.
-    // For each point, determine which voxel it is in.  Then determine
-    // the subvolume that the splat is contained in, and process that.
-    //
-    int abortExecute = 0;
-    vtkIdType progressInterval = numPts / 20 + 1;
-    for (ptId = 0; ptId < numPts && !abortExecute; ptId++)
+    vtkDebugMacro(<< "Inserting " << input->GetNumberOfPoints() << " points");
+    this->UpdateProgress(static_cast<double>(numSplattedPts) / totalNumPts);
+    numSplattedPts += input->GetNumberOfPoints();
+
+    // Sort the points by the slices that their footprint covers, then
+    // splat the slices in parallel.
+    algo.Input = input;
+    algo.InNormals = myNormals;
+    algo.InScalars = myScalars;
+    algo.SortPoints();
+    vtkSMPTools::For(0, algo.Dims[2], algo);
+    if (this->GetAbortOutput())
     {
-      if (!(ptId % progressInterval))
-      {
-        vtkDebugMacro(<< "Inserting point #" << ptId);
-        this->UpdateProgress(static_cast<double>(ptId) / numPts);
-        abortExecute = this->GetAbortExecute();
-      }
-
-      this->P = input->GetPoint(ptId);
-      if (myNormals != nullptr)
-      {
-        this->N = myNormals->GetTuple(ptId);
-      }
-      if (myScalars != nullptr)
-      {
-        this->S = myScalars->GetComponent(ptId, 0);
-      }
-
-      // Determine the voxel that the point is in
-      for (i = 0; i < 3; i++)
-      {
-        loc[i] = (this->P[i] - this->Origin[i]) / this->Spacing[i];
-      }
-
-      // Determine splat footprint
-      for (i = 0; i < 3; i++)
-      {
-        min[i] = static_cast<int>(floor(loc[i] - this->SplatDistance[i]));
-        max[i] = static_cast<int>(ceil(loc[i] + this->SplatDistance[i]));
-        min[i] = std::max(min[i], 0);
-        max[i] = std::min(max[i], this->SampleDimensions[i] - 1);
-      }
-
-      // Parallel splat the point
-      splat.SetBounds(min, max);
-      vtkSMPTools::For(min[2], max[2] + 1, splat);
-
-    } // for all input points
+      break;
+    }
   } // for all datasets
 
   // If capping is turned on, set the distances of the outside of the volume
@@ -638,8 +765,7 @@ void vtkGaussianSplatter::Cap(vtkDoubleArray* s)
 //
 double vtkGaussianSplatter::Gaussian(double cx[3])
 {
-  return ((cx[0] - P[0]) * (cx[0] - P[0]) + (cx[1] - P[1]) * (cx[1] - P[1]) +
-    (cx[2] - P[2]) * (cx[2] - P[2]));
+  return GaussianSample(this->P, cx);
 }
 
 //------------------------------------------------------------------------------
@@ -648,32 +774,7 @@ double vtkGaussianSplatter::Gaussian(double cx[3])
 //
 double vtkGaussianSplatter::EccentricGaussian(double cx[3])
 {
-  double v[3], r2, z2, rxy2, mag;
-
-  v[0] = cx[0] - this->P[0];
-  v[1] = cx[1] - this->P[1];
-  v[2] = cx[2] - this->P[2];
-
-  r2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
-
-  if ((mag = this->N[0] * this->N[0] + this->N[1] * this->N[1] + this->N[2] * this->N[2]) != 1.0)
-  {
-    if (mag == 0.0)
-    {
-      mag = 1.0;
-    }
-    else
-    {
-      mag = sqrt(mag);
-    }
-  }
-
-  z2 = (v[0] * this->N[0] + v[1] * this->N[1] + v[2] * this->N[2]) / mag;
-  z2 = z2 * z2;
-
-  rxy2 = r2 - z2;
-
-  return (rxy2 / this->Eccentricity2 + z2);
+  return EccentricGaussianSample(this->P, this->N, this->Eccentricity2, cx);
 }
 
 //------------------------------------------------------------------------------
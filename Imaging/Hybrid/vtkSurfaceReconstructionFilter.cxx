@@ -9,11 +9,19 @@
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
-#include "vtkPointLocator.h"
-#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSurfaceReconstructionFilter);
 
@@ -24,78 +32,6 @@ vtkSurfaceReconstructionFilter::vtkSurfaceReconstructionFilter()
   this->SampleSpacing = -1.0;
 }
 
-// some simple routines for vector math
-static void vtkCopyBToA(double* a, double* b)
-{
-  for (int i = 0; i < 3; i++)
-  {
-    a[i] = b[i];
-  }
-}
-static void vtkSubtractBFromA(double* a, double* b)
-{
-  for (int i = 0; i < 3; i++)
-  {
-    a[i] -= b[i];
-  }
-}
-static void vtkAddBToA(double* a, double* b)
-{
-  for (int i = 0; i < 3; i++)
-  {
-    a[i] += b[i];
-  }
-}
-static void vtkMultiplyBy(double* a, double f)
-{
-  for (int i = 0; i < 3; i++)
-  {
-    a[i] *= f;
-  }
-}
-static void vtkDivideBy(double* a, double f)
-{
-  for (int i = 0; i < 3; i++)
-  {
-    a[i] /= f;
-  }
-}
-
-// Routines for matrix creation
-static void vtkSRFreeMatrix(double** m, long nrl, long nrh, long ncl, long nch);
-static double** vtkSRMatrix(long nrl, long nrh, long ncl, long nch);
-static void vtkSRFreeVector(double* v, long nl, long nh);
-static double* vtkSRVector(long nl, long nh);
-
-// set a matrix to zero
-static void vtkSRMakeZero(double** m, long nrl, long nrh, long ncl, long nch)
-{
-  int i, j;
-  for (i = nrl; i <= nrh; i++)
-  {
-    for (j = ncl; j <= nch; j++)
-    {
-      m[i][j] = 0.0;
-    }
-  }
-}
-
-// add v*Transpose(v) to m, where v is 3x1 and m is 3x3
-void vtkSRAddOuterProduct(double** m, double* v);
-
-// scalar multiply a matrix
-static void vtkSRMultiply(double** m, double f, long nrl, long nrh, long ncl, long nch)
-{
-  int i, j;
-  for (i = nrl; i <= nrh; i++)
-  {
-    for (j = ncl; j <= nch; j++)
-    {
-      m[i][j] *= f;
-    }
-  }
-}
-
 //------------------------------------------------------------------------------
 int vtkSurfaceReconstructionFilter::FillInputPortInformation(
   int vtkNotUsed(port), vtkInformation* info)
@@ -119,27 +55,55 @@ int vtkSurfaceReconstructionFilter::RequestInformation(vtkInformation* vtkNotUse
 }
 
 //------------------------------------------------------------------------------
+namespace
+{
 struct SurfacePoint
 {
   double loc[3];
-  double o[3], n[3];    // plane centre and normal
-  vtkIdList* neighbors; // id's of points within LocalRadius of this point
-  double* costs;        // should have same length as neighbors, cost for corresponding points
-  char isVisited;
-
-  // simple constructor to initialise the members
-  SurfacePoint()
-    : neighbors(vtkIdList::New())
-    , isVisited(0)
+  double o[3], n[3]; // plane centre and normal
+};
+
+// An edge of the neighborhood graph, from a point to its neighbor.  The
+// edges are ordered by cost, and the ids break the ties so that the order
+// is strict and the minimum spanning tree is unique.
+struct NeighborEdge
+{
+  double Cost;
+  vtkIdType Ids[2];
+
+  NeighborEdge(double cost, vtkIdType id0, vtkIdType id1)
+    : Cost(cost)
+    , Ids{ std::min(id0, id1), std::max(id0, id1) }
   {
   }
-  ~SurfacePoint()
+
+  bool operator<(const NeighborEdge& other) const
   {
-    delete[] costs;
-    neighbors->Delete();
+    if (this->Cost != other.Cost)
+    {
+      return this->Cost < other.Cost;
+    }
+    if (this->Ids[0] != other.Ids[0])
+    {
+      return this->Ids[0] < other.Ids[0];
+    }
+    return this->Ids[1] < other.Ids[1];
   }
 };
 
+// Find the representative of a point in a union-find forest, halving the
+// path to the root along the way.
+vtkIdType FindRoot(std::vector<vtkIdType>& parents, vtkIdType i)
+{
+  while (parents[i] != i)
+  {
+    parents[i] = parents[parents[i]];
+    i = parents[i];
+  }
+  return i;
+}
+}
+
 //------------------------------------------------------------------------------
 int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -153,226 +117,320 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
   vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   const vtkIdType COUNT = input->GetNumberOfPoints();
-  SurfacePoint* surfacePoints;
-
-  vtkIdType i, j;
-  int k;
 
   if (COUNT < 1)
   {
     vtkErrorMacro(<< "No points to reconstruct");
     return 1;
   }
-  surfacePoints = new SurfacePoint[COUNT];
+  std::vector<SurfacePoint> surfacePoints(COUNT);
 
   vtkDebugMacro(<< "Reconstructing " << COUNT << " points");
 
-  // time_t start_time,t1,t2,t3,t4;
-  // time(&start_time);
-
   // --------------------------------------------------------------------------
   // 1. Build local connectivity graph
-  // -------------------------------------------------------------------------
-  {
-    vtkPointLocator* locator = vtkPointLocator::New();
-    locator->SetDataSet(input);
-    vtkIdList* locals = vtkIdList::New();
-    // if a pair is close, add each one as a neighbor of the other
-    for (i = 0; i < COUNT; i++)
+  // --------------------------------------------------------------------------
+  // the closest points are found in parallel, the static locator is also
+  // used to sample the signed distance at the end, where larger buckets
+  // are faster for the samples that are far from the points
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->SetNumberOfPointsPerBucket(3);
+  locator->BuildLocator();
+
+  const int numClosest = std::max(this->NeighborhoodSize, 0);
+  std::vector<vtkIdType> closest(COUNT * numClosest, -1);
+  vtkSMPThreadLocalObject<vtkIdList> localIds;
+  vtkSMPTools::For(0, COUNT,
+    [&](vtkIdType i, vtkIdType end)
     {
-      SurfacePoint* p = &surfacePoints[i];
-      vtkCopyBToA(p->loc, input->GetPoint(i));
-      locator->FindClosestNPoints(this->NeighborhoodSize, p->loc, locals);
-      int iNeighbor;
-      for (j = 0; j < locals->GetNumberOfIds(); j++)
+      vtkIdList* locals = localIds.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (; i < end; ++i)
       {
-        iNeighbor = locals->GetId(j);
-        if (iNeighbor != i)
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
         {
-          p->neighbors->InsertNextId(iNeighbor);
-          surfacePoints[iNeighbor].neighbors->InsertNextId(i);
+          break;
         }
+        SurfacePoint& p = surfacePoints[i];
+        input->GetPoint(i, p.loc);
+        locator->FindClosestNPoints(numClosest, p.loc, locals);
+        std::copy_n(
+          locals->GetPointer(0), locals->GetNumberOfIds(), closest.data() + i * numClosest);
       }
-    }
-    locator->Delete();
-    locals->Delete();
+    });
+  if (this->GetAbortOutput())
+  {
+    return 1;
   }
 
-  // time(&t1);
-  // --------------------------------------------------------------------------
-  // 2. Estimate a plane at each point using local points
-  // --------------------------------------------------------------------------
+  // if a pair is close, add each one as a neighbor of the other, in the
+  // order of the ids so that the graph does not depend on the threads.
+  // The neighbors of point i are neighbors[offsets[i]] ... neighbors[offsets[i+1]-1].
+  std::vector<vtkIdType> offsets(COUNT + 1, 0);
+  for (vtkIdType i = 0; i < COUNT; i++)
   {
-    double* pointi;
-    double **covar, *v3d, *eigenvalues, **eigenvectors;
-    covar = vtkSRMatrix(0, 2, 0, 2);
-    v3d = vtkSRVector(0, 2);
-    eigenvalues = vtkSRVector(0, 2);
-    eigenvectors = vtkSRMatrix(0, 2, 0, 2);
-    for (i = 0; i < COUNT; i++)
+    for (int j = 0; j < numClosest; j++)
     {
-      SurfacePoint* p = &surfacePoints[i];
-
-      // first find the centroid of the neighbors
-      vtkCopyBToA(p->o, p->loc);
-      int number = 1;
-      vtkIdType neighborIndex;
-      for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+      vtkIdType iNeighbor = closest[i * numClosest + j];
+      if (iNeighbor >= 0 && iNeighbor != i)
       {
-        neighborIndex = p->neighbors->GetId(j);
-        pointi = input->GetPoint(neighborIndex);
-        vtkAddBToA(p->o, pointi);
-        number++;
+        offsets[i + 1]++;
+        offsets[iNeighbor + 1]++;
       }
-      vtkDivideBy(p->o, number);
-      // then compute the covariance matrix
-      vtkSRMakeZero(covar, 0, 2, 0, 2);
-      for (k = 0; k < 3; k++)
-        v3d[k] = p->loc[k] - p->o[k];
-      vtkSRAddOuterProduct(covar, v3d);
-      for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<vtkIdType> neighbors(offsets[COUNT]);
+  {
+    std::vector<vtkIdType> cursors(offsets.begin(), offsets.end() - 1);
+    for (vtkIdType i = 0; i < COUNT; i++)
+    {
+      for (int j = 0; j < numClosest; j++)
       {
-        neighborIndex = p->neighbors->GetId(j);
-        pointi = input->GetPoint(neighborIndex);
-        for (k = 0; k < 3; k++)
+        vtkIdType iNeighbor = closest[i * numClosest + j];
+        if (iNeighbor >= 0 && iNeighbor != i)
         {
-          v3d[k] = pointi[k] - p->o[k];
+          neighbors[cursors[i]++] = iNeighbor;
+          neighbors[cursors[iNeighbor]++] = i;
         }
-        vtkSRAddOuterProduct(covar, v3d);
-      }
-      vtkSRMultiply(covar, 1.0 / number, 0, 2, 0, 2);
-      // then extract the third eigenvector
-      vtkMath::Jacobi(covar, eigenvalues, eigenvectors);
-      // third eigenvector (column 2, ordered by eigenvalue magnitude) is plane normal
-      for (k = 0; k < 3; k++)
-      {
-        p->n[k] = eigenvectors[k][2];
       }
     }
-    vtkSRFreeMatrix(covar, 0, 2, 0, 2);
-    vtkSRFreeVector(v3d, 0, 2);
-    vtkSRFreeVector(eigenvalues, 0, 2);
-    vtkSRFreeMatrix(eigenvectors, 0, 2, 0, 2);
   }
+  std::vector<vtkIdType>().swap(closest);
+
+  // --------------------------------------------------------------------------
+  // 2. Estimate a plane at each point using local points
+  // --------------------------------------------------------------------------
+  vtkSMPTools::For(0, COUNT,
+    [&](vtkIdType i, vtkIdType end)
+    {
+      double covar0[3], covar1[3], covar2[3];
+      double* covar[3] = { covar0, covar1, covar2 };
+      double eigenvectors0[3], eigenvectors1[3], eigenvectors2[3];
+      double* eigenvectors[3] = { eigenvectors0, eigenvectors1, eigenvectors2 };
+      double eigenvalues[3], v3d[3];
+      for (; i < end; ++i)
+      {
+        SurfacePoint* p = &surfacePoints[i];
+
+        // first find the centroid of the neighbors
+        std::copy_n(p->loc, 3, p->o);
+        int number = 1;
+        for (vtkIdType j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+          const double* pointi = surfacePoints[neighbors[j]].loc;
+          for (int k = 0; k < 3; k++)
+          {
+            p->o[k] += pointi[k];
+          }
+          number++;
+        }
+        for (int k = 0; k < 3; k++)
+        {
+          p->o[k] /= number;
+        }
+        // then compute the covariance matrix
+        for (int k = 0; k < 3; k++)
+        {
+          v3d[k] = p->loc[k] - p->o[k];
+          for (int l = 0; l < 3; l++)
+          {
+            covar[k][l] = v3d[k] * v3d[l];
+          }
+        }
+        for (vtkIdType j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+          const double* pointi = surfacePoints[neighbors[j]].loc;
+          for (int k = 0; k < 3; k++)
+          {
+            v3d[k] = pointi[k] - p->o[k];
+          }
+          for (int k = 0; k < 3; k++)
+          {
+            for (int l = 0; l < 3; l++)
+            {
+              covar[k][l] += v3d[k] * v3d[l];
+            }
+          }
+        }
+        for (int k = 0; k < 3; k++)
+        {
+          for (int l = 0; l < 3; l++)
+          {
+            covar[k][l] *= 1.0 / number;
+          }
+        }
+        // then extract the third eigenvector
+        vtkMath::Jacobi(covar, eigenvalues, eigenvectors);
+        // third eigenvector (column 2, ordered by eigenvalue magnitude) is plane normal
+        for (int k = 0; k < 3; k++)
+        {
+          p->n[k] = eigenvectors[k][2];
+        }
+      }
+    });
 
-  // time(&t2);
   //--------------------------------------------------------------------------
   // 3a. Compute a cost between every pair of neighbors for the MST
   // --------------------------------------------------------------------------
   // cost = 1 - |normal1.normal2|
   // ie. cost is 0 if planes are parallel, 1 if orthogonal (least parallel)
-  for (i = 0; i < COUNT; i++)
-  {
-    SurfacePoint* p = &surfacePoints[i];
-    p->costs = new double[p->neighbors->GetNumberOfIds()];
-
-    // compute cost between all its neighbors
-    // (bit inefficient to do this for every point, as cost is symmetric)
-    for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+  std::vector<double> costs(neighbors.size());
+  vtkSMPTools::For(0, COUNT,
+    [&](vtkIdType i, vtkIdType end)
     {
-      p->costs[j] = 1.0 - fabs(vtkMath::Dot(p->n, surfacePoints[p->neighbors->GetId(j)].n));
-    }
-  }
+      for (; i < end; ++i)
+      {
+        for (vtkIdType j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+          costs[j] =
+            1.0 - std::fabs(vtkMath::Dot(surfacePoints[i].n, surfacePoints[neighbors[j]].n));
+        }
+      }
+    });
 
   // --------------------------------------------------------------------------
   // 3b. Ensure consistency in plane direction between neighbors
   // --------------------------------------------------------------------------
-  // method: guess first one, then walk through tree along most-parallel
-  // neighbors MST, flipping the new normal if inconsistent
-
-  // to walk minimal spanning tree, keep record of vertices visited and list
-  // of those near to any visited point but not themselves visited. Start
-  // with just one vertex as visited.  Pick the vertex in the neighbors list
-  // that has the lowest cost connection with a visited vertex. Record this
-  // vertex as visited, add any new neighbors to the neighbors list.
-
-  // Disable if you don't want orientation propagation (for testing)
-#if 1
+  // method: compute the minimal spanning tree of the graph with Boruvka's
+  // algorithm, then walk through the tree from its root and flip the normals
+  // that are inconsistent with the normal of their parent.
+
+  // Each round of Boruvka's algorithm finds, in parallel, the cheapest edge
+  // from each point to another component, then joins each component to
+  // another along the cheapest edge of its points.  The number of
+  // components is at least halved at each round.
+  std::vector<vtkIdType> parents(COUNT);
+  std::iota(parents.begin(), parents.end(), 0);
+  std::vector<vtkIdType> components(parents);
+  std::vector<vtkIdType> cheapest(COUNT);
+  std::vector<vtkIdType> componentCheapest(COUNT);
+  std::vector<vtkIdType> componentPoint(COUNT);
+  std::vector<std::pair<vtkIdType, vtkIdType>> treeEdges;
+  treeEdges.reserve(COUNT);
+  bool joined = true;
+  while (joined && !this->CheckAbort())
   {
-    vtkIdList* nearby = vtkIdList::New(); // list of nearby, unvisited points
-
-    // start with some vertex
-    int first = 0; // index of starting vertex
-    surfacePoints[first].isVisited = 1;
-    // add all the neighbors of the starting vertex into nearby
-    for (j = 0; j < surfacePoints[first].neighbors->GetNumberOfIds(); j++)
-    {
-      nearby->InsertNextId(surfacePoints[first].neighbors->GetId(j));
-    }
-
-    double cost, lowestCost;
-    int cheapestNearby = 0, connectedVisited = 0;
-
-    // repeat until nearby is empty:
-    while (nearby->GetNumberOfIds() > 0)
-    {
-      // for each nearby point:
-      vtkIdType iNearby, iNeighbor;
-      lowestCost = VTK_DOUBLE_MAX;
-      for (i = 0; i < nearby->GetNumberOfIds(); i++)
+    joined = false;
+    vtkSMPTools::For(0, COUNT,
+      [&](vtkIdType i, vtkIdType end)
       {
-        iNearby = nearby->GetId(i);
-        // test cost against all neighbors that are members of visited
-        for (j = 0; j < surfacePoints[iNearby].neighbors->GetNumberOfIds(); j++)
+        for (; i < end; ++i)
         {
-          iNeighbor = surfacePoints[iNearby].neighbors->GetId(j);
-          if (surfacePoints[iNeighbor].isVisited)
+          vtkIdType best = -1;
+          for (vtkIdType j = offsets[i]; j < offsets[i + 1]; j++)
           {
-            cost = surfacePoints[iNearby].costs[j];
-            // pick lowest cost for this nearby point
-            if (cost < lowestCost)
+            if (components[neighbors[j]] != components[i] &&
+              (best < 0 ||
+                NeighborEdge(costs[j], i, neighbors[j]) <
+                  NeighborEdge(costs[best], i, neighbors[best])))
             {
-              lowestCost = cost;
-              cheapestNearby = iNearby;
-              connectedVisited = iNeighbor;
-              // optional: can break out if satisfied with parallelness
-              if (lowestCost < 0.1)
-              {
-                i = nearby->GetNumberOfIds();
-                break;
-              }
+              best = j;
             }
           }
+          cheapest[i] = best;
         }
-      }
-      if (connectedVisited == cheapestNearby)
+      });
+
+    std::fill(componentCheapest.begin(), componentCheapest.end(), -1);
+    for (vtkIdType i = 0; i < COUNT; i++)
+    {
+      vtkIdType j = cheapest[i];
+      vtkIdType c = components[i];
+      if (j >= 0 &&
+        (componentCheapest[c] < 0 ||
+          NeighborEdge(costs[j], i, neighbors[j]) <
+            NeighborEdge(costs[componentCheapest[c]], componentPoint[c],
+              neighbors[componentCheapest[c]])))
       {
-        vtkErrorMacro(<< "Internal error in vtkSurfaceReconstructionFilter");
-        return 0;
+        componentCheapest[c] = j;
+        componentPoint[c] = i;
       }
+    }
 
-      // correct the orientation of the point if necessary
-      if (vtkMath::Dot(surfacePoints[cheapestNearby].n, surfacePoints[connectedVisited].n) < 0.0F)
+    for (vtkIdType c = 0; c < COUNT; c++)
+    {
+      if (componentCheapest[c] >= 0)
       {
-        // flip this normal
-        vtkMultiplyBy(surfacePoints[cheapestNearby].n, -1);
+        vtkIdType i = componentPoint[c];
+        vtkIdType iNeighbor = neighbors[componentCheapest[c]];
+        vtkIdType root0 = FindRoot(parents, i);
+        vtkIdType root1 = FindRoot(parents, iNeighbor);
+        if (root0 != root1)
+        {
+          parents[std::max(root0, root1)] = std::min(root0, root1);
+          treeEdges.emplace_back(i, iNeighbor);
+          joined = true;
+        }
       }
-      // add this nearby point to visited
-      if (surfacePoints[cheapestNearby].isVisited != 0)
+    }
+    for (vtkIdType i = 0; i < COUNT; i++)
+    {
+      components[i] = FindRoot(parents, i);
+    }
+  }
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+  std::vector<vtkIdType>().swap(neighbors);
+  std::vector<double>().swap(costs);
+
+  // walk through the tree from the first point of each component, flipping
+  // the new normal if inconsistent
+  {
+    std::vector<vtkIdType> treeOffsets(COUNT + 1, 0);
+    for (const auto& edge : treeEdges)
+    {
+      treeOffsets[edge.first + 1]++;
+      treeOffsets[edge.second + 1]++;
+    }
+    std::partial_sum(treeOffsets.begin(), treeOffsets.end(), treeOffsets.begin());
+    std::vector<vtkIdType> treeNeighbors(treeOffsets[COUNT]);
+    std::vector<vtkIdType> cursors(treeOffsets.begin(), treeOffsets.end() - 1);
+    for (const auto& edge : treeEdges)
+    {
+      treeNeighbors[cursors[edge.first]++] = edge.second;
+      treeNeighbors[cursors[edge.second]++] = edge.first;
+    }
+
+    std::vector<char> isVisited(COUNT, 0);
+    std::vector<vtkIdType> visited;
+    visited.reserve(COUNT);
+    for (vtkIdType first = 0; first < COUNT; first++)
+    {
+      if (isVisited[first])
       {
-        vtkErrorMacro(<< "Internal error in vtkSurfaceReconstructionFilter");
-        return 0;
+        continue;
       }
-
-      surfacePoints[cheapestNearby].isVisited = 1;
-      // remove from nearby
-      nearby->DeleteId(cheapestNearby);
-      // add all new nearby points to nearby
-      for (j = 0; j < surfacePoints[cheapestNearby].neighbors->GetNumberOfIds(); j++)
+      isVisited[first] = 1;
+      visited.push_back(first);
+      for (size_t next = visited.size() - 1; next < visited.size(); next++)
       {
-        iNeighbor = surfacePoints[cheapestNearby].neighbors->GetId(j);
-        if (surfacePoints[iNeighbor].isVisited == 0)
+        vtkIdType i = visited[next];
+        for (vtkIdType j = treeOffsets[i]; j < treeOffsets[i + 1]; j++)
         {
-          nearby->InsertUniqueId(iNeighbor);
+          vtkIdType iNeighbor = treeNeighbors[j];
+          if (!isVisited[iNeighbor])
+          {
+            // correct the orientation of the point if necessary
+            if (vtkMath::Dot(surfacePoints[iNeighbor].n, surfacePoints[i].n) < 0.0)
+            {
+              // flip this normal
+              vtkMath::MultiplyScalar(surfacePoints[iNeighbor].n, -1.0);
+            }
+            isVisited[iNeighbor] = 1;
+            visited.push_back(iNeighbor);
+          }
         }
       }
     }
-
-    nearby->Delete();
   }
-#endif
-
-  // time(&t3);
 
   // --------------------------------------------------------------------------
   // 4. Compute signed distance to surface for every point on a 3D grid
@@ -380,7 +438,7 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
   {
     // need to know the bounding rectangle
     double bounds[6];
-    for (i = 0; i < 3; i++)
+    for (int i = 0; i < 3; i++)
     {
       bounds[i * 2] = input->GetBounds()[i * 2];
       bounds[i * 2 + 1] = input->GetBounds()[i * 2 + 1];
@@ -398,7 +456,7 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
     }
 
     // allow a border around the volume to allow sampling around the extremes
-    for (i = 0; i < 3; i++)
+    for (int i = 0; i < 3; i++)
     {
       bounds[i * 2] -= this->SampleSpacing * 2;
       bounds[i * 2 + 1] += this->SampleSpacing * 2;
@@ -407,7 +465,7 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
     double topleft[3] = { bounds[0], bounds[2], bounds[4] };
     double bottomright[3] = { bounds[1], bounds[3], bounds[5] };
     int dim[3];
-    for (i = 0; i < 3; i++)
+    for (int i = 0; i < 3; i++)
     {
       dim[i] = static_cast<int>((bottomright[i] - topleft[i]) / this->SampleSpacing);
     }
@@ -432,57 +490,44 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
       vtkDataObject::SPACING(), this->SampleSpacing, this->SampleSpacing, this->SampleSpacing);
     outInfo->Set(vtkDataObject::ORIGIN(), topleft, 3);
 
-    // initialise the point locator (have to use point insertion because we
-    // need to set our own bounds, slightly larger than the dataset to allow
-    // for sampling around the edge)
-    vtkPointLocator* locator = vtkPointLocator::New();
-    vtkPoints* newPts = vtkPoints::New();
-    locator->InitPointInsertion(newPts, bounds, static_cast<int>(COUNT));
-    for (i = 0; i < COUNT; i++)
-    {
-      locator->InsertPoint(i, surfacePoints[i].loc);
-    }
-
-    // go through the array probing the values
-    int x, y, z;
-    int iClosestPoint;
-    int zOffset, yOffset, offset;
-    double probeValue;
-    double point[3], temp[3];
-    for (z = 0; z < dim[2]; z++)
-    {
-      zOffset = z * dim[1] * dim[0];
-      point[2] = topleft[2] + z * this->SampleSpacing;
-      for (y = 0; y < dim[1]; y++)
+    // go through the array probing the values, one slice per task, the
+    // static locator finds the closest point also outside of its bounds
+    float* scalars = newScalars->GetPointer(0);
+    const double spacing = this->SampleSpacing;
+    vtkSMPTools::For(0, dim[2],
+      [&](vtkIdType z, vtkIdType zEnd)
       {
-        yOffset = y * dim[0] + zOffset;
-        point[1] = topleft[1] + y * this->SampleSpacing;
-        for (x = 0; x < dim[0]; x++)
+        double point[3], temp[3];
+        bool isFirst = vtkSMPTools::GetSingleThread();
+        for (; z < zEnd; z++)
         {
-          offset = x + yOffset;
-          point[0] = topleft[0] + x * this->SampleSpacing;
-          // find the distance from the probe to the plane of the nearest point
-          iClosestPoint = locator->FindClosestInsertedPoint(point);
-          if (iClosestPoint == -1)
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
           {
-            vtkErrorMacro(<< "Internal error");
-            return 0;
+            break;
+          }
+          vtkIdType zOffset = z * dim[1] * dim[0];
+          point[2] = topleft[2] + z * spacing;
+          for (int y = 0; y < dim[1]; y++)
+          {
+            vtkIdType yOffset = y * dim[0] + zOffset;
+            point[1] = topleft[1] + y * spacing;
+            for (int x = 0; x < dim[0]; x++)
+            {
+              point[0] = topleft[0] + x * spacing;
+              // find the distance from the probe to the plane of the nearest point
+              const SurfacePoint& closestPoint = surfacePoints[locator->FindClosestPoint(point)];
+              vtkMath::Subtract(point, closestPoint.loc, temp);
+              scalars[x + yOffset] = vtkMath::Dot(temp, closestPoint.n);
+            }
           }
-          vtkCopyBToA(temp, point);
-          vtkSubtractBFromA(temp, surfacePoints[iClosestPoint].loc);
-          probeValue = vtkMath::Dot(temp, surfacePoints[iClosestPoint].n);
-          newScalars->SetValue(offset, probeValue);
         }
-      }
-    }
-    locator->Delete();
-    newPts->Delete();
+      });
   }
 
-  // time(&t4);
-  // Clear up everything
-  delete[] surfacePoints;
-
   return 1;
 }
 
@@ -494,85 +539,4 @@ void vtkSurfaceReconstructionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Sample Spacing:" << this->SampleSpacing << "\n";
 }
 
-void vtkSRAddOuterProduct(double** m, double* v)
-{
-  int i, j;
-  for (i = 0; i < 3; i++)
-  {
-    for (j = 0; j < 3; j++)
-    {
-      m[i][j] += v[i] * v[j];
-    }
-  }
-}
-
-#define VTK_NR_END 1
-
-// allocate a float vector with subscript range v[nl..nh]
-// must be balanced with vtkSRFreeVector.
-static double* vtkSRVector(long nl, long nh)
-{
-  double* v = new double[nh - nl + 1 + VTK_NR_END];
-  if (!v)
-  {
-    vtkGenericWarningMacro(<< "allocation failure in vector()");
-    return nullptr;
-  }
-
-  return (v - nl + VTK_NR_END);
-}
-
-// allocate a float matrix with subscript range m[nrl..nrh][ncl..nch]
-// must be balanced with vtkSRFreeMatrix.
-static double** vtkSRMatrix(long nrl, long nrh, long ncl, long nch)
-{
-  long i, nrow = nrh - nrl + 1, ncol = nch - ncl + 1;
-  double** m;
-
-  // allocate pointers to rows
-  m = new double*[nrow + VTK_NR_END];
-  if (!m)
-  {
-    vtkGenericWarningMacro(<< "allocation failure 1 in Matrix()");
-    return nullptr;
-  }
-
-  m += VTK_NR_END;
-  m -= nrl;
-
-  // allocate rows and set pointers to them
-  m[nrl] = new double[nrow * ncol + VTK_NR_END];
-  if (!m[nrl])
-  {
-    vtkGenericWarningMacro("allocation failure 2 in Matrix()");
-    return nullptr;
-  }
-
-  m[nrl] += VTK_NR_END;
-  m[nrl] -= ncl;
-  for (i = nrl + 1; i <= nrh; i++)
-  {
-    m[i] = m[i - 1] + ncol;
-  }
-
-  // return pointer to array of pointers to rows
-  return m;
-}
-
-// free a double vector allocated with SRVector()
-static void vtkSRFreeVector(double* v, long nl, long vtkNotUsed(nh))
-{
-  delete[] (v + nl - VTK_NR_END);
-}
-
-// free a double matrix allocated by Matrix()
-static void vtkSRFreeMatrix(
-  double** m, long nrl, long vtkNotUsed(nrh), long ncl, long vtkNotUsed(nch))
-
-{
-  delete[] (m[nrl] + ncl - VTK_NR_END);
-  delete[] (m + nrl - VTK_NR_END);
-}
-
-#undef VTK_NR_END
 VTK_ABI_NAMESPACE_END
@@ -11,6 +11,15 @@
  * neighborhood size and sample spacing should give reasonable results for
  * most uses but can be set if desired. This procedure is based on the PhD
  * work of Hugues Hoppe: http://www.research.microsoft.com/~hoppe
+ *
+ * The normals of the planes fitted to the neighborhoods are oriented
+ * consistently along a minimum spanning tree of the neighborhood graph,
+ * separately for each connected part of the graph.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
  */
 
 #ifndef vtkSurfaceReconstructionFilter_h
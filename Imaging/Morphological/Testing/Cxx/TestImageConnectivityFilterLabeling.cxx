@@ -0,0 +1,564 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the labels, the region sizes, the region order and the region extents
+// given by vtkImageConnectivityFilter against a voxel by voxel flood fill,
+// which is how the filter labeled the unseeded regions before it used runs.
+// All the extraction and label modes are checked, with and without seeds,
+// with scalar and size ranges, with more regions than the label type can
+// hold, and for thin images whose extent does not start at zero.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkTypeTraits.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <stack>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+struct ReferenceRegion
+{
+  vtkIdType Size;
+  vtkIdType Id;
+  std::array<int, 6> Extent;
+};
+
+//------------------------------------------------------------------------------
+// The voxel by voxel labeling: every seed, then every voxel that is not
+// labeled yet in raster order, is flood filled.  Regions are kept in the
+// order in which they are found, and are removed as the filter removed them.
+class ReferenceLabeler
+{
+public:
+  ReferenceLabeler(
+    vtkImageConnectivityFilter* filter, vtkImageData* image, vtkPolyData* seeds, int maxLabel)
+    : Filter(filter)
+    , Image(image)
+    , MaxLabel(static_cast<size_t>(maxLabel))
+  {
+    image->GetExtent(this->Extent);
+    this->Filter->GetSizeRange(this->SizeRange);
+    double range[2];
+    this->Filter->GetScalarRange(range);
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    const vtkIdType n = scalars->GetNumberOfTuples();
+    this->Region.assign(n, -1);
+    this->Done.resize(n);
+    for (vtkIdType i = 0; i < n; i++)
+    {
+      const double v = scalars->GetComponent(i, 0);
+      this->Done[i] = (v < range[0] || v > range[1]);
+    }
+
+    // index 0 is the background
+    this->Regions.push_back(-1);
+    const int extractionMode = this->Filter->GetExtractionMode();
+    if (seeds)
+    {
+      this->FillSeeds(seeds);
+    }
+    if (!seeds || extractionMode == vtkImageConnectivityFilter::AllRegions)
+    {
+      this->FillAll();
+    }
+    this->PruneBySize();
+  }
+
+  // Regions left after the labeling, in the order of their region ids.
+  std::vector<ReferenceRegion> GetRegions() const
+  {
+    std::vector<ReferenceRegion> regions;
+    for (size_t i = 1; i < this->Regions.size(); i++)
+    {
+      regions.push_back(this->Found[this->Regions[i]]);
+    }
+    return regions;
+  }
+
+  // Region id of each voxel, 0 for the background.
+  std::vector<vtkIdType> GetRegionIds() const
+  {
+    std::vector<vtkIdType> position(this->Found.size(), 0);
+    for (size_t i = 1; i < this->Regions.size(); i++)
+    {
+      position[this->Regions[i]] = static_cast<vtkIdType>(i);
+    }
+    std::vector<vtkIdType> ids(this->Region.size(), 0);
+    for (size_t i = 0; i < this->Region.size(); i++)
+    {
+      ids[i] = (this->Region[i] >= 0 ? position[this->Region[i]] : 0);
+    }
+    return ids;
+  }
+
+private:
+  vtkIdType Fill(int i, int j, int k)
+  {
+    int dims[3];
+    this->Image->GetDimensions(dims);
+    const vtkIdType found = static_cast<vtkIdType>(this->Found.size());
+    ReferenceRegion region = { 0, -1, { i, i, j, j, k, k } };
+    std::stack<std::array<int, 3>> stack;
+    stack.push({ i, j, k });
+    while (!stack.empty())
+    {
+      std::array<int, 3> idx = stack.top();
+      stack.pop();
+      const vtkIdType offset =
+        (static_cast<vtkIdType>(idx[2]) * dims[1] + idx[1]) * dims[0] + idx[0];
+      if (this->Done[offset])
+      {
+        continue;
+      }
+      this->Done[offset] = true;
+      this->Region[offset] = found;
+      region.Size++;
+      for (int c = 0; c < 3; c++)
+      {
+        if (this->Filter->GetGenerateRegionExtents())
+        {
+          region.Extent[2 * c] = std::min(region.Extent[2 * c], idx[c]);
+          region.Extent[2 * c + 1] = std::max(region.Extent[2 * c + 1], idx[c]);
+        }
+        for (int step : { -1, 1 })
+        {
+          std::array<int, 3> next = idx;
+          next[c] += step;
+          if (next[c] >= 0 && next[c] < dims[c])
+          {
+            stack.push(next);
+          }
+        }
+      }
+    }
+    for (int c = 0; c < 3; c++)
+    {
+      region.Extent[2 * c] += this->Extent[2 * c];
+      region.Extent[2 * c + 1] += this->Extent[2 * c];
+    }
+    if (region.Size > 0)
+    {
+      this->Found.push_back(region);
+    }
+    return region.Size;
+  }
+
+  void FillSeeds(vtkPolyData* seeds)
+  {
+    vtkDataArray* seedScalars = seeds->GetPointData()->GetScalars();
+    double origin[3];
+    double spacing[3];
+    this->Image->GetOrigin(origin);
+    this->Image->GetSpacing(spacing);
+    for (vtkIdType s = 0; s < seeds->GetNumberOfPoints(); s++)
+    {
+      if (seedScalars && seedScalars->GetComponent(s, 0) == 0)
+      {
+        continue;
+      }
+      double point[3];
+      seeds->GetPoint(s, point);
+      int idx[3];
+      bool outOfBounds = false;
+      for (int c = 0; c < 3; c++)
+      {
+        idx[c] = vtkMath::Floor((point[c] - origin[c]) / spacing[c] + 0.5) - this->Extent[2 * c];
+        outOfBounds |= (idx[c] < 0 || idx[c] > this->Extent[2 * c + 1] - this->Extent[2 * c]);
+      }
+      if (!outOfBounds && this->Fill(idx[0], idx[1], idx[2]) > 0)
+      {
+        this->Found.back().Id = s;
+        this->AddRegion();
+      }
+    }
+  }
+
+  void FillAll()
+  {
+    int dims[3];
+    this->Image->GetDimensions(dims);
+    for (int k = 0; k < dims[2]; k++)
+    {
+      for (int j = 0; j < dims[1]; j++)
+      {
+        for (int i = 0; i < dims[0]; i++)
+        {
+          const vtkIdType size = this->Fill(i, j, k);
+          // a single voxel would be the smallest region, so it is dropped
+          // instead of being added when there is no label left
+          if (size > 1 || (size == 1 && this->Regions.size() != this->MaxLabel))
+          {
+            this->AddRegion();
+          }
+        }
+      }
+    }
+  }
+
+  void AddRegion()
+  {
+    this->Regions.push_back(static_cast<vtkIdType>(this->Found.size()) - 1);
+    if (this->Regions.size() > this->MaxLabel)
+    {
+      this->PruneBySize();
+      if (this->Regions.size() > this->MaxLabel)
+      {
+        if (this->Filter->GetExtractionMode() == vtkImageConnectivityFilter::LargestRegion)
+        {
+          this->Regions = { -1, this->Regions[this->Largest()] };
+        }
+        else
+        {
+          this->Regions.erase(this->Regions.begin() + this->Smallest());
+        }
+      }
+    }
+  }
+
+  void PruneBySize()
+  {
+    std::vector<vtkIdType> regions = { -1 };
+    for (size_t i = 1; i < this->Regions.size(); i++)
+    {
+      const vtkIdType size = this->Found[this->Regions[i]].Size;
+      if (size >= this->SizeRange[0] && size <= this->SizeRange[1])
+      {
+        regions.push_back(this->Regions[i]);
+      }
+    }
+    this->Regions = regions;
+  }
+
+  // first of the largest regions
+  size_t Largest() const
+  {
+    size_t largest = 1;
+    for (size_t i = 2; i < this->Regions.size(); i++)
+    {
+      if (this->Found[this->Regions[i]].Size > this->Found[this->Regions[largest]].Size)
+      {
+        largest = i;
+      }
+    }
+    return largest;
+  }
+
+  // last of the smallest regions
+  size_t Smallest() const
+  {
+    size_t smallest = 1;
+    for (size_t i = 2; i < this->Regions.size(); i++)
+    {
+      if (this->Found[this->Regions[i]].Size <= this->Found[this->Regions[smallest]].Size)
+      {
+        smallest = i;
+      }
+    }
+    return smallest;
+  }
+
+  vtkImageConnectivityFilter* Filter;
+  vtkImageData* Image;
+  size_t MaxLabel;
+  int Extent[6];
+  vtkIdType SizeRange[2];
+  // region found for each voxel, and voxels already filled or excluded
+  std::vector<vtkIdType> Region;
+  std::vector<bool> Done;
+  // all the regions found, and the ones kept, by their index in Found
+  std::vector<ReferenceRegion> Found;
+  std::vector<vtkIdType> Regions;
+};
+
+//------------------------------------------------------------------------------
+// Image of random values from 0 to 9, with an origin and a spacing that are
+// used to place the seeds.
+vtkSmartPointer<vtkImageData> MakeImage(const int extent[6], int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4], extent[5]);
+  image->SetOrigin(1.5, -2.0, 0.25);
+  image->SetSpacing(0.5, 1.0, 2.0);
+  vtkNew<vtkShortArray> values;
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); i++)
+  {
+    values->SetValue(i, static_cast<short>(random->GetNextRangeValue(0.0, 10.0)));
+  }
+  image->GetPointData()->SetScalars(values);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+// Seeds at voxels spread over the image, with a zero scalar for one of them so
+// that it is ignored, and one outside of the image.
+vtkSmartPointer<vtkPolyData> MakeSeeds(vtkImageData* image)
+{
+  int extent[6];
+  image->GetExtent(extent);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  for (int s = 0; s < 12; s++)
+  {
+    int idx[3];
+    for (int c = 0; c < 3; c++)
+    {
+      idx[c] = extent[2 * c] + ((s * (c + 3)) % (extent[2 * c + 1] - extent[2 * c] + 1));
+    }
+    double point[3];
+    image->TransformIndexToPhysicalPoint(idx, point);
+    points->InsertNextPoint(point);
+    scalars->InsertNextValue(s == 4 ? 0.0 : 17.4 * s + 3.6);
+  }
+  points->InsertNextPoint(-100.0, 0.0, 0.0);
+  scalars->InsertNextValue(9.0);
+  auto seeds = vtkSmartPointer<vtkPolyData>::New();
+  seeds->SetPoints(points);
+  seeds->GetPointData()->SetScalars(scalars);
+  return seeds;
+}
+
+//------------------------------------------------------------------------------
+int ClampLabel(double value, int minLabel, int maxLabel)
+{
+  value = std::min(std::max(value, static_cast<double>(minLabel)), static_cast<double>(maxLabel));
+  return vtkMath::Floor(value + 0.5);
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+bool CheckArray(vtkDataArray* array, const std::vector<T>& expected, const std::string& what)
+{
+  const vtkIdType n = static_cast<vtkIdType>(expected.size());
+  if (array->GetNumberOfValues() != n)
+  {
+    std::cerr << what << ": " << array->GetNumberOfValues() << " values instead of " << n
+              << ".\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < n; i++)
+  {
+    if (array->GetVariantValue(i).ToDouble() != static_cast<double>(expected[i]))
+    {
+      std::cerr << what << ": value " << i << " is " << array->GetVariantValue(i).ToDouble()
+                << " instead of " << expected[i] << ".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Run the filter and compare its output with the reference labeling.
+bool Compare(vtkImageConnectivityFilter* filter, vtkImageData* image, vtkPolyData* seeds,
+  int minLabel, int maxLabel, const std::string& what)
+{
+  filter->SetInputData(image);
+  filter->SetSeedData(seeds);
+  filter->Update();
+
+  ::ReferenceLabeler reference(filter, image, seeds, maxLabel);
+  std::vector<::ReferenceRegion> regions = reference.GetRegions();
+  std::vector<vtkIdType> regionIds = reference.GetRegionIds();
+  const int labelMode = filter->GetLabelMode();
+  vtkDataArray* seedScalars = (seeds ? seeds->GetPointData()->GetScalars() : nullptr);
+  const int constantLabel = ::ClampLabel(filter->GetLabelConstantValue(), minLabel, maxLabel);
+
+  // label of each region, in the order of the region ids
+  std::vector<vtkIdType> labels(regions.size());
+  for (size_t i = 0; i < regions.size(); i++)
+  {
+    labels[i] = static_cast<vtkIdType>(i) + 1;
+    if (labelMode == vtkImageConnectivityFilter::ConstantValue)
+    {
+      labels[i] = constantLabel;
+    }
+    else if (labelMode == vtkImageConnectivityFilter::SeedScalar && seedScalars)
+    {
+      labels[i] = (regions[i].Id >= 0
+          ? ::ClampLabel(seedScalars->GetTuple1(regions[i].Id), minLabel, maxLabel)
+          : constantLabel);
+    }
+  }
+
+  // the regions in the order of the output arrays
+  std::vector<size_t> order;
+  if (filter->GetExtractionMode() == vtkImageConnectivityFilter::LargestRegion)
+  {
+    if (!regions.empty())
+    {
+      size_t largest = 0;
+      for (size_t i = 1; i < regions.size(); i++)
+      {
+        largest = (regions[i].Size > regions[largest].Size ? i : largest);
+      }
+      order.push_back(largest);
+      if (labelMode == vtkImageConnectivityFilter::SizeRank ||
+        (labelMode == vtkImageConnectivityFilter::SeedScalar && !seedScalars))
+      {
+        labels[largest] = 1;
+      }
+      for (vtkIdType& id : regionIds)
+      {
+        id = (id == static_cast<vtkIdType>(largest) + 1 ? id : 0);
+      }
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < regions.size(); i++)
+    {
+      order.push_back(i);
+    }
+    if (labelMode == vtkImageConnectivityFilter::SizeRank)
+    {
+      std::stable_sort(order.begin(), order.end(),
+        [&regions](size_t a, size_t b) { return regions[a].Size > regions[b].Size; });
+      for (size_t i = 0; i < order.size(); i++)
+      {
+        labels[order[i]] = static_cast<vtkIdType>(i) + 1;
+      }
+    }
+  }
+
+  std::vector<vtkIdType> sizes;
+  std::vector<vtkIdType> ids;
+  std::vector<vtkIdType> sortedLabels;
+  std::vector<int> extents;
+  for (size_t i : order)
+  {
+    sizes.push_back(regions[i].Size);
+    ids.push_back(regions[i].Id);
+    sortedLabels.push_back(labels[i]);
+    extents.insert(extents.end(), regions[i].Extent.begin(), regions[i].Extent.end());
+  }
+  std::vector<vtkIdType> voxelLabels(regionIds.size());
+  for (size_t i = 0; i < regionIds.size(); i++)
+  {
+    voxelLabels[i] = (regionIds[i] > 0 ? labels[regionIds[i] - 1] : 0);
+  }
+
+  if (!::CheckArray(filter->GetExtractedRegionSizes(), sizes, what + ", sizes") ||
+    !::CheckArray(filter->GetExtractedRegionSeedIds(), ids, what + ", seed ids") ||
+    !::CheckArray(filter->GetExtractedRegionLabels(), sortedLabels, what + ", labels") ||
+    !::CheckArray(filter->GetExtractedRegionExtents(), extents, what + ", extents") ||
+    !::CheckArray(filter->GetOutput()->GetPointData()->GetScalars(), voxelLabels,
+      what + ", output"))
+  {
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestImage(vtkImageData* image, const std::string& name)
+{
+  vtkSmartPointer<vtkPolyData> seeds = ::MakeSeeds(image);
+  const int extractionModes[] = { vtkImageConnectivityFilter::SeededRegions,
+    vtkImageConnectivityFilter::AllRegions, vtkImageConnectivityFilter::LargestRegion };
+  const int labelModes[] = { vtkImageConnectivityFilter::SeedScalar,
+    vtkImageConnectivityFilter::ConstantValue, vtkImageConnectivityFilter::SizeRank };
+  const double scalarRanges[][2] = { { 6.0, 9.0 }, { 8.0, 9.0 } };
+  const vtkIdType sizeRanges[][2] = { { 1, VTK_ID_MAX }, { 2, 40 } };
+
+  for (int extractionMode : extractionModes)
+  {
+    for (int labelMode : labelModes)
+    {
+      for (int useSeeds = 0; useSeeds < 2; useSeeds++)
+      {
+        for (int range = 0; range < 2; range++)
+        {
+          for (int generateExtents = 0; generateExtents < 2; generateExtents++)
+          {
+            vtkNew<vtkImageConnectivityFilter> filter;
+            filter->SetExtractionMode(extractionMode);
+            filter->SetLabelMode(labelMode);
+            filter->SetLabelConstantValue(300);
+            filter->SetScalarRange(scalarRanges[range]);
+            filter->SetSizeRange(sizeRanges[range]);
+            filter->SetGenerateRegionExtents(generateExtents);
+            const std::string what = name + ", " + filter->GetExtractionModeAsString() + ", " +
+              filter->GetLabelModeAsString() + (useSeeds ? ", seeds" : "") + ", range " +
+              std::to_string(range) + (generateExtents ? ", extents" : "");
+
+            filter->SetLabelScalarTypeToUnsignedChar();
+            if (!::Compare(filter, image, useSeeds ? seeds.Get() : nullptr,
+                  vtkTypeTraits<unsigned char>::Min(), vtkTypeTraits<unsigned char>::Max(),
+                  what + ", unsigned char"))
+            {
+              return false;
+            }
+            filter->SetLabelScalarTypeToShort();
+            if (!::Compare(filter, image, useSeeds ? seeds.Get() : nullptr,
+                  vtkTypeTraits<short>::Min(), vtkTypeTraits<short>::Max(), what + ", short"))
+            {
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageConnectivityFilterLabeling(int, char*[])
+{
+  // the first image has more than 255 regions
+  const int extents[][6] = { { 3, 50, -5, 30, 2, 9 }, { -4, 9, 0, 7, 10, 12 },
+    { 5, 60, -3, 11, -2, -2 }, { 0, 0, -8, 30, 1, 9 }, { 2, 80, 7, 7, -2, -2 } };
+  int seed = 1;
+  for (const auto& extent : extents)
+  {
+    vtkSmartPointer<vtkImageData> image = ::MakeImage(extent, seed++);
+    std::string name = "Extent";
+    for (int e : extent)
+    {
+      name += " " + std::to_string(e);
+    }
+    if (!::TestImage(image, name))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // make sure that the label type overflow is covered
+  vtkSmartPointer<vtkImageData> image = ::MakeImage(extents[0], 1);
+  vtkNew<vtkImageConnectivityFilter> filter;
+  filter->SetScalarRange(6.0, 9.0);
+  filter->SetLabelScalarTypeToInt();
+  filter->SetInputData(image);
+  filter->Update();
+  if (filter->GetNumberOfExtractedRegions() <= 255)
+  {
+    std::cerr << "Expected more than 255 regions, got " << filter->GetNumberOfExtractedRegions()
+              << ".\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check the neighborhood filters that use van Herk / Gil-Werman extrema and
+// sliding histograms against a brute force computation, for ellipsoidal and
+// box kernels of odd and even sizes and for multiple components.
+
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageEllipsoidSource.h"
+#include "vtkImageMedian3D.h"
+#include "vtkImageRange3D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+enum class Operation
+{
+  Dilate,
+  Erode,
+  Range,
+  DilateErode,
+  Median
+};
+
+//------------------------------------------------------------------------------
+// The ellipsoid used by the filters, or the whole box.
+std::vector<bool> MakeKernel(const int kernelSize[3], bool box)
+{
+  vtkNew<vtkImageEllipsoidSource> ellipse;
+  ellipse->SetWholeExtent(0, kernelSize[0] - 1, 0, kernelSize[1] - 1, 0, kernelSize[2] - 1);
+  ellipse->SetCenter((kernelSize[0] - 1) * 0.5, (kernelSize[1] - 1) * 0.5,
+    (kernelSize[2] - 1) * 0.5);
+  ellipse->SetRadius(kernelSize[0] * 0.5, kernelSize[1] * 0.5, kernelSize[2] * 0.5);
+  ellipse->Update();
+  vtkDataArray* values = ellipse->GetOutput()->GetPointData()->GetScalars();
+  std::vector<bool> kernel(values->GetNumberOfTuples());
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    kernel[i] = box || values->GetComponent(i, 0) != 0;
+  }
+  return kernel;
+}
+
+//------------------------------------------------------------------------------
+double BruteForce(vtkImageData* image, Operation operation, const int kernelSize[3],
+  const std::vector<bool>& kernel, const int idx[3], int comp)
+{
+  const int* ext = image->GetExtent();
+  const double center = image->GetScalarComponentAsDouble(idx[0], idx[1], idx[2], comp);
+  std::vector<double> values = { center };
+  for (int k2 = 0; k2 < kernelSize[2]; ++k2)
+  {
+    for (int k1 = 0; k1 < kernelSize[1]; ++k1)
+    {
+      for (int k0 = 0; k0 < kernelSize[0]; ++k0)
+      {
+        const int hood[3] = { idx[0] + k0 - kernelSize[0] / 2, idx[1] + k1 - kernelSize[1] / 2,
+          idx[2] + k2 - kernelSize[2] / 2 };
+        if (kernel[(k2 * kernelSize[1] + k1) * kernelSize[0] + k0] && hood[0] >= ext[0] &&
+          hood[0] <= ext[1] && hood[1] >= ext[2] && hood[1] <= ext[3] && hood[2] >= ext[4] &&
+          hood[2] <= ext[5])
+        {
+          values.push_back(image->GetScalarComponentAsDouble(hood[0], hood[1], hood[2], comp));
+        }
+      }
+    }
+  }
+
+  const double maximum = *std::max_element(values.begin(), values.end());
+  const double minimum = *std::min_element(values.begin(), values.end());
+  switch (operation)
+  {
+    case Operation::Dilate:
+      return maximum;
+    case Operation::Erode:
+      return minimum;
+    case Operation::Range:
+      return maximum - minimum;
+    case Operation::DilateErode:
+      return (center == 1 && std::find(values.begin(), values.end(), 0) != values.end()) ? 0
+                                                                                          : center;
+    case Operation::Median:
+    default:
+    {
+      // The median of the box, without the duplicated center.
+      values.erase(values.begin());
+      std::sort(values.begin(), values.end());
+      const size_t n = values.size();
+      const short high = static_cast<short>(values[n / 2]);
+      const short low = static_cast<short>(values[(n - 1) / 2]);
+      return static_cast<short>(low + (high - low) / 2);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool Check(vtkImageData* image, vtkImageData* output, Operation operation,
+  const int kernelSize[3], bool box, const char* name)
+{
+  const std::vector<bool> kernel = ::MakeKernel(kernelSize, box);
+  const int* ext = image->GetExtent();
+  for (int comp = 0; comp < image->GetNumberOfScalarComponents(); ++comp)
+  {
+    for (int idx2 = ext[4]; idx2 <= ext[5]; ++idx2)
+    {
+      for (int idx1 = ext[2]; idx1 <= ext[3]; ++idx1)
+      {
+        for (int idx0 = ext[0]; idx0 <= ext[1]; ++idx0)
+        {
+          const int idx[3] = { idx0, idx1, idx2 };
+          const double expected = ::BruteForce(image, operation, kernelSize, kernel, idx, comp);
+          const double actual = output->GetScalarComponentAsDouble(idx0, idx1, idx2, comp);
+          if (actual != expected)
+          {
+            std::cerr << name << " with kernel size " << kernelSize[0] << " " << kernelSize[1]
+                      << " " << kernelSize[2] << (box ? " (box)" : "") << " gives " << actual
+                      << " instead of " << expected << " at " << idx0 << " " << idx1 << " "
+                      << idx2 << " for component " << comp << "\n";
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestImageNeighborhoodFilters(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkImageData> image;
+  image->SetExtent(-3, 17, 2, 15, 0, 8);
+  image->AllocateScalars(VTK_SHORT, 2);
+  vtkNew<vtkImageData> binary;
+  binary->SetExtent(image->GetExtent());
+  binary->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  short* imagePtr = static_cast<short*>(image->GetScalarPointer());
+  unsigned char* binaryPtr = static_cast<unsigned char*>(binary->GetScalarPointer());
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    imagePtr[2 * i] = static_cast<short>(random->GetNextRangeValue(-30, 30));
+    imagePtr[2 * i + 1] = static_cast<short>(random->GetNextRangeValue(-3000, 3000));
+    binaryPtr[i] = random->GetNextValue() < 0.97 ? 1 : 0;
+  }
+
+  const int kernelSizes[][3] = { { 1, 1, 1 }, { 3, 3, 3 }, { 7, 5, 3 }, { 1, 9, 1 }, { 8, 6, 4 },
+    { 11, 11, 5 } };
+  for (const auto& kernelSize : kernelSizes)
+  {
+    for (bool box : { false, true })
+    {
+      vtkNew<vtkImageContinuousDilate3D> dilate;
+      dilate->SetInputData(image);
+      dilate->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+      dilate->SetKernelShape(box ? vtkImageContinuousDilate3D::Box
+                                 : vtkImageContinuousDilate3D::Ellipsoid);
+      dilate->Update();
+      vtkNew<vtkImageContinuousErode3D> erode;
+      erode->SetInputData(image);
+      erode->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+      erode->SetKernelShape(
+        box ? vtkImageContinuousErode3D::Box : vtkImageContinuousErode3D::Ellipsoid);
+      erode->Update();
+      vtkNew<vtkImageRange3D> range;
+      range->SetInputData(image);
+      range->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+      range->SetKernelShape(box ? vtkImageRange3D::Box : vtkImageRange3D::Ellipsoid);
+      range->Update();
+      if (!::Check(image, dilate->GetOutput(), Operation::Dilate, kernelSize, box, "Dilate") ||
+        !::Check(image, erode->GetOutput(), Operation::Erode, kernelSize, box, "Erode") ||
+        !::Check(image, range->GetOutput(), Operation::Range, kernelSize, box, "Range"))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+
+    vtkNew<vtkImageDilateErode3D> dilateErode;
+    dilateErode->SetInputData(binary);
+    dilateErode->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+    dilateErode->SetDilateValue(0);
+    dilateErode->SetErodeValue(1);
+    dilateErode->Update();
+    if (!::Check(binary, dilateErode->GetOutput(), Operation::DilateErode, kernelSize, false,
+          "DilateErode"))
+    {
+      return EXIT_FAILURE;
+    }
+
+    for (int algorithm : { vtkImageMedian3D::Sort, vtkImageMedian3D::Histogram })
+    {
+      vtkNew<vtkImageMedian3D> median;
+      median->SetInputData(image);
+      median->SetKernelSize(kernelSize[0], kernelSize[1], kernelSize[2]);
+      median->SetAlgorithm(algorithm);
+      median->Update();
+      if (!::Check(image, median->GetOutput(), Operation::Median, kernelSize, true,
+            algorithm == vtkImageMedian3D::Sort ? "Median (sort)" : "Median (histogram)"))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -16,6 +16,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
@@ -23,6 +24,7 @@
 #include "vtkVersion.h"
 
 #include <algorithm>
+#include <array>
 #include <stack>
 #include <vector>
 
@@ -223,6 +225,11 @@ protected:
   // A functor to assist in comparing region sizes.
   struct CompareSize;
 
+  // Labels the runs of unmasked voxels by connectivity, in parallel.
+  class RunLabeler;
+
+  // The pruning methods below only modify regionInfo if outPtr is null.
+
   // Remove all but the largest region from the output image.
   template <class OT>
   static void PruneAllButLargest(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
@@ -249,7 +256,7 @@ protected:
   template <class OT>
   static void AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
     int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo, vtkIdType voxelCount,
-    vtkIdType regionId, int regionExtent[6], int extractionMode);
+    vtkIdType regionId, int regionExtent[6], int extractionMode, vtkIdType component = -1);
 
   // Fill the ExtractedRegionSizes and ExtractedRegionLabels arrays.
   static void GenerateRegionArrays(vtkImageConnectivityFilter* self,
@@ -352,9 +359,10 @@ private:
 // region struct: size and id
 struct vtkICF::Region
 {
-  Region(vtkIdType s, vtkIdType i, const int e[6])
+  Region(vtkIdType s, vtkIdType i, const int e[6], vtkIdType c = -1)
     : size(s)
     , id(i)
+    , component(c)
   {
     extent[0] = e[0];
     extent[1] = e[1];
@@ -366,6 +374,7 @@ struct vtkICF::Region
   Region()
     : size(0)
     , id(0)
+    , component(-1)
   {
     extent[0] = extent[1] = extent[2] = 0;
     extent[3] = extent[4] = extent[5] = 0;
@@ -373,6 +382,9 @@ struct vtkICF::Region
 
   vtkIdType size;
   vtkIdType id;
+  // For regions that are not painted in the output yet, the component
+  // index given by the RunLabeler.  For the painted ones, -1 - label.
+  vtkIdType component;
   int extent[6];
 };
 
@@ -419,6 +431,242 @@ public:
   }
 };
 
+//------------------------------------------------------------------------------
+// Connected component labeling of the voxels that are not set in the bitmask.
+// The voxels are grouped in runs along X, and the runs are merged with a
+// union-find where each root is the first run of its component.  The rows
+// are split in blocks that are merged in parallel, then the runs on the
+// boundaries of the blocks are merged serially.  Components are numbered in
+// the order of their first voxel, which is the order in which a raster scan
+// would find them.
+class vtkICF::RunLabeler
+{
+public:
+  void Execute(const unsigned char* maskPtr, const int maxIdx[3], bool computeExtents);
+
+  vtkIdType GetNumberOfComponents() const { return this->NumberOfComponents; }
+  vtkIdType GetNumberOfRows() const { return this->NumberOfRows; }
+
+  // The runs of a row are [RowOffsets[row], RowOffsets[row + 1]).
+  std::vector<vtkIdType> RowOffsets;
+  // First and last X index of each run.
+  std::vector<int> RunStart;
+  std::vector<int> RunEnd;
+  // Component index of each run.
+  std::vector<vtkIdType> RunComponent;
+  // Size and extent of each component.  The extent is reduced to the first
+  // voxel if computeExtents is false.
+  std::vector<vtkIdType> ComponentSize;
+  std::vector<int> ComponentExtent;
+
+protected:
+  vtkIdType Find(vtkIdType run)
+  {
+    vtkIdType* parent = this->RunComponent.data();
+    while (parent[run] != run)
+    {
+      parent[run] = parent[parent[run]];
+      run = parent[run];
+    }
+    return run;
+  }
+
+  // Merge the overlapping runs of two rows.
+  void MergeRows(vtkIdType row0, vtkIdType row1)
+  {
+    vtkIdType i = this->RowOffsets[row0];
+    vtkIdType j = this->RowOffsets[row1];
+    const vtkIdType iEnd = this->RowOffsets[row0 + 1];
+    const vtkIdType jEnd = this->RowOffsets[row1 + 1];
+    while (i < iEnd && j < jEnd)
+    {
+      if (this->RunEnd[i] < this->RunStart[j])
+      {
+        ++i;
+      }
+      else if (this->RunEnd[j] < this->RunStart[i])
+      {
+        ++j;
+      }
+      else
+      {
+        vtkIdType root0 = this->Find(i);
+        vtkIdType root1 = this->Find(j);
+        if (root0 != root1)
+        {
+          this->RunComponent[std::max(root0, root1)] = std::min(root0, root1);
+        }
+        if (this->RunEnd[i] < this->RunEnd[j])
+        {
+          ++i;
+        }
+        else
+        {
+          ++j;
+        }
+      }
+    }
+  }
+
+  vtkIdType NumberOfRows = 0;
+  vtkIdType NumberOfComponents = 0;
+};
+
+//------------------------------------------------------------------------------
+void vtkICF::RunLabeler::Execute(
+  const unsigned char* maskPtr, const int maxIdx[3], bool computeExtents)
+{
+  const int nx = maxIdx[0] + 1;
+  const vtkIdType ny = maxIdx[1] + 1;
+  this->NumberOfRows = ny * (maxIdx[2] + 1);
+  const vtkIdType numberOfRows = this->NumberOfRows;
+
+  // call a functor for each run of unset bits in a row
+  auto forEachRun = [maskPtr, nx](vtkIdType row, auto&& functor)
+  {
+    vtkIdType bitOffset = row * nx;
+    int start = -1;
+    for (int x = 0; x < nx; ++x, ++bitOffset)
+    {
+      const bool isSet = ((maskPtr[bitOffset >> 3] >> (bitOffset & 0x7)) & 1) != 0;
+      if (!isSet && start < 0)
+      {
+        start = x;
+      }
+      else if (isSet && start >= 0)
+      {
+        functor(start, x - 1);
+        start = -1;
+      }
+    }
+    if (start >= 0)
+    {
+      functor(start, nx - 1);
+    }
+  };
+
+  // count the runs of each row, then store them
+  this->RowOffsets.assign(numberOfRows + 1, 0);
+  vtkSMPTools::For(0, numberOfRows,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType row = begin; row < end; ++row)
+      {
+        vtkIdType count = 0;
+        forEachRun(row, [&count](int, int) { ++count; });
+        this->RowOffsets[row + 1] = count;
+      }
+    });
+  for (vtkIdType row = 0; row < numberOfRows; ++row)
+  {
+    this->RowOffsets[row + 1] += this->RowOffsets[row];
+  }
+
+  const vtkIdType numberOfRuns = this->RowOffsets[numberOfRows];
+  this->RunStart.resize(numberOfRuns);
+  this->RunEnd.resize(numberOfRuns);
+  this->RunComponent.resize(numberOfRuns);
+  vtkSMPTools::For(0, numberOfRows,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType row = begin; row < end; ++row)
+      {
+        vtkIdType run = this->RowOffsets[row];
+        forEachRun(row,
+          [&](int start, int last)
+          {
+            this->RunStart[run] = start;
+            this->RunEnd[run] = last;
+            this->RunComponent[run] = run;
+            ++run;
+          });
+      }
+    });
+
+  // merge the runs with the ones of the previous rows, within each block
+  const vtkIdType numberOfBlocks = std::max<vtkIdType>(
+    1, std::min<vtkIdType>(numberOfRows, 4 * vtkSMPTools::GetEstimatedNumberOfThreads()));
+  const vtkIdType blockSize = (numberOfRows + numberOfBlocks - 1) / numberOfBlocks;
+  vtkSMPTools::For(0, numberOfBlocks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const vtkIdType blockBegin = block * blockSize;
+        const vtkIdType blockEnd = std::min(blockBegin + blockSize, numberOfRows);
+        for (vtkIdType row = blockBegin; row < blockEnd; ++row)
+        {
+          if (row % ny != 0 && row - 1 >= blockBegin)
+          {
+            this->MergeRows(row - 1, row);
+          }
+          if (row >= ny && row - ny >= blockBegin)
+          {
+            this->MergeRows(row - ny, row);
+          }
+        }
+      }
+    });
+
+  // merge across the block boundaries
+  for (vtkIdType blockBegin = blockSize; blockBegin < numberOfRows; blockBegin += blockSize)
+  {
+    const vtkIdType blockEnd = std::min(blockBegin + std::min(blockSize, ny), numberOfRows);
+    for (vtkIdType row = blockBegin; row < blockEnd; ++row)
+    {
+      if (row % ny != 0 && row - 1 < blockBegin)
+      {
+        this->MergeRows(row - 1, row);
+      }
+      if (row >= ny && row - ny < blockBegin)
+      {
+        this->MergeRows(row - ny, row);
+      }
+    }
+  }
+
+  // roots always precede the runs of their component, so a single pass
+  // replaces the parents with component indices
+  vtkIdType* component = this->RunComponent.data();
+  vtkIdType numberOfComponents = 0;
+  for (vtkIdType run = 0; run < numberOfRuns; ++run)
+  {
+    component[run] = (component[run] == run ? numberOfComponents++ : component[component[run]]);
+  }
+  this->NumberOfComponents = numberOfComponents;
+
+  // compute the size and extent of each component
+  this->ComponentSize.assign(numberOfComponents, 0);
+  this->ComponentExtent.resize(6 * numberOfComponents);
+  std::vector<bool> found(numberOfComponents, false);
+  for (vtkIdType row = 0; row < numberOfRows; ++row)
+  {
+    const int y = static_cast<int>(row % ny);
+    const int z = static_cast<int>(row / ny);
+    for (vtkIdType run = this->RowOffsets[row]; run < this->RowOffsets[row + 1]; ++run)
+    {
+      const vtkIdType c = component[run];
+      int* ext = &this->ComponentExtent[6 * c];
+      this->ComponentSize[c] += this->RunEnd[run] - this->RunStart[run] + 1;
+      if (!found[c])
+      {
+        found[c] = true;
+        ext[0] = ext[1] = this->RunStart[run];
+        ext[2] = ext[3] = y;
+        ext[4] = ext[5] = z;
+      }
+      if (computeExtents)
+      {
+        ext[0] = std::min(ext[0], this->RunStart[run]);
+        ext[1] = std::max(ext[1], this->RunEnd[run]);
+        ext[2] = std::min(ext[2], y);
+        ext[3] = std::max(ext[3], y);
+        ext[5] = z;
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 bool vtkICF::IntersectExtents(const int extent1[6], const int extent2[6], int output[6])
 {
@@ -548,6 +796,10 @@ void vtkICF::PruneAllButLargest(vtkImageData* outData, OT* outPtr, vtkImageStenc
     OT t = std::distance(regionInfo.begin(), largest);
     regionInfo[1] = *largest;
     regionInfo.erase(regionInfo.begin() + 2, regionInfo.end());
+    if (!outPtr)
+    {
+      return;
+    }
 
     // remove all other regions from the output
     vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
@@ -594,6 +846,10 @@ void vtkICF::PruneSmallestRegion(vtkImageData* outData, OT* outPtr, vtkImageSten
     // get the index to the smallest value and remove it
     OT t = std::distance(regionInfo.begin(), smallest);
     regionInfo.erase(smallest);
+    if (!outPtr)
+    {
+      return;
+    }
 
     // remove the corresponding region from the output
     vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
@@ -650,6 +906,10 @@ void vtkICF::PruneBySize(vtkImageData* outData, OT* outPtr, vtkImageStencilData*
   {
     // resize regionInfo
     regionInfo.resize(m);
+    if (!outPtr)
+    {
+      return;
+    }
 
     // clip the extent with the output extent
     int outExt[6];
@@ -769,9 +1029,9 @@ vtkIdType vtkICF::Fill(OT* outPtr, vtkIdType outInc[3], int outLimits[6], unsign
 template <class OT>
 void vtkICF::AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
   int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo, vtkIdType voxelCount,
-  vtkIdType regionId, int regionExtent[6], int extractionMode)
+  vtkIdType regionId, int regionExtent[6], int extractionMode, vtkIdType component)
 {
-  regionInfo.push_back(vtkICF::Region(voxelCount, regionId, regionExtent));
+  regionInfo.push_back(vtkICF::Region(voxelCount, regionId, regionExtent, component));
   // check if the label value has reached its maximum, and if so,
   // remove some of the regions
   if (regionInfo.size() > static_cast<size_t>(vtkTypeTraits<OT>::Max()))
@@ -1195,72 +1455,105 @@ void vtkICF::SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* out
   outData->GetExtent(outExt);
 
   // Indexing will go from 0 to maxIdX, and the lower limit if "extent" will
-  // be subtracted from outExt.  If outExt was the same as extent, then nullptr
-  // is returned, else outExt is returned.
+  // be subtracted from outExt.
   int maxIdx[3];
-  int* outLimits = vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
+  vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
 
-  // for measuring extent of fill
-  int seedExtent[6];
-  // only set to non-null if extent generation was requested
-  int* fillExtent = (self->GetGenerateRegionExtents() ? seedExtent : nullptr);
+  // label all the voxels that were not colored by the seeds
+  vtkICF::RunLabeler labeler;
+  labeler.Execute(maskPtr, maxIdx, self->GetGenerateRegionExtents() != 0);
 
-  // keep track of position in bitmask
-  unsigned char* maskPtr1 = maskPtr;
-  unsigned char bit = 1;
+  // the regions that are already in the output keep track of their label
+  size_t numberOfPainted = regionInfo.size();
+  for (size_t i = 1; i < numberOfPainted; i++)
+  {
+    regionInfo[i].component = -1 - static_cast<vtkIdType>(i);
+  }
 
-  std::stack<vtkICF::Seed> seedStack;
+  // add the regions in the order a raster scan would find them, pruning
+  // only regionInfo since the output is written afterwards
+  for (vtkIdType c = 0; c < labeler.GetNumberOfComponents(); c++)
+  {
+    vtkIdType voxelCount = labeler.ComponentSize[c];
+    if (voxelCount == 1 && static_cast<OT>(regionInfo.size()) == vtkTypeTraits<OT>::Max())
+    {
+      // smallest region is definitely the one we would add
+      continue;
+    }
+    vtkICF::AddRegion<OT>(outData, nullptr, stencil, extent, sizeRange, regionInfo, voxelCount, -1,
+      &labeler.ComponentExtent[6 * c], extractionMode, c);
+  }
 
-  for (int zIdx = 0; zIdx <= maxIdx[2]; zIdx++)
+  // compute the final label of each component and of each painted region
+  std::vector<OT> componentLabels(labeler.GetNumberOfComponents(), 0);
+  std::vector<OT> paintedLabels(numberOfPainted, 0);
+  for (size_t i = 1; i < regionInfo.size(); i++)
   {
-    for (int yIdx = 0; yIdx <= maxIdx[1]; yIdx++)
+    vtkIdType c = regionInfo[i].component;
+    if (c >= 0)
+    {
+      componentLabels[c] = static_cast<OT>(i);
+    }
+    else
     {
-      for (int xIdx = 0; xIdx <= maxIdx[0]; xIdx++)
+      paintedLabels[-1 - c] = static_cast<OT>(i);
+    }
+  }
+  bool relabelPainted = false;
+  for (size_t i = 1; i < numberOfPainted; i++)
+  {
+    relabelPainted |= (paintedLabels[i] != static_cast<OT>(i));
+  }
+
+  // write the labels of the rows that are within the output extent
+  int limits[6];
+  if (!vtkICF::IntersectExtents(
+        outExt, std::array<int, 6>{ 0, maxIdx[0], 0, maxIdx[1], 0, maxIdx[2] }.data(), limits))
+  {
+    return;
+  }
+  const vtkIdType ny = maxIdx[1] + 1;
+  const vtkIdType numberOfRows = labeler.GetNumberOfRows();
+  vtkSMPTools::For(0, numberOfRows,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType row = begin; row < end; row++)
       {
-        // check the bitmask to see if voxel is already colored
-        unsigned char bitSet = *maskPtr1 & bit;
-        bit <<= 1;
-        if (bit == 0)
+        const int y = static_cast<int>(row % ny);
+        const int z = static_cast<int>(row / ny);
+        if (y < limits[2] || y > limits[3] || z < limits[4] || z > limits[5])
         {
-          maskPtr1++;
-          bit = 1;
+          continue;
         }
-
-        // if already colored, skip
-        if (bitSet != 0)
+        OT* rowPtr = outPtr + (y - outExt[2]) * outInc[1] + (z - outExt[4]) * outInc[2] -
+          outExt[0] * outInc[0];
+        if (relabelPainted)
         {
-          continue;
+          for (int x = limits[0]; x <= limits[1]; x++)
+          {
+            OT v = rowPtr[x * outInc[0]];
+            if (v != 0)
+            {
+              rowPtr[x * outInc[0]] = paintedLabels[v];
+            }
+          }
         }
-
-        // initialize the region extent from the seed position
-        seedExtent[0] = seedExtent[1] = xIdx;
-        seedExtent[2] = seedExtent[3] = yIdx;
-        seedExtent[4] = seedExtent[5] = zIdx;
-
-        OT label = static_cast<OT>(regionInfo.size());
-        seedStack.push(vtkICF::Seed(xIdx, yIdx, zIdx, label));
-
-        // find all voxels that are connected to the seed
-        vtkIdType voxelCount =
-          vtkICF::Fill(outPtr, outInc, outLimits, maskPtr, maxIdx, fillExtent, seedStack);
-
-        if (voxelCount != 0)
+        for (vtkIdType run = labeler.RowOffsets[row]; run < labeler.RowOffsets[row + 1]; run++)
         {
-          if (voxelCount == 1 && static_cast<OT>(regionInfo.size()) == vtkTypeTraits<OT>::Max())
+          OT label = componentLabels[labeler.RunComponent[run]];
+          if (label == 0)
           {
-            // smallest region is definitely the one we just added
-            vtkIdType outOffset = (xIdx * outInc[0] + yIdx * outInc[1] + zIdx * outInc[2]);
-            outPtr[outOffset] = 0;
+            continue;
           }
-          else
+          int x0 = std::max(labeler.RunStart[run], limits[0]);
+          int x1 = std::min(labeler.RunEnd[run], limits[1]);
+          for (int x = x0; x <= x1; x++)
           {
-            vtkICF::AddRegion(outData, outPtr, stencil, extent, sizeRange, regionInfo, voxelCount,
-              -1, seedExtent, extractionMode);
+            rowPtr[x * outInc[0]] = label;
           }
         }
       }
-    }
-  }
+    });
 }
 
 //------------------------------------------------------------------------------
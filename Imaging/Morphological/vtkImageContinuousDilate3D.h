@@ -5,8 +5,11 @@
  * @brief   Dilate implemented as a maximum.
  *
  * vtkImageContinuousDilate3D replaces a pixel with the maximum over
- * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
- * is done on that axis.
+ * an ellipsoidal or box neighborhood.  If KernelSize of an axis is 1, no
+ * processing is done on that axis.  The maximum is computed with the algorithm
+ * of van Herk and Gil-Werman, so the cost per voxel does not depend on the
+ * kernel size for a box kernel, and only grows with the kernel cross section
+ * for an ellipsoidal kernel.
  */
 
 #ifndef vtkImageContinuousDilate3D_h
@@ -37,11 +40,29 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the neighborhood, either the ellipsoid that fits in
+   * the kernel (the default) or the whole box of the kernel.
+   */
+  vtkSetClampMacro(KernelShape, int, Ellipsoid, Box);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
 protected:
   vtkImageContinuousDilate3D();
   ~vtkImageContinuousDilate3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -3,12 +3,13 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageNeighborhoodExtremum.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
-#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkImageDilateErode3D);
@@ -100,141 +101,66 @@ void vtkImageDilateErode3D::SetKernelSize(int size0, int size1, int size2)
 
 //------------------------------------------------------------------------------
 // This templated function executes the filter on any region,
-// whether it needs boundary checking or not.
-// If the filter needs to be faster, the function could be duplicated
-// for strictly center (no boundary) processing.
+// whether it needs boundary checking or not.  For each component, the
+// presence of the dilate value in the neighborhood is computed as an
+// extremum over the kernel, where the dilate value is better than any other.
 template <class T>
-void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mask,
-  vtkImageData* inData, T* inPtr, vtkImageData* outData, const int* outExt, T* outPtr, int id)
+void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self,
+  const std::vector<vtkImageNeighborhoodExtremum::Span>* spans, vtkImageData* inData, T* inPtr,
+  vtkImageData* outData, const int* outExt, T* outPtr, int id)
 {
-  // to compute the range
-  unsigned long count = 0;
-
   // Get information to march through data
-  vtkIdType inInc0, inInc1, inInc2;
-  inData->GetIncrements(inInc0, inInc1, inInc2);
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
   const int* inExt = inData->GetExtent();
-  int inImageMin0 = inExt[0];
-  int inImageMax0 = inExt[1];
-  int inImageMin1 = inExt[2];
-  int inImageMax1 = inExt[3];
-  int inImageMin2 = inExt[4];
-  int inImageMax2 = inExt[5];
   vtkIdType outInc0, outInc1, outInc2;
   outData->GetIncrements(outInc0, outInc1, outInc2);
-  int outMin0 = outExt[0];
-  int outMax0 = outExt[1];
-  int outMin1 = outExt[2];
-  int outMax1 = outExt[3];
-  int outMin2 = outExt[4];
-  int outMax2 = outExt[5];
   int numComps = outData->GetNumberOfScalarComponents();
 
   // Get ivars of this object (easier than making friends)
   T erodeValue = static_cast<T>(self->GetErodeValue());
   T dilateValue = static_cast<T>(self->GetDilateValue());
-  const int* kernelSize = self->GetKernelSize();
-  const int* kernelMiddle = self->GetKernelMiddle();
-  int hoodMin0 = -kernelMiddle[0];
-  int hoodMin1 = -kernelMiddle[1];
-  int hoodMin2 = -kernelMiddle[2];
-  int hoodMax0 = hoodMin0 + kernelSize[0] - 1;
-  int hoodMax1 = hoodMin1 + kernelSize[1] - 1;
-  int hoodMax2 = hoodMin2 + kernelSize[2] - 1;
-
-  // Setup mask info
-  const unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
-  vtkIdType maskInc0, maskInc1, maskInc2;
-  mask->GetIncrements(maskInc0, maskInc1, maskInc2);
-
-  // in and out should be marching through corresponding pixels.
-  inPtr = static_cast<T*>(inData->GetScalarPointer(outMin0, outMin1, outMin2));
-
-  unsigned long target =
-    static_cast<unsigned long>(numComps * (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) / 50.0);
-  target++;
+  T otherValue = static_cast<T>(dilateValue == 0 ? 1 : 0);
+  auto better = [dilateValue](const T& a, const T& b)
+  { return a == dilateValue && b != dilateValue; };
 
-  // loop through components
-  for (int outIdxC = 0; outIdxC < numComps; ++outIdxC)
+  std::vector<T> result;
+  for (int outIdxC = 0; !self->AbortExecute && outIdxC < numComps; ++outIdxC)
   {
-    // loop through pixels of output
-    T* outPtr2 = outPtr;
-    const T* inPtr2 = inPtr;
-    for (int outIdx2 = outMin2; outIdx2 <= outMax2; ++outIdx2)
+    vtkImageNeighborhoodExtremum::Compute(inPtr + outIdxC, inInc, inExt, outExt,
+      self->GetKernelSize(), self->GetKernelMiddle(), spans, better, otherValue, result);
+
+    // Dilate the pixels that have the erode value, copy the other pixels
+    const T* resultPtr = result.data();
+    T* outPtr2 = outPtr + outIdxC;
+    const T* inPtr2 = inPtr + outIdxC + (outExt[0] - inExt[0]) * inInc[0] +
+      (outExt[2] - inExt[2]) * inInc[1] + (outExt[4] - inExt[4]) * inInc[2];
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
     {
       T* outPtr1 = outPtr2;
       const T* inPtr1 = inPtr2;
-      for (int outIdx1 = outMin1; !self->AbortExecute && outIdx1 <= outMax1; ++outIdx1)
+      for (int outIdx1 = outExt[2]; outIdx1 <= outExt[3]; ++outIdx1)
       {
-        if (!id)
-        {
-          if (!(count % target))
-          {
-            self->UpdateProgress(count / (50.0 * target));
-          }
-          count++;
-        }
-
         T* outPtr0 = outPtr1;
         const T* inPtr0 = inPtr1;
-        for (int outIdx0 = outMin0; outIdx0 <= outMax0; ++outIdx0)
+        for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
         {
-          // Default behavior (copy input pixel)
-          *outPtr0 = *inPtr0;
-          if (*inPtr0 == erodeValue)
-          {
-            // loop through neighborhood pixels
-            // as sort of a hack to handle boundaries,
-            // input pointer will be marching through data that does not exist.
-            int hoodMinClamp2 = std::max(hoodMin2, inImageMin2 - outIdx2);
-            int hoodMaxClamp2 = std::min(hoodMax2, inImageMax2 - outIdx2);
-            const T* hoodPtr2 = inPtr0 - kernelMiddle[0] * inInc0 - kernelMiddle[1] * inInc1 -
-              kernelMiddle[2] * inInc2 + (hoodMinClamp2 - hoodMin2) * inInc2;
-            const unsigned char* maskPtr2 = maskPtr + (hoodMinClamp2 - hoodMin2) * maskInc2;
-            for (int hoodIdx2 = hoodMinClamp2; hoodIdx2 <= hoodMaxClamp2; ++hoodIdx2)
-            {
-              int hoodMinClamp1 = std::max(hoodMin1, inImageMin1 - outIdx1);
-              int hoodMaxClamp1 = std::min(hoodMax1, inImageMax1 - outIdx1);
-              const T* hoodPtr1 = hoodPtr2 + (hoodMinClamp1 - hoodMin1) * inInc1;
-              const unsigned char* maskPtr1 = maskPtr2 + (hoodMinClamp1 - hoodMin1) * maskInc1;
-              for (int hoodIdx1 = hoodMinClamp1; hoodIdx1 <= hoodMaxClamp1; ++hoodIdx1)
-              {
-                int hoodMinClamp0 = std::max(hoodMin0, inImageMin0 - outIdx0);
-                int hoodMaxClamp0 = std::min(hoodMax0, inImageMax0 - outIdx0);
-                const T* hoodPtr0 = hoodPtr1 + (hoodMinClamp0 - hoodMin0) * inInc0;
-                const unsigned char* maskPtr0 = maskPtr1 + (hoodMinClamp0 - hoodMin0) * maskInc0;
-                for (int hoodIdx0 = hoodMinClamp0; hoodIdx0 <= hoodMaxClamp0; ++hoodIdx0)
-                {
-                  if (*maskPtr0 != 0)
-                  {
-                    if (*hoodPtr0 == dilateValue)
-                    {
-                      *outPtr0 = dilateValue;
-                    }
-                  }
-
-                  hoodPtr0 += inInc0;
-                  maskPtr0 += maskInc0;
-                }
-                hoodPtr1 += inInc1;
-                maskPtr1 += maskInc1;
-              }
-              hoodPtr2 += inInc2;
-              maskPtr2 += maskInc2;
-            }
-          }
-
-          inPtr0 += inInc0;
+          *outPtr0 = (*inPtr0 == erodeValue && *resultPtr == dilateValue) ? dilateValue : *inPtr0;
+          ++resultPtr;
+          inPtr0 += inInc[0];
           outPtr0 += outInc0;
         }
-        inPtr1 += inInc1;
+        inPtr1 += inInc[1];
         outPtr1 += outInc1;
       }
-      inPtr2 += inInc2;
+      inPtr2 += inInc[2];
       outPtr2 += outInc2;
     }
-    ++inPtr;
-    ++outPtr;
+
+    if (!id)
+    {
+      self->UpdateProgress(static_cast<double>(outIdxC + 1) / numComps);
+    }
   }
 }
 
@@ -243,14 +169,10 @@ void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mas
 // templated function for the input and output Data types.
 // It handles image boundaries, so the image does not shrink.
 void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* vtkNotUsed(outputVector),
+  vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* vtkNotUsed(outputVector),
   vtkImageData*** inData, vtkImageData** outData, VTK_FUTURE_CONST int outExt[6], int id)
 {
-  int inExt[6], wholeExt[6];
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExt);
-  this->InternalRequestUpdateExtent(inExt, outExt, wholeExt);
-  void* inPtr = inData[0][0]->GetScalarPointerForExtent(inExt);
+  void* inPtr = inData[0][0]->GetScalarPointer();
   void* outPtr = outData[0]->GetScalarPointerForExtent(outExt);
   vtkImageData* mask;
 
@@ -271,9 +193,15 @@ void vtkImageDilateErode3D::ThreadedRequestData(vtkInformation* vtkNotUsed(reque
     return;
   }
 
+  // The ellipsoid is decomposed into spans along X, unless it fills the box.
+  std::vector<vtkImageNeighborhoodExtremum::Span> spans;
+  vtkImageNeighborhoodExtremum::ComputeSpans(mask, this->KernelMiddle, spans);
+  const std::vector<vtkImageNeighborhoodExtremum::Span>* spansPtr =
+    vtkImageNeighborhoodExtremum::IsBox(spans, this->KernelSize) ? nullptr : &spans;
+
   switch (inData[0][0]->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageDilateErode3DExecute(this, mask, inData[0][0],
+    vtkTemplateMacro(vtkImageDilateErode3DExecute(this, spansPtr, inData[0][0],
       static_cast<VTK_TT*>(inPtr), outData[0], outExt, static_cast<VTK_TT*>(outPtr), id));
     default:
       vtkErrorMacro(<< "Execute: Unknown ScalarType");
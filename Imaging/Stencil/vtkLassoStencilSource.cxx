@@ -11,12 +11,15 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkLassoStencilSource);
@@ -449,6 +452,98 @@ static int vtkLassoStencilSourceExecute(vtkPoints* points, vtkImageStencilData*
   return result;
 }
 
+//------------------------------------------------------------------------------
+// Rasterize a range of slices, each run of slices that share the same points
+// is rasterized once and copied to the other slices of the run.  Each thread
+// uses its own raster and splines, and the rows of the stencil that are
+// filled for different slices are independent when the slices are stacked
+// along y or z.
+class vtkLassoStencilSourceWorker
+{
+public:
+  vtkLassoStencilSourceWorker(vtkLassoStencilSource* self, vtkImageStencilData* data,
+    const std::vector<vtkPoints*>& slicePoints, int extent[6], double origin[3],
+    double spacing[3], int shape, int xj, int yj, int zj, vtkSpline* xspline, vtkSpline* yspline)
+    : Self(self)
+    , Data(data)
+    , SlicePoints(slicePoints)
+    , Extent(extent)
+    , Origin(origin)
+    , Spacing(spacing)
+    , Shape(shape)
+    , XJ(xj)
+    , YJ(yj)
+    , ZJ(zj)
+    , SplineX(xspline)
+    , SplineY(yspline)
+    , Result(1)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    int zmin = this->Extent[2 * this->ZJ];
+    int zmax = this->Extent[2 * this->ZJ + 1];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    vtkImageStencilRaster raster(&this->Extent[2 * this->YJ]);
+    raster.SetTolerance(VTK_STENCIL_TOL);
+
+    vtkSmartPointer<vtkSpline> xspline =
+      vtkSmartPointer<vtkSpline>::Take(this->SplineX->NewInstance());
+    vtkSmartPointer<vtkSpline> yspline =
+      vtkSmartPointer<vtkSpline>::Take(this->SplineY->NewInstance());
+    xspline->DeepCopy(this->SplineX);
+    yspline->DeepCopy(this->SplineY);
+
+    int slabExtent[6];
+    std::copy(this->Extent, this->Extent + 6, slabExtent);
+
+    int i = begin;
+    while (i < end && this->Result)
+    {
+      if (isFirst)
+      {
+        this->Self->UpdateProgress((i - zmin) * 1.0 / (zmax - zmin + 1));
+      }
+
+      vtkPoints* points = this->SlicePoints[i - zmin];
+      int j = i + 1;
+      while (j < end && this->SlicePoints[j - zmin] == points)
+      {
+        j++;
+      }
+
+      slabExtent[2 * this->ZJ] = i;
+      slabExtent[2 * this->ZJ + 1] = j - 1;
+      if (!vtkLassoStencilSourceExecute(points, this->Data, &raster, slabExtent, this->Origin,
+            this->Spacing, this->Shape, this->XJ, this->YJ, xspline, yspline))
+      {
+        this->Result = 0;
+      }
+
+      i = j;
+    }
+  }
+
+  int GetResult() { return this->Result; }
+
+private:
+  vtkLassoStencilSource* Self;
+  vtkImageStencilData* Data;
+  const std::vector<vtkPoints*>& SlicePoints;
+  int* Extent;
+  double* Origin;
+  double* Spacing;
+  int Shape;
+  int XJ;
+  int YJ;
+  int ZJ;
+  vtkSpline* SplineX;
+  vtkSpline* SplineY;
+  std::atomic<int> Result;
+};
+
 //------------------------------------------------------------------------------
 int vtkLassoStencilSource::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -456,7 +551,6 @@ int vtkLassoStencilSource::RequestData(
   int extent[6];
   double origin[3];
   double spacing[3];
-  int result = 1;
 
   this->Superclass::RequestData(request, inputVector, outputVector);
 
@@ -468,14 +562,6 @@ int vtkLassoStencilSource::RequestData(
   outInfo->Get(vtkDataObject::ORIGIN(), origin);
   outInfo->Get(vtkDataObject::SPACING(), spacing);
 
-  int slabExtent[6];
-  slabExtent[0] = extent[0];
-  slabExtent[1] = extent[1];
-  slabExtent[2] = extent[2];
-  slabExtent[3] = extent[3];
-  slabExtent[4] = extent[4];
-  slabExtent[5] = extent[5];
-
   int xj = 0;
   int yj = 1;
   int zj = 2;
@@ -493,59 +579,48 @@ int vtkLassoStencilSource::RequestData(
     zj = 1;
   }
 
-  vtkImageStencilRaster raster(&extent[2 * yj]);
-  raster.SetTolerance(VTK_STENCIL_TOL);
-
   int zmin = extent[2 * zj];
   int zmax = extent[2 * zj + 1];
+  if (zmin > zmax)
+  {
+    return 1;
+  }
+
+  // the points for each slice, the bounds of the points are computed
+  // here since computing them is not thread safe
+  std::vector<vtkPoints*> slicePoints(static_cast<size_t>(zmax - zmin + 1), this->Points);
+  if (this->Points)
+  {
+    this->Points->ComputeBounds();
+  }
 
   vtkLSSPointMap::iterator iter = this->PointMap->lower_bound(zmin);
   vtkLSSPointMap::iterator maxiter = this->PointMap->upper_bound(zmax);
-
-  while (iter != maxiter && result != 0)
+  for (; iter != maxiter; ++iter)
   {
-    this->UpdateProgress((slabExtent[2 * zj] - zmin) * 1.0 / (zmax - zmin + 1));
-
-    int i = iter->first;
-    vtkPoints* points = iter->second;
-
-    // fill in the slices with no SlicePoints
-    if (this->Points && i > slabExtent[2 * zj])
-    {
-      slabExtent[2 * zj + 1] = i - 1;
-
-      result = vtkLassoStencilSourceExecute(this->Points, data, &raster, slabExtent, origin,
-        spacing, this->Shape, xj, yj, this->SplineX, this->SplineY);
-    }
-
-    // do the slice with its SlicePoints
-    if (result)
-    {
-      slabExtent[2 * zj] = i;
-      slabExtent[2 * zj + 1] = i;
-
-      result = vtkLassoStencilSourceExecute(points, data, &raster, slabExtent, origin, spacing,
-        this->Shape, xj, yj, this->SplineX, this->SplineY);
-
-      slabExtent[2 * zj] = slabExtent[2 * zj + 1] + 1;
-    }
-
-    ++iter;
+    slicePoints[iter->first - zmin] = iter->second;
+    iter->second->ComputeBounds();
   }
 
-  this->UpdateProgress((slabExtent[2 * zj] - zmin) * 1.0 / (zmax - zmin + 1));
+  vtkLassoStencilSourceWorker worker(this, data, slicePoints, extent, origin, spacing,
+    this->Shape, xj, yj, zj, this->SplineX, this->SplineY);
 
-  // fill in the rest
-  if (result && slabExtent[2 * zj] <= zmax)
+  // the slices are rasterized in parallel, unless they are stacked along x
+  // since each row of the stencil then spans all of the slices
+  if (zj != 0)
   {
-    slabExtent[2 * zj + 1] = zmax;
+    vtkSMPTools::For(zmin, zmax + 1, worker);
+  }
+  else
+  {
+    worker(zmin, zmax + 1);
+  }
 
-    result = vtkLassoStencilSourceExecute(this->Points, data, &raster, slabExtent, origin, spacing,
-      this->Shape, xj, yj, this->SplineX, this->SplineY);
+  // pack the rows of the stencil into a single block
+  data->Squeeze();
 
-    this->UpdateProgress(1.0);
-  }
+  this->UpdateProgress(1.0);
 
-  return result;
+  return worker.GetResult();
 }
 VTK_ABI_NAMESPACE_END
@@ -776,6 +776,9 @@ int vtkPolyDataToImageStencil::RequestData(
     this->ThreadedExecute(data, storage, extent, 0);
   }
 
+  // Pack the rows of the stencil into a single block
+  data->Squeeze();
+
   return 1;
 }
 
@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that data objects marshaled into binary metadata and bulk arrays by
+// vtkCommunicator come back the same once unmarshaled from copies of the
+// arrays, by comparing their legacy serializations, for each supported type
+// and for composite data sets made of them.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
+#include "vtkDataAssembly.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Marshal and unmarshal an object, with copies of the arrays standing for the
+// arrays received from another process, which only hold the values.
+vtkSmartPointer<vtkDataObject> RoundTrip(vtkDataObject* object)
+{
+  vtkMultiProcessStream metadata;
+  std::vector<vtkSmartPointer<vtkDataArray>> arrays;
+  if (!vtkCommunicator::MarshalDataObject(object, metadata, arrays))
+  {
+    std::cerr << "Could not marshal a " << object->GetClassName() << "\n";
+    return nullptr;
+  }
+  std::vector<unsigned char> raw;
+  metadata.GetRawData(raw);
+  vtkMultiProcessStream received;
+  received.SetRawData(raw);
+  std::vector<vtkSmartPointer<vtkDataArray>> copies;
+  for (vtkDataArray* array : arrays)
+  {
+    auto copy = vtk::TakeSmartPointer(array->NewInstance());
+    copy->SetNumberOfComponents(array->GetNumberOfComponents());
+    copy->SetNumberOfTuples(array->GetNumberOfTuples());
+    if (array->GetNumberOfValues() > 0)
+    {
+      // NOLINTNEXTLINE(bugprone-unsafe-functions)
+      std::memcpy(copy->GetVoidPointer(0), array->GetVoidPointer(0),
+        array->GetNumberOfValues() * array->GetDataTypeSize());
+    }
+    copies.push_back(copy);
+  }
+  return vtkCommunicator::UnMarshalDataObject(received, copies);
+}
+
+//------------------------------------------------------------------------------
+bool SameLegacy(vtkDataObject* expected, vtkDataObject* actual)
+{
+  vtkNew<vtkCharArray> a;
+  vtkNew<vtkCharArray> b;
+  if (!vtkCommunicator::MarshalDataObject(expected, a) ||
+    !vtkCommunicator::MarshalDataObject(actual, b))
+  {
+    std::cerr << "Could not marshal a " << expected->GetClassName() << " to compare it\n";
+    return false;
+  }
+  if (a->GetNumberOfValues() != b->GetNumberOfValues() ||
+    std::memcmp(a->GetPointer(0), b->GetPointer(0), a->GetNumberOfValues()) != 0)
+  {
+    std::cerr << "The unmarshaled " << expected->GetClassName() << " differs\n";
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool Check(vtkDataObject* object)
+{
+  vtkSmartPointer<vtkDataObject> result = ::RoundTrip(object);
+  if (!result || result->GetDataObjectType() != object->GetDataObjectType())
+  {
+    std::cerr << "No " << object->GetClassName() << " after unmarshaling\n";
+    return false;
+  }
+  return ::SameLegacy(object, result);
+}
+
+//------------------------------------------------------------------------------
+// Point data with attributes, component names and strings, and field data.
+void AddArrays(vtkDataSet* dataSet)
+{
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetComponentName(0, "u");
+  vectors->SetComponentName(2, "w");
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("labels");
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfPoints(); i++)
+  {
+    scalars->InsertNextValue(0.5f * i);
+    vectors->InsertNextTuple3(i, -i, 2.0 * i);
+    labels->InsertNextValue("point " + std::to_string(i));
+  }
+  dataSet->GetPointData()->SetScalars(scalars);
+  dataSet->GetPointData()->SetVectors(vectors);
+  dataSet->GetPointData()->AddArray(labels);
+
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); i++)
+  {
+    ids->InsertNextValue(static_cast<int>(3 * i));
+  }
+  dataSet->GetCellData()->AddArray(ids);
+
+  vtkNew<vtkStringArray> comment;
+  comment->SetName("comment");
+  comment->InsertNextValue("marshaled");
+  dataSet->GetFieldData()->AddArray(comment);
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> NewPoints(vtkIdType numPoints)
+{
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  for (vtkIdType i = 0; i < numPoints; i++)
+  {
+    points->InsertNextPoint(0.1 * i, 0.2 * (i % 5), 0.3 * (i % 7));
+  }
+  return points;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> NewImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-1, 3, 0, 2, 4, 5);
+  image->SetOrigin(0.5, 1.0, -2.0);
+  image->SetSpacing(0.1, 0.2, 0.3);
+  ::AddArrays(image);
+  return image;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> NewPolyData()
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(::NewPoints(12));
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell({ 0 });
+  verts->InsertNextCell({ 1, 2 });
+  vtkNew<vtkCellArray> polys;
+  polys->InsertNextCell({ 0, 1, 2 });
+  polys->InsertNextCell({ 3, 4, 5, 6 });
+  polys->InsertNextCell({ 7, 8, 9, 10, 11 });
+  // Triangles, which are stored without offsets.
+  vtkNew<vtkCellArray> strips;
+  strips->UseFixedSize32BitStorage(3);
+  strips->InsertNextCell({ 2, 3, 4 });
+  strips->InsertNextCell({ 5, 6, 7 });
+  polyData->SetVerts(verts);
+  polyData->SetPolys(polys);
+  polyData->SetStrips(strips);
+  ::AddArrays(polyData);
+  return polyData;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> NewUnstructuredGrid()
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(::NewPoints(8));
+  const vtkIdType tetra[4] = { 0, 1, 2, 3 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetra);
+  // A polyhedron, with its faces.
+  const vtkIdType faces[] = { 4, 3, 4, 5, 6, 3, 4, 5, 7, 3, 5, 6, 7, 3, 6, 4, 7 };
+  const vtkIdType polyhedron[4] = { 4, 5, 6, 7 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 4, polyhedron, 4, faces + 1);
+  const vtkIdType line[2] = { 1, 6 };
+  grid->InsertNextCell(VTK_LINE, 2, line);
+  ::AddArrays(grid);
+  return grid;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestDataObjectMarshaling(int, char*[])
+{
+  vtkSmartPointer<vtkImageData> image = ::NewImage();
+  if (!::Check(image))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkImageData> imageCopy = vtkImageData::SafeDownCast(::RoundTrip(image));
+  vtkDataArray* vectors = imageCopy->GetPointData()->GetVectors();
+  if (imageCopy->GetOrigin()[0] != 0.5 || !vectors ||
+    std::string(vectors->GetComponentName(2)) != "w" || vectors->GetComponentName(1) != nullptr)
+  {
+    std::cerr << "The image was not unmarshaled\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkRectilinearGrid> rectilinear;
+  rectilinear->SetDimensions(3, 2, 1);
+  vtkNew<vtkDoubleArray> x;
+  vtkNew<vtkFloatArray> y;
+  vtkNew<vtkDoubleArray> z;
+  x->InsertNextValue(0.0);
+  x->InsertNextValue(0.5);
+  x->InsertNextValue(2.0);
+  y->InsertNextValue(-1.0f);
+  y->InsertNextValue(1.0f);
+  z->InsertNextValue(3.0);
+  rectilinear->SetXCoordinates(x);
+  rectilinear->SetYCoordinates(y);
+  rectilinear->SetZCoordinates(z);
+  ::AddArrays(rectilinear);
+  if (!::Check(rectilinear))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkStructuredGrid> structured;
+  structured->SetDimensions(2, 3, 2);
+  structured->SetPoints(::NewPoints(12));
+  ::AddArrays(structured);
+  if (!::Check(structured))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkPolyData> polyData = ::NewPolyData();
+  if (!::Check(polyData))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkPolyData> polyDataCopy = vtkPolyData::SafeDownCast(::RoundTrip(polyData));
+  if (!polyDataCopy->GetStrips()->IsStorageFixedSize() ||
+    polyDataCopy->GetStrips()->GetNumberOfCells() != 2 || polyDataCopy->GetLines() == nullptr)
+  {
+    std::cerr << "The cells of the polydata were not unmarshaled\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = ::NewUnstructuredGrid();
+  if (!::Check(grid))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> gridCopy =
+    vtkUnstructuredGrid::SafeDownCast(::RoundTrip(grid));
+  if (gridCopy->GetCellType(1) != VTK_POLYHEDRON || gridCopy->GetPolyhedronFaces() == nullptr ||
+    gridCopy->GetPolyhedronFaces()->GetNumberOfCells() != 4)
+  {
+    std::cerr << "The polyhedron was not unmarshaled\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIdTypeArray> column;
+  column->SetName("column");
+  vtkNew<vtkStringArray> names;
+  names->SetName("names");
+  for (int i = 0; i < 5; i++)
+  {
+    column->InsertNextValue(i * i);
+    names->InsertNextValue(std::string(i, 'a'));
+  }
+  table->AddColumn(column);
+  table->AddColumn(names);
+  if (!::Check(table))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Composite data sets keep their structure and the names of their blocks.
+  vtkNew<vtkMultiBlockDataSet> inner;
+  inner->SetBlock(0, polyData);
+  inner->SetBlock(2, grid);
+  inner->GetMetaData(2u)->Set(vtkCompositeDataSet::NAME(), "grid");
+  vtkNew<vtkMultiBlockDataSet> multiBlock;
+  multiBlock->SetBlock(0, image);
+  multiBlock->SetBlock(1, inner);
+  multiBlock->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "inner");
+  if (!::Check(multiBlock))
+  {
+    return EXIT_FAILURE;
+  }
+  vtkSmartPointer<vtkMultiBlockDataSet> multiBlockCopy =
+    vtkMultiBlockDataSet::SafeDownCast(::RoundTrip(multiBlock));
+  vtkMultiBlockDataSet* innerCopy = vtkMultiBlockDataSet::SafeDownCast(multiBlockCopy->GetBlock(1));
+  if (!innerCopy || innerCopy->GetNumberOfBlocks() != 3 || innerCopy->GetBlock(1) != nullptr ||
+    !multiBlockCopy->HasMetaData(1u) ||
+    std::string(multiBlockCopy->GetMetaData(1u)->Get(vtkCompositeDataSet::NAME())) != "inner" ||
+    std::string(innerCopy->GetMetaData(2u)->Get(vtkCompositeDataSet::NAME())) != "grid")
+  {
+    std::cerr << "The structure of the multiblock data set was not unmarshaled\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPartitionedDataSetCollection> collection;
+  collection->SetNumberOfPartitionedDataSets(2);
+  collection->SetPartition(0, 0, polyData);
+  collection->SetPartition(0, 1, grid);
+  collection->SetPartition(1, 0, image);
+  collection->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "images");
+  vtkNew<vtkDataAssembly> assembly;
+  assembly->SetRootNodeName("root");
+  assembly->AddDataSetIndex(assembly->AddNode("meshes"), 0);
+  collection->SetDataAssembly(assembly);
+  vtkSmartPointer<vtkPartitionedDataSetCollection> collectionCopy =
+    vtkPartitionedDataSetCollection::SafeDownCast(::RoundTrip(collection));
+  if (!collectionCopy || collectionCopy->GetNumberOfPartitionedDataSets() != 2 ||
+    collectionCopy->GetNumberOfPartitions(0) != 2 ||
+    std::string(collectionCopy->GetMetaData(1u)->Get(vtkCompositeDataSet::NAME())) != "images" ||
+    !collectionCopy->GetDataAssembly() ||
+    collectionCopy->GetDataAssembly()->GetDataSetIndices(1) != std::vector<unsigned int>{ 0 })
+  {
+    std::cerr << "The partitioned data set collection was not unmarshaled\n";
+    return EXIT_FAILURE;
+  }
+  if (!::SameLegacy(polyData, collectionCopy->GetPartition(0, 0)) ||
+    !::SameLegacy(grid, collectionCopy->GetPartition(0, 1)) ||
+    !::SameLegacy(image, collectionCopy->GetPartition(1, 0)))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Arrays that do not match the metadata are rejected.
+  vtkMultiProcessStream metadata;
+  std::vector<vtkSmartPointer<vtkDataArray>> arrays;
+  vtkCommunicator::MarshalDataObject(polyData, metadata, arrays);
+  arrays.pop_back();
+  if (vtkCommunicator::UnMarshalDataObject(metadata, arrays) != nullptr)
+  {
+    std::cerr << "Missing arrays were not detected\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
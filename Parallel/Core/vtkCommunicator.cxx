@@ -4,8 +4,11 @@
 #include "vtkCommunicator.h"
 
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataAssembly.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
@@ -13,11 +16,20 @@
 #include "vtkGenericDataObjectWriter.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
 #include "vtkStringFormatter.h"
 #include "vtkStringScanner.h"
 #include "vtkStructuredGrid.h"
@@ -25,10 +37,13 @@
 #include "vtkTypeTraits.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedLongArray.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <string>
+#include <utility>
 #include <vector>
 
 #define EXTENT_HEADER_SIZE 128
@@ -87,6 +102,712 @@ STANDARD_OPERATION_DEFINITION(LogicalXor, (!A[i] && B[i]) || (A[i] && !B[i]));
 STANDARD_OPERATION_FLOAT_OVERRIDE(BitwiseXor);
 STANDARD_OPERATION_DEFINITION(BitwiseXor, A[i] ^ B[i]);
 
+//------------------------------------------------------------------------------
+// Binary marshaling of data objects. The metadata starts with the types and
+// sizes of the bulk arrays, so that the receiver can allocate them before
+// they arrive, followed by the structure of the data object. The structure
+// refers to the bulk arrays in the order in which they are listed.
+namespace
+{
+constexpr int VTK_COMMUNICATOR_MARSHAL_VERSION = 1;
+
+// The kinds of arrays in field data and attributes.
+enum vtkCommunicatorArrayKind
+{
+  BULK_ARRAY = 0,
+  STRING_ARRAY = 1
+};
+
+//------------------------------------------------------------------------------
+class vtkCommunicatorMarshaler
+{
+public:
+  std::vector<vtkSmartPointer<vtkDataArray>> Arrays;
+
+  bool WriteObject(vtkDataObject* object, vtkMultiProcessStream& stream);
+
+private:
+  void WriteBulkArray(vtkDataArray* array, vtkMultiProcessStream& stream);
+  bool WriteArray(vtkAbstractArray* array, vtkMultiProcessStream& stream);
+  bool WriteFieldData(vtkFieldData* fieldData, vtkMultiProcessStream& stream);
+  void WritePoints(vtkPoints* points, vtkMultiProcessStream& stream);
+  void WriteCells(vtkCellArray* cells, vtkMultiProcessStream& stream);
+  bool WriteStructure(vtkDataObject* object, vtkMultiProcessStream& stream);
+
+  template <class T>
+  void WriteName(T* composite, unsigned int index, vtkMultiProcessStream& stream)
+  {
+    const char* name = nullptr;
+    if (composite->HasMetaData(index))
+    {
+      name = composite->GetMetaData(index)->Get(vtkCompositeDataSet::NAME());
+    }
+    stream << (name != nullptr);
+    if (name)
+    {
+      stream << name;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// An optional bulk array, which is converted to the standard memory layout
+// only if needed.
+void vtkCommunicatorMarshaler::WriteBulkArray(vtkDataArray* array, vtkMultiProcessStream& stream)
+{
+  stream << (array != nullptr);
+  if (array)
+  {
+    this->Arrays.push_back(array->ToAOSDataArray());
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkCommunicatorMarshaler::WriteArray(vtkAbstractArray* array, vtkMultiProcessStream& stream)
+{
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  vtkStringArray* stringArray = vtkArrayDownCast<vtkStringArray>(array);
+  if (dataArray && dataArray->GetDataType() != VTK_BIT)
+  {
+    stream << static_cast<int>(BULK_ARRAY);
+    this->Arrays.push_back(dataArray->ToAOSDataArray());
+  }
+  else if (stringArray)
+  {
+    stream << static_cast<int>(STRING_ARRAY) << stringArray->GetNumberOfComponents()
+           << stringArray->GetNumberOfValues();
+    for (vtkIdType i = 0; i < stringArray->GetNumberOfValues(); i++)
+    {
+      stream << stringArray->GetValue(i);
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  const char* name = array->GetName();
+  stream << (name != nullptr);
+  if (name)
+  {
+    stream << name;
+  }
+  bool hasComponentNames = array->HasAComponentName();
+  stream << hasComponentNames;
+  for (int c = 0; hasComponentNames && c < array->GetNumberOfComponents(); c++)
+  {
+    const char* componentName = array->GetComponentName(c);
+    stream << (componentName != nullptr);
+    if (componentName)
+    {
+      stream << componentName;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Write the arrays of field data, and which attribute they are if the field
+// data is a vtkDataSetAttributes.
+bool vtkCommunicatorMarshaler::WriteFieldData(
+  vtkFieldData* fieldData, vtkMultiProcessStream& stream)
+{
+  vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  int numArrays = (fieldData ? fieldData->GetNumberOfArrays() : 0);
+  stream << numArrays;
+  for (int i = 0; i < numArrays; i++)
+  {
+    if (!this->WriteArray(fieldData->GetAbstractArray(i), stream))
+    {
+      return false;
+    }
+    stream << (attributes ? attributes->IsArrayAnAttribute(i) : -1);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkCommunicatorMarshaler::WritePoints(vtkPoints* points, vtkMultiProcessStream& stream)
+{
+  this->WriteBulkArray(points ? points->GetData() : nullptr, stream);
+}
+
+//------------------------------------------------------------------------------
+// Cells of the same size are written without their offsets.
+void vtkCommunicatorMarshaler::WriteCells(vtkCellArray* cells, vtkMultiProcessStream& stream)
+{
+  stream << (cells != nullptr);
+  if (!cells)
+  {
+    return;
+  }
+  vtkIdType cellSize = 0;
+  if ((cells->IsStorageFixedSize32Bit() || cells->IsStorageFixedSize64Bit()) &&
+    cells->GetNumberOfCells() > 0)
+  {
+    cellSize = cells->GetCellSize(0);
+  }
+  stream << cellSize;
+  if (cellSize == 0)
+  {
+    this->WriteBulkArray(cells->GetOffsetsArray(), stream);
+  }
+  this->WriteBulkArray(cells->GetConnectivityArray(), stream);
+}
+
+//------------------------------------------------------------------------------
+bool vtkCommunicatorMarshaler::WriteStructure(vtkDataObject* object, vtkMultiProcessStream& stream)
+{
+  switch (object->GetDataObjectType())
+  {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    {
+      vtkImageData* image = vtkImageData::SafeDownCast(object);
+      const int* extent = image->GetExtent();
+      const double* origin = image->GetOrigin();
+      const double* spacing = image->GetSpacing();
+      const double* direction = image->GetDirectionMatrix()->GetData();
+      for (int i = 0; i < 6; i++)
+      {
+        stream << extent[i];
+      }
+      for (int i = 0; i < 3; i++)
+      {
+        stream << origin[i] << spacing[i];
+      }
+      for (int i = 0; i < 9; i++)
+      {
+        stream << direction[i];
+      }
+      return true;
+    }
+    case VTK_RECTILINEAR_GRID:
+    {
+      vtkRectilinearGrid* grid = vtkRectilinearGrid::SafeDownCast(object);
+      const int* extent = grid->GetExtent();
+      for (int i = 0; i < 6; i++)
+      {
+        stream << extent[i];
+      }
+      this->WriteBulkArray(grid->GetXCoordinates(), stream);
+      this->WriteBulkArray(grid->GetYCoordinates(), stream);
+      this->WriteBulkArray(grid->GetZCoordinates(), stream);
+      return true;
+    }
+    case VTK_STRUCTURED_GRID:
+    {
+      vtkStructuredGrid* grid = vtkStructuredGrid::SafeDownCast(object);
+      const int* extent = grid->GetExtent();
+      for (int i = 0; i < 6; i++)
+      {
+        stream << extent[i];
+      }
+      this->WritePoints(grid->GetPoints(), stream);
+      return true;
+    }
+    case VTK_POLY_DATA:
+    {
+      vtkPolyData* polyData = vtkPolyData::SafeDownCast(object);
+      this->WritePoints(polyData->GetPoints(), stream);
+      this->WriteCells(polyData->GetVerts(), stream);
+      this->WriteCells(polyData->GetLines(), stream);
+      this->WriteCells(polyData->GetPolys(), stream);
+      this->WriteCells(polyData->GetStrips(), stream);
+      return true;
+    }
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(object);
+      this->WritePoints(grid->GetPoints(), stream);
+      this->WriteBulkArray(grid->GetCellTypes(), stream);
+      this->WriteCells(grid->GetCells(), stream);
+      this->WriteCells(grid->GetPolyhedronFaceLocations(), stream);
+      this->WriteCells(grid->GetPolyhedronFaces(), stream);
+      return true;
+    }
+    case VTK_TABLE:
+      return this->WriteFieldData(vtkTable::SafeDownCast(object)->GetRowData(), stream);
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(object);
+      stream << multiBlock->GetNumberOfBlocks();
+      for (unsigned int i = 0; i < multiBlock->GetNumberOfBlocks(); i++)
+      {
+        this->WriteName(multiBlock, i, stream);
+        if (!this->WriteObject(multiBlock->GetBlock(i), stream))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(object);
+      stream << partitioned->GetNumberOfPartitions();
+      for (unsigned int i = 0; i < partitioned->GetNumberOfPartitions(); i++)
+      {
+        this->WriteName(partitioned, i, stream);
+        if (!this->WriteObject(partitioned->GetPartitionAsDataObject(i), stream))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    {
+      vtkPartitionedDataSetCollection* collection =
+        vtkPartitionedDataSetCollection::SafeDownCast(object);
+      stream << collection->GetNumberOfPartitionedDataSets();
+      for (unsigned int i = 0; i < collection->GetNumberOfPartitionedDataSets(); i++)
+      {
+        this->WriteName(collection, i, stream);
+        if (!this->WriteObject(collection->GetPartitionedDataSet(i), stream))
+        {
+          return false;
+        }
+      }
+      vtkDataAssembly* assembly = collection->GetDataAssembly();
+      stream << (assembly != nullptr);
+      if (assembly)
+      {
+        stream << assembly->SerializeToXML(vtkIndent());
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkCommunicatorMarshaler::WriteObject(vtkDataObject* object, vtkMultiProcessStream& stream)
+{
+  stream << (object ? object->GetDataObjectType() : -1);
+  if (!object)
+  {
+    return true;
+  }
+  if (!this->WriteStructure(object, stream) ||
+    !this->WriteFieldData(object->GetFieldData(), stream))
+  {
+    return false;
+  }
+  if (vtkDataSet* dataSet = vtkDataSet::SafeDownCast(object))
+  {
+    return this->WriteFieldData(dataSet->GetPointData(), stream) &&
+      this->WriteFieldData(dataSet->GetCellData(), stream);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+class vtkCommunicatorUnMarshaler
+{
+public:
+  vtkCommunicatorUnMarshaler(const std::vector<vtkSmartPointer<vtkDataArray>>& arrays)
+    : Arrays(arrays)
+  {
+  }
+
+  vtkSmartPointer<vtkDataObject> ReadObject(vtkMultiProcessStream& stream);
+
+  // Set when the structure refers to more arrays than there are.
+  bool Failed = false;
+
+private:
+  const std::vector<vtkSmartPointer<vtkDataArray>>& Arrays;
+  size_t NextArray = 0;
+
+  vtkDataArray* NextBulkArray();
+  vtkDataArray* ReadBulkArray(vtkMultiProcessStream& stream);
+  vtkSmartPointer<vtkAbstractArray> ReadArray(vtkMultiProcessStream& stream);
+  void ReadFieldData(vtkFieldData* fieldData, vtkMultiProcessStream& stream);
+  vtkSmartPointer<vtkPoints> ReadPoints(vtkMultiProcessStream& stream);
+  vtkSmartPointer<vtkCellArray> ReadCells(vtkMultiProcessStream& stream);
+  void ReadStructure(vtkDataObject* object, vtkMultiProcessStream& stream);
+
+  template <class T>
+  void ReadName(T* composite, unsigned int index, vtkMultiProcessStream& stream)
+  {
+    bool hasName;
+    stream >> hasName;
+    if (hasName)
+    {
+      std::string name;
+      stream >> name;
+      composite->GetMetaData(index)->Set(vtkCompositeDataSet::NAME(), name);
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkCommunicatorUnMarshaler::NextBulkArray()
+{
+  if (this->NextArray >= this->Arrays.size())
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  return this->Arrays[this->NextArray++];
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkCommunicatorUnMarshaler::ReadBulkArray(vtkMultiProcessStream& stream)
+{
+  bool hasArray;
+  stream >> hasArray;
+  return (hasArray ? this->NextBulkArray() : nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractArray> vtkCommunicatorUnMarshaler::ReadArray(
+  vtkMultiProcessStream& stream)
+{
+  vtkSmartPointer<vtkAbstractArray> array;
+  int kind;
+  stream >> kind;
+  if (kind == BULK_ARRAY)
+  {
+    array = this->NextBulkArray();
+  }
+  else
+  {
+    int numComponents;
+    vtkIdType numValues;
+    stream >> numComponents >> numValues;
+    vtkNew<vtkStringArray> stringArray;
+    stringArray->SetNumberOfComponents(numComponents);
+    stringArray->SetNumberOfValues(numValues);
+    for (vtkIdType i = 0; i < numValues; i++)
+    {
+      std::string value;
+      stream >> value;
+      stringArray->SetValue(i, value);
+    }
+    array = stringArray;
+  }
+
+  bool hasName;
+  std::string name;
+  stream >> hasName;
+  if (hasName)
+  {
+    stream >> name;
+  }
+  bool hasComponentNames;
+  stream >> hasComponentNames;
+  std::vector<std::pair<int, std::string>> componentNames;
+  for (int c = 0; hasComponentNames && c < (array ? array->GetNumberOfComponents() : 0); c++)
+  {
+    bool hasComponentName;
+    stream >> hasComponentName;
+    if (hasComponentName)
+    {
+      componentNames.emplace_back(c, std::string());
+      stream >> componentNames.back().second;
+    }
+  }
+  if (array)
+  {
+    array->SetName(hasName ? name.c_str() : nullptr);
+    for (const auto& componentName : componentNames)
+    {
+      array->SetComponentName(componentName.first, componentName.second.c_str());
+    }
+  }
+  return array;
+}
+
+//------------------------------------------------------------------------------
+void vtkCommunicatorUnMarshaler::ReadFieldData(
+  vtkFieldData* fieldData, vtkMultiProcessStream& stream)
+{
+  vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+  int numArrays;
+  stream >> numArrays;
+  for (int i = 0; i < numArrays && !this->Failed; i++)
+  {
+    vtkSmartPointer<vtkAbstractArray> array = this->ReadArray(stream);
+    int attributeType;
+    stream >> attributeType;
+    if (!array)
+    {
+      return;
+    }
+    int index = fieldData->AddArray(array);
+    if (attributes && attributeType >= 0)
+    {
+      attributes->SetActiveAttribute(index, attributeType);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkPoints> vtkCommunicatorUnMarshaler::ReadPoints(vtkMultiProcessStream& stream)
+{
+  vtkDataArray* data = this->ReadBulkArray(stream);
+  if (!data)
+  {
+    return nullptr;
+  }
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetData(data);
+  return points;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> vtkCommunicatorUnMarshaler::ReadCells(vtkMultiProcessStream& stream)
+{
+  bool hasCells;
+  stream >> hasCells;
+  if (!hasCells)
+  {
+    return nullptr;
+  }
+  vtkIdType cellSize;
+  stream >> cellSize;
+  vtkDataArray* offsets = (cellSize == 0 ? this->ReadBulkArray(stream) : nullptr);
+  vtkDataArray* connectivity = this->ReadBulkArray(stream);
+  if (!connectivity || (cellSize == 0 && !offsets))
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  auto cells = vtkSmartPointer<vtkCellArray>::New();
+  if (!(cellSize > 0 ? cells->SetData(cellSize, connectivity)
+                     : cells->SetData(offsets, connectivity)))
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  return cells;
+}
+
+//------------------------------------------------------------------------------
+void vtkCommunicatorUnMarshaler::ReadStructure(vtkDataObject* object, vtkMultiProcessStream& stream)
+{
+  switch (object->GetDataObjectType())
+  {
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    {
+      vtkImageData* image = vtkImageData::SafeDownCast(object);
+      int extent[6];
+      double origin[3], spacing[3], direction[9];
+      for (int i = 0; i < 6; i++)
+      {
+        stream >> extent[i];
+      }
+      for (int i = 0; i < 3; i++)
+      {
+        stream >> origin[i] >> spacing[i];
+      }
+      for (int i = 0; i < 9; i++)
+      {
+        stream >> direction[i];
+      }
+      image->SetExtent(extent);
+      image->SetOrigin(origin);
+      image->SetSpacing(spacing);
+      image->SetDirectionMatrix(direction);
+      break;
+    }
+    case VTK_RECTILINEAR_GRID:
+    {
+      vtkRectilinearGrid* grid = vtkRectilinearGrid::SafeDownCast(object);
+      int extent[6];
+      for (int i = 0; i < 6; i++)
+      {
+        stream >> extent[i];
+      }
+      grid->SetExtent(extent);
+      grid->SetXCoordinates(this->ReadBulkArray(stream));
+      grid->SetYCoordinates(this->ReadBulkArray(stream));
+      grid->SetZCoordinates(this->ReadBulkArray(stream));
+      break;
+    }
+    case VTK_STRUCTURED_GRID:
+    {
+      vtkStructuredGrid* grid = vtkStructuredGrid::SafeDownCast(object);
+      int extent[6];
+      for (int i = 0; i < 6; i++)
+      {
+        stream >> extent[i];
+      }
+      grid->SetExtent(extent);
+      grid->SetPoints(this->ReadPoints(stream));
+      break;
+    }
+    case VTK_POLY_DATA:
+    {
+      vtkPolyData* polyData = vtkPolyData::SafeDownCast(object);
+      polyData->SetPoints(this->ReadPoints(stream));
+      vtkSmartPointer<vtkCellArray> verts = this->ReadCells(stream);
+      vtkSmartPointer<vtkCellArray> lines = this->ReadCells(stream);
+      vtkSmartPointer<vtkCellArray> polys = this->ReadCells(stream);
+      vtkSmartPointer<vtkCellArray> strips = this->ReadCells(stream);
+      polyData->SetVerts(verts);
+      polyData->SetLines(lines);
+      polyData->SetPolys(polys);
+      polyData->SetStrips(strips);
+      break;
+    }
+    case VTK_UNSTRUCTURED_GRID:
+    {
+      vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(object);
+      grid->SetPoints(this->ReadPoints(stream));
+      vtkDataArray* cellTypes = this->ReadBulkArray(stream);
+      vtkSmartPointer<vtkCellArray> cells = this->ReadCells(stream);
+      vtkSmartPointer<vtkCellArray> faceLocations = this->ReadCells(stream);
+      vtkSmartPointer<vtkCellArray> faces = this->ReadCells(stream);
+      if (cellTypes && cells)
+      {
+        if (faceLocations && faces)
+        {
+          grid->SetPolyhedralCells(cellTypes, cells, faceLocations, faces);
+        }
+        else
+        {
+          grid->SetCells(cellTypes, cells);
+        }
+      }
+      break;
+    }
+    case VTK_TABLE:
+      this->ReadFieldData(vtkTable::SafeDownCast(object)->GetRowData(), stream);
+      break;
+    case VTK_MULTIBLOCK_DATA_SET:
+    {
+      vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(object);
+      unsigned int numBlocks;
+      stream >> numBlocks;
+      multiBlock->SetNumberOfBlocks(numBlocks);
+      for (unsigned int i = 0; i < numBlocks && !this->Failed; i++)
+      {
+        this->ReadName(multiBlock, i, stream);
+        multiBlock->SetBlock(i, this->ReadObject(stream));
+      }
+      break;
+    }
+    case VTK_PARTITIONED_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
+    {
+      vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(object);
+      unsigned int numPartitions;
+      stream >> numPartitions;
+      partitioned->SetNumberOfPartitions(numPartitions);
+      for (unsigned int i = 0; i < numPartitions && !this->Failed; i++)
+      {
+        this->ReadName(partitioned, i, stream);
+        partitioned->SetPartition(i, this->ReadObject(stream));
+      }
+      break;
+    }
+    case VTK_PARTITIONED_DATA_SET_COLLECTION:
+    {
+      vtkPartitionedDataSetCollection* collection =
+        vtkPartitionedDataSetCollection::SafeDownCast(object);
+      unsigned int numPartitionedDataSets;
+      stream >> numPartitionedDataSets;
+      collection->SetNumberOfPartitionedDataSets(numPartitionedDataSets);
+      for (unsigned int i = 0; i < numPartitionedDataSets && !this->Failed; i++)
+      {
+        this->ReadName(collection, i, stream);
+        collection->SetPartitionedDataSet(
+          i, vtkPartitionedDataSet::SafeDownCast(this->ReadObject(stream)));
+      }
+      bool hasAssembly;
+      stream >> hasAssembly;
+      if (hasAssembly)
+      {
+        std::string xml;
+        stream >> xml;
+        vtkNew<vtkDataAssembly> assembly;
+        assembly->InitializeFromXML(xml.c_str());
+        collection->SetDataAssembly(assembly);
+      }
+      break;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkCommunicatorUnMarshaler::ReadObject(
+  vtkMultiProcessStream& stream)
+{
+  int dataType;
+  stream >> dataType;
+  if (dataType < 0 || this->Failed)
+  {
+    return nullptr;
+  }
+  auto object = vtk::TakeSmartPointer(vtkDataObjectTypes::NewDataObject(dataType));
+  if (!object)
+  {
+    this->Failed = true;
+    return nullptr;
+  }
+  this->ReadStructure(object, stream);
+  this->ReadFieldData(object->GetFieldData(), stream);
+  if (vtkDataSet* dataSet = vtkDataSet::SafeDownCast(object))
+  {
+    this->ReadFieldData(dataSet->GetPointData(), stream);
+    this->ReadFieldData(dataSet->GetCellData(), stream);
+  }
+  return object;
+}
+
+//------------------------------------------------------------------------------
+// Allocate the bulk arrays listed at the start of the metadata.
+bool vtkCommunicatorNewBulkArrays(
+  vtkMultiProcessStream metadata, std::vector<vtkSmartPointer<vtkDataArray>>& arrays)
+{
+  int version;
+  unsigned int numArrays;
+  metadata >> version >> numArrays;
+  if (version != VTK_COMMUNICATOR_MARSHAL_VERSION)
+  {
+    return false;
+  }
+  arrays.clear();
+  for (unsigned int i = 0; i < numArrays; i++)
+  {
+    int dataType, numComponents;
+    vtkIdType numTuples;
+    metadata >> dataType >> numComponents >> numTuples;
+    auto array = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(dataType));
+    if (!array)
+    {
+      return false;
+    }
+    array->SetNumberOfComponents(numComponents);
+    array->SetNumberOfTuples(numTuples);
+    arrays.push_back(array);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Shallow copy an unmarshaled data object into the given one.
+int vtkCommunicatorAdoptDataObject(vtkDataObject* source, vtkDataObject* data)
+{
+  if (!source)
+  {
+    return 0;
+  }
+  if (!source->IsA(data->GetClassName()))
+  {
+    vtkGenericWarningMacro("Type mismatch while unmarshalling data.");
+  }
+  data->ShallowCopy(source);
+  return 1;
+}
+}
+
 //=============================================================================
 vtkCommunicator::vtkCommunicator()
 {
@@ -210,6 +931,34 @@ int vtkCommunicator::Send(vtkDataObject* data, int remoteHandle, int tag)
 //------------------------------------------------------------------------------
 int vtkCommunicator::SendElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
+  // Send the metadata, then the bulk arrays as they are. Empty metadata
+  // means that the data object follows in the legacy format.
+  vtkMultiProcessStream metadata;
+  std::vector<vtkSmartPointer<vtkDataArray>> arrays;
+  if (!vtkCommunicator::MarshalDataObject(data, metadata, arrays))
+  {
+    metadata.Reset();
+    arrays.clear();
+  }
+  if (!this->Send(metadata, remoteHandle, tag))
+  {
+    return 0;
+  }
+  for (vtkDataArray* array : arrays)
+  {
+    vtkIdType size = array->GetNumberOfValues();
+    // NOLINTNEXTLINE(bugprone-unsafe-functions)
+    if (size > 0 &&
+      !this->SendVoidArray(array->GetVoidPointer(0), size, array->GetDataType(), remoteHandle, tag))
+    {
+      return 0;
+    }
+  }
+  if (!metadata.Empty())
+  {
+    return 1;
+  }
+
   VTK_CREATE(vtkCharArray, buffer);
   if (vtkCommunicator::MarshalDataObject(data, buffer))
   {
@@ -414,13 +1163,42 @@ int vtkCommunicator::ReceiveDataObject(vtkDataObject* data, int remoteHandle, in
 //------------------------------------------------------------------------------
 int vtkCommunicator::ReceiveElementalDataObject(vtkDataObject* data, int remoteHandle, int tag)
 {
-  VTK_CREATE(vtkCharArray, buffer);
-  if (!this->Receive(buffer, remoteHandle, tag))
+  vtkMultiProcessStream metadata;
+  if (!this->Receive(metadata, remoteHandle, tag))
   {
     return 0;
   }
+  if (metadata.Empty())
+  {
+    VTK_CREATE(vtkCharArray, buffer);
+    if (!this->Receive(buffer, remoteHandle, tag))
+    {
+      return 0;
+    }
+
+    return vtkCommunicator::UnMarshalDataObject(buffer, data);
+  }
 
-  return vtkCommunicator::UnMarshalDataObject(buffer, data);
+  // Receive the bulk arrays directly into the arrays of the data object.
+  std::vector<vtkSmartPointer<vtkDataArray>> arrays;
+  if (!vtkCommunicatorNewBulkArrays(metadata, arrays))
+  {
+    vtkErrorMacro("Could not allocate the arrays of the received data object.");
+    return 0;
+  }
+  for (vtkDataArray* array : arrays)
+  {
+    vtkIdType size = array->GetNumberOfValues();
+    // NOLINTNEXTLINE(bugprone-unsafe-functions)
+    if (size > 0 &&
+      !this->ReceiveVoidArray(
+        array->GetVoidPointer(0), size, array->GetDataType(), remoteHandle, tag))
+    {
+      return 0;
+    }
+  }
+  return vtkCommunicatorAdoptDataObject(
+    vtkCommunicator::UnMarshalDataObject(metadata, arrays), data);
 }
 
 int vtkCommunicator::Receive(vtkDataArray* data, int remoteHandle, int tag)
@@ -515,6 +1293,69 @@ int vtkCommunicator::Receive(vtkDataArray* data, int remoteHandle, int tag)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+int vtkCommunicator::MarshalDataObject(vtkDataObject* object, vtkMultiProcessStream& metadata,
+  std::vector<vtkSmartPointer<vtkDataArray>>& arrays)
+{
+  metadata.Reset();
+  arrays.clear();
+
+  vtkCommunicatorMarshaler marshaler;
+  vtkMultiProcessStream structure;
+  if (!object || !marshaler.WriteObject(object, structure))
+  {
+    return 0;
+  }
+
+  metadata << VTK_COMMUNICATOR_MARSHAL_VERSION
+           << static_cast<unsigned int>(marshaler.Arrays.size());
+  for (vtkDataArray* array : marshaler.Arrays)
+  {
+    metadata << array->GetDataType() << array->GetNumberOfComponents()
+             << array->GetNumberOfTuples();
+  }
+  metadata << structure;
+  arrays = std::move(marshaler.Arrays);
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkCommunicator::UnMarshalDataObject(
+  vtkMultiProcessStream& metadata, const std::vector<vtkSmartPointer<vtkDataArray>>& arrays)
+{
+  int version;
+  unsigned int numArrays;
+  metadata >> version >> numArrays;
+  if (version != VTK_COMMUNICATOR_MARSHAL_VERSION || numArrays != arrays.size())
+  {
+    vtkGenericWarningMacro("Metadata does not match the arrays to unmarshal.");
+    return nullptr;
+  }
+  for (vtkDataArray* array : arrays)
+  {
+    int dataType, numComponents;
+    vtkIdType numTuples;
+    metadata >> dataType >> numComponents >> numTuples;
+    if (!array || array->GetDataType() != dataType ||
+      array->GetNumberOfComponents() != numComponents || array->GetNumberOfTuples() != numTuples)
+    {
+      vtkGenericWarningMacro("Metadata does not match the arrays to unmarshal.");
+      return nullptr;
+    }
+  }
+
+  vtkMultiProcessStream structure;
+  metadata >> structure;
+  vtkCommunicatorUnMarshaler unmarshaler(arrays);
+  vtkSmartPointer<vtkDataObject> object = unmarshaler.ReadObject(structure);
+  if (unmarshaler.Failed)
+  {
+    vtkGenericWarningMacro("Error detected while unmarshaling data object.");
+    return nullptr;
+  }
+  return object;
+}
+
 //------------------------------------------------------------------------------
 int vtkCommunicator::MarshalDataObject(vtkDataObject* object, vtkCharArray* buffer)
 {
@@ -897,8 +1738,44 @@ int vtkCommunicator::BroadcastVoidArray(void* data, vtkIdType length, int type,
 //------------------------------------------------------------------------------
 int vtkCommunicator::Broadcast(vtkDataObject* data, int srcProcessId)
 {
+  // Broadcast the metadata, then the bulk arrays as they are. Empty metadata
+  // means that the data object follows in the legacy format.
+  vtkMultiProcessStream metadata;
+  std::vector<vtkSmartPointer<vtkDataArray>> arrays;
+  bool isSource = (this->LocalProcessId == srcProcessId);
+  if (isSource && !vtkCommunicator::MarshalDataObject(data, metadata, arrays))
+  {
+    metadata.Reset();
+    arrays.clear();
+  }
+  if (!this->Broadcast(metadata, srcProcessId))
+  {
+    return 0;
+  }
+  if (!metadata.Empty())
+  {
+    if (!isSource && !vtkCommunicatorNewBulkArrays(metadata, arrays))
+    {
+      vtkErrorMacro("Could not allocate the arrays of the broadcast data object.");
+      return 0;
+    }
+    for (vtkDataArray* array : arrays)
+    {
+      vtkIdType size = array->GetNumberOfValues();
+      // NOLINTNEXTLINE(bugprone-unsafe-functions)
+      if (size > 0 &&
+        !this->BroadcastVoidArray(
+          array->GetVoidPointer(0), size, array->GetDataType(), srcProcessId))
+      {
+        return 0;
+      }
+    }
+    return isSource ||
+      vtkCommunicatorAdoptDataObject(vtkCommunicator::UnMarshalDataObject(metadata, arrays), data);
+  }
+
   VTK_CREATE(vtkCharArray, buffer);
-  if (this->LocalProcessId == srcProcessId)
+  if (isSource)
   {
     if (vtkCommunicator::MarshalDataObject(data, buffer))
     {
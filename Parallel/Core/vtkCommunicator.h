@@ -7,7 +7,8 @@
  * This is an abstract class which contains functionality for sending
  * and receiving inter-process messages. It contains methods for marshaling
  * an object into a string (currently used by the MPI communicator but
- * not the shared memory communicator).
+ * not the shared memory communicator), or into binary metadata and a list
+ * of bulk arrays, which is how data objects are sent.
  *
  * @warning
  * Communication between systems with different vtkIdTypes is not
@@ -1321,6 +1322,34 @@ public:
    */
   static vtkSmartPointer<vtkDataObject> UnMarshalDataObject(vtkCharArray* buffer);
 
+  ///@{
+  /**
+   * Convert a data object into binary metadata and a list of bulk arrays,
+   * and vice versa. The bulk arrays hold the values of all the data arrays,
+   * points and cells of the object, so that they can be sent as they are in
+   * separate messages instead of being copied into a single buffer. Arrays
+   * with the standard memory layout are not copied, the others are converted
+   * to it. UnMarshalDataObject() adopts the bulk arrays into the new data
+   * object, which must be given the arrays that were marshaled, or arrays
+   * with the same types and sizes holding the same values.
+   *
+   * vtkImageData, vtkRectilinearGrid, vtkStructuredGrid, vtkPolyData,
+   * vtkUnstructuredGrid, vtkTable, and vtkMultiBlockDataSet,
+   * vtkPartitionedDataSet and vtkPartitionedDataSetCollection made of these
+   * are supported. MarshalDataObject() returns 0 for other data objects, or
+   * data objects with arrays that are neither data arrays (except bit arrays)
+   * nor string arrays, which can still be marshaled into a vtkCharArray.
+   * UnMarshalDataObject() returns nullptr if the arrays do not match the
+   * metadata.
+   *
+   * Send(), Receive() and Broadcast() of data objects use this format.
+   */
+  static int MarshalDataObject(vtkDataObject* object, vtkMultiProcessStream& metadata,
+    std::vector<vtkSmartPointer<vtkDataArray>>& arrays);
+  static vtkSmartPointer<vtkDataObject> UnMarshalDataObject(
+    vtkMultiProcessStream& metadata, const std::vector<vtkSmartPointer<vtkDataArray>>& arrays);
+  ///@}
+
 protected:
   int WriteDataArray(vtkDataArray* object);
   int ReadDataArray(vtkDataArray* object);
@@ -754,8 +754,10 @@ vtkMultiProcessStream& vtkMultiProcessStream::operator>>(vtkMultiProcessStream&
   this->Internals->Pop(&value.Endianness, 1);
   size--;
 
-  value.Internals->Data.resize(size);
-  this->Internals->Pop(&value.Internals->Data[0], size);
+  // The data is not contiguous, move it element by element.
+  auto end = this->Internals->Data.begin() + size;
+  value.Internals->Data.assign(this->Internals->Data.begin(), end);
+  this->Internals->Data.erase(this->Internals->Data.begin(), end);
   return (*this);
 }
 